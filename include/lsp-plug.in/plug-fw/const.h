@@ -54,6 +54,8 @@
 // Prefix for built-in resource
 #define LSP_BUILTIN_PREFIX                  "builtin://"
 #define LSP_RESOURCE_PATH_VAR               "LSP_RESOURCE_PATH"
+#define LSP_EXECUTOR_THREADS_VAR            "LSP_EXECUTOR_THREADS"
+#define LSP_DSP_PROFILE_VAR                 "LSP_DSP_PROFILE"
 
 #ifdef LSP_IDE_DEBUG
     #ifndef LSP_NO_BUILTIN_RESOURCES
@@ -24,8 +24,10 @@
 
 #include <lsp-plug.in/plug-fw/version.h>
 
+#include <lsp-plug.in/common/atomic.h>
 #include <lsp-plug.in/dsp-units/sampling/Sample.h>
 #include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/ipc/Thread.h>
 
 namespace lsp
 {
@@ -33,21 +35,33 @@ namespace lsp
     {
         /**
          * Simple audio tracer object that allows to trace audio streams into separate audio files
-         * stored in some folder.
+         * stored in some folder. The submitted data is copied into the preallocated ring buffer
+         * and is written to the disk by the background thread, so the submit() method never blocks.
+         * If the ring buffer overflows, the data is dropped and the drop counter is incremented.
          */
         class AudioTracer
         {
             public:
                 static constexpr size_t SAMPLE_RATE         = 48000;
                 static constexpr size_t FRAME_LENTH         = SAMPLE_RATE * 5;
+                static constexpr size_t RING_LENGTH         = 0x20000;        // Should be power of 2
+                static constexpr size_t IDLE_DELAY          = 20;
 
             private:
-                dspu::Sample    sSample;
+                dspu::Sample    sSample;        // Current frame, accessed by the writer thread only
                 io::Path        sPath;
                 char           *pId;
                 const void     *pInstance;
                 size_t          nFrameId;
 
+                ipc::Thread    *pWriter;        // Background writer thread
+                float          *vRing;          // Ring buffer
+                uatomic_t       nHead;          // Write position of the ring buffer (producer)
+                uatomic_t       nTail;          // Read position of the ring buffer (consumer)
+                uatomic_t       nDropped;       // Overall number of dropped samples
+                uatomic_t       nDropEvents;    // Number of submit() calls that dropped samples
+                uatomic_t       nReported;      // Number of dropped samples already reported, accessed by the writer thread only
+
             public:
                 AudioTracer();
                 AudioTracer(const AudioTracer &) = delete;
@@ -57,10 +71,15 @@ namespace lsp
                 AudioTracer & operator = (const AudioTracer &) = delete;
                 AudioTracer & operator = (AudioTracer &&) = delete;
 
+            private:
+                static status_t writer_main(void *arg);
+
             private:
                 void            stop_trace();
                 status_t        make_full_path(io::Path &wpath, const char *format, const char *id, const void *instance);
                 status_t        save_frame();
+                size_t          drain_ring();
+                void            report_drops();
 
             public:
                 /**
@@ -72,11 +91,24 @@ namespace lsp
                 status_t        set_trace(const char *format, const char *id, const void *instance);
 
                 /**
-                 * Submit audio samples to the trace
+                 * Submit audio samples to the trace, never blocks. Samples that do not fit
+                 * into the ring buffer are dropped.
                  * @param data data to submit
                  * @param count number of samples to submit
                  */
                 void            submit(const float *data, size_t count);
+
+                /**
+                 * Get overall number of dropped samples
+                 * @return overall number of dropped samples
+                 */
+                inline size_t   dropped() const         { return atomic_load(&nDropped);        }
+
+                /**
+                 * Get number of submit() calls that caused samples to be dropped
+                 * @return number of drop events
+                 */
+                inline size_t   drop_events() const     { return atomic_load(&nDropEvents);     }
         };
 
     } /* namespace core */
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_PLUG_FW_CORE_CHANGESET_H_
+#define LSP_PLUG_IN_PLUG_FW_CORE_CHANGESET_H_
+
+#include <lsp-plug.in/plug-fw/version.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/common/types.h>
+
+namespace lsp
+{
+    namespace core
+    {
+        /**
+         * Lock-free set of changed items. Any number of threads may mark items as changed,
+         * only one thread is allowed to consume the changes. The consumer first calls begin()
+         * to check that there were changes since the previous call and then calls next()
+         * until it returns negative value to obtain indices of changed items.
+         */
+        class ChangeSet
+        {
+            public:
+                static constexpr size_t WORD_BITS       = sizeof(uatomic_t) * 8;
+
+            private:
+                uatomic_t          *vWords;         // Bit set of changed items
+                size_t              nWords;         // Number of words in the bit set
+                size_t              nItems;         // Number of items
+                uatomic_t           nRequest;       // Change request counter
+                uatomic_t           nResponse;      // Change response counter
+
+                size_t              nWord;          // Current word of the consumer
+                size_t              nBase;          // Index of the first item in the current word
+                uatomic_t           nBits;          // Bits of the current word not yet processed by the consumer
+
+            public:
+                ChangeSet();
+                ChangeSet(const ChangeSet &) = delete;
+                ChangeSet(ChangeSet &&) = delete;
+                ~ChangeSet();
+
+                ChangeSet & operator = (const ChangeSet &) = delete;
+                ChangeSet & operator = (ChangeSet &&) = delete;
+
+            public:
+                /**
+                 * Initialize the change set
+                 * @param items number of items in the set
+                 * @return status of operation
+                 */
+                status_t            init(size_t items);
+
+                /**
+                 * Destroy the change set
+                 */
+                void                destroy();
+
+            public:
+                /**
+                 * Get number of items in the set
+                 * @return number of items in the set
+                 */
+                inline size_t       size() const        { return nItems;        }
+
+                /**
+                 * Mark item as changed, can be called from any thread
+                 * @param index index of the item
+                 */
+                void                mark(size_t index);
+
+                /**
+                 * Mark all items as changed, can be called from any thread
+                 */
+                void                mark_all();
+
+                /**
+                 * Begin processing of changes, consumer-side only
+                 * @return true if there were changes since the last call
+                 */
+                bool                begin();
+
+                /**
+                 * Fetch the index of the next changed item and reset it's changed state,
+                 * consumer-side only
+                 * @return index of the changed item or negative value if there are no more changes
+                 */
+                ssize_t             next();
+        };
+
+    } /* namespace core */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_PLUG_FW_CORE_CHANGESET_H_ */
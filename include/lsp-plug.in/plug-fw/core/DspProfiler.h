@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LSP_PLUG_IN_PLUG_FW_CORE_DSPPROFILER_H_
+#define LSP_PLUG_IN_PLUG_FW_CORE_DSPPROFILER_H_
+
+#include <lsp-plug.in/plug-fw/version.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp-units/iface/IStateDumper.h>
+#include <lsp-plug.in/io/Path.h>
+
+namespace lsp
+{
+    namespace core
+    {
+        /**
+         * Identifiers of DSP profiler probes
+         */
+        enum dsp_probe_t
+        {
+            DSP_PROBE_BLOCK,                // Whole processing cycle of the wrapper
+            DSP_PROBE_PROCESS,              // Call of plug::Module::process()
+            DSP_PROBE_SETTINGS,             // Call of plug::Module::update_settings()
+            DSP_PROBE_SHM_PRE,              // Call of core::ShmClient::pre_process()
+            DSP_PROBE_SHM_POST,             // Call of core::ShmClient::post_process()
+            DSP_PROBE_SAMPLE_PLAYER,        // Call of core::SamplePlayer::process()
+
+            DSP_PROBE_TOTAL
+        };
+
+        /**
+         * Statistics of the DSP profiler probe. The load is the ratio between the time
+         * spent and the real-time duration of the processed block
+         */
+        typedef struct dsp_stats_t
+        {
+            size_t      count;              // Number of measurements
+            float       min_load;           // Minimum load
+            float       avg_load;           // Average load
+            float       p99_load;           // 99th percentile of the load
+            float       max_load;           // Maximum load
+            float       min_time;           // Minimum time [us]
+            float       avg_time;           // Average time [us]
+            float       max_time;           // Maximum time [us]
+        } dsp_stats_t;
+
+        /**
+         * Per-block timing instrumentation of the DSP code. Measurements are submitted
+         * by the single DSP thread into lock-free histograms, statistics can be read by
+         * any other thread. The profiler is enabled by the LSP_DSP_PROFILE environment
+         * variable which should contain the path to the directory for storing reports.
+         */
+        class DspProfiler
+        {
+            public:
+                static constexpr size_t     BUCKETS             = 256;      // Number of histogram buckets
+                static constexpr size_t     BUCKET_SCALE        = 100;      // Number of buckets per block deadline
+
+            private:
+                typedef struct probe_t
+                {
+                    uatomic_t       vBuckets[BUCKETS];  // Histogram of load, the last bucket holds overflows
+                    uatomic_t       nCount;             // Number of measurements
+                    float           fMinLoad;           // Minimum load
+                    float           fMaxLoad;           // Maximum load
+                    double          fSumLoad;           // Sum of load
+                    float           fMinTime;           // Minimum time [us]
+                    float           fMaxTime;           // Maximum time [us]
+                    double          fSumTime;           // Sum of time [us]
+                } probe_t;
+
+            private:
+                probe_t             vProbes[DSP_PROBE_TOTAL];   // List of probes
+                io::Path            sPath;                      // Directory for reports
+                const char         *sUID;                       // Plugin identifier
+
+            public:
+                explicit DspProfiler(const char *uid);
+                DspProfiler(const DspProfiler &) = delete;
+                DspProfiler(DspProfiler &&) = delete;
+                ~DspProfiler();
+
+                DspProfiler & operator = (const DspProfiler &) = delete;
+                DspProfiler & operator = (DspProfiler &&) = delete;
+
+            public:
+                /**
+                 * Check that DSP profiling is enabled by the environment
+                 * @return true if DSP profiling is enabled
+                 */
+                static bool         enabled();
+
+                /**
+                 * Create the profiler if profiling is enabled by the environment
+                 * @param uid unique identifier of the plugin
+                 * @return pointer to profiler or NULL if profiling is disabled
+                 */
+                static DspProfiler *create(const char *uid);
+
+                /**
+                 * Get the current timestamp of the monotonic clock
+                 * @return current timestamp in nanoseconds
+                 */
+                static uint64_t     timestamp();
+
+                /**
+                 * Get name of the probe
+                 * @param probe probe identifier
+                 * @return name of the probe
+                 */
+                static const char  *probe_name(dsp_probe_t probe);
+
+            public:
+                /**
+                 * Submit the measurement, should be called from the DSP thread only
+                 * @param probe probe identifier
+                 * @param start timestamp obtained by the timestamp() call before the measured code
+                 * @param samples number of samples in the processed block
+                 * @param sample_rate sample rate
+                 */
+                void                commit(dsp_probe_t probe, uint64_t start, size_t samples, size_t sample_rate);
+
+                /**
+                 * Get statistics of the probe, can be called from any thread
+                 * @param dst destination to store statistics
+                 * @param probe probe identifier
+                 */
+                void                stats(dsp_stats_t *dst, dsp_probe_t probe) const;
+
+                /**
+                 * Dump the statistics of all probes
+                 * @param v state dumper
+                 */
+                void                dump(dspu::IStateDumper *v) const;
+
+                /**
+                 * Save machine-readable report to the directory specified by environment
+                 * @return status of operation
+                 */
+                status_t            save() const;
+        };
+
+    } /* namespace core */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_PLUG_FW_CORE_DSPPROFILER_H_ */
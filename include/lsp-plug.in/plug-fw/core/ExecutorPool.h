@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LSP_PLUG_IN_PLUG_FW_CORE_EXECUTORPOOL_H_
+#define LSP_PLUG_IN_PLUG_FW_CORE_EXECUTORPOOL_H_
+
+#include <lsp-plug.in/plug-fw/version.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/ipc/IExecutor.h>
+#include <lsp-plug.in/ipc/Mutex.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/lltl/parray.h>
+#include <lsp-plug.in/plug-fw/core/Notifier.h>
+
+namespace lsp
+{
+    namespace core
+    {
+        /**
+         * Process-wide work-stealing pool of threads for executing offline tasks.
+         * Each worker has it's own queue of tasks, idle workers steal tasks from
+         * queues of other workers. Idle workers sleep until a task is submitted to
+         * their queue or another worker finds more pending tasks than it can take.
+         * The pool is shared between all plugin instances which reside in the same
+         * process and should be accessed either via SharedExecutor or by an executor
+         * that wraps the pool and tracks the submitted tasks.
+         */
+        class ExecutorPool: public ipc::IExecutor
+        {
+            public:
+                static constexpr size_t     THREADS_MAX         = 64;       // Maximum number of worker threads
+                static constexpr size_t     IDLE_DELAY          = 50;       // Maximum idle delay before checking other queues [ms]
+
+            private:
+                typedef struct worker_t
+                {
+                    ExecutorPool                   *pPool;          // Pool the worker belongs to
+                    ipc::Thread                    *pThread;        // Worker thread
+                    ipc::Mutex                      sMutex;         // Mutex for the task queue
+                    Notifier                        sWakeup;        // Wakeup notification for idle worker
+                    lltl::parray<ipc::ITask>        vTasks;         // Task queue
+                    size_t                          nIndex;         // Index of the worker
+                } worker_t;
+
+            private:
+                static ipc::Mutex           sInstanceMutex;     // Mutex for the process-wide instance
+                static ExecutorPool        *pInstance;          // Process-wide instance
+                static size_t               nInstanceRefs;      // Number of references to the process-wide instance
+
+            private:
+                lltl::parray<worker_t>      vWorkers;           // List of workers
+                uatomic_t                   nNextWorker;        // Next worker to submit the task to
+                atomic_t                    nPending;           // Number of pending tasks
+
+            private:
+                static status_t     worker_main(void *arg);
+                ipc::ITask         *fetch_task(worker_t *w);
+                ipc::ITask         *steal_task(worker_t *w);
+                void                wakeup_next(worker_t *w);
+
+            public:
+                explicit ExecutorPool();
+                ExecutorPool(const ExecutorPool &) = delete;
+                ExecutorPool(ExecutorPool &&) = delete;
+                virtual ~ExecutorPool() override;
+
+                ExecutorPool & operator = (const ExecutorPool &) = delete;
+                ExecutorPool & operator = (ExecutorPool &&) = delete;
+
+            public:
+                /**
+                 * Start the pool
+                 * @param threads number of worker threads
+                 * @return status of operation
+                 */
+                status_t            start(size_t threads);
+
+                /**
+                 * Get number of worker threads
+                 * @return number of worker threads
+                 */
+                inline size_t       threads() const         { return vWorkers.size();   }
+
+            public:
+                virtual bool        submit(ipc::ITask *task) override;
+                virtual void        shutdown() override;
+
+            public:
+                /**
+                 * Get the default number of worker threads. The value is bound to the number of
+                 * CPU cores and can be overridden by the LSP_EXECUTOR_THREADS environment variable.
+                 * @return default number of worker threads
+                 */
+                static size_t       default_threads();
+
+                /**
+                 * Acquire the process-wide pool, start it on the first call
+                 * @return pointer to the pool or NULL on error
+                 */
+                static ExecutorPool *acquire();
+
+                /**
+                 * Release the process-wide pool, stop it when the last reference has been released
+                 * @param pool pool to release
+                 */
+                static void         release(ExecutorPool *pool);
+        };
+
+    } /* namespace core */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_PLUG_FW_CORE_EXECUTORPOOL_H_ */
@@ -25,6 +25,8 @@
 #include <lsp-plug.in/plug-fw/version.h>
 #include <lsp-plug.in/ipc/Thread.h>
 #include <lsp-plug.in/ipc/Mutex.h>
+#include <lsp-plug.in/plug-fw/core/KVTStorage.h>
+#include <lsp-plug.in/plug-fw/core/Notifier.h>
 #include <lsp-plug.in/plug-fw/core/osc_buffer.h>
 #include <lsp-plug.in/plug-fw/plug.h>
 
@@ -34,6 +36,30 @@ namespace lsp
     {
         class KVTDispatcher: public ipc::Thread
         {
+            public:
+                static constexpr size_t     IDLE_DELAY          = 500;      // Maximum delay between two iterations [ms]
+
+            protected:
+                class Listener: public KVTListener
+                {
+                    private:
+                        KVTDispatcher      *pDispatcher;
+
+                    public:
+                        explicit Listener(KVTDispatcher *dispatcher);
+                        Listener(const Listener &) = delete;
+                        Listener(Listener &&) = delete;
+                        virtual ~Listener() override;
+
+                        Listener & operator = (const Listener &) = delete;
+                        Listener & operator = (Listener &&) = delete;
+
+                    public:
+                        virtual void created(KVTStorage *storage, const char *id, const kvt_param_t *param, size_t pending) override;
+                        virtual void changed(KVTStorage *storage, const char *id, const kvt_param_t *oval, const kvt_param_t *nval, size_t pending) override;
+                        virtual void transaction(KVTStorage *storage, size_t changes) override;
+                };
+
             protected:
                 core::osc_buffer_t *pRx;
                 core::osc_buffer_t *pTx;
@@ -42,6 +68,10 @@ namespace lsp
                 uint8_t            *pPacket;
                 atomic_t            nClients;
                 atomic_t            nTxRequest;
+                atomic_t            nTxBlocked;     // Transmission is blocked by the overflow of the TX queue
+                atomic_t            nTxLock;        // Exclusive access of the reader to the TX queue
+                Notifier            sNotifier;      // Notifier to wake up the dispatcher thread
+                Listener            sListener;      // Listener of the KVT changes
 
             protected:
                 size_t              receive_changes();
@@ -65,10 +95,36 @@ namespace lsp
                 status_t            submit(const void *data, size_t size);
                 status_t            submit(const osc::packet_t *packet);
 
+                /**
+                 * Acquire exclusive access to the transmission queue for reading. The call does not
+                 * block and can be performed from the real-time thread.
+                 * @return true if access has been granted
+                 */
+                bool                tx_trylock();
+
+                /**
+                 * Release exclusive access to the transmission queue
+                 */
+                void                tx_unlock();
+
+                /**
+                 * Methods for reading the transmission queue. The queue contains changes of the KVT
+                 * published by the dispatcher thread and is read without locking the KVT storage.
+                 * The queue allows only one reader at a time, so the caller should hold the access
+                 * acquired by tx_trylock(). The queue is cleared only when there are no connected
+                 * clients and no reader holds the access.
+                 */
                 status_t            fetch(void *data, size_t *size, size_t limit);
                 status_t            fetch(osc::packet_t *packet, size_t limit);
+                status_t            peek(osc::packet_t *packet);
+                void                release();
                 status_t            skip();
 
+                /**
+                 * Wake up the dispatcher thread to process changes immediately, can be called from any thread
+                 */
+                void                wakeup();
+
                 void                connect_client();
                 void                disconnect_client();
 
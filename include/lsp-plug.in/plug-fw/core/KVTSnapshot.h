@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_PLUG_FW_CORE_KVTSNAPSHOT_H_
+#define LSP_PLUG_IN_PLUG_FW_CORE_KVTSNAPSHOT_H_
+
+#include <lsp-plug.in/plug-fw/version.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/plug-fw/core/KVTStorage.h>
+
+namespace lsp
+{
+    namespace core
+    {
+        /**
+         * Binary snapshot of the persistent KVT parameters. The snapshot is produced by a single
+         * pass over the KVT storage and is stored by plugin wrappers as one blob within the plugin
+         * state. The restore validates all records first and then passes keys and values to the KVT
+         * storage directly from the snapshot data without intermediate allocations.
+         *
+         * All fields are stored in little-endian byte order, each record is aligned to 64-bit
+         * boundary relatively to the beginning of the snapshot:
+         *   - header: signature, version, number of records, size of the snapshot;
+         *   - for each record: size of the record, type, flags, length of the key, length of
+         *     the string or content type, scalar value or size of the BLOB data, zero-terminated
+         *     key, zero-terminated string or content type, BLOB data.
+         * Records of unknown types are skipped on restore.
+         */
+        class KVTSnapshot
+        {
+            public:
+                static constexpr uint32_t SIGNATURE     = 0x5354564b;   // 'KVTS'
+                static constexpr uint16_t VERSION       = 1;
+
+            private:
+                uint8_t        *pData;          // Snapshot data
+                size_t          nSize;          // Size of the snapshot
+                size_t          nCapacity;      // Capacity of the buffer
+
+            protected:
+                uint8_t        *append(size_t bytes);
+
+            public:
+                KVTSnapshot();
+                KVTSnapshot(const KVTSnapshot &) = delete;
+                KVTSnapshot(KVTSnapshot &&) = delete;
+                ~KVTSnapshot();
+
+                KVTSnapshot & operator = (const KVTSnapshot &) = delete;
+                KVTSnapshot & operator = (KVTSnapshot &&) = delete;
+
+            public:
+                /**
+                 * Serialize all non-transient parameters of the KVT storage, the storage
+                 * should be locked by the caller
+                 * @param kvt KVT storage
+                 * @return status of operation
+                 */
+                status_t        save(KVTStorage *kvt);
+
+                /**
+                 * Drop the snapshot data but keep the allocated memory for further use
+                 */
+                void            clear();
+
+                /**
+                 * Drop the snapshot data and free the allocated memory
+                 */
+                void            destroy();
+
+                /**
+                 * Get the snapshot data
+                 * @return pointer to the snapshot data
+                 */
+                inline const void *data() const     { return pData;         }
+
+                /**
+                 * Get the size of the snapshot
+                 * @return size of the snapshot in bytes
+                 */
+                inline size_t   size() const        { return nSize;         }
+
+            public:
+                /**
+                 * Check that data contains the KVT snapshot
+                 * @param data snapshot data
+                 * @param size size of the snapshot data
+                 * @return true if data contains the snapshot header of supported version
+                 */
+                static bool     probe(const void *data, size_t size);
+
+                /**
+                 * Restore parameters from the snapshot to the KVT storage, the storage
+                 * should be locked by the caller. The storage is not cleared before the restore
+                 * and is not modified at all if the snapshot is corrupted.
+                 * @param kvt KVT storage
+                 * @param data snapshot data, may be not aligned
+                 * @param size size of the snapshot data
+                 * @param flags additional flags to pass to the KVT storage for each parameter
+                 * @param skip skip parameters having any of the specified flags (only KVT_PRIVATE is supported)
+                 * @return status of operation
+                 */
+                static status_t restore(KVTStorage *kvt, const void *data, size_t size, size_t flags, size_t skip = 0);
+        };
+
+    } /* namespace core */
+} /* namespace lsp */
+
+
+#endif /* LSP_PLUG_IN_PLUG_FW_CORE_KVTSNAPSHOT_H_ */
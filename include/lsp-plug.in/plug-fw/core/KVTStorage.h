@@ -54,6 +54,7 @@ namespace lsp
             KVT_PRIVATE         = 1 << 4,       // Private option (do not transfer)
             KVT_TRANSIENT       = 1 << 5,       // Transient option (do not serialize)
             KVT_STATE           = 1 << 6,       // State restore of parameter
+            KVT_BATCH           = 1 << 7,       // Notification about the change made within committed transaction
 
             // Special constants to not to be confused with KVT_RX and KVT_TX abbreviations
             KVT_TO_UI           = KVT_TX,
@@ -168,6 +169,15 @@ namespace lsp
                  * @param param parameter
                  */
                 virtual void missed(KVTStorage *storage, const char *id);
+
+                /**
+                 * The transaction has been committed. All changes made within the transaction
+                 * are delivered right before this event as single created(), changed() or removed()
+                 * event per parameter with the KVT_BATCH flag set in pending flags.
+                 * @param storage KVT storage that triggered the event
+                 * @param changes number of changed parameters
+                 */
+                virtual void transaction(KVTStorage *storage, size_t changes);
         };
 
         class KVTIterator;
@@ -203,6 +213,9 @@ namespace lsp
                 typedef struct kvt_gcparam_t : public kvt_param_t {
                     size_t              flags;
                     kvt_gcparam_t      *next;
+                    uint8_t            *data;           // Buffer that holds string or blob contents
+                    size_t              capacity;       // Capacity of the buffer
+                    bool                delegated;      // Contents are owned by the parameter itself
                 } kvt_gcparam_t;
 
                 typedef struct kvt_node_t
@@ -210,6 +223,8 @@ namespace lsp
                     char               *id;             // Unique node identifier
                     size_t              idlen;          // Length of the ID string
                     kvt_node_t         *parent;         // Parent node
+                    uint32_t            hash;           // Hash of the full path to the node
+                    kvt_node_t         *hnext;          // Next node in the hash bin
                     ssize_t             refs;           // Number of references
                     kvt_gcparam_t      *param;          // Currently used parameter
 
@@ -218,6 +233,10 @@ namespace lsp
                     kvt_link_t          rx;             // Link to the Rx modified list
                     kvt_link_t          tx;             // Link to the Tx modified list
 
+                    kvt_gcparam_t      *bparam;         // Parameter value before the transaction
+                    size_t              bpending;       // Pending flags of changes within the transaction
+                    bool                batched;        // Node has been changed within the transaction
+
                     kvt_node_t        **children;       // Children
                     size_t              nchildren;      // Number of children
                     size_t              capacity;       // Capacity in children
@@ -225,6 +244,7 @@ namespace lsp
 
             protected:
                 lltl::parray<KVTListener>   vListeners;
+                lltl::parray<kvt_node_t>    vBatch;     // Nodes changed within the transaction
 
                 kvt_link_t              sValid;
                 kvt_link_t              sTx;
@@ -232,12 +252,18 @@ namespace lsp
                 kvt_link_t              sGarbage;
                 char                    cSeparator;
                 kvt_gcparam_t          *pTrash;
+                kvt_gcparam_t          *pPool;          // Pool of parameters ready for reuse
+                kvt_node_t            **vHash;          // Hash index of nodes by their full path
+                size_t                  nHashCap;
+                size_t                  nHashSize;
+                size_t                  nPoolSize;
                 KVTIterator            *pIterators;
                 kvt_node_t              sRoot;
                 size_t                  nValues;
                 size_t                  nNodes;
                 size_t                  nTxPending;
                 size_t                  nRxPending;
+                size_t                  nTransaction;   // Transaction nesting level
 
             protected:
                 inline void             notify_created(const char *id, const kvt_param_t *param, size_t pending);
@@ -247,6 +273,8 @@ namespace lsp
                 inline void             notify_access(const char *id, const kvt_param_t *param, size_t pending);
                 inline void             notify_commit(const char *id, const kvt_param_t *param, size_t pending);
                 inline void             notify_missed(const char *id);
+                inline void             notify_transaction(size_t changes);
+                bool                    defer_change(kvt_node_t *node, kvt_gcparam_t *oval, size_t pending);
 
             protected:
                 inline static void      link_list(kvt_link_t *root, kvt_link_t *item);
@@ -259,14 +287,21 @@ namespace lsp
                 char                   *build_path(char **path, size_t *capacity, const kvt_node_t *node);
 
                 void                    destroy_parameter(kvt_gcparam_t *p);
+                void                    recycle_parameter(kvt_gcparam_t *p);
+                kvt_gcparam_t          *allocate_parameter();
                 status_t                commit_parameter(const char *path, kvt_node_t *node, const kvt_param_t *value, size_t flags);
                 kvt_gcparam_t          *copy_parameter(const kvt_param_t *src, size_t flags);
 
+                bool                    reserve_index();
+                void                    index_node(kvt_node_t *node);
+                void                    unindex_node(kvt_node_t *node);
+                bool                    match_path(const kvt_node_t *node, const char *name, size_t len) const;
+                status_t                lookup_node(kvt_node_t **out, const char *name);
+
                 inline void             init_node(kvt_node_t *node, const char *name, size_t len);
                 kvt_node_t             *allocate_node(const char *name, size_t len);
                 kvt_node_t             *create_node(kvt_node_t *base, const char *name, size_t len);
                 void                    destroy_node(kvt_node_t *node);
-                kvt_node_t             *get_node(kvt_node_t *base, const char *name, size_t len);
                 status_t                walk_node(kvt_node_t **out, const char *name);
 
                 status_t                do_remove_node(const char *name, kvt_node_t *node, const kvt_param_t **value, kvt_param_type_t type);
@@ -316,6 +351,25 @@ namespace lsp
                  */
                 status_t    unbind_all();
 
+            public:
+                /**
+                 * Begin the transaction. Until the transaction is committed, the listeners
+                 * are not notified about created, changed and removed parameters, and the
+                 * garbage collection is deferred. Transactions can be nested.
+                 * @return status of operation
+                 */
+                status_t    begin_transaction();
+
+                /**
+                 * Commit the transaction. When the outermost transaction is committed, the
+                 * listeners receive one notification for each changed parameter which reflects
+                 * the overall change of the parameter, followed by the transaction() event.
+                 * @return status of operation
+                 */
+                status_t    commit_transaction();
+
+                inline bool in_transaction() const  { return nTransaction > 0; }
+
             public:
                 inline  size_t nodes() const        { return nNodes;        }
                 inline  size_t values() const       { return nValues;       }
@@ -425,7 +479,7 @@ namespace lsp
 
                 /**
                  * Perform garbage collection. Any of previously returned pointers to strings and
-                 * blobs can become invalid
+                 * blobs can become invalid. Does nothing while the transaction is active.
                  * @return status of operation
                  */
                 status_t    gc();
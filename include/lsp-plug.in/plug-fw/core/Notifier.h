@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_PLUG_FW_CORE_NOTIFIER_H_
+#define LSP_PLUG_IN_PLUG_FW_CORE_NOTIFIER_H_
+
+#include <lsp-plug.in/plug-fw/version.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/common/types.h>
+
+#if !defined(PLATFORM_WINDOWS) && !defined(PLATFORM_LINUX) && !defined(PLATFORM_MACOSX)
+    #include <semaphore.h>
+#endif /* PLATFORM_WINDOWS, PLATFORM_LINUX, PLATFORM_MACOSX */
+
+namespace lsp
+{
+    namespace core
+    {
+        /**
+         * Binary event that allows one thread to sleep until another thread notifies it.
+         * Any number of threads may call notify(), only one thread is allowed to wait.
+         * Multiple notifications issued while the waiting thread is busy are collapsed
+         * into a single one. The notify() call never blocks on locks and performs a
+         * system call only when there is a thread waiting for the notification, so
+         * it is safe to call it from the real-time thread.
+         */
+        class Notifier
+        {
+            private:
+            #if defined(PLATFORM_WINDOWS)
+                void               *hEvent;         // Auto-reset event handle
+            #elif defined(PLATFORM_LINUX)
+                atomic_t            nState;         // Futex word
+            #elif defined(PLATFORM_MACOSX)
+                atomic_t            nState;         // Notification state
+                void               *hSemaphore;     // Dispatch semaphore to sleep on
+            #else
+                atomic_t            nState;         // Notification state
+                sem_t               sSemaphore;     // Semaphore to sleep on
+                bool                bValid;         // Semaphore has been initialized
+            #endif /* PLATFORM_WINDOWS, PLATFORM_LINUX, PLATFORM_MACOSX */
+
+            public:
+                Notifier();
+                Notifier(const Notifier &) = delete;
+                Notifier(Notifier &&) = delete;
+                ~Notifier();
+
+                Notifier & operator = (const Notifier &) = delete;
+                Notifier & operator = (Notifier &&) = delete;
+
+            public:
+                /**
+                 * Notify the waiting thread, can be called from any thread
+                 */
+                void                notify();
+
+                /**
+                 * Wait for the notification, the notification state is reset after the call
+                 * @param millis maximum time to wait in milliseconds
+                 * @return true if the notification has been received, false on timeout or spurious wakeup
+                 */
+                bool                wait(size_t millis);
+        };
+
+    } /* namespace core */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_PLUG_FW_CORE_NOTIFIER_H_ */
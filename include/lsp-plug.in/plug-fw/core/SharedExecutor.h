@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LSP_PLUG_IN_PLUG_FW_CORE_SHAREDEXECUTOR_H_
+#define LSP_PLUG_IN_PLUG_FW_CORE_SHAREDEXECUTOR_H_
+
+#include <lsp-plug.in/plug-fw/version.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/ipc/IExecutor.h>
+#include <lsp-plug.in/plug-fw/core/ExecutorPool.h>
+
+namespace lsp
+{
+    namespace core
+    {
+        /**
+         * Executor of a single plugin instance. Submits tasks to the process-wide
+         * executor pool and keeps track of the own tasks, so the shutdown waits
+         * only for tasks that were submitted by this executor. The executor becomes
+         * the owner of the submitted task and receives the completion notification,
+         * so it should be passed to the plugin as is and never be wrapped by another
+         * executor. Wrappers that need own task tracking should wrap ExecutorPool.
+         */
+        class SharedExecutor: public ipc::IExecutor
+        {
+            private:
+                ExecutorPool       *pPool;
+                atomic_t            nActiveTasks;
+
+            public:
+                explicit SharedExecutor();
+                SharedExecutor(const SharedExecutor &) = delete;
+                SharedExecutor(SharedExecutor &&) = delete;
+                virtual ~SharedExecutor() override;
+
+                SharedExecutor & operator = (const SharedExecutor &) = delete;
+                SharedExecutor & operator = (SharedExecutor &&) = delete;
+
+            protected:
+                virtual void        task_finished(ipc::ITask *task) override;
+
+            public:
+                /**
+                 * Initialize executor: acquire the process-wide executor pool
+                 * @return status of operation
+                 */
+                status_t            init();
+
+                /**
+                 * Get number of tasks submitted by this executor and not yet finished
+                 * @return number of active tasks
+                 */
+                inline size_t       active_tasks() const    { return atomic_load(&nActiveTasks); }
+
+            public:
+                virtual bool        submit(ipc::ITask *task) override;
+                virtual void        shutdown() override;
+        };
+
+    } /* namespace core */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_PLUG_FW_CORE_SHAREDEXECUTOR_H_ */
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_PLUG_FW_CORE_SILENCEDETECTOR_H_
+#define LSP_PLUG_IN_PLUG_FW_CORE_SILENCEDETECTOR_H_
+
+#include <lsp-plug.in/plug-fw/version.h>
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/lltl/parray.h>
+#include <lsp-plug.in/plug-fw/plug.h>
+
+namespace lsp
+{
+    namespace core
+    {
+        /**
+         * Silence detector, allows the wrapper to suspend the plugin processing when all audio
+         * inputs contain digital silence for a period longer than the plugin's latency,
+         * post-processing tail and additional hold time. Suspension is enabled only for plugins
+         * that specify the meta::E_SILENCE_SUSPEND flag in their metadata and thus guarantee that
+         * their tail size is actual. The plugin is not suspended if it has infinite tail, has no
+         * audio inputs or receives MIDI, OSC or shared memory audio data.
+         */
+        class SilenceDetector
+        {
+            public:
+                static constexpr float      THRESHOLD       = 1e-8f;    // Maximum absolute sample value treated as silence
+                static constexpr float      HOLD_TIME       = 0.5f;     // Additional time in seconds to wait before suspend
+
+            private:
+                plug::Module               *pPlugin;        // Plugin module
+                lltl::parray<plug::IPort>   vInputs;        // Audio inputs
+                lltl::parray<plug::IPort>   vOutputs;       // Audio outputs
+                lltl::parray<plug::IPort>   vSends;         // Shared memory audio sends
+                lltl::parray<plug::IPort>   vMeters;        // Output meters
+                wsize_t                     nSilence;       // Number of silent samples since the last non-silent input
+                bool                        bEnabled;       // Suspend is enabled
+                bool                        bSuspended;     // Plugin is currently suspended
+
+            public:
+                SilenceDetector();
+                SilenceDetector(const SilenceDetector &) = delete;
+                SilenceDetector(SilenceDetector &&) = delete;
+                ~SilenceDetector();
+
+                SilenceDetector & operator = (const SilenceDetector &) = delete;
+                SilenceDetector & operator = (SilenceDetector &&) = delete;
+
+                /**
+                 * Initialize silence detector
+                 * @param plugin plugin module
+                 * @param ports list of plugin ports
+                 * @param count number of plugin ports
+                 */
+                void                init(plug::Module *plugin, plug::IPort **ports, size_t count);
+
+                /**
+                 * Destroy silence detector
+                 */
+                void                destroy();
+
+            public:
+                /**
+                 * Check that suspend is enabled for the plugin
+                 * @return true if suspend is enabled
+                 */
+                inline bool         enabled() const         { return bEnabled;      }
+
+                /**
+                 * Check that the plugin is currently suspended
+                 * @return true if the plugin is currently suspended
+                 */
+                inline bool         suspended() const       { return bSuspended;    }
+
+                /**
+                 * Reset the state of the detector, should be called on plugin (re)activation
+                 */
+                void                reset();
+
+                /**
+                 * Scan audio inputs of the plugin and decide whether the processing of the
+                 * current block can be skipped. Should be called each time before the
+                 * processing call with input buffers already bound to ports.
+                 *
+                 * @param samples number of samples in the block
+                 * @return true if the processing of the block can be skipped
+                 */
+                bool                idle(size_t samples);
+
+                /**
+                 * Emit silence instead of calling the processing routine: clear audio outputs
+                 * and sends, reset meters to their default values
+                 *
+                 * @param samples number of samples in the block
+                 */
+                void                silence(size_t samples);
+        };
+
+    } /* namespace core */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_PLUG_FW_CORE_SILENCEDETECTOR_H_ */
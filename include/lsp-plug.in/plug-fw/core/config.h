@@ -24,6 +24,7 @@
 
 #include <lsp-plug.in/plug-fw/version.h>
 #include <lsp-plug.in/plug-fw/meta/types.h>
+#include <lsp-plug.in/plug-fw/core/KVTStorage.h>
 #include <lsp-plug.in/runtime/LSPString.h>
 #include <lsp-plug.in/io/Path.h>
 #include <lsp-plug.in/fmt/config/Serializer.h>
@@ -64,6 +65,27 @@ namespace lsp
          * @return true if the relative path has been extracted
          */
         bool parse_relative_path(io::Path *path, const io::Path *base, const char *value, size_t len);
+
+        /**
+         * Deserialize value of the control port, decibel values are converted to gain
+         * for the ports that have gain units
+         *
+         * @param meta port metadata
+         * @param param configuration parameter
+         * @return deserialized value
+         */
+        float deserialize_control_value(const meta::port_t *meta, const config::param_t *param);
+
+        /**
+         * Deserialize KVT parameter and store it to the KVT storage, the name of the
+         * configuration parameter is used as the KVT parameter identifier
+         *
+         * @param kvt KVT storage
+         * @param param configuration parameter
+         * @param flags flags passed to the KVTStorage::put() call
+         * @return status of operation or STATUS_BAD_TYPE if parameter can not be deserialized
+         */
+        status_t deserialize_kvt_param(KVTStorage *kvt, const config::param_t *param, size_t flags);
     }
 }
 
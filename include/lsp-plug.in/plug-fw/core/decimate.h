@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_PLUG_FW_CORE_DECIMATE_H_
+#define LSP_PLUG_IN_PLUG_FW_CORE_DECIMATE_H_
+
+#include <lsp-plug.in/plug-fw/version.h>
+#include <lsp-plug.in/common/types.h>
+
+namespace lsp
+{
+    namespace core
+    {
+        /**
+         * Compute the number of mesh items after the decimation to the display width. Each pixel
+         * of the display width produces two items, so the mesh is decimated only if it contains
+         * more than twice as many items as the display width.
+         *
+         * @param items number of items in the mesh
+         * @param width display width, zero means no decimation
+         * @return number of items after decimation
+         */
+        size_t decimated_size(size_t items, size_t width);
+
+        /**
+         * Decimate the argument buffer of the mesh: the first and the last value of each segment
+         * are kept. The operation can be performed in-place.
+         *
+         * @param dst destination buffer of decimated_size() elements
+         * @param src source buffer
+         * @param items number of items in the source buffer
+         * @param width display width, zero means no decimation
+         * @return number of items in the destination buffer
+         */
+        size_t decimate_argument(float *dst, const float *src, size_t items, size_t width);
+
+        /**
+         * Decimate the value buffer of the mesh preserving the envelope: the minimum and the maximum
+         * of each segment are kept in their original order. The operation can be performed in-place.
+         *
+         * @param dst destination buffer of decimated_size() elements
+         * @param src source buffer
+         * @param items number of items in the source buffer
+         * @param width display width, zero means no decimation
+         * @return number of items in the destination buffer
+         */
+        size_t decimate_envelope(float *dst, const float *src, size_t items, size_t width);
+
+        /**
+         * Decimate all buffers of the mesh, the first buffer is considered to be the argument,
+         * all other buffers are considered to be values. The operation can be performed in-place.
+         *
+         * @param dst destination buffers
+         * @param src source buffers
+         * @param buffers number of buffers
+         * @param items number of items in each source buffer
+         * @param width display width, zero means no decimation
+         * @return number of items in each destination buffer
+         */
+        size_t decimate_mesh(float * const *dst, const float * const *src, size_t buffers, size_t items, size_t width);
+
+        /**
+         * Copy all buffers of the mesh replacing non-finite values, decimate the mesh if the display
+         * width is specified. The operation can not be performed in-place.
+         *
+         * @param dst destination buffers
+         * @param src source buffers
+         * @param buffers number of buffers
+         * @param items number of items in each source buffer
+         * @param width display width, zero means no decimation
+         * @return number of items in each destination buffer
+         */
+        size_t decimate_mesh_saturated(float * const *dst, const float * const *src, size_t buffers, size_t items, size_t width);
+
+    } /* namespace core */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_PLUG_FW_CORE_DECIMATE_H_ */
@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LSP_PLUG_IN_PLUG_FW_CORE_DELTA_H_
+#define LSP_PLUG_IN_PLUG_FW_CORE_DELTA_H_
+
+#include <lsp-plug.in/plug-fw/version.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/common/types.h>
+
+namespace lsp
+{
+    namespace core
+    {
+        /**
+         * Flags of the delta packet
+         */
+        enum delta_flags_t
+        {
+            DELTA_KEY       = 1 << 0,       // Key packet, contains all items of all buffers
+            DELTA_HALF      = 1 << 1        // Values are stored as 16-bit floating-point numbers
+        };
+
+        /**
+         * Convert floating-point values to 16-bit floating-point values stored in little-endian
+         * byte order. The values are rounded to the nearest even.
+         *
+         * @param dst destination buffer
+         * @param src source buffer
+         * @param count number of values
+         */
+        void encode_half(uint16_t *dst, const float *src, size_t count);
+
+        /**
+         * Convert 16-bit floating-point values stored in little-endian byte order to
+         * floating-point values.
+         *
+         * @param dst destination buffer
+         * @param src source buffer
+         * @param count number of values
+         */
+        void decode_half(float *dst, const uint16_t *src, size_t count);
+
+        /**
+         * Delta encoder for the mesh data. Keeps the copy of the data known by the receiver
+         * and emits only ranges of items that have changed since the previous packet. The key
+         * packet containing all items is emitted after reset(), on change of the mesh size,
+         * periodically to recover the receiver after lost packets and each time when the delta
+         * packet would not be smaller than the key packet.
+         *
+         * All fields of the packet are stored in little-endian byte order:
+         *   - header: flags, serial number, number of buffers, number of items;
+         *   - for each buffer: number of ranges, for each range: offset, number of items, values.
+         * Values of each range are padded to 32-bit boundary.
+         */
+        class DeltaEncoder
+        {
+            public:
+                static constexpr size_t KEY_INTERVAL        = 64;   // Maximum number of delta packets between key packets
+
+            private:
+                float          *vRef;           // Data known by the receiver
+                uint8_t        *vPacket;        // Encoded packet
+                size_t          nMaxBuffers;    // Maximum number of buffers
+                size_t          nMaxItems;      // Maximum number of items per buffer
+                size_t          nCapacity;      // Capacity of the packet
+                size_t          nBuffers;       // Number of buffers known by the receiver
+                size_t          nItems;         // Number of items known by the receiver
+                uint32_t        nSerial;        // Serial number of the packet
+                size_t          nFrames;        // Number of delta packets since the last key packet
+                bool            bHalf;          // Use 16-bit floating-point values
+                bool            bKey;           // Force key packet
+
+            protected:
+                size_t          encode_key(const float * const *src, size_t buffers, size_t items);
+                size_t          encode_delta(const float * const *src, size_t buffers, size_t items);
+
+            public:
+                DeltaEncoder();
+                DeltaEncoder(const DeltaEncoder &) = delete;
+                DeltaEncoder(DeltaEncoder &&) = delete;
+                ~DeltaEncoder();
+
+                DeltaEncoder & operator = (const DeltaEncoder &) = delete;
+                DeltaEncoder & operator = (DeltaEncoder &&) = delete;
+
+            public:
+                /**
+                 * Initialize encoder
+                 * @param buffers maximum number of buffers
+                 * @param items maximum number of items per buffer
+                 * @param half store values as 16-bit floating-point numbers
+                 * @return status of operation
+                 */
+                status_t        init(size_t buffers, size_t items, bool half);
+
+                /**
+                 * Destroy encoder
+                 */
+                void            destroy();
+
+                /**
+                 * Force the next packet to be the key packet, should be called when the receiver
+                 * has lost it's state
+                 */
+                inline void     reset()             { bKey = true;          }
+
+                /**
+                 * Get the encoded packet
+                 * @return pointer to the packet produced by the last call of encode()
+                 */
+                inline const void *data() const     { return vPacket;       }
+
+                /**
+                 * Encode the mesh data
+                 * @param src source buffers
+                 * @param buffers number of buffers
+                 * @param items number of items in each buffer
+                 * @return size of the packet in bytes or zero on error
+                 */
+                size_t          encode(const float * const *src, size_t buffers, size_t items);
+        };
+
+        /**
+         * Delta decoder for the mesh data. Applies packets produced by DeltaEncoder to the
+         * destination buffers which should retain the data between calls. Delta packets are
+         * ignored after the lost packet until the next key packet arrives.
+         */
+        class DeltaDecoder
+        {
+            private:
+                uint32_t        nSerial;        // Serial number of the last packet
+                size_t          nBuffers;       // Number of buffers in the destination
+                size_t          nItems;         // Number of items in the destination
+                bool            bValid;         // Destination contains valid data
+
+            public:
+                DeltaDecoder();
+                DeltaDecoder(const DeltaDecoder &) = delete;
+                DeltaDecoder(DeltaDecoder &&) = delete;
+                ~DeltaDecoder();
+
+                DeltaDecoder & operator = (const DeltaDecoder &) = delete;
+                DeltaDecoder & operator = (DeltaDecoder &&) = delete;
+
+            public:
+                /**
+                 * Reset the state of the decoder, all delta packets will be ignored until
+                 * the next key packet arrives
+                 */
+                inline void     reset()             { bValid = false;       }
+
+                /**
+                 * Apply packet to the destination buffers, non-finite values are replaced
+                 *
+                 * @param dst destination buffers
+                 * @param buffers pointer to store the number of buffers
+                 * @param items pointer to store the number of items in each buffer
+                 * @param max_buffers maximum number of destination buffers
+                 * @param max_items maximum number of items in each destination buffer
+                 * @param data packet data
+                 * @param size size of the packet in bytes
+                 * @return true if destination buffers contain valid data after the call
+                 */
+                bool            decode(
+                    float * const *dst, size_t *buffers, size_t *items,
+                    size_t max_buffers, size_t max_items,
+                    const void *data, size_t size);
+        };
+
+    } /* namespace core */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_PLUG_FW_CORE_DELTA_H_ */
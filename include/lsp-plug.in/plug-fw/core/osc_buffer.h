@@ -36,7 +36,12 @@ namespace lsp
          * Buffer to transfer OSC packets between two threads.
          * It is safe to use if one thread is reading data and one thread is
          * submitting data. Otherwise, additional synchronization mechanism
-         * should be used
+         * should be used.
+         *
+         * Each packet is stored as a contiguous region of memory prefixed by it's size,
+         * if the packet does not fit into the end of the buffer, the rest of the buffer
+         * is padded and the packet is stored at the beginning of the buffer. This allows
+         * to forge packets directly in the buffer and to parse them without copying.
          */
         typedef struct osc_buffer_t
         {
@@ -44,6 +49,8 @@ namespace lsp
             size_t              nCapacity;
             size_t              nHead;
             size_t              nTail;
+            size_t              nReserved;      // Size of the space reserved for the packet
+            size_t              nPadding;       // Padding to apply before the reserved packet
             uint8_t            *pBuffer;
             uint8_t            *pTempBuf;
             size_t              nTempSize;
@@ -78,6 +85,21 @@ namespace lsp
              */
             status_t    reserve(size_t size);
 
+            /**
+             * Reserve contiguous space for the packet directly in the buffer. The packet should be
+             * formed in the returned memory region and then committed by the commit_packet() call.
+             * @param size maximum size of the packet, should be multiple of 4
+             * @return pointer to the reserved space or NULL if there is not enough contiguous space
+             */
+            void       *reserve_packet(size_t size);
+
+            /**
+             * Commit the packet formed in the space previously reserved by reserve_packet()
+             * @param size actual size of the packet, should be multiple of 4 and not greater than reserved
+             * @return status of operation
+             */
+            status_t    commit_packet(size_t size);
+
             /**
              * Submit OSC packet to the queue
              * @param data packet data
@@ -147,6 +169,19 @@ namespace lsp
              */
             status_t    fetch(osc::packet_t *packet, size_t limit);
 
+            /**
+             * Get the current packet without copying and without removing it from the buffer,
+             * the data of the packet remains valid until the release() or skip() call
+             * @param packet pointer to packet structure to store the pointer to the data and size
+             * @return status of operation
+             */
+            status_t    peek(osc::packet_t *packet);
+
+            /**
+             * Release the packet obtained by the peek() call
+             */
+            inline void release() { skip(); }
+
             /**
              * Skip current message in the buffer
              * @return number of bytes skipped
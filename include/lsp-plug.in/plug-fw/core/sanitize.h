@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LSP_PLUG_IN_PLUG_FW_CORE_SANITIZE_H_
+#define LSP_PLUG_IN_PLUG_FW_CORE_SANITIZE_H_
+
+#include <lsp-plug.in/plug-fw/version.h>
+#include <lsp-plug.in/common/types.h>
+
+namespace lsp
+{
+    namespace core
+    {
+        /**
+         * Check that the buffer contains samples that should be sanitized: NaNs, infinities
+         * or denormal values. The check is much cheaper than the sanitizing copy of the buffer,
+         * so the host buffer can be passed to the plugin as is when the check fails.
+         *
+         * @param src buffer to check
+         * @param count number of samples in the buffer
+         * @return true if the buffer contains at least one sample that should be sanitized
+         */
+        bool need_sanitize(const float *src, size_t count);
+
+    } /* namespace core */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_PLUG_FW_CORE_SANITIZE_H_ */
@@ -61,6 +61,7 @@ namespace lsp
 
                 bool                bStream;
                 bool                bStrobe;
+                bool                bDecimate;
                 ssize_t             nXIndex;
                 ssize_t             nYIndex;
                 ssize_t             nSIndex;
@@ -69,7 +70,9 @@ namespace lsp
             protected:
                 void                trigger_expr();
                 void                commit_data();
+                void                request_display_width();
                 static ssize_t      get_strobe_block_size(const float *s, size_t size);
+                static status_t     slot_graph_resize(tk::Widget *sender, void *ptr, void *data);
 
             public:
                 explicit Mesh(ui::IWrapper *wrapper, tk::GraphMesh *widget, bool stream);
@@ -46,10 +46,16 @@
     { id, label, NULL, U_NONE, R_METER, 0, F_INT | F_UPPER | F_LOWER, 0, STATUS_MAX, STATUS_UNSPECIFIED, 0, NULL, NULL, NULL }
 #define MESH(id, label, dim, points) \
     { id, label, NULL, U_NONE, R_MESH, 0, 0, 0.0, 0.0, points, dim, NULL, NULL, NULL }
+#define DELTA_MESH(id, label, dim, points) \
+    { id, label, NULL, U_NONE, R_MESH, 0, F_DELTA, 0.0, 0.0, points, dim, NULL, NULL, NULL }
+#define DISPLAY_MESH(id, label, dim, points) \
+    { id, label, NULL, U_NONE, R_MESH, 0, F_DELTA | F_HALF, 0.0, 0.0, points, dim, NULL, NULL, NULL }
 #define STREAM(id, label, dim, frames, capacity) \
     { id, label, NULL, U_NONE, R_STREAM, 0, 0, dim, frames, capacity, 0.0f, NULL, NULL, NULL }
 #define FBUFFER(id, label, rows, cols) \
     { id, label, NULL, U_NONE, R_FBUFFER, 0, 0, 0.0, 0.0, rows, cols, NULL, NULL, NULL }
+#define DISPLAY_FBUFFER(id, label, rows, cols) \
+    { id, label, NULL, U_NONE, R_FBUFFER, 0, F_HALF, 0.0, 0.0, rows, cols, NULL, NULL, NULL }
 #define PATH(id, label) \
     { id, label, NULL, U_STRING, R_PATH, 0, 0, 0, 0, 0, 0, NULL, NULL, NULL }
 
@@ -147,6 +147,8 @@ namespace lsp
             F_PEAK          = (1 << 9),     // Peak flag
             F_CYCLIC        = (1 << 10),    // Cyclic flag
             F_EXT           = (1 << 11),    // Extended range
+            F_DELTA         = (1 << 12),    // Transmit only changed data of the mesh to the UI
+            F_HALF          = (1 << 13),    // Display-only data, can be transmitted to the UI with 16-bit precision
         };
 
         enum plugin_class_t
@@ -284,6 +286,7 @@ namespace lsp
             E_DUMP_STATE            = 1 << 4,   // Support of internal state dump
             E_FILE_PREVIEW          = 1 << 5,   // Support of file listen preview
             E_SHM_TRACKING          = 1 << 6,   // Support of shared memory segments enumeration and tracking
+            E_SILENCE_SUSPEND       = 1 << 7,   // Processing can be suspended when audio inputs are silent longer than latency and tail
         };
 
         enum port_group_type_t
@@ -28,6 +28,7 @@
 
 #include <lsp-plug.in/plug-fw/version.h>
 #include <lsp-plug.in/plug-fw/plug/data.h>
+#include <lsp-plug.in/plug-fw/core/DspProfiler.h>
 #include <lsp-plug.in/plug-fw/core/KVTStorage.h>
 #include <lsp-plug.in/plug-fw/core/ShmState.h>
 #include <lsp-plug.in/ipc/IExecutor.h>
@@ -50,10 +51,28 @@ namespace lsp
                 resource::ILoader          *pLoader;
                 plug::ICanvas              *pCanvas;            // Inline display featured canvas
                 plug::position_t            sPosition;          // Actual time position
+                core::DspProfiler          *pProfiler;          // DSP profiler, NULL if profiling is disabled
 
             protected:
                 plug::ICanvas              *create_canvas(size_t width, size_t height);
 
+                /**
+                 * Start the DSP profiler measurement
+                 * @return timestamp of the measurement start
+                 */
+                inline uint64_t             profile_begin()
+                {
+                    return (pProfiler != NULL) ? core::DspProfiler::timestamp() : 0;
+                }
+
+                /**
+                 * Complete the DSP profiler measurement
+                 * @param probe probe identifier
+                 * @param start timestamp returned by profile_begin()
+                 * @param samples number of samples in the processed block
+                 */
+                void                        profile_end(core::dsp_probe_t probe, uint64_t start, size_t samples);
+
             public:
                 explicit IWrapper(Module *plugin, resource::ILoader *loader);
                 IWrapper(const IWrapper &) = delete;
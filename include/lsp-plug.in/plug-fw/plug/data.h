@@ -104,6 +104,27 @@ namespace lsp
             }
         } mesh_t;
 
+        /**
+         * Read-only view of the data stored in the ring buffer. Because of the ring buffer
+         * the data can be split into two contiguous parts: the head and the tail. The view
+         * remains valid until the owner of the buffer overwrites the data.
+         */
+        typedef struct data_view_t
+        {
+            const float            *head;       // The first contiguous part of data
+            size_t                  head_size;  // Number of elements in the first part
+            const float            *tail;       // The second contiguous part of data or NULL
+            size_t                  tail_size;  // Number of elements in the second part
+
+            inline size_t size() const          { return head_size + tail_size;             }
+
+            /**
+             * Copy data of the view to the buffer
+             * @param dst destination buffer of at least size() elements
+             */
+            void copy_to(float *dst) const;
+        } data_view_t;
+
         /**
          * Streaming mesh. The data structure consists from a long single buffer splitted into
          * channels. The mesh is incrementally appended with special markers - frames. Each frame
@@ -236,6 +257,17 @@ namespace lsp
                  */
                 ssize_t                 read_frame(uint32_t frame_id, size_t channel, float *data, size_t off, size_t count);
 
+                /**
+                 * Get the view of the frame data without copying
+                 * @param frame frame identifier
+                 * @param channel channel number
+                 * @param view view to store the result
+                 * @param off offset from the beginning of the frame
+                 * @param count number of elements to view
+                 * @return number of elements in the view or negative error code
+                 */
+                ssize_t                 view_frame(uint32_t frame_id, size_t channel, data_view_t *view, size_t off, size_t count) const;
+
                 /**
                  * Read the whole stream according to the information stored inside of the last frame
                  * @param channel channel number
@@ -246,6 +278,17 @@ namespace lsp
                  */
                 ssize_t                 read(size_t channel, float *data, size_t off, size_t count);
 
+                /**
+                 * Get the view of the whole stream according to the information stored inside of the last
+                 * frame without copying
+                 * @param channel channel number
+                 * @param view view to store the result
+                 * @param off offset relative to the beginning of the whole frame
+                 * @param count number of elements to view
+                 * @return number of elements in the view or negative error code
+                 */
+                ssize_t                 view(size_t channel, data_view_t *view, size_t off, size_t count) const;
+
                 /**
                  * Commit the new frame to the list of frames
                  * @return true if frame has been committed
@@ -317,6 +360,16 @@ namespace lsp
                  */
                 float *next_row() const;
 
+                /**
+                 * Get the view of the contiguous range of rows without copying. The range can be split
+                 * into two parts because of the ring buffer, sizes of parts are measured in elements.
+                 * @param view view to store the result
+                 * @param row_id identifier of the first row
+                 * @param count number of rows
+                 * @return number of rows in the view
+                 */
+                size_t view_rows(data_view_t *view, uint32_t row_id, size_t count) const;
+
                 /**
                  * Return actual number of rows
                  * @return actual number of rows
@@ -356,6 +409,14 @@ namespace lsp
                  */
                 void write_row(uint32_t row_id, const float *row);
 
+                /** Overwrite the contiguous range of rows of frame buffer, contiguous parts of
+                 * the ring buffer are written at once
+                 * @param row_id identifier of the first row
+                 * @param rows data contents of all rows
+                 * @param count number of rows
+                 */
+                void write_rows(uint32_t row_id, const float *rows, size_t count);
+
                 /**
                  * Just increment row counter to commit row data
                  */
@@ -396,6 +457,65 @@ namespace lsp
              */
             inline bool push(const midi::event_t &me) { return push(&me); }
 
+            /**
+             * Insert event to the sorted queue keeping the chronological order of events. Event is
+             * placed after all events with the same timestamp. Appending events in chronological
+             * order does not require any movement of the stored events.
+             * @param me pointer to event to insert
+             * @return true if event was inserted
+             */
+            bool insert(const midi::event_t *me);
+
+            /**
+             * Insert event to the sorted queue keeping the chronological order of events
+             * @param me event to insert
+             * @return true if event was inserted
+             */
+            inline bool insert(const midi::event_t &me) { return insert(&me); }
+
+            /**
+             * Find the index of the first event which has timestamp not less than specified
+             * @note For proper work of this function the queue should be sorted.
+             *
+             * @param timestamp the timestamp to search
+             * @return index of the event or number of events if there is no such event
+             */
+            size_t lower_bound(uint32_t timestamp) const;
+
+            /**
+             * Select events from the sorted source queue starting with the specified index while their
+             * timestamps are less than end and put to this queue, subtract timestamp value by start from
+             * original events. Allows to split the source queue into subsequent blocks without searching
+             * for the start of each block.
+             *
+             * @param src source queue to select data
+             * @param first index of the first event in the source queue to process
+             * @param start the start of the timestamp range, should not be greater than timestamp of the first event
+             * @param end the end of the timestamp range
+             * @return index of the first event in the source queue which has not been processed
+             */
+            size_t push_split(const midi_t *src, size_t first, uint32_t start, uint32_t end);
+
+            /**
+             * Merge all events from the sorted source queue into this sorted queue in one linear pass,
+             * events of the source queue are placed after events of this queue with the same timestamp.
+             * If the queue overflows, the latest events are dropped.
+             *
+             * @param src source queue
+             * @return true if all events have been added
+             */
+            bool merge(const midi_t *src);
+
+            /**
+             * Merge all events from the sorted source queue into this sorted queue in one linear pass
+             * and add the specified offset to their timestamps.
+             *
+             * @param src source queue
+             * @param offset the offset to add to the timestamp of each event
+             * @return true if all events have been added
+             */
+            bool merge_shifted(const midi_t *src, uint32_t offset);
+
             /**
              * Select all events from the source queue that match specified timestamp range [start, end) and put to this queue,
              * subtract timestamp value by start from original events.
@@ -431,7 +551,7 @@ namespace lsp
             bool push_all_shifted(const midi_t *src, uint32_t offset);
 
             /**
-             * Copy the contents of the queue
+             * Copy the contents of the queue, only live events are copied
              * @param src the contents of the queue to copy
              */
             inline void copy_from(const midi_t *src)
@@ -459,12 +579,26 @@ namespace lsp
             }
 
             /**
-             * Perform sort of events stored in the queue according to their timestamps
+             * Check that events stored in the queue are ordered chronologically
+             * @return true if events are ordered chronologically
+             */
+            bool is_sorted() const;
+
+            /**
+             * Perform sort of events stored in the queue according to their timestamps.
+             * Does not modify the queue if it is already sorted.
              */
             void sort();
         } midi_t;
 
-        // Path port structure
+        /**
+         * Path port structure. Unlike the string port, the path is a request which should remain
+         * unchanged between accept() and commit() while the plugin loads the file, so it is not
+         * passed by the triple buffer. Wrappers keep a single-slot request protected by a lock:
+         * the real-time thread only tries to acquire the lock when fetching the request and postpones
+         * it to the next block if the lock is busy, then copies at most PATH_MAX bytes once per request.
+         * Writers may wait for the lock, the real-time thread never does.
+         */
         typedef struct path_t
         {
             /**
@@ -520,18 +654,36 @@ namespace lsp
             virtual void commit();
         } path_t;
 
+        /**
+         * String port structure. The value is passed from writers to the real-time thread by
+         * the triple buffer: writers fill the back buffer and exchange it with the middle one,
+         * the real-time thread exchanges the front buffer with the middle one on sync() if it
+         * contains a new value. The real-time thread never waits and the value is never copied
+         * between buffers. Readers copy the front buffer and validate the copy by the version number.
+         */
         typedef struct string_t
         {
-            char               *sData;              // Actual value available to host
-            char               *sPending;           // Pending value
+            enum buffer_flags_t
+            {
+                SB_INDEX            = 0x03,             // Mask for the index of the buffer
+                SB_PENDING          = 0x04              // Middle buffer contains new value
+            };
+
+            char               *sData;              // Actual value available to host (front buffer)
+            char               *vBuffers[3];        // Storage of the triple buffer
+            uint32_t            vSerials[3];        // Serial versions associated with buffers
+            uint32_t            nFront;             // Index of the front buffer (real-time thread)
+            uint32_t            nBack;              // Index of the back buffer (writers)
+            uint32_t            nMiddle;            // Index of the middle buffer + SB_PENDING flag
             uint32_t            nCapacity;          // Capacity
-            uint32_t            nLock;              // Write lock + flags
+            uint32_t            nLock;              // Lock between concurrent writers, never taken by real-time thread
             uint32_t            nSerial;            // Current serial version
-            uint32_t            nRequest;           // Requested version
+            uint32_t            nRequest;           // Last allocated serial version
+            uint32_t            nVersion;           // Version of the front buffer, odd while it is being exchanged
 
             /**
              * Submit string contents. If string length is larger than allowed capacity, it is truncated.
-             * This method introduces atomic locks and should never be called from real-time thread.
+             * This method serializes concurrent writers and should never be called from real-time thread.
              * @param str UTF-8 string to submit
              * @param state indicates that value has been restored from state
              * @return serial number associated with this change
@@ -540,7 +692,7 @@ namespace lsp
 
             /**
              * Submit string contents. If string length is larger than allowed capacity, it is truncated.
-             * This method introduces atomic locks and should never be called from real-time thread.
+             * This method serializes concurrent writers and should never be called from real-time thread.
              * @param buffer UTF-8 string to submit
              * @param size size of data in bytes
              * @param state indicates that value has been restored from state
@@ -550,7 +702,7 @@ namespace lsp
 
             /**
              * Submit string contents. If string length is larger than allowed capacity, it is truncated.
-             * This method introduces atomic locks and should never be called from real-time thread.
+             * This method serializes concurrent writers and should never be called from real-time thread.
              * @param str string to submit
              * @param state indicates that value has been restored from state
              * @return serial number associated with this change
@@ -559,7 +711,8 @@ namespace lsp
 
             /**
              * Set string contents. If string length is larger than allowed capacity, it is truncated.
-             * This method does the same to submit() but without locking.
+             * This method does the same to submit() but without locking, so it should be called
+             * only when there are no concurrent writers.
              * @param str UTF-8 string to submit
              * @param state indicates that value has been restored from state
              * @return serial number associated with this change
@@ -568,7 +721,8 @@ namespace lsp
 
             /**
              * Set string contents. If string length is larger than allowed capacity, it is truncated.
-             * This method does the same to submit() but without locking.
+             * This method does the same to submit() but without locking, so it should be called
+             * only when there are no concurrent writers.
              * @param buffer UTF-8 string to submit
              * @param size size of data in bytes
              * @param state indicates that value has been restored from state
@@ -579,7 +733,7 @@ namespace lsp
             /**
              * Read current contents of the string to passed buffer if serial value differs to the passed one,
              * store new serial value into the passed pointer.
-             * This method introduces atomic locks and should never be called from real-time thread.
+             * This method does not take locks but may retry the copy and should never be called from real-time thread.
              * @param serial pointer to the strings's serial number the requestor holds
              * @param dst destination buffer to store the string
              * @param size size of destination buffer in bytes
@@ -588,9 +742,26 @@ namespace lsp
              */
             bool                fetch(uint32_t *serial, char *dst, size_t size);
 
+            /**
+             * Read consistent copy of current contents of the string to passed buffer.
+             * This method does not take locks but may retry the copy and should never be called from real-time thread.
+             * @param dst destination buffer to store the string
+             * @param size size of destination buffer in bytes
+             * @return serial number of the copied value
+             */
+            uint32_t            read(char *dst, size_t size) const;
+
+            /**
+             * Make consistent copy of current contents of the string, can be used for saving state.
+             * This method does not take locks but may retry the copy and should never be called from real-time thread.
+             * @return pointer to the copy of the string that should be freed by caller with free() or NULL if no memory
+             */
+            char               *snapshot() const;
+
             /**
              * Synchronize state. This method is designed to be called from real-time thread to commit
-             * pending state change of the string and return update status.
+             * pending state change of the string and return update status. The method is wait-free and
+             * does not copy the string.
              * @return true if value of the string has been updated
              */
             bool                sync();
@@ -614,7 +785,7 @@ namespace lsp
             uint32_t            serial() const;
 
             /**
-             * Increment serial number as internal value has been changed
+             * Increment serial number as internal value has been changed by the real-time thread
              */
             void                touch();
 
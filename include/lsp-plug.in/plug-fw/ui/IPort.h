@@ -42,6 +42,12 @@ namespace lsp
             PORT_USER_EDIT      = 1 << 0
         };
 
+        /**
+         * Display width requested for the mesh by the consumer that needs the mesh data
+         * in the original resolution
+         */
+        constexpr size_t DISPLAY_WIDTH_FULL     = 0x3fffffff;
+
         /**
          * Interface for UI port that can hold different types of data
          */
@@ -142,6 +148,17 @@ namespace lsp
                  */
                 virtual bool        editing() const;
 
+                /**
+                 * Request the display width for the mesh data. The wrapper may reduce the
+                 * resolution of the mesh to the display width preserving it's envelope,
+                 * the first buffer of the mesh is considered to be the argument.
+                 * If multiple widths are requested, the maximum one is used, so the consumer
+                 * that does not accept the decimated data should request DISPLAY_WIDTH_FULL.
+                 *
+                 * @param width display width in pixels
+                 */
+                virtual void        set_display_width(size_t width);
+
              public:
 
                 /** Add listener to the port
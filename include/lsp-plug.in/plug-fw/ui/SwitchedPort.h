@@ -97,6 +97,7 @@ namespace lsp
                 virtual void    notify(IPort *port, size_t flags) override;
                 virtual bool    begin_edit() override;
                 virtual bool    end_edit() override;
+                virtual void    set_display_width(size_t width) override;
         };
 
     } /* namespace ctl */
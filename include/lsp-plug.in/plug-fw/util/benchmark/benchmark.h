@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_PLUG_FW_UTIL_BENCHMARK_BENCHMARK_H_
+#define LSP_PLUG_IN_PLUG_FW_UTIL_BENCHMARK_BENCHMARK_H_
+
+#include <lsp-plug.in/plug-fw/version.h>
+
+namespace lsp
+{
+    namespace benchmark
+    {
+
+        /**
+         * Register memory allocation, called by memory allocation hooks of the executable.
+         * Allocations are reported as not tracked if the function has never been called.
+         */
+        void on_allocate();
+
+        /**
+         * Execute main function of the utility: measure processing throughput of
+         * all plugins in the package and store results to CSV or JSON file
+         * @param argc number of arguments
+         * @param argv list of arguments
+         * @return status of operation
+         */
+        int main(int argc, const char **argv);
+
+    } /* namespace benchmark */
+} /* namespace lsp */
+
+
+#endif /* LSP_PLUG_IN_PLUG_FW_UTIL_BENCHMARK_BENCHMARK_H_ */
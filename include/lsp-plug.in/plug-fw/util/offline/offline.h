@@ -0,0 +1,416 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_PLUG_FW_UTIL_OFFLINE_OFFLINE_H_
+#define LSP_PLUG_IN_PLUG_FW_UTIL_OFFLINE_OFFLINE_H_
+
+#include <lsp-plug.in/plug-fw/version.h>
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/fmt/config/PullParser.h>
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/ipc/Mutex.h>
+#include <lsp-plug.in/lltl/parray.h>
+#include <lsp-plug.in/mm/IInAudioStream.h>
+#include <lsp-plug.in/mm/IOutAudioStream.h>
+#include <lsp-plug.in/plug-fw/const.h>
+#include <lsp-plug.in/plug-fw/core/AudioBuffer.h>
+#include <lsp-plug.in/plug-fw/core/KVTStorage.h>
+#include <lsp-plug.in/plug-fw/core/osc_buffer.h>
+#include <lsp-plug.in/plug-fw/core/SharedExecutor.h>
+#include <lsp-plug.in/plug-fw/meta/manifest.h>
+#include <lsp-plug.in/plug-fw/plug.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+namespace lsp
+{
+    namespace offline
+    {
+        typedef struct path_t: public plug::path_t
+        {
+            enum flags_t
+            {
+                F_PENDING       = 1 << 0,
+                F_ACCEPTED      = 1 << 1
+            };
+
+            size_t      nFlags;
+            size_t      nXFlags;
+            char        sPath[PATH_MAX];
+
+            virtual void init()
+            {
+                nFlags          = 0;
+                nXFlags         = 0;
+                sPath[0]        = '\0';
+            }
+
+            virtual const char *path() const
+            {
+                return sPath;
+            }
+
+            virtual size_t flags() const
+            {
+                return nXFlags;
+            }
+
+            virtual bool pending()
+            {
+                return (nFlags & F_PENDING) && (!(nFlags & F_ACCEPTED));
+            }
+
+            virtual void accept()
+            {
+                if (nFlags & F_PENDING)
+                    nFlags     |= F_ACCEPTED;
+            }
+
+            virtual bool accepted()
+            {
+                return nFlags & F_ACCEPTED;
+            }
+
+            virtual void commit()
+            {
+                if (nFlags & (F_PENDING | F_ACCEPTED))
+                    nFlags      = 0;
+            }
+
+            // Offline processing is single-threaded, no synchronization with DSP is required
+            void submit(const char *path, size_t flags)
+            {
+                ::strncpy(sPath, path, PATH_MAX);
+                sPath[PATH_MAX-1]   = '\0';
+                nXFlags             = flags;
+                nFlags              = F_PENDING;
+            }
+
+            inline bool idle() const
+            {
+                return nFlags == 0;
+            }
+        } path_t;
+
+        class Port: public plug::IPort
+        {
+            protected:
+                float       fValue;
+                void       *pBuffer;
+
+            public:
+                explicit Port(const meta::port_t *meta) : IPort(meta)
+                {
+                    fValue      = meta->start;
+                    pBuffer     = NULL;
+                }
+                Port(const Port &) = delete;
+                Port(Port &&) = delete;
+                Port & operator = (const Port &) = delete;
+                Port & operator = (Port &&) = delete;
+
+            public:
+                virtual float value() override
+                {
+                    return fValue;
+                }
+
+                virtual void set_value(float value) override
+                {
+                    fValue      = meta::limit_value(pMetadata, value);
+                }
+
+                virtual void *buffer() override
+                {
+                    return pBuffer;
+                }
+
+            public:
+                void bind(void *buffer)
+                {
+                    pBuffer     = buffer;
+                }
+        };
+
+        class PathPort: public Port
+        {
+            private:
+                path_t      sPath;
+
+            public:
+                explicit PathPort(const meta::port_t *meta) : Port(meta)
+                {
+                    sPath.init();
+                    pBuffer     = &sPath;
+                }
+                PathPort(const PathPort &) = delete;
+                PathPort(PathPort &&) = delete;
+                PathPort & operator = (const PathPort &) = delete;
+                PathPort & operator = (PathPort &&) = delete;
+
+            public:
+                inline path_t *data()       { return &sPath;    }
+        };
+
+        class StringPort: public Port
+        {
+            private:
+                plug::string_t     *pValue;
+
+            public:
+                explicit StringPort(const meta::port_t *meta) : Port(meta)
+                {
+                    pValue      = plug::string_t::allocate(size_t(meta->max));
+                    pBuffer     = (pValue != NULL) ? pValue->sData : NULL;
+                }
+                StringPort(const StringPort &) = delete;
+                StringPort(StringPort &&) = delete;
+
+                virtual ~StringPort() override
+                {
+                    if (pValue != NULL)
+                    {
+                        plug::string_t::destroy(pValue);
+                        pValue      = NULL;
+                    }
+                    pBuffer     = NULL;
+                }
+
+                StringPort & operator = (const StringPort &) = delete;
+                StringPort & operator = (StringPort &&) = delete;
+
+            public:
+                inline plug::string_t *data()   { return pValue;    }
+
+                bool sync()
+                {
+                    return (pValue != NULL) ? pValue->sync() : false;
+                }
+        };
+
+        class MidiPort: public Port
+        {
+            private:
+                plug::midi_t        sQueue;
+
+            public:
+                explicit MidiPort(const meta::port_t *meta) : Port(meta)
+                {
+                    sQueue.clear();
+                    pBuffer     = &sQueue;
+                }
+                MidiPort(const MidiPort &) = delete;
+                MidiPort(MidiPort &&) = delete;
+                MidiPort & operator = (const MidiPort &) = delete;
+                MidiPort & operator = (MidiPort &&) = delete;
+
+            public:
+                inline void clear()             { sQueue.clear();   }
+        };
+
+        class MeshPort: public Port
+        {
+            public:
+                explicit MeshPort(const meta::port_t *meta);
+                MeshPort(const MeshPort &) = delete;
+                MeshPort(MeshPort &&) = delete;
+                virtual ~MeshPort() override;
+                MeshPort & operator = (const MeshPort &) = delete;
+                MeshPort & operator = (MeshPort &&) = delete;
+        };
+
+        class StreamPort: public Port
+        {
+            public:
+                explicit StreamPort(const meta::port_t *meta) : Port(meta)
+                {
+                    pBuffer     = plug::stream_t::create(meta->min, meta->max, meta->start);
+                }
+                StreamPort(const StreamPort &) = delete;
+                StreamPort(StreamPort &&) = delete;
+
+                virtual ~StreamPort() override
+                {
+                    plug::stream_t::destroy(static_cast<plug::stream_t *>(pBuffer));
+                    pBuffer     = NULL;
+                }
+
+                StreamPort & operator = (const StreamPort &) = delete;
+                StreamPort & operator = (StreamPort &&) = delete;
+        };
+
+        class FrameBufferPort: public Port
+        {
+            public:
+                explicit FrameBufferPort(const meta::port_t *meta) : Port(meta)
+                {
+                    pBuffer     = plug::frame_buffer_t::create(meta->start, meta->step);
+                }
+                FrameBufferPort(const FrameBufferPort &) = delete;
+                FrameBufferPort(FrameBufferPort &&) = delete;
+
+                virtual ~FrameBufferPort() override
+                {
+                    plug::frame_buffer_t::destroy(static_cast<plug::frame_buffer_t *>(pBuffer));
+                    pBuffer     = NULL;
+                }
+
+                FrameBufferPort & operator = (const FrameBufferPort &) = delete;
+                FrameBufferPort & operator = (FrameBufferPort &&) = delete;
+        };
+
+        class OscPort: public Port
+        {
+            public:
+                explicit OscPort(const meta::port_t *meta) : Port(meta)
+                {
+                    pBuffer     = core::osc_buffer_t::create(OSC_BUFFER_MAX);
+                }
+                OscPort(const OscPort &) = delete;
+                OscPort(OscPort &&) = delete;
+
+                virtual ~OscPort() override
+                {
+                    core::osc_buffer_t::destroy(static_cast<core::osc_buffer_t *>(pBuffer));
+                    pBuffer     = NULL;
+                }
+
+                OscPort & operator = (const OscPort &) = delete;
+                OscPort & operator = (OscPort &&) = delete;
+
+            public:
+                inline void clear()             { static_cast<core::osc_buffer_t *>(pBuffer)->clear();  }
+        };
+
+        class AudioBufferPort: public Port
+        {
+            private:
+                core::AudioBuffer   sBuffer;
+
+            public:
+                explicit AudioBufferPort(const meta::port_t *meta) : Port(meta)
+                {
+                    pBuffer     = &sBuffer;
+                }
+                AudioBufferPort(const AudioBufferPort &) = delete;
+                AudioBufferPort(AudioBufferPort &&) = delete;
+                AudioBufferPort & operator = (const AudioBufferPort &) = delete;
+                AudioBufferPort & operator = (AudioBufferPort &&) = delete;
+
+            public:
+                inline void set_buffer_size(size_t size)    { sBuffer.set_size(size);   }
+        };
+
+        /**
+         * Minimal plugin host for offline processing: all data is processed
+         * by the caller's thread, no real-time constraints are applied
+         */
+        class Wrapper: public plug::IWrapper
+        {
+            private:
+                const meta::package_t      *pPackage;
+                core::SharedExecutor       *pExecutor;
+                core::KVTStorage            sKVT;
+                ipc::Mutex                  sKVTMutex;
+                float                      *vBuffers;
+                size_t                      nBlockSize;
+                bool                        bUpdateSettings;
+
+                lltl::parray<Port>          vAllPorts;
+                lltl::parray<Port>          vAudioIn;
+                lltl::parray<Port>          vAudioOut;
+                lltl::parray<PathPort>      vPaths;
+                lltl::parray<StringPort>    vStrings;
+                lltl::parray<MidiPort>      vMidi;
+                lltl::parray<OscPort>       vOsc;
+                lltl::parray<AudioBufferPort>   vAudioBuffers;
+
+            protected:
+                Port                       *create_port(lltl::parray<plug::IPort> *plugin_ports, const meta::port_t *port);
+                bool                        set_port_value(Port *port, const config::param_t *param, const io::Path *base);
+                status_t                    import_settings_work(config::PullParser *parser, const io::Path *base);
+                bool                        loading();
+
+            public:
+                explicit Wrapper(plug::Module *plugin, resource::ILoader *loader, const meta::package_t *package);
+                Wrapper(const Wrapper &) = delete;
+                Wrapper(Wrapper &&) = delete;
+                virtual ~Wrapper() override;
+
+                Wrapper & operator = (const Wrapper &) = delete;
+                Wrapper & operator = (Wrapper &&) = delete;
+
+                status_t                    init(size_t sample_rate, size_t block_size);
+                void                        destroy();
+
+            public:
+                virtual ipc::IExecutor     *executor() override;
+                virtual core::KVTStorage   *kvt_lock() override;
+                virtual core::KVTStorage   *kvt_trylock() override;
+                virtual bool                kvt_release() override;
+                virtual void                request_settings_update() override;
+                virtual const meta::package_t  *package() const override;
+
+            public:
+                inline size_t               block_size() const          { return nBlockSize;                }
+                inline size_t               ports() const               { return vAllPorts.size();          }
+                inline Port                *port(size_t index)          { return vAllPorts.get(index);      }
+                inline size_t               audio_inputs() const        { return vAudioIn.size();           }
+                inline Port                *audio_input(size_t index)   { return vAudioIn.get(index);       }
+                inline size_t               audio_outputs() const       { return vAudioOut.size();          }
+                inline Port                *audio_output(size_t index)  { return vAudioOut.get(index);      }
+
+            public:
+                status_t                    import_settings(const char *file);
+                void                        warm_up();
+                void                        process_block(size_t samples);
+                /**
+                 * Render the input stream into the output stream block by block, so the memory
+                 * consumption does not depend on the length of the input. The latency of the plugin
+                 * is compensated, the tail is rendered after the end of the input stream.
+                 *
+                 * @param os output stream, should have as many channels as the plugin has audio outputs
+                 * @param is input stream, should have the same sample rate as the plugin
+                 * @param tail number of samples to render after the end of the input stream
+                 * @return status of operation
+                 */
+                status_t                    render(mm::IOutAudioStream *os, mm::IInAudioStream *is, size_t tail);
+        };
+
+        /**
+         * Check that the offline host supports all ports of the plugin
+         * @param meta plugin metadata
+         * @return true if plugin can be instantiated by the offline host
+         */
+        bool supported(const meta::plugin_t *meta);
+
+        /**
+         * Load manifest of the package from builtin resources
+         * @param package pointer to store the manifest, should be freed by meta::free_manifest()
+         * @return status of operation
+         */
+        status_t load_package(meta::package_t **package);
+
+    } /* namespace offline */
+} /* namespace lsp */
+
+#endif /* LSP_PLUG_IN_PLUG_FW_UTIL_OFFLINE_OFFLINE_H_ */
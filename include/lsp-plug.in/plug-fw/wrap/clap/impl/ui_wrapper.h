@@ -49,6 +49,8 @@ namespace lsp
             bRequestProcess = false;
             bUIActive       = false;
             bRealizeActive  = false;
+            vTrackedPorts   = NULL;
+            nTrackedPorts   = 0;
 
         #ifdef LSP_CLAP_OWN_EVENT_LOOP
             pUIThread       = NULL;
@@ -75,6 +77,8 @@ namespace lsp
             lsp_trace("Creating ports for %s - %s", meta->name, meta->description);
             for (const meta::port_t *port = meta->ports ; port->id != NULL; ++port)
                 create_port(port, NULL);
+            if ((res = bind_tracked_ports()) != STATUS_OK)
+                return res;
 
             // Initialize parent
             if ((res = IWrapper::init(root_widget)) != STATUS_OK)
@@ -131,6 +135,15 @@ namespace lsp
             // Call parent instance
             IWrapper::destroy();
 
+            // Forget the lists of ports
+            vPolledPorts.flush();
+            if (vTrackedPorts != NULL)
+            {
+                free(vTrackedPorts);
+                vTrackedPorts   = NULL;
+            }
+            nTrackedPorts   = 0;
+
             // Destroy the display
             if (pDisplay != NULL)
             {
@@ -362,6 +375,38 @@ namespace lsp
             return cup;
         }
 
+        status_t UIWrapper::bind_tracked_ports()
+        {
+            core::ChangeSet *changes = pWrapper->ui_changes();
+
+            // Allocate the mapping of change identifiers to UI ports
+            nTrackedPorts   = changes->size();
+            if (nTrackedPorts > 0)
+            {
+                vTrackedPorts   = static_cast<clap::UIPort **>(calloc(nTrackedPorts, sizeof(clap::UIPort *)));
+                if (vTrackedPorts == NULL)
+                    return STATUS_NO_MEM;
+            }
+
+            // Ports that report changes are synchronized on demand, all other ports are polled
+            for (size_t i=0, n=vPorts.size(); i<n; ++i)
+            {
+                clap::UIPort *cup   = static_cast<clap::UIPort *>(vPorts.uget(i));
+                clap::Port *cp      = cup->port();
+                const ssize_t id    = (cp != NULL) ? cp->change_id() : -1;
+
+                if ((id >= 0) && (size_t(id) < nTrackedPorts) && (vTrackedPorts[id] == NULL))
+                    vTrackedPorts[id]   = cup;
+                else if (!vPolledPorts.add(cup))
+                    return STATUS_NO_MEM;
+            }
+
+            // Force the initial synchronization of all tracked ports
+            changes->mark_all();
+
+            return STATUS_OK;
+        }
+
         void UIWrapper::tranfet_ui_to_dsp()
         {
             if (bRequestProcess)
@@ -382,19 +427,36 @@ namespace lsp
             // Try to sync position
             IWrapper::position_updated(pWrapper->position());
 
-            // DSP -> UI communication
-            for (size_t i=0, nports=vPorts.size(); i < nports; ++i)
+            // DSP -> UI communication for ports that are polled
+            for (size_t i=0, nports=vPolledPorts.size(); i < nports; ++i)
             {
                 // Get UI port
-                clap::UIPort *cup   = static_cast<clap::UIPort *>(vPorts.uget(i));
+                clap::UIPort *cup   = vPolledPorts.uget(i);
                 do {
                     if (cup->sync())
                         cup->notify_all(ui::PORT_NONE);
                 } while (cup->sync_again());
             } // for port_id
 
-            // Perform KVT synchronization
-            core::KVTStorage *kvt = pWrapper->kvt_lock();
+            // DSP -> UI communication for ports that have reported changes
+            core::ChangeSet *changes = pWrapper->ui_changes();
+            if (changes->begin())
+            {
+                for (ssize_t index; (index = changes->next()) >= 0; )
+                {
+                    clap::UIPort *cup   = (size_t(index) < nTrackedPorts) ? vTrackedPorts[index] : NULL;
+                    if (cup == NULL)
+                        continue;
+
+                    do {
+                        if (cup->sync())
+                            cup->notify_all(ui::PORT_NONE);
+                    } while (cup->sync_again());
+                }
+            }
+
+            // Perform KVT synchronization, do not block the UI if the KVT is busy
+            core::KVTStorage *kvt = pWrapper->kvt_trylock();
             if (kvt != NULL)
             {
                 // Synchronize DSP -> UI transfer
@@ -25,7 +25,8 @@
 #include <lsp-plug.in/plug-fw/version.h>
 
 #include <clap/clap.h>
-#include <lsp-plug.in/ipc/NativeExecutor.h>
+#include <lsp-plug.in/plug-fw/core/KVTSnapshot.h>
+#include <lsp-plug.in/plug-fw/core/SharedExecutor.h>
 #include <lsp-plug.in/plug-fw/wrap/clap/wrapper.h>
 #include <lsp-plug.in/runtime/system.h>
 #include <lsp-plug.in/stdlib/stdio.h>
@@ -95,6 +96,9 @@ namespace lsp
                 pExecutor   = NULL;
             }
 
+            // Destroy silence detector
+            sSilence.destroy();
+
             // Destroy sample player
             if (pSamplePlayer != NULL)
             {
@@ -137,6 +141,7 @@ namespace lsp
             vAllPorts.flush();
             vSortedPorts.flush();
             vAudioBuffers.flush();
+            sUIChanges.destroy();
             vMidiIn.flush();
             vMidiOut.flush();
 
@@ -635,7 +640,34 @@ namespace lsp
                 return STATUS_NO_MEM;
             vSortedPorts.qsort(compare_ports_by_id);
 
-            return STATUS_OK;
+            // Bind output ports to the set of changes delivered to the UI
+            size_t tracked = 0;
+            for (size_t i=0, n=vAllPorts.size(); i<n; ++i)
+            {
+                clap::Port *p = vAllPorts.uget(i);
+                if (is_ui_tracked_port(p->metadata()))
+                    p->bind_changes(&sUIChanges, tracked++);
+            }
+
+            return sUIChanges.init(tracked);
+        }
+
+        bool Wrapper::is_ui_tracked_port(const meta::port_t *meta)
+        {
+            switch (meta->role)
+            {
+                case meta::R_METER:
+                case meta::R_MESH:
+                case meta::R_STREAM:
+                case meta::R_FBUFFER:
+                case meta::R_STRING:
+                case meta::R_SEND_NAME:
+                case meta::R_RETURN_NAME:
+                    return true;
+                default:
+                    break;
+            }
+            return false;
         }
 
         status_t Wrapper::init()
@@ -674,6 +706,7 @@ namespace lsp
             // Initialize plugin
             lsp_trace("pPlugin = %p", pPlugin);
             pPlugin->init(this, plugin_ports.array());
+            sSilence.init(pPlugin, plugin_ports.array(), plugin_ports.size());
 
             // Create sample player if required
             if (meta->extensions & meta::E_FILE_PREVIEW)
@@ -753,6 +786,7 @@ namespace lsp
 
             // Call plugin for activation
             pPlugin->activate();
+            sSilence.reset();
 
             return STATUS_OK;
         }
@@ -1030,6 +1064,8 @@ namespace lsp
                 (process->audio_outputs_count > vAudioOut.size()))
                 return CLAP_PROCESS_ERROR;
 
+            const uint64_t block_ts = profile_begin();
+
         #ifdef WITH_UI_FEATURE
             // Update UI activity state
             const uatomic_t ui_req = nUIReq;
@@ -1141,7 +1177,9 @@ namespace lsp
             if (pShmClient != NULL)
             {
                 pShmClient->begin(process->frames_count);
+                const uint64_t shm_ts = profile_begin();
                 pShmClient->pre_process(process->frames_count);
+                profile_end(core::DSP_PROBE_SHM_PRE, shm_ts, process->frames_count);
             }
 
             // CLAP may deliver change of input parameters in the input events.
@@ -1168,16 +1206,29 @@ namespace lsp
                     lsp_trace("Updating settings");
                     if (pShmClient != NULL)
                         pShmClient->update_settings();
+                    const uint64_t settings_ts = profile_begin();
                     pPlugin->update_settings();
+                    profile_end(core::DSP_PROBE_SETTINGS, settings_ts, block_size);
                     bUpdateSettings     = false;
                 }
 
                 // Call the plugin for processing
-                pPlugin->process(block_size);
+                if (sSilence.idle(block_size))
+                    sSilence.silence(block_size);
+                else
+                {
+                    const uint64_t process_ts = profile_begin();
+                    pPlugin->process(block_size);
+                    profile_end(core::DSP_PROBE_PROCESS, process_ts, block_size);
+                }
 
                 // Call the sampler for processing
                 if (pSamplePlayer != NULL)
+                {
+                    const uint64_t player_ts = profile_begin();
                     pSamplePlayer->process(block_size);
+                    profile_end(core::DSP_PROBE_SAMPLE_PLAYER, player_ts, block_size);
+                }
 
                 // Do the post-processing stuff
                 generate_output_events(offset, process);
@@ -1190,7 +1241,9 @@ namespace lsp
 
             if (pShmClient != NULL)
             {
+                const uint64_t shm_ts = profile_begin();
                 pShmClient->post_process(process->frames_count);
+                profile_end(core::DSP_PROBE_SHM_POST, shm_ts, process->frames_count);
                 pShmClient->end();
             }
 
@@ -1233,6 +1286,8 @@ namespace lsp
                 pExt->tail->changed(pHost);
             }
 
+            profile_end(core::DSP_PROBE_BLOCK, block_ts, process->frames_count);
+
             return CLAP_PROCESS_CONTINUE;
         }
 
@@ -1385,7 +1440,7 @@ namespace lsp
                 return res;
             }
 
-            // Serialize KVT storage
+            // Serialize KVT storage as a single snapshot
             if (sKVTMutex.lock())
             {
                 lsp_finally {
@@ -1393,129 +1448,27 @@ namespace lsp
                     sKVTMutex.unlock();
                 };
 
-                const core::kvt_param_t *p;
-
-                // Read the whole KVT storage
-                core::KVTIterator *it = sKVT.enum_all();
-                while (it->next() == STATUS_OK)
+                core::KVTSnapshot snapshot;
+                if ((res = snapshot.save(&sKVT)) != STATUS_OK)
                 {
-                    res             = it->get(&p);
-                    if (res == STATUS_NOT_FOUND) // Not a parameter
-                        continue;
-                    else if (res != STATUS_OK)
-                    {
-                        lsp_warn("it->get() returned %d", int(res));
-                        break;
-                    }
-                    else if (it->is_transient()) // Skip transient parameters
-                        continue;
-
-                    const char *name = it->name();
-                    if (name == NULL)
-                    {
-                        lsp_trace("it->name() returned NULL");
-                        break;
-                    }
-
-                    uint8_t flags = 0;
-                    if (it->is_private())
-                        flags      |= clap::FLAG_PRIVATE;
-
-                    kvt_dump_parameter("Saving state of KVT parameter: %s = ", p, name);
-
-                    // Write KVT entry header
-                    if ((res = write_string(os, name)) != STATUS_OK)
-                    {
-                        lsp_warn("Error serializing KVT record name id=%s, code=%d", name, int(res));
-                        return res;
-                    }
-                    if ((res = write_fully(os, flags)) != STATUS_OK)
-                    {
-                        lsp_warn("Error serializing KVT record flags id=%s, code=%d", name, int(res));
-                        return res;
-                    }
-
-                    // Serialize parameter according to it's type
-                    switch (p->type)
-                    {
-                        case core::KVT_INT32:
-                        {
-                            res = write_fully(os, uint8_t(clap::TYPE_INT32));
-                            if (res == STATUS_OK)
-                                res = write_fully(os, p->i32);
-                            break;
-                        };
-                        case core::KVT_UINT32:
-                        {
-                            res = write_fully(os, uint8_t(clap::TYPE_UINT32));
-                            if (res == STATUS_OK)
-                                res = write_fully(os, p->u32);
-                            break;
-                        }
-                        case core::KVT_INT64:
-                        {
-                            res = write_fully(os, uint8_t(clap::TYPE_INT64));
-                            if (res == STATUS_OK)
-                                res = write_fully(os, p->i64);
-                            break;
-                        };
-                        case core::KVT_UINT64:
-                        {
-                            res = write_fully(os, uint8_t(clap::TYPE_UINT64));
-                            if (res == STATUS_OK)
-                                res = write_fully(os, p->u64);
-                            break;
-                        }
-                        case core::KVT_FLOAT32:
-                        {
-                            res = write_fully(os, uint8_t(clap::TYPE_FLOAT32));
-                            if (res == STATUS_OK)
-                                res = write_fully(os, p->f32);
-                            break;
-                        }
-                        case core::KVT_FLOAT64:
-                        {
-                            res = write_fully(os, uint8_t(clap::TYPE_FLOAT64));
-                            if (res == STATUS_OK)
-                                res = write_fully(os, p->f64);
-                            break;
-                        }
-                        case core::KVT_STRING:
-                        {
-                            res = write_fully(os, uint8_t(clap::TYPE_STRING));
-                            if (res == STATUS_OK)
-                                res = write_string(os, (p->str != NULL) ? p->str : "");
-                            break;
-                        }
-                        case core::KVT_BLOB:
-                        {
-                            if ((p->blob.size > 0) && (p->blob.data == NULL))
-                            {
-                                res = STATUS_INVALID_VALUE;
-                                break;
-                            }
-
-                            res = write_fully(os, uint8_t(clap::TYPE_BLOB));
-                            if (res == STATUS_OK)
-                                res = write_fully(os, uint32_t(p->blob.size));
-                            if (res == STATUS_OK)
-                                res = write_string(os, (p->blob.ctype != NULL) ? p->blob.ctype : "");
-                            if ((res == STATUS_OK) && (p->blob.size > 0))
-                                res = write_fully(os, p->blob.data, p->blob.size);
-                            break;
-                        }
-
-                        default:
-                            res     = STATUS_BAD_TYPE;
-                            break;
-                    }
+                    lsp_warn("Error serializing KVT snapshot, code=%d", int(res));
+                    return res;
+                }
 
-                    // Successful status?
-                    if (res != STATUS_OK)
-                    {
-                        lsp_warn("Failed to serialize value id=%s, code=%d", name, int(res));
-                        break;
-                    }
+                if ((res = write_string(os, "!kvt_snapshot")) != STATUS_OK)
+                {
+                    lsp_warn("Error serializing KVT snapshot name, code=%d", int(res));
+                    return res;
+                }
+                if ((res = write_varint(os, snapshot.size())) != STATUS_OK)
+                {
+                    lsp_warn("Error serializing KVT snapshot size, code=%d", int(res));
+                    return res;
+                }
+                if ((res = write_fully(os, snapshot.data(), snapshot.size())) != STATUS_OK)
+                {
+                    lsp_warn("Error serializing KVT snapshot data, code=%d", int(res));
+                    return res;
                 }
             }
 
@@ -1571,6 +1524,11 @@ namespace lsp
             return pSamplePlayer;
         }
 
+        core::ChangeSet *Wrapper::ui_changes()
+        {
+            return &sUIChanges;
+        }
+
     #ifdef WITH_UI_FEATURE
         void Wrapper::lookup_ui_factory()
         {
@@ -1786,6 +1744,27 @@ namespace lsp
             return res;
         }
 
+        status_t Wrapper::read_kvt_snapshot(const clap_istream_t *is)
+        {
+            status_t res;
+            size_t size = 0;
+
+            if ((res = read_varint(is, &size)) != STATUS_OK)
+                return res;
+            if (size == 0)
+                return STATUS_CORRUPTED;
+
+            uint8_t *data = static_cast<uint8_t *>(malloc(size));
+            if (data == NULL)
+                return STATUS_NO_MEM;
+            lsp_finally { free(data); };
+
+            if ((res = read_fully(is, data, size)) != STATUS_OK)
+                return res;
+
+            return core::KVTSnapshot::restore(&sKVT, data, size, core::KVT_TX | core::KVT_STATE);
+        }
+
         void Wrapper::destroy_value(core::kvt_param_t *p)
         {
             switch (p->type)
@@ -1856,13 +1835,15 @@ namespace lsp
                 return STATUS_NO_DATA;
             }
 
-            // Lock the KVT
+            // Lock the KVT and apply all changes as a single transaction
             if (!sKVTMutex.lock())
             {
                 lsp_warn("Failed to lock KVT");
                 return STATUS_UNKNOWN_ERR;
             }
+            sKVT.begin_transaction();
             lsp_finally {
+                sKVT.commit_transaction();
                 sKVT.gc();
                 sKVTMutex.unlock();
             };
@@ -1930,6 +1911,14 @@ namespace lsp
 
                         set_preset_state(&state, PT_STATE);
                     }
+                    else if (strcmp(name, "!kvt_snapshot") == 0)
+                    {
+                        if ((res = read_kvt_snapshot(is)) != STATUS_OK)
+                        {
+                            lsp_warn("Error reading KVT snapshot, code=%d", int(res));
+                            return res;
+                        }
+                    }
                     else
                     {
                         lsp_trace("Unknown special variable %s, skipping", name);
@@ -2189,11 +2178,11 @@ namespace lsp
             if (pExecutor != NULL)
                 return pExecutor;
 
-            lsp_trace("Creating native executor service");
-            ipc::NativeExecutor *exec = new ipc::NativeExecutor();
+            lsp_trace("Creating shared executor service");
+            core::SharedExecutor *exec = new core::SharedExecutor();
             if (exec == NULL)
                 return NULL;
-            if (exec->start() != STATUS_OK)
+            if (exec->init() != STATUS_OK)
             {
                 delete exec;
                 return NULL;
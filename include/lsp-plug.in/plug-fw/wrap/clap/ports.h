@@ -31,6 +31,7 @@
 #include <lsp-plug.in/dsp/dsp.h>
 #include <lsp-plug.in/plug-fw/core/AudioBuffer.h>
 #include <lsp-plug.in/plug-fw/core/AudioTracer.h>
+#include <lsp-plug.in/plug-fw/core/ChangeSet.h>
 #include <lsp-plug.in/plug-fw/core/osc_buffer.h>
 #include <lsp-plug.in/plug-fw/meta/func.h>
 #include <lsp-plug.in/plug-fw/plug.h>
@@ -45,9 +46,15 @@ namespace lsp
         // Specify port classes
         class Port: public plug::IPort
         {
+            protected:
+                core::ChangeSet    *pChanges;       // Set of changes to notify the UI
+                ssize_t             nChangeId;      // Index of the port in the set of changes
+
             public:
                 explicit Port(const meta::port_t *meta): plug::IPort(meta)
                 {
+                    pChanges        = NULL;
+                    nChangeId       = -1;
                 }
                 Port(const Port &) = delete;
                 Port(Port &&) = delete;
@@ -87,6 +94,33 @@ namespace lsp
                  * Notify port finished being edited
                  */
                 virtual void end_edit() {}
+
+            public:
+                /**
+                 * Bind the port to the set of changes delivered to the UI
+                 * @param changes set of changes
+                 * @param id index of the port in the set of changes
+                 */
+                inline void bind_changes(core::ChangeSet *changes, size_t id)
+                {
+                    pChanges        = changes;
+                    nChangeId       = id;
+                }
+
+                /**
+                 * Get index of the port in the set of changes
+                 * @return index of the port or negative value if the port is not bound
+                 */
+                inline ssize_t change_id() const                    { return nChangeId; }
+
+                /**
+                 * Notify the UI that the port has changed it's state
+                 */
+                inline void mark_changed()
+                {
+                    if (pChanges != NULL)
+                        pChanges->mark(nChangeId);
+                }
         };
 
         /**
@@ -276,7 +310,7 @@ namespace lsp
 
                 inline bool push(const midi::event_t *me)
                 {
-                    return sQueue.push(me);
+                    return sQueue.insert(me);
                 }
         };
 
@@ -560,6 +594,7 @@ namespace lsp
         {
             public:
                 float   fValue;
+                float   fLastValue;
                 bool    bForce;
 
             public:
@@ -567,6 +602,7 @@ namespace lsp
                     Port(meta)
                 {
                     fValue      = meta->start;
+                    fLastValue  = fValue;
                     bForce      = true;
                 }
                 MeterPort(const MeterPort &) = delete;
@@ -602,6 +638,15 @@ namespace lsp
                         fValue = value;
                 }
 
+                virtual void post_process(size_t samples) override
+                {
+                    if (fValue == fLastValue)
+                        return;
+
+                    fLastValue  = fValue;
+                    mark_changed();
+                }
+
                 float sync_value()
                 {
                     float value = fValue;
@@ -672,18 +717,26 @@ namespace lsp
                 {
                     return pMesh;
                 }
+
+                virtual void post_process(size_t samples) override
+                {
+                    if ((pMesh != NULL) && (pMesh->containsData()))
+                        mark_changed();
+                }
         };
 
         class StreamPort: public Port
         {
             private:
                 plug::stream_t     *pStream;
+                uint32_t            nFrameId;
 
             public:
                 explicit StreamPort(const meta::port_t *meta):
                     Port(meta)
                 {
                     pStream     = plug::stream_t::create(pMetadata->min, pMetadata->max, pMetadata->start);
+                    nFrameId    = (pStream != NULL) ? pStream->frame_id() : 0;
                 }
                 StreamPort(const StreamPort &) = delete;
                 StreamPort(StreamPort &&) = delete;
@@ -705,18 +758,33 @@ namespace lsp
                 {
                     return pStream;
                 }
+
+                virtual void post_process(size_t samples) override
+                {
+                    if (pStream == NULL)
+                        return;
+
+                    const uint32_t frame_id = pStream->frame_id();
+                    if (frame_id == nFrameId)
+                        return;
+
+                    nFrameId    = frame_id;
+                    mark_changed();
+                }
         };
 
         class FrameBufferPort: public Port
         {
             private:
                 plug::frame_buffer_t    sFB;
+                uint32_t                nRowId;
 
             public:
                 explicit FrameBufferPort(const meta::port_t *meta):
                     Port(meta)
                 {
                     sFB.init(pMetadata->start, pMetadata->step);
+                    nRowId      = sFB.next_rowid();
                 }
                 FrameBufferPort(const FrameBufferPort &) = delete;
                 FrameBufferPort(FrameBufferPort &&) = delete;
@@ -734,6 +802,16 @@ namespace lsp
                 {
                     return &sFB;
                 }
+
+                virtual void post_process(size_t samples) override
+                {
+                    const uint32_t row_id = sFB.next_rowid();
+                    if (row_id == nRowId)
+                        return;
+
+                    nRowId      = row_id;
+                    mark_changed();
+                }
         };
 
         class PathPort: public Port
@@ -836,9 +914,15 @@ namespace lsp
                     if (pValue == NULL)
                         return STATUS_OK;
 
+                    // Take the consistent copy of the value since it can be changed by the real-time thread
+                    char *str = pValue->snapshot();
+                    if (str == NULL)
+                        return STATUS_NO_MEM;
+                    lsp_finally { free(str); };
+
                     status_t res = write_fully(os, uint8_t(clap::TYPE_STRING));
                     if (res == STATUS_OK)
-                        res = write_string(os, pValue->sData);
+                        res = write_string(os, str);
 
                     return res;
                 }
@@ -884,6 +968,7 @@ namespace lsp
                 {
                     strcpy(pValue->sData, pMetadata->value);
                     atomic_add(&nUIPending, 1);
+                    mark_changed();
                 }
 
             public:
@@ -894,7 +979,11 @@ namespace lsp
 
                 bool changed()
                 {
-                    return (pValue != NULL) ? pValue->sync() : false;
+                    if ((pValue == NULL) || (!pValue->sync()))
+                        return false;
+
+                    mark_changed();
+                    return true;
                 }
 
                 bool is_state() const
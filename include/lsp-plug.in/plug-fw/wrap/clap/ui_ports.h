@@ -25,6 +25,7 @@
 #include <lsp-plug.in/plug-fw/version.h>
 
 #include <clap/clap.h>
+#include <lsp-plug.in/plug-fw/core/decimate.h>
 #include <lsp-plug.in/plug-fw/core/osc_buffer.h>
 #include <lsp-plug.in/plug-fw/ui.h>
 #include <lsp-plug.in/plug-fw/wrap/clap/ports.h>
@@ -63,6 +64,13 @@ namespace lsp
                 virtual bool sync()         { return false; }
 
                 virtual bool sync_again()   { return false; }
+
+            public:
+                /**
+                 * Get the backend port
+                 * @return backend port
+                 */
+                inline clap::Port *port()   { return pPort; }
         };
 
         class UIParameterPort: public UIPort
@@ -244,12 +252,14 @@ namespace lsp
         {
             private:
                 plug::mesh_t   *pMesh;
+                size_t          nDisplayWidth;
 
             public:
                 explicit UIMeshPort(clap::Port *port):
                     UIPort(port->metadata(), port)
                 {
-                    pMesh       = clap::create_mesh(pMetadata);
+                    pMesh           = clap::create_mesh(pMetadata);
+                    nDisplayWidth   = 0;
                 }
 
                 UIMeshPort(const UIMeshPort &) = delete;
@@ -271,10 +281,10 @@ namespace lsp
                     if ((mesh == NULL) || (!mesh->containsData()))
                         return false;
 
-                    // Copy mesh data
-                    for (size_t i=0; i < mesh->nBuffers; ++i)
-                        dsp::copy_saturated(pMesh->pvData[i], mesh->pvData[i], mesh->nItems);
-                    pMesh->data(mesh->nBuffers, mesh->nItems);
+                    // Copy mesh data, reduce it to the display width if requested
+                    const size_t items = core::decimate_mesh_saturated(
+                        pMesh->pvData, mesh->pvData, mesh->nBuffers, mesh->nItems, nDisplayWidth);
+                    pMesh->data(mesh->nBuffers, items);
 
                     // Clean the source mesh
                     mesh->cleanup();
@@ -286,6 +296,11 @@ namespace lsp
                 {
                     return pMesh;
                 }
+
+                virtual void set_display_width(size_t width) override
+                {
+                    nDisplayWidth   = lsp_max(nDisplayWidth, width);
+                }
         };
 
         class UIStreamPort: public UIPort
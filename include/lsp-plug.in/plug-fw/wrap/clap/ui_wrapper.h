@@ -60,6 +60,9 @@ namespace lsp
                 bool                            bRequestProcess;// Request the process() call flag
                 bool                            bUIActive;      // UI is active flag
                 bool                            bRealizeActive; // Realize is active
+                lltl::parray<clap::UIPort>      vPolledPorts;   // Ports that are synchronized on each UI frame
+                clap::UIPort                  **vTrackedPorts;  // Ports that are synchronized only on change, indexed by change id
+                size_t                          nTrackedPorts;  // Number of tracked ports
 
             #ifdef LSP_CLAP_OWN_EVENT_LOOP
                 ipc::Thread                    *pUIThread;      // Thread that performs the UI event loop
@@ -84,6 +87,7 @@ namespace lsp
                 void                            tranfet_ui_to_dsp();
                 void                            transfer_dsp_to_ui();
                 bool                            initialize_ui();
+                status_t                        bind_tracked_ports();
                 void                            do_destroy();
 
             public:
@@ -28,8 +28,10 @@
 #include <lsp-plug.in/common/status.h>
 #include <lsp-plug.in/ipc/Mutex.h>
 #include <lsp-plug.in/lltl/parray.h>
+#include <lsp-plug.in/plug-fw/core/ChangeSet.h>
 #include <lsp-plug.in/plug-fw/core/SamplePlayer.h>
 #include <lsp-plug.in/plug-fw/core/ShmClient.h>
+#include <lsp-plug.in/plug-fw/core/SilenceDetector.h>
 #include <lsp-plug.in/plug-fw/core/presets.h>
 #include <lsp-plug.in/plug-fw/meta/manifest.h>
 #include <lsp-plug.in/plug-fw/wrap/clap/extensions.h>
@@ -118,6 +120,7 @@ namespace lsp
                 lltl::parray<clap::Port>        vSortedPorts;       // List of ports sorted by metadata identifier
                 lltl::parray<meta::port_t>      vGenMetadata;       // Generated metadata for virtual ports
 
+                core::ChangeSet                 sUIChanges;         // Changes of output ports to deliver to the UI
                 core::KVTStorage                sKVT;               // KVT storage
                 ipc::Mutex                      sKVTMutex;          // KVT storage access mutex
 
@@ -126,6 +129,7 @@ namespace lsp
                 bool                            bStateManage;       // State management barrier
                 core::SamplePlayer             *pSamplePlayer;      // Sample player
                 core::ShmClient                *pShmClient;         // Shared memory client
+                core::SilenceDetector          sSilence;            // Silence detector for processing suspend
 
             protected:
                 static audio_group_t *alloc_audio_group(size_t ports);
@@ -138,6 +142,7 @@ namespace lsp
                 static plug::IPort *find_port(const char *id, lltl::parray<plug::IPort> *list);
                 static ssize_t  compare_ports_by_clap_id(const ParameterPort *a, const ParameterPort *b);
                 static ssize_t  compare_ports_by_id(const clap::Port *a, const clap::Port *b);
+                static bool     is_ui_tracked_port(const meta::port_t *meta);
                 static status_t read_value(const clap_istream_t *is, const char *name, core::kvt_param_t *p);
                 static void     destroy_value(core::kvt_param_t *p);
 
@@ -150,6 +155,7 @@ namespace lsp
                 void            process_transport_event(const clap_event_transport_t *ev);
                 void            generate_output_events(size_t offset, const clap_process_t *process);
                 status_t        serialize_preset_settings(const clap_ostream_t *os);
+                status_t        read_kvt_snapshot(const clap_istream_t *is);
 
         #ifdef WITH_UI_FEATURE
             protected:
@@ -226,6 +232,7 @@ namespace lsp
                 // Miscellaneous functions
                 clap::Port                     *find_by_id(const char *id);
                 inline core::SamplePlayer      *sample_player();
+                inline core::ChangeSet         *ui_changes();
                 void                            request_state_dump();
                 inline HostExtensions          *extensions();
                 void                            set_preset_state(const core::preset_state_t *state, size_t mode);
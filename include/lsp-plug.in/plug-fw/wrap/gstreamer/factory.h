@@ -28,6 +28,7 @@
 #include <lsp-plug.in/ipc/Mutex.h>
 #include <lsp-plug.in/lltl/parray.h>
 #include <lsp-plug.in/plug-fw/core/CatalogManager.h>
+#include <lsp-plug.in/plug-fw/core/ExecutorPool.h>
 #include <lsp-plug.in/plug-fw/core/ICatalogFactory.h>
 #include <lsp-plug.in/plug-fw/meta/types.h>
 #include <lsp-plug.in/plug-fw/meta/manifest.h>
@@ -63,7 +64,7 @@ namespace lsp
                 uatomic_t               nReferences;        // Number of references
                 ipc::Mutex              sMutex;             // Mutex for managing factory state
                 size_t                  nRefExecutor;       // Number of executor references
-                ipc::IExecutor         *pExecutor;          // Executor service
+                core::ExecutorPool     *pExecutor;          // Executor service
                 core::CatalogManager    sCatalogManager;    // Catalog management
 
             private:
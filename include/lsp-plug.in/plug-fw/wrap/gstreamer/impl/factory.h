@@ -26,8 +26,8 @@
 
 #include <lsp-plug.in/common/debug.h>
 #include <lsp-plug.in/io/IInStream.h>
-#include <lsp-plug.in/ipc/NativeExecutor.h>
 #include <lsp-plug.in/plug-fw/core/Resources.h>
+#include <lsp-plug.in/plug-fw/core/ExecutorPool.h>
 #include <lsp-plug.in/plug-fw/wrap/gstreamer/factory.h>
 #include <lsp-plug.in/plug-fw/wrap/gstreamer/wrapper.h>
 #include <lsp-plug.in/stdlib/stdio.h>
@@ -53,11 +53,11 @@ namespace lsp
 
         void Factory::destroy()
         {
-            // Shutdown executor
+            // Release executor
             if (pExecutor != NULL)
             {
-                pExecutor->shutdown();
-                delete pExecutor;
+                core::ExecutorPool::release(pExecutor);
+                pExecutor       = NULL;
             }
 
             // Forget the package
@@ -135,20 +135,12 @@ namespace lsp
                 return pExecutor;
             }
 
-            // Create executor
-            ipc::NativeExecutor *executor = new ipc::NativeExecutor();
+            // Acquire the process-wide executor pool. The pool is passed to plugins directly:
+            // each plugin wraps it with own executor which keeps track of submitted tasks
+            core::ExecutorPool *executor = core::ExecutorPool::acquire();
             if (executor == NULL)
                 return NULL;
-            lsp_trace("Allocated executor=%p", executor);
-
-            // Launch executor
-            status_t res = executor->start();
-            if (res != STATUS_OK)
-            {
-                lsp_trace("Failed to start executor=%p, code=%d", executor, int(res));
-                delete executor;
-                return NULL;
-            }
+            lsp_trace("Acquired executor=%p", executor);
 
             // Update status
             ++nRefExecutor;
@@ -168,9 +160,8 @@ namespace lsp
             if (pExecutor == NULL)
                 return;
 
-            lsp_trace("Destroying executor pExecutor=%p", pExecutor);
-            pExecutor->shutdown();
-            delete pExecutor;
+            lsp_trace("Releasing executor pExecutor=%p", pExecutor);
+            core::ExecutorPool::release(pExecutor);
             pExecutor   = NULL;
         }
 
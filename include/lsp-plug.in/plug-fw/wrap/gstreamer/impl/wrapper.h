@@ -89,6 +89,9 @@ namespace lsp
                 pExecutor = NULL;
             }
 
+            // Destroy silence detector
+            sSilence.destroy();
+
             // Destroy sample player
             if (pSamplePlayer != NULL)
             {
@@ -346,6 +349,7 @@ namespace lsp
 
             // Initialize plugin
             pPlugin->init(this, plugin_ports.array());
+            sSilence.init(pPlugin, plugin_ports.array(), plugin_ports.size());
 
             return STATUS_OK;
         }
@@ -989,6 +993,8 @@ namespace lsp
             dsp::start(&ctx);
             lsp_finally { dsp::finish(&ctx); };
 
+            const uint64_t block_ts = profile_begin();
+
             // Process input events
             process_input_events();
 
@@ -1011,14 +1017,18 @@ namespace lsp
                     bUpdateSettings         = false;
                     if (pShmClient != NULL)
                         pShmClient->update_settings();
+                    const uint64_t settings_ts = profile_begin();
                     pPlugin->update_settings();
+                    profile_end(core::DSP_PROBE_SETTINGS, settings_ts, to_do);
                 }
 
                 // Prepare shared memory buffers
                 if (pShmClient != NULL)
                 {
                     pShmClient->begin(to_do);
+                    const uint64_t shm_ts = profile_begin();
                     pShmClient->pre_process(to_do);
+                    profile_end(core::DSP_PROBE_SHM_PRE, shm_ts, to_do);
                 }
 
                 // Process input buffers
@@ -1049,11 +1059,22 @@ namespace lsp
                 pPlugin->set_position(&sPosition);
 
                 // Call plugin
-                pPlugin->process(to_do);
+                if (sSilence.idle(to_do))
+                    sSilence.silence(to_do);
+                else
+                {
+                    const uint64_t process_ts = profile_begin();
+                    pPlugin->process(to_do);
+                    profile_end(core::DSP_PROBE_PROCESS, process_ts, to_do);
+                }
 
                 // Call sample player
                 if (pSamplePlayer != NULL)
+                {
+                    const uint64_t player_ts = profile_begin();
                     pSamplePlayer->process(samples);
+                    profile_end(core::DSP_PROBE_SAMPLE_PLAYER, player_ts, samples);
+                }
 
                 // Process generated MIDI events
                 for (size_t i=0, n=vMidiOut.size(); i<n; ++i)
@@ -1086,7 +1107,9 @@ namespace lsp
                 // Process shared memory buffers
                 if (pShmClient != NULL)
                 {
+                    const uint64_t shm_ts = profile_begin();
                     pShmClient->post_process(to_do);
+                    profile_end(core::DSP_PROBE_SHM_POST, shm_ts, to_do);
                     pShmClient->end();
                 }
 
@@ -1106,6 +1129,8 @@ namespace lsp
                 nLatency = latency;
                 report_latency();
             }
+
+            profile_end(core::DSP_PROBE_BLOCK, block_ts, samples);
         }
 
         const core::ShmState *Wrapper::shm_state()
@@ -27,6 +27,7 @@
 #include <lsp-plug.in/lltl/parray.h>
 #include <lsp-plug.in/plug-fw/core/SamplePlayer.h>
 #include <lsp-plug.in/plug-fw/core/ShmClient.h>
+#include <lsp-plug.in/plug-fw/core/SilenceDetector.h>
 #include <lsp-plug.in/plug-fw/plug.h>
 
 #include <lsp-plug.in/plug-fw/wrap/gstreamer/ports.h>
@@ -77,6 +78,7 @@ namespace lsp
                 ipc::Mutex                          sKVTMutex;          // Key-value tree lock mutex
                 core::SamplePlayer                 *pSamplePlayer;      // Sample player
                 core::ShmClient                    *pShmClient;         // Shared memory client
+                core::SilenceDetector              sSilence;            // Silence detector for processing suspend
 
             protected:
                 plug::IPort                        *create_port(lltl::parray<plug::IPort> *plugin_ports, const meta::port_t *port, const char *postfix);
@@ -50,8 +50,6 @@ namespace lsp
             atomic_store(&nDumpReq, 0);
             nDumpResp       = 0;
 
-            atomic_init(nLockMeters);
-
             pSamplePlayer   = NULL;
             pShmClient      = NULL;
 
@@ -131,8 +129,14 @@ namespace lsp
                 return STATUS_NO_MEM;
             vSortedPorts.qsort(cmp_port_identifiers);
 
+            // Allocate the set of dirty parameters, initially all parameters are dirty
+            if ((res = sDirtyParams.init(vParams.size())) != STATUS_OK)
+                return res;
+            sDirtyParams.mark_all();
+
             // Initialize plugin and UI
             pPlugin->init(this, plugin_ports.array());
+            sSilence.init(pPlugin, plugin_ports.array(), plugin_ports.size());
 
             // Create sample player if required
             if (meta->extensions & meta::E_FILE_PREVIEW)
@@ -354,7 +358,10 @@ namespace lsp
 
             // Now we ready for processing
             if (pPlugin != NULL)
+            {
                 pPlugin->activate();
+                sSilence.reset();
+            }
 
             // Activate JACK client
             if (jack_activate(pClient))
@@ -370,6 +377,8 @@ namespace lsp
 
         int Wrapper::run(size_t samples)
         {
+            const uint64_t block_ts = profile_begin();
+
             // Activate UI if present
             bool ui_active = bUIActive;
             if (ui_active != pPlugin->ui_active())
@@ -390,20 +399,7 @@ namespace lsp
             }
 
             // Check that input ports have been changed
-            for (size_t i=0, n=vParams.size(); i<n; ++i)
-            {
-                // Get port
-                jack::Port *port = vParams.uget(i);
-                if (port == NULL)
-                    continue;
-
-                // Pre-process data in port
-                if (port->sync())
-                {
-                    lsp_trace("port changed: %s", port->metadata()->id);
-                    bUpdateSettings = true;
-                }
-            }
+            sync_params();
 
             // Check that input parameters have changed
             if (bUpdateSettings)
@@ -411,7 +407,9 @@ namespace lsp
                 lsp_trace("updating settings");
                 if (pShmClient != NULL)
                     pShmClient->update_settings();
+                const uint64_t settings_ts = profile_begin();
                 pPlugin->update_settings();
+                profile_end(core::DSP_PROBE_SETTINGS, settings_ts, samples);
                 bUpdateSettings = false;
             }
 
@@ -426,19 +424,34 @@ namespace lsp
             if (pShmClient != NULL)
             {
                 pShmClient->begin(samples);
+                const uint64_t shm_ts = profile_begin();
                 pShmClient->pre_process(samples);
+                profile_end(core::DSP_PROBE_SHM_PRE, shm_ts, samples);
             }
 
             // Call the main processing unit
-            pPlugin->process(samples);
+            if (sSilence.idle(samples))
+                sSilence.silence(samples);
+            else
+            {
+                const uint64_t process_ts = profile_begin();
+                pPlugin->process(samples);
+                profile_end(core::DSP_PROBE_PROCESS, process_ts, samples);
+            }
 
             // Launch the sample player
             if (pSamplePlayer != NULL)
+            {
+                const uint64_t player_ts = profile_begin();
                 pSamplePlayer->process(samples);
+                profile_end(core::DSP_PROBE_SAMPLE_PLAYER, player_ts, samples);
+            }
 
             if (pShmClient != NULL)
             {
+                const uint64_t shm_ts = profile_begin();
                 pShmClient->post_process(samples);
+                profile_end(core::DSP_PROBE_SHM_POST, shm_ts, samples);
                 pShmClient->end();
             }
 
@@ -461,20 +474,55 @@ namespace lsp
             }
 
             // Commit meters
-            if (lock_meters())
+            for (size_t i=0, n=vMeters.size(); i<n; ++i)
             {
-                lsp_finally { unlock_meters(); };
-                for (size_t i=0, n=vMeters.size(); i<n; ++i)
-                {
-                    jack::MeterPort *mp = vMeters.uget(i);
-                    if (mp != NULL)
-                        mp->commit();
-                }
+                jack::MeterPort *mp = vMeters.uget(i);
+                if (mp != NULL)
+                    mp->commit();
             }
 
+            profile_end(core::DSP_PROBE_BLOCK, block_ts, samples);
+
             return 0;
         }
 
+        bool Wrapper::add_param(jack::Port *port)
+        {
+            const size_t index  = vParams.size();
+            if (!vParams.add(port))
+                return false;
+
+            port->set_param_index(index);
+            return true;
+        }
+
+        void Wrapper::mark_param_dirty(size_t index)
+        {
+            sDirtyParams.mark(index);
+        }
+
+        void Wrapper::sync_params()
+        {
+            // Nothing has been changed since the last call?
+            if (!sDirtyParams.begin())
+                return;
+
+            // Visit only ports marked as dirty
+            for (ssize_t index; (index = sDirtyParams.next()) >= 0; )
+            {
+                jack::Port *port    = vParams.get(index);
+                if (port == NULL)
+                    continue;
+
+                // Pre-process data in port
+                if (port->sync())
+                {
+                    lsp_trace("port changed: %s", port->metadata()->id);
+                    bUpdateSettings = true;
+                }
+            }
+        }
+
         status_t Wrapper::disconnect()
         {
             // Check connection state
@@ -527,6 +575,9 @@ namespace lsp
             // Disconnect
             disconnect();
 
+            // Destroy silence detector
+            sSilence.destroy();
+
             // Destroy sample player
             if (pSamplePlayer != NULL)
             {
@@ -554,6 +605,7 @@ namespace lsp
             }
             vParams.flush();
             vMeters.flush();
+            sDirtyParams.destroy();
             vAllPorts.flush();
             vSortedPorts.flush();
 
@@ -630,20 +682,20 @@ namespace lsp
 
                 case meta::R_PATH:
                     jp      = new jack::PathPort(port, this);
-                    vParams.add(jp);
+                    add_param(jp);
                     break;
 
                 case meta::R_STRING:
                 case meta::R_SEND_NAME:
                 case meta::R_RETURN_NAME:
                     jp      = new jack::StringPort(port, this);
-                    vParams.add(jp);
+                    add_param(jp);
                     break;
 
                 case meta::R_CONTROL:
                 case meta::R_BYPASS:
                     jp      = new jack::ControlPort(port, this);
-                    vParams.add(jp);
+                    add_param(jp);
                     break;
 
                 case meta::R_METER:
@@ -659,7 +711,7 @@ namespace lsp
                     LSPString postfix_str;
                     jack::PortGroup     *pg      = new jack::PortGroup(port, this);
                     pg->init();
-                    vParams.add(pg);
+                    add_param(pg);
                     vAllPorts.add(pg);
                     plugin_ports->add(pg);
 
@@ -763,11 +815,11 @@ namespace lsp
             if (pExecutor != NULL)
                 return pExecutor;
 
-            lsp_trace("Creating native executor service");
-            ipc::NativeExecutor *exec = new ipc::NativeExecutor();
+            lsp_trace("Creating shared executor service");
+            core::SharedExecutor *exec = new core::SharedExecutor();
             if (exec == NULL)
                 return NULL;
-            if (exec->start() != STATUS_OK)
+            if (exec->init() != STATUS_OK)
             {
                 delete exec;
                 return NULL;
@@ -989,84 +1041,7 @@ namespace lsp
                         continue;
                     }
 
-                    core::kvt_param_t kp;
-
-                    switch (param.type())
-                    {
-                        case config::SF_TYPE_I32:
-                            kp.type         = core::KVT_INT32;
-                            kp.i32          = param.v.i32;
-                            break;
-                        case config::SF_TYPE_U32:
-                            kp.type         = core::KVT_UINT32;
-                            kp.u32          = param.v.u32;
-                            break;
-                        case config::SF_TYPE_I64:
-                            kp.type         = core::KVT_INT64;
-                            kp.i64          = param.v.i64;
-                            break;
-                        case config::SF_TYPE_U64:
-                            kp.type         = core::KVT_UINT64;
-                            kp.u64          = param.v.u64;
-                            break;
-                        case config::SF_TYPE_F32:
-                            kp.type         = core::KVT_FLOAT32;
-                            kp.f32          = param.v.f32;
-                            break;
-                        case config::SF_TYPE_F64:
-                            kp.type         = core::KVT_FLOAT64;
-                            kp.f64          = param.v.f64;
-                            break;
-                        case config::SF_TYPE_BOOL:
-                            kp.type         = core::KVT_FLOAT32;
-                            kp.f32          = (param.v.bval) ? 1.0f : 0.0f;
-                            break;
-                        case config::SF_TYPE_STR:
-                            kp.type         = core::KVT_STRING;
-                            kp.str          = param.v.str;
-                            break;
-                        case config::SF_TYPE_BLOB:
-                            kp.type         = core::KVT_BLOB;
-                            kp.blob.size    = param.v.blob.length;
-                            kp.blob.ctype   = param.v.blob.ctype;
-                            kp.blob.data    = NULL;
-                            if (param.v.blob.data != NULL)
-                            {
-                                // Allocate memory
-                                size_t src_left = strlen(param.v.blob.data);
-                                size_t dst_left = 0x10 + param.v.blob.length;
-                                void *blob      = ::malloc(dst_left);
-                                if (blob != NULL)
-                                {
-                                    kp.blob.data    = blob;
-
-                                    // Decode
-                                    size_t n = dsp::base64_dec(blob, &dst_left, param.v.blob.data, &src_left);
-                                    if ((n != param.v.blob.length) || (src_left != 0))
-                                    {
-                                        ::free(blob);
-                                        kp.type         = core::KVT_ANY;
-                                        kp.blob.data    = NULL;
-                                    }
-                                }
-                                else
-                                    kp.type         = core::KVT_ANY;
-                            }
-                            break;
-                        default:
-                            kp.type         = core::KVT_ANY;
-                            break;
-                    }
-
-                    if (kp.type != core::KVT_ANY)
-                    {
-                        const char *id = param.name.get_utf8();
-                        kvt->put(id, &kp, core::KVT_RX);
-                    }
-
-                    // Free previously allocated data
-                    if ((kp.type == core::KVT_BLOB) && (kp.blob.data != NULL))
-                        free(const_cast<void *>(kp.blob.data));
+                    core::deserialize_kvt_param(kvt, &param, core::KVT_RX);
                 }
                 else
                 {
@@ -1121,33 +1096,7 @@ namespace lsp
                 case meta::R_CONTROL:
                 case meta::R_BYPASS:
                 {
-                    if (meta::is_discrete_unit(p->unit))
-                    {
-                        if (meta::is_bool_unit(p->unit))
-                            port->commit_value((param->to_bool()) ? 1.0f : 0.0f);
-                        else
-                            port->commit_value(param->to_int());
-                    }
-                    else
-                    {
-                        float v = param->to_float();
-
-                        // Decode decibels to values
-                        if ((meta::is_decibel_unit(p->unit)) && (param->is_decibel()))
-                        {
-                            if ((p->unit == meta::U_GAIN_AMP) || (p->unit == meta::U_GAIN_POW))
-                            {
-                                if (v < -250.0f)
-                                    v       = 0.0f;
-                                else if (v > 250.0f)
-                                    v       = (p->unit == meta::U_GAIN_AMP) ? dspu::db_to_gain(250.0f) : dspu::db_to_power(250.0f);
-                                else
-                                    v       = (p->unit == meta::U_GAIN_AMP) ? dspu::db_to_gain(v) : dspu::db_to_power(v);
-                            }
-                        }
-
-                        port->commit_value(v);
-                    }
+                    port->commit_value(core::deserialize_control_value(p, param));
                     break;
                 }
                 case meta::R_PATH:
@@ -1169,7 +1118,10 @@ namespace lsp
 
                     path_t *bpath = port->buffer<path_t>();
                     if (bpath != NULL)
+                    {
                         bpath->submit(value, flags);
+                        port->mark_dirty();
+                    }
                     break;
                 }
                 case meta::R_STRING:
@@ -1185,7 +1137,10 @@ namespace lsp
                     jack::StringPort *sp = static_cast<jack::StringPort *>(port);
                     plug::string_t *str = sp->data();
                     if (str != NULL)
+                    {
                         str->submit(value, false);
+                        port->mark_dirty();
+                    }
 
                     break;
                 }
@@ -1195,35 +1150,6 @@ namespace lsp
             return true;
         }
 
-        bool Wrapper::lock_meters()
-        {
-            for (size_t i=0; i<10; ++i)
-            {
-                if (atomic_trylock(nLockMeters))
-                    return true;
-            }
-
-            return false;
-        }
-
-        bool Wrapper::lock_meters_soft()
-        {
-            for (size_t i=0; i<10; ++i)
-            {
-                if (atomic_trylock(nLockMeters))
-                    return true;
-                if (i & 1)
-                    ipc::Thread::yield();
-            }
-
-            return false;
-        }
-
-        void Wrapper::unlock_meters()
-        {
-            atomic_unlock(nLockMeters);
-        }
-
         bool Wrapper::test_display_draw()
         {
             uatomic_t last      = atomic_load(&nQueryDrawReq);
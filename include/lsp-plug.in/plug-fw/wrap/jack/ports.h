@@ -28,6 +28,7 @@
 #include <lsp-plug.in/plug-fw/plug.h>
 
 #include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/atomic.h>
 #include <lsp-plug.in/common/status.h>
 #include <lsp-plug.in/stdlib/math.h>
 #include <lsp-plug.in/dsp/dsp.h>
@@ -51,11 +52,13 @@ namespace lsp
         {
             protected:
                 Wrapper         *pWrapper;
+                ssize_t          nParamIndex;       // Index in the list of input parameters, negative if not a parameter
 
             public:
                 explicit Port(const meta::port_t *meta, Wrapper *w): IPort(meta)
                 {
                     pWrapper        = w;
+                    nParamIndex     = -1;
                 }
 
                 Port(const Port &) = delete;
@@ -91,6 +94,27 @@ namespace lsp
                 virtual void commit_value(float value)
                 {
                 }
+
+            public:
+                inline void set_param_index(ssize_t index)
+                {
+                    nParamIndex     = index;
+                }
+
+                inline ssize_t param_index() const
+                {
+                    return nParamIndex;
+                }
+
+                /**
+                 * Notify the wrapper that the port has pending changes and should be
+                 * synchronized on the next processing cycle
+                 */
+                inline void mark_dirty()
+                {
+                    if (nParamIndex >= 0)
+                        pWrapper->mark_param_dirty(nParamIndex);
+                }
         };
 
         class DataPort: public Port
@@ -458,6 +482,7 @@ namespace lsp
                 virtual void commit_value(float value) override
                 {
                     fNewValue   = meta::limit_value(pMetadata, value);
+                    mark_dirty();
                 }
         };
 
@@ -490,6 +515,7 @@ namespace lsp
                 virtual void commit_value(float value) override
                 {
                     fNewValue   = lsp_limit(ssize_t(value), 0, ssize_t(nRows));
+                    mark_dirty();
                 }
 
             public:
@@ -499,16 +525,29 @@ namespace lsp
 
         class MeterPort: public Port
         {
+            private:
+                static constexpr uint32_t UI_EMPTY  = 0xffffffff;    // NaN pattern: no values committed since last UI read
+
+                typedef union bits_t
+                {
+                    float       f;
+                    uint32_t    u;
+                } bits_t;
+
             private:
                 float       fValue;
                 float       fUIValue;
+                uint32_t    nUIValue;       // Value (or peak) committed since last UI read, accessed atomically
                 bool        bForce;
 
             public:
                 explicit MeterPort(const meta::port_t *meta, Wrapper *w) : Port(meta, w)
                 {
+                    bits_t v;
                     fValue      = meta->start;
                     fUIValue    = fValue;
+                    v.f         = fValue;
+                    atomic_store(&nUIValue, v.u);
                     bForce      = true;
                 }
 
@@ -545,15 +584,48 @@ namespace lsp
                         fValue = value;
                 }
 
+                /**
+                 * Commit the value of the meter, called from the real-time thread. Peak meters
+                 * accumulate the peak since the last read by the UI, the UI can only reset the
+                 * accumulated value, so the update is retried only if the UI has read it concurrently.
+                 */
                 void commit()
                 {
-                    fUIValue        = fValue;
+                    bits_t v;
+                    v.f             = fValue;
                     bForce          = pMetadata->flags & meta::F_PEAK;
+
+                    if (!bForce)
+                    {
+                        atomic_store(&nUIValue, v.u);
+                        return;
+                    }
+
+                    while (true)
+                    {
+                        bits_t prev;
+                        prev.u          = atomic_load(&nUIValue);
+                        if ((prev.u != UI_EMPTY) && (fabsf(prev.f) >= fabsf(v.f)))
+                            return;
+                        if (atomic_cas(&nUIValue, prev.u, v.u))
+                            return;
+                    }
                 }
 
             public:
+                /**
+                 * Read the value of the meter and reset the accumulated peak, called from the UI thread
+                 * @return the value committed since last call or previous value if there were no commits
+                 */
                 float sync_value()
                 {
+                    bits_t v;
+                    v.u             = (pMetadata->flags & meta::F_PEAK) ?
+                                        atomic_swap(&nUIValue, UI_EMPTY) :
+                                        atomic_load(&nUIValue);
+                    if (v.u != UI_EMPTY)
+                        fUIValue        = v.f;
+
                     return fUIValue;
                 }
         };
@@ -742,7 +814,13 @@ namespace lsp
 
                 virtual bool sync() override
                 {
-                    return sPath.pending();
+                    // The path remains pending until the plugin accepts it, the request
+                    // also may be not fetched if the submitter currently holds the lock
+                    const bool pending  = sPath.pending();
+                    if ((pending) || (atomic_load(&sPath.nSerial) != sPath.nCommit))
+                        mark_dirty();
+
+                    return pending;
                 }
         };
 
@@ -783,7 +861,18 @@ namespace lsp
 
                 virtual bool sync() override
                 {
-                    return (pValue != NULL) ? pValue->sync() : false;
+                    if (pValue == NULL)
+                        return false;
+                    if (pValue->sync())
+                        return true;
+
+                    // The writer may have allocated the serial number but not published the value yet,
+                    // retry on the next cycle. The state restore bit is stored in the published serial only.
+                    const uint32_t request  = atomic_load(&pValue->nRequest);
+                    if ((request ^ pValue->serial()) & (~uint32_t(1)))
+                        mark_dirty();
+
+                    return false;
                 }
 
                 virtual float value() override
@@ -23,6 +23,7 @@
 #define LSP_PLUG_IN_PLUG_FW_WRAP_JACK_UI_PORTS_H_
 
 #include <lsp-plug.in/plug-fw/version.h>
+#include <lsp-plug.in/plug-fw/core/decimate.h>
 #include <lsp-plug.in/plug-fw/core/osc_buffer.h>
 #include <lsp-plug.in/plug-fw/wrap/jack/ports.h>
 #include <lsp-plug.in/plug-fw/ui.h>
@@ -178,11 +179,13 @@ namespace lsp
         {
             private:
                 plug::mesh_t   *pMesh;
+                size_t          nDisplayWidth;
 
             public:
                 explicit UIMeshPort(jack::Port *port): UIPort(port)
                 {
-                    pMesh       = jack::create_mesh(port->metadata());
+                    pMesh           = jack::create_mesh(port->metadata());
+                    nDisplayWidth   = 0;
                 }
 
                 UIMeshPort(const UIMeshPort &) = delete;
@@ -204,10 +207,10 @@ namespace lsp
                     if ((mesh == NULL) || (!mesh->containsData()))
                         return false;
 
-                    // Copy mesh data
-                    for (size_t i=0; i < mesh->nBuffers; ++i)
-                        dsp::copy_saturated(pMesh->pvData[i], mesh->pvData[i], mesh->nItems);
-                    pMesh->data(mesh->nBuffers, mesh->nItems);
+                    // Copy mesh data, reduce it to the display width if requested
+                    const size_t items = core::decimate_mesh_saturated(
+                        pMesh->pvData, mesh->pvData, mesh->nBuffers, mesh->nItems, nDisplayWidth);
+                    pMesh->data(mesh->nBuffers, items);
 
                     // Clean source mesh
                     mesh->cleanup();
@@ -218,6 +221,11 @@ namespace lsp
                 {
                     return pMesh;
                 }
+
+                virtual void set_display_width(size_t width) override
+                {
+                    nDisplayWidth   = lsp_max(nDisplayWidth, width);
+                }
         };
 
         class UIStreamPort: public UIPort
@@ -453,7 +461,10 @@ namespace lsp
 
                     // Submit path string to DSP
                     if (pPath != NULL)
+                    {
                         pPath->submit(sPath, flags);
+                        pPort->mark_dirty();
+                    }
                 }
 
                 virtual void set_default() override
@@ -519,6 +530,7 @@ namespace lsp
                     const size_t count = lsp_min(size, pValue->nCapacity);
                     plug::utf8_strncpy(pData, count, buffer, size);
                     nSerial = pValue->submit(buffer, size, flags & plug::PF_STATE_RESTORE);
+                    pPort->mark_dirty();
 
                     if (pManager != NULL)
                         pManager->mark_active_preset_dirty();
@@ -26,17 +26,19 @@
 #include <lsp-plug.in/plug-fw/plug.h>
 #include <lsp-plug.in/plug-fw/meta/func.h>
 #include <lsp-plug.in/plug-fw/meta/manifest.h>
+#include <lsp-plug.in/plug-fw/core/ChangeSet.h>
 #include <lsp-plug.in/plug-fw/core/config.h>
 #include <lsp-plug.in/plug-fw/core/KVTStorage.h>
 #include <lsp-plug.in/plug-fw/core/SamplePlayer.h>
+#include <lsp-plug.in/plug-fw/core/SharedExecutor.h>
 #include <lsp-plug.in/plug-fw/core/ShmClient.h>
+#include <lsp-plug.in/plug-fw/core/SilenceDetector.h>
 #include <lsp-plug.in/plug-fw/wrap/jack/factory.h>
 
 #include <lsp-plug.in/common/debug.h>
 #include <lsp-plug.in/stdlib/string.h>
 #include <lsp-plug.in/lltl/parray.h>
 #include <lsp-plug.in/ipc/IExecutor.h>
-#include <lsp-plug.in/ipc/NativeExecutor.h>
 #include <lsp-plug.in/ipc/Mutex.h>
 #include <lsp-plug.in/dsp-units/units.h>
 
@@ -109,10 +111,11 @@ namespace lsp
                 uatomic_t                       nQueryDrawResp;     // QueryDraw response
                 uatomic_t                       nDumpReq;           // Dump state to file request
                 uatomic_t                       nDumpResp;          // Dump state to file response
-                uatomic_t                       nLockMeters;        // Meters lock
+                core::ChangeSet                 sDirtyParams;       // Set of input parameters with pending changes
 
                 core::SamplePlayer             *pSamplePlayer;      // Sample player
                 core::ShmClient                *pShmClient;         // Shared memory client
+                core::SilenceDetector          sSilence;            // Silence detector for processing suspend
 
                 lltl::parray<jack::Port>        vAllPorts;          // All ports
                 lltl::parray<jack::Port>        vParams;            // All input parameters
@@ -126,6 +129,8 @@ namespace lsp
 
             protected:
                 void            create_port(lltl::parray<plug::IPort> *plugin_ports, const meta::port_t *port, const char *postfix);
+                bool            add_param(jack::Port *port);
+                void            sync_params();
                 int             sync_position(jack_transport_state_t state, const jack_position_t *pos);
                 int             latency_callback(jack_latency_callback_mode_t mode);
                 int             run(size_t samples);
@@ -179,9 +184,7 @@ namespace lsp
                 void                                set_routing(const lltl::darray<connection_t> *routing);
                 status_t                            disconnect();
 
-                bool                                lock_meters();
-                bool                                lock_meters_soft();
-                void                                unlock_meters();
+                void                                mark_param_dirty(size_t index);
 
                 jack::Port                         *port_by_id(const char *id);
                 jack::Port                         *port_by_idx(size_t index);
@@ -126,6 +126,7 @@ namespace lsp
             // Initialize plugin
             lsp_trace("Initializing plugin");
             pPlugin->init(this, plugin_ports.array());
+            sSilence.init(pPlugin, plugin_ports.array(), plugin_ports.size());
             pPlugin->set_sample_rate(sr);
             bUpdateSettings = true;
 
@@ -153,6 +154,9 @@ namespace lsp
             vMeters.flush();
             vExtPorts.flush();
 
+            // Destroy silence detector
+            sSilence.destroy();
+
             // Delete plugin
             if (pPlugin != NULL)
             {
@@ -286,6 +290,7 @@ namespace lsp
             sPosition.frame     = 0;
             sNewPosition.frame  = 0;
             pPlugin->activate();
+            sSilence.reset();
         }
 
         inline void Wrapper::connect(size_t id, void *data)
@@ -299,6 +304,8 @@ namespace lsp
 
         inline void Wrapper::run(size_t samples)
         {
+            const uint64_t block_ts = profile_begin();
+
             // Emulate the behaviour of position
             if (pPlugin->set_position(&sNewPosition))
                 bUpdateSettings = true;
@@ -334,7 +341,9 @@ namespace lsp
             if (bUpdateSettings)
             {
                 lsp_trace("updating settings");
+                const uint64_t settings_ts = profile_begin();
                 pPlugin->update_settings();
+                profile_end(core::DSP_PROBE_SETTINGS, settings_ts, samples);
                 bUpdateSettings     = false;
             }
 
@@ -360,7 +369,14 @@ namespace lsp
                 }
 
                 // Process samples
-                pPlugin->process(to_process);
+                if (sSilence.idle(to_process))
+                    sSilence.silence(to_process);
+                else
+                {
+                    const uint64_t process_ts = profile_begin();
+                    pPlugin->process(to_process);
+                    profile_end(core::DSP_PROBE_PROCESS, process_ts, to_process);
+                }
 
                 // Sanitize output data
                 for (size_t i=0, n=vAudioIn.size(); i < n; ++i)
@@ -406,6 +422,8 @@ namespace lsp
             size_t spb          = sNewPosition.sampleRate / sNewPosition.beatsPerMinute; // samples per beat
             sNewPosition.frame += samples;
             sNewPosition.tick   = ((sNewPosition.frame % spb) * sNewPosition.ticksPerBeat) / spb;
+
+            profile_end(core::DSP_PROBE_BLOCK, block_ts, samples);
         }
 
         inline void Wrapper::deactivate()
@@ -415,12 +433,19 @@ namespace lsp
 
         ipc::IExecutor *Wrapper::executor()
         {
-            if (pExecutor == NULL)
+            if (pExecutor != NULL)
+                return pExecutor;
+
+            lsp_trace("Creating shared executor service");
+            core::SharedExecutor *exec = new core::SharedExecutor();
+            if (exec == NULL)
+                return NULL;
+            if (exec->init() != STATUS_OK)
             {
-                lsp_trace("Creating native executor service");
-                pExecutor       = new ipc::NativeExecutor();
+                delete exec;
+                return NULL;
             }
-            return pExecutor;
+            return pExecutor = exec;
         }
 
         const meta::package_t *Wrapper::package() const
@@ -27,10 +27,12 @@
 #include <lsp-plug.in/plug-fw/meta/func.h>
 #include <lsp-plug.in/plug-fw/meta/manifest.h>
 #include <lsp-plug.in/plug-fw/plug.h>
+#include <lsp-plug.in/plug-fw/core/SharedExecutor.h>
+#include <lsp-plug.in/plug-fw/core/SilenceDetector.h>
 #include <lsp-plug.in/common/status.h>
 #include <lsp-plug.in/common/debug.h>
 #include <lsp-plug.in/lltl/parray.h>
-#include <lsp-plug.in/ipc/NativeExecutor.h>
+#include <lsp-plug.in/ipc/IExecutor.h>
 #include <lsp-plug.in/resource/ILoader.h>
 
 #include <ladspa/ladspa.h>
@@ -61,6 +63,7 @@ namespace lsp
                 bool                                bUpdateSettings;    // Settings update flag
                 plug::position_t                    sNewPosition;       // New position
                 meta::package_t                    *pPackage;           // Package descriptor
+                core::SilenceDetector               sSilence;           // Silence detector for processing suspend
 
             protected:
                 ladspa::Port                       *create_port(lltl::parray<plug::IPort> *plugin_ports, const meta::port_t *port);
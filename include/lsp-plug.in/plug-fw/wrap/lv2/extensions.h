@@ -206,6 +206,8 @@ namespace lsp
                 LV2_URID                uridMeshItems;
                 LV2_URID                uridMeshDimensions;
                 LV2_URID                uridMeshData;
+                LV2_URID                uridMeshDelta;              // Delta-encoded mesh data
+                LV2_URID                uridMeshDisplayWidth;       // Display width request for mesh ports
                 LV2_URID                uridFrameBufferType;
                 LV2_URID                uridFrameBufferRows;        // Number of rows
                 LV2_URID                uridFrameBufferCols;        // Number of cols
@@ -406,6 +408,8 @@ namespace lsp
                     uridMeshItems               = map_field("Mesh", "items");
                     uridMeshDimensions          = map_field("Mesh", "dimensions");
                     uridMeshData                = map_field("Mesh", "data");
+                    uridMeshDelta               = map_field("Mesh", "delta");
+                    uridMeshDisplayWidth        = map_type("MeshDisplayWidth");
 
                     uridFrameBufferType         = map_type_legacy("FrameBuffer");
                     uridFrameBufferRows         = map_field("FrameBuffer", "rows");
@@ -682,6 +686,14 @@ namespace lsp
                     return lv2_atom_forge_raw(&forge, data, size);
                 }
 
+                inline LV2_Atom_Forge_Ref forge_chunk(const void *data, size_t size)
+                {
+                    const LV2_Atom_Forge_Ref ref = lv2_atom_forge_atom(&forge, size, forge.Chunk);
+                    if ((ref) && (size > 0))
+                        lv2_atom_forge_write(&forge, data, size);
+                    return ref;
+                }
+
                 inline LV2_Atom_Forge_Ref forge_primitive(const LV2_Atom *atom)
                 {
                     return lv2_atom_forge_primitive(&forge, atom);
@@ -947,6 +959,25 @@ namespace lsp
                     return true;
                 }
 
+                bool ui_write_mesh_display_width(lv2::Serializable *p, size_t width)
+                {
+                    if ((map == NULL) || (p->get_urid() <= 0))
+                        return false;
+
+                    // Forge display width request message
+                    LV2_Atom_Forge_Frame    frame;
+                    forge_set_buffer(pBuffer, nBufSize);
+
+                    forge_frame_time(0);
+                    LV2_Atom *msg = forge_object(&frame, uridChunk, uridMeshDisplayWidth);
+                    forge_key(p->get_urid());
+                    forge_int(int32_t(width));
+                    forge_pop(&frame);
+
+                    write_data(nAtomOut, lv2_atom_total_size(msg), uridEventTransfer, msg);
+                    return true;
+                }
+
                 bool ui_play_sample(const char *name, wsize_t position, bool release)
                 {
                     if (map == NULL)
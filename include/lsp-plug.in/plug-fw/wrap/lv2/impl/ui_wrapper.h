@@ -1001,63 +1001,47 @@ namespace lsp
 
         void UIWrapper::receive_kvt_state()
         {
-            lv2::Wrapper *w = pExt->wrapper();
-            if (w == NULL)
-                return;
-
             // Obtain the dispatcher
             core::KVTDispatcher *d = (pExt->wrapper() != NULL) ? pExt->wrapper()->kvt_dispatcher() : NULL;
             if (d == NULL)
                 return;
-            if (d->tx_size() <= 0) // Is there data for transfer?
-                return;
 
-            core::KVTStorage *skvt = w->kvt_trylock();
-            if (skvt == NULL)
+            // The dispatcher publishes changes of the DSP KVT to the transmission queue which
+            // is read without locking the DSP KVT storage. The DSP may read the same queue
+            // for other clients, so obtain exclusive access to the queue first.
+            if (!d->tx_trylock())
                 return;
+            lsp_finally { d->tx_unlock(); };
 
-            size_t size;
-            if (sKVTMutex.lock())
+            osc::packet_t packet;
+
+            while (true)
             {
-                status_t res;
+                // Parse the packet directly in the buffer
+                status_t res = d->peek(&packet);
 
-                do
+                switch (res)
                 {
-                    // Try to fetch record from buffer
-                    res = d->fetch(pOscBuffer, &size, OSC_PACKET_MAX);
-
-                    switch (res)
+                    case STATUS_OK:
                     {
-                        case STATUS_OK:
-                        {
-                            lsp_trace("Fetched OSC packet of %d bytes", int(size));
-                            osc::dump_packet(pOscBuffer, size);
-                            core::KVTDispatcher::parse_message(&sKVT, pOscBuffer, size, core::KVT_TX);
-                            break;
-                        }
-
-                        case STATUS_NO_DATA: // No more data to transmit
-                            break;
+                        lsp_trace("Fetched OSC packet of %d bytes", int(packet.size));
+                        osc::dump_packet(&packet);
+                        core::KVTDispatcher::parse_message(&sKVT, &packet, core::KVT_TX);
+                        d->release();
+                        break;
+                    }
 
-                        case STATUS_OVERFLOW:
-                        {
-                            lsp_warn("Too large OSC packet in the buffer, skipping");
-                            d->skip();
-                            break;
-                        }
+                    case STATUS_NO_DATA: // No more data to transmit
+                        return;
 
-                        default:
-                        {
-                            lsp_warn("OSC packet parsing error %d, skipping", int(res));
-                            d->skip();
-                            break;
-                        }
+                    default:
+                    {
+                        lsp_warn("OSC packet parsing error %d, skipping", int(res));
+                        d->skip();
+                        return;
                     }
-                } while (res != STATUS_NO_DATA);
-
-                sKVTMutex.unlock();
+                }
             }
-            w->kvt_release();
         }
 
         void UIWrapper::sync_kvt_state()
@@ -23,6 +23,7 @@
 #define LSP_PLUG_IN_PLUG_FW_WRAP_LV2_IMPL_WRAPPER_H_
 
 #include <lsp-plug.in/plug-fw/version.h>
+#include <lsp-plug.in/plug-fw/core/KVTSnapshot.h>
 #include <lsp-plug.in/plug-fw/core/osc_buffer.h>
 #include <lsp-plug.in/plug-fw/wrap/lv2/wrapper.h>
 #include <lsp-plug.in/plug-fw/meta/manifest.h>
@@ -40,17 +41,26 @@ namespace lsp
         //---------------------------------------------------------------------
         void Wrapper::LV2KVTListener::created(core::KVTStorage *storage, const char *id, const core::kvt_param_t *param, size_t pending)
         {
-            pWrapper->state_changed();
+            if (!(pending & core::KVT_BATCH))
+                pWrapper->state_changed();
         }
 
         void Wrapper::LV2KVTListener::changed(core::KVTStorage *storage, const char *id, const core::kvt_param_t *oval, const core::kvt_param_t *nval, size_t pending)
         {
-            pWrapper->state_changed();
+            if (!(pending & core::KVT_BATCH))
+                pWrapper->state_changed();
         }
 
         void Wrapper::LV2KVTListener::removed(core::KVTStorage *storage, const char *id, const core::kvt_param_t *param, size_t pending)
         {
-            pWrapper->state_changed();
+            if (!(pending & core::KVT_BATCH))
+                pWrapper->state_changed();
+        }
+
+        void Wrapper::LV2KVTListener::transaction(core::KVTStorage *storage, size_t changes)
+        {
+            if (changes > 0)
+                pWrapper->state_changed();
         }
 
         //---------------------------------------------------------------------
@@ -86,7 +96,6 @@ namespace lsp
             bStateManage    = false;
             bSendPreset     = false;
             fSampleRate     = DEFAULT_SAMPLE_RATE;
-            pOscPacket      = reinterpret_cast<uint8_t *>(::malloc(OSC_PACKET_MAX));
             atomic_store(&nStateMode, SM_LOADING);
             atomic_store(&nDumpReq, 0);
             nDumpResp       = 0;
@@ -240,6 +249,7 @@ namespace lsp
             // Initialize plugin
             lsp_trace("Initializing plugin");
             pPlugin->init(this, plugin_ports.array());
+            sSilence.init(pPlugin, plugin_ports.array(), plugin_ports.size());
             pPlugin->set_sample_rate(srate);
             bUpdateSettings     = true;
 
@@ -279,6 +289,9 @@ namespace lsp
 
         void Wrapper::do_destroy()
         {
+            // Destroy silence detector
+            sSilence.destroy();
+
             // Destroy sample player
             if (pSamplePlayer != NULL)
             {
@@ -300,6 +313,7 @@ namespace lsp
             {
                 lsp_trace("Stopping KVT dispatcher thread...");
                 pKVTDispatcher->cancel();
+                pKVTDispatcher->wakeup();
                 pKVTDispatcher->join();
                 delete pKVTDispatcher;
 
@@ -358,13 +372,6 @@ namespace lsp
             vFrameBufferPorts.flush();
             vGenMetadata.flush();
 
-            // Delete temporary buffer for OSC serialization
-            if (pOscPacket != NULL)
-            {
-                ::free(pOscPacket);
-                pOscPacket = NULL;
-            }
-
             // Drop extensions
             if (pExt != NULL)
             {
@@ -682,6 +689,8 @@ namespace lsp
 
         void Wrapper::run(size_t samples)
         {
+            const uint64_t block_ts = profile_begin();
+
             // Activate/deactivate the UI
             ssize_t clients = nClients + nDirectClients;
             if (clients > 0)
@@ -722,7 +731,9 @@ namespace lsp
             // Check that input parameters have changed
             if (bUpdateSettings)
             {
+                const uint64_t settings_ts = profile_begin();
                 pPlugin->update_settings();
+                profile_end(core::DSP_PROBE_SETTINGS, settings_ts, samples);
                 if (pShmClient != NULL)
                     pShmClient->update_settings();
                 bUpdateSettings     = false;
@@ -736,6 +747,9 @@ namespace lsp
                 nDumpResp           = dump_req;
             }
 
+            // The host may process data in place, such inputs can not be passed to the plugin as is
+            detect_aliased_inputs();
+
             // Call the main processing unit (split data buffers into chunks not greater than MaxBlockLength)
             size_t n_audio_ports = vAudioPorts.size();
             for (size_t off=0; off < samples; )
@@ -745,7 +759,9 @@ namespace lsp
                 if (pShmClient != NULL)
                 {
                     pShmClient->begin(to_process);
+                    const uint64_t shm_ts = profile_begin();
                     pShmClient->pre_process(to_process);
+                    profile_end(core::DSP_PROBE_SHM_PRE, shm_ts, to_process);
                 }
 
                 // Sanitize input data
@@ -756,9 +772,20 @@ namespace lsp
                         port->sanitize_before(off, to_process);
                 }
                 // Process samples
-                pPlugin->process(to_process);
+                if (sSilence.idle(to_process))
+                    sSilence.silence(to_process);
+                else
+                {
+                    const uint64_t process_ts = profile_begin();
+                    pPlugin->process(to_process);
+                    profile_end(core::DSP_PROBE_PROCESS, process_ts, to_process);
+                }
                 if (pSamplePlayer != NULL)
+                {
+                    const uint64_t player_ts = profile_begin();
                     pSamplePlayer->process(to_process);
+                    profile_end(core::DSP_PROBE_SAMPLE_PLAYER, player_ts, to_process);
+                }
                 // Sanitize output data
                 for (size_t i=0; i<n_audio_ports; ++i)
                 {
@@ -769,7 +796,9 @@ namespace lsp
 
                 if (pShmClient != NULL)
                 {
+                    const uint64_t shm_ts = profile_begin();
                     pShmClient->post_process(to_process);
+                    profile_end(core::DSP_PROBE_SHM_POST, shm_ts, to_process);
                     pShmClient->end();
                 }
 
@@ -806,6 +835,8 @@ namespace lsp
 
                 *pLatency   = latency;
             }
+
+            profile_end(core::DSP_PROBE_BLOCK, block_ts, samples);
         }
 
         void Wrapper::clear_midi_ports()
@@ -822,6 +853,26 @@ namespace lsp
             }
         }
 
+        void Wrapper::detect_aliased_inputs()
+        {
+            for (size_t i=0, n=vAudioPorts.size(); i<n; ++i)
+            {
+                lv2::AudioPort *in  = vAudioPorts.uget(i);
+                if ((in == NULL) || (!meta::is_in_port(in->metadata())))
+                    continue;
+
+                const float *data   = in->data();
+                bool aliased        = false;
+                for (size_t j=0; (j<n) && (!aliased) && (data != NULL); ++j)
+                {
+                    lv2::AudioPort *out = vAudioPorts.uget(j);
+                    aliased             = (out != NULL) && (meta::is_out_port(out->metadata())) && (out->data() == data);
+                }
+
+                in->set_aliased(aliased);
+            }
+        }
+
         void Wrapper::receive_midi_event(const LV2_Atom_Event *ev)
         {
             // Are there any MIDI input ports in plugin?
@@ -1048,6 +1099,23 @@ namespace lsp
                     }
                 }
             }
+            else if (obj->body.otype == pExt->uridMeshDisplayWidth) // Display width request for mesh ports
+            {
+                for (
+                    LV2_Atom_Property_Body *body = lv2_atom_object_begin(&obj->body) ;
+                    !lv2_atom_object_is_end(&obj->body, obj->atom.size, body) ;
+                    body = lv2_atom_object_next(body)
+                )
+                {
+                    lv2::Port *p    = port_by_urid(body->key);
+                    if ((p == NULL) || (!meta::is_mesh_port(p->metadata())) || (body->value.type != pExt->forge.Int))
+                        continue;
+
+                    const int32_t width = (reinterpret_cast<const LV2_Atom_Int *>(&body->value))->body;
+                    lsp_trace("mesh id=%s, display width=%d", p->metadata()->id, int(width));
+                    static_cast<lv2::MeshPort *>(p)->set_display_width(lsp_max(width, 0));
+                }
+            }
             else if (obj->body.otype == pExt->uridTimePosition) // Time position notification
             {
                 plug::position_t pos    = sPosition;
@@ -1123,6 +1191,14 @@ namespace lsp
                     if (pKVTDispatcher != NULL)
                         pKVTDispatcher->disconnect_client();
                     lsp_trace("UI has disconnected, current number of clients=%d", int(nClients));
+
+                    // Notify all ports that UI has disconnected from backend
+                    for (size_t i=0, n = vAllPorts.size(); i<n; ++i)
+                    {
+                        lv2::Port *p = vAllPorts.get(i);
+                        if (p != NULL)
+                            p->ui_disconnected();
+                    }
                 }
                 else if (obj->body.id == pExt->uridDumpState)
                 {
@@ -1394,19 +1470,17 @@ namespace lsp
             }
         }
 
-        void Wrapper::transmit_port_data_to_clients(bool sync_req)
+        void Wrapper::transmit_port_data_to_clients(bool sync)
         {
             // Serialize time/position of plugin
             LV2_Atom_Forge_Frame    frame;
 
             // Serialize meshes (it's own primitive MESH)
-            for (size_t i=0, n=vMeshPorts.size(); i<n; ++i)
+            for (size_t i=0, n=(sync) ? vMeshPorts.size() : 0; i<n; ++i)
             {
                 lv2::Port *p = vMeshPorts[i];
                 if (p == NULL)
                     continue;
-                if ((!sync_req) && (!p->tx_pending()))
-                    continue;
                 plug::mesh_t *mesh  = p->buffer<plug::mesh_t>();
                 if ((mesh == NULL) || (!mesh->containsData()))
                     continue;
@@ -1425,7 +1499,7 @@ namespace lsp
             for (size_t i=0, n=vStreamPorts.size(); i<n; ++i)
             {
                 lv2::Port *p = vStreamPorts[i];
-                if ((p == NULL) || (!p->tx_pending()))
+                if ((p == NULL) || (!((sync) ? p->tx_pending() : p->tx_backlog())))
                     continue;
                 plug::stream_t *s = p->buffer<plug::stream_t>();
                 if (s == NULL)
@@ -1441,7 +1515,7 @@ namespace lsp
             for (size_t i=0, n=vFrameBufferPorts.size(); i<n; ++i)
             {
                 lv2::Port *p = vFrameBufferPorts[i];
-                if ((p == NULL) || (!p->tx_pending()))
+                if ((p == NULL) || (!((sync) ? p->tx_pending() : p->tx_backlog())))
                     continue;
                 plug::frame_buffer_t *fb= p->buffer<plug::frame_buffer_t>();
                 if (fb == NULL)
@@ -1532,40 +1606,43 @@ namespace lsp
             if (pKVTDispatcher == NULL)
                 return;
 
+            // The queue may be read by the directly connected UI, skip the transfer if it is busy
+            if (!pKVTDispatcher->tx_trylock())
+                return;
+            lsp_finally { pKVTDispatcher->tx_unlock(); };
+
             LV2_Atom atom;
-            size_t size;
+            osc::packet_t packet;
 
             while (true)
             {
-                status_t res = pKVTDispatcher->fetch(pOscPacket, &size, OSC_PACKET_MAX);
+                // Forge the packet directly from the buffer
+                status_t res = pKVTDispatcher->peek(&packet);
 
                 switch (res)
                 {
                     case STATUS_OK:
                     {
-                        lsp_trace("Transmitting OSC packet of %d bytes", int(size));
-                        osc::dump_packet(pOscPacket, size);
+                        lsp_trace("Transmitting OSC packet of %d bytes", int(packet.size));
+                        osc::dump_packet(&packet);
 
-                        atom.size       = size;
+                        atom.size       = packet.size;
                         atom.type       = pExt->uridOscRawPacket;
 
                         pExt->forge_frame_time(0);
                         pExt->forge_raw(&atom, sizeof(LV2_Atom));
-                        pExt->forge_raw(pOscPacket, size);
-                        pExt->forge_pad(sizeof(LV2_Atom) + size);
+                        pExt->forge_raw(packet.data, packet.size);
+                        pExt->forge_pad(sizeof(LV2_Atom) + packet.size);
+                        pKVTDispatcher->release();
                         break;
                     }
 
-                    case STATUS_OVERFLOW:
-                        lsp_warn("Received too big OSC packet, skipping");
-                        pKVTDispatcher->skip();
-                        break;
-
                     case STATUS_NO_DATA:
                         return;
 
                     default:
-                        lsp_warn("Received error while deserializing KVT changes: %d", int(res));
+                        lsp_warn("Received error while deserializing KVT changes: %d, skipping", int(res));
+                        pKVTDispatcher->skip();
                         return;
                 }
             }
@@ -1679,6 +1756,11 @@ namespace lsp
                 transmit_port_state(state_req);
                 transmit_kvt_events();
                 transmit_time_position_to_clients();
+
+                // Transmit the latest state of data ports once per UI refresh period, intermediate
+                // states are coalesced by the ports. Streams and frame buffers which have more pending
+                // frames or rows than fit into a single message are transmitted on each block until
+                // they catch up, so the size of the atom output buffer is not exceeded.
                 transmit_port_data_to_clients(sync_req);
             }
 
@@ -1779,46 +1861,39 @@ namespace lsp
             if (osc == NULL)  // There are no events ?
                 return;
 
-            size_t size;
+            osc::packet_t packet;
             LV2_Atom atom;
 
             while (true)
             {
-                // Try to fetch record from buffer
-                status_t res = osc->fetch(pOscPacket, &size, OSC_PACKET_MAX);
+                // Try to peek record from buffer, it is forged without intermediate copying
+                status_t res = osc->peek(&packet);
 
                 switch (res)
                 {
                     case STATUS_OK:
                     {
-                        lsp_trace("Transmitting OSC packet of %d bytes", int(size));
-                        osc::dump_packet(pOscPacket, size);
+                        lsp_trace("Transmitting OSC packet of %d bytes", int(packet.size));
+                        osc::dump_packet(&packet);
 
-                        atom.size       = size;
+                        atom.size       = packet.size;
                         atom.type       = pExt->uridOscRawPacket;
 
                         pExt->forge_frame_time(0);
                         pExt->forge_raw(&atom, sizeof(LV2_Atom));
-                        pExt->forge_raw(pOscPacket, size);
-                        pExt->forge_pad(sizeof(LV2_Atom) + size);
+                        pExt->forge_raw(packet.data, packet.size);
+                        pExt->forge_pad(sizeof(LV2_Atom) + packet.size);
+                        osc->release();
                         break;
                     }
 
                     case STATUS_NO_DATA: // No more data to transmit
                         return;
 
-                    case STATUS_OVERFLOW:
-                    {
-                        lsp_warn("Too large OSC packet in the buffer, skipping");
-                        osc->skip();
-                        break;
-                    }
-
                     default:
                     {
-                        lsp_warn("OSC packet parsing error %d, skipping", int(res));
-                        osc->skip();
-                        break;
+                        lsp_warn("OSC buffer is in inconsistent state: error %d", int(res));
+                        return;
                     }
                 }
             }
@@ -1827,190 +1902,17 @@ namespace lsp
 
         void Wrapper::save_kvt_parameters()
         {
-            const core::kvt_param_t *p;
-
-            status_t res    = STATUS_OK;
-
-            // We should use our own forge to prevent from race condition
-            LV2_Atom_Forge forge;
-            LV2_Atom_Forge_Frame frame;
-            lv2::lv2_sink   sink(0x100);
-
-            // Initialize sink
-            lv2_atom_forge_init(&forge, pExt->map);
-            lv2_atom_forge_set_sink(&forge, lv2_sink::sink, lv2_sink::deref, &sink);
-            lv2_atom_forge_tuple(&forge, &frame);
-
-            // Read the whole KVT storage
-            core::KVTIterator *it = sKVT.enum_all();
-            while (it->next() == STATUS_OK)
-            {
-                res             = it->get(&p);
-                if (res == STATUS_NOT_FOUND) // Not a parameter
-                    continue;
-                else if (res != STATUS_OK)
-                {
-                    lsp_warn("it->get() returned %d", int(res));
-                    break;
-                }
-                else if (it->is_transient()) // Skip transient parameters
-                    continue;
-
-                int flags       = 0;
-                if (it->is_private())
-                    flags          |= LSP_LV2_PRIVATE;
-
-                const char *name = it->name();
-                if (name == NULL)
-                {
-                    lsp_trace("it->name() returned NULL");
-                    break;
-                }
-
-                kvt_dump_parameter("Saving state of KVT parameter: %s = ", p, name);
-
-                LV2_Atom_Forge_Frame prop;
-                lv2_atom_forge_object(&forge, &prop, 0, pExt->uridKvtEntryType);
-
-                // Key
-                lv2_atom_forge_key(&forge, pExt->uridKvtEntryKey);
-                lv2_atom_forge_string(&forge, name, strlen(name));
-
-                // Value
-                switch (p->type)
-                {
-                    case core::KVT_INT32:
-                    case core::KVT_UINT32:
-                    {
-                        LV2_Atom_Int v;
-                        v.atom.type     = (p->type == core::KVT_INT32) ? pExt->forge.Int : pExt->uridTypeUInt;
-                        v.atom.size     = sizeof(v) - sizeof(LV2_Atom);
-                        v.body          = p->i32;
-
-                        lv2_atom_forge_key(&forge, pExt->uridKvtEntryValue);
-                        lv2_atom_forge_primitive(&forge, &v.atom);
-                        break;
-                    }
-
-                    case core::KVT_INT64:
-                    case core::KVT_UINT64:
-                    {
-                        LV2_Atom_Long v;
-                        v.atom.type     = (p->type == core::KVT_INT64) ? pExt->forge.Long : pExt->uridTypeULong;
-                        v.atom.size     = sizeof(v) - sizeof(LV2_Atom);
-                        v.body          = p->i64;
-                        lv2_atom_forge_key(&forge, pExt->uridKvtEntryValue);
-                        lv2_atom_forge_primitive(&forge, &v.atom);
-                        break;
-                    }
-                    case core::KVT_FLOAT32:
-                    {
-                        LV2_Atom_Float v;
-                        v.atom.type     = pExt->forge.Float;
-                        v.atom.size     = sizeof(v) - sizeof(LV2_Atom);
-                        v.body          = p->f32;
-                        lv2_atom_forge_key(&forge, pExt->uridKvtEntryValue);
-                        lv2_atom_forge_primitive(&forge, &v.atom);
-                        break;
-                    }
-                    case core::KVT_FLOAT64:
-                    {
-                        LV2_Atom_Double v;
-                        v.atom.type     = pExt->forge.Double;
-                        v.atom.size     = sizeof(v) - sizeof(LV2_Atom);
-                        v.body          = p->f64;
-                        lv2_atom_forge_key(&forge, pExt->uridKvtEntryValue);
-                        lv2_atom_forge_primitive(&forge, &v.atom);
-                        break;
-                    }
-                    case core::KVT_STRING:
-                    {
-                        lv2_atom_forge_key(&forge, pExt->uridKvtEntryValue);
-                        const char *str = (p->str != NULL) ? p->str : "";
-                        lv2_atom_forge_typed_string(&forge, forge.String, str, ::strlen(str));
-                        break;
-                    }
-                    case core::KVT_BLOB:
-                    {
-                        LV2_Atom_Forge_Frame obj;
-
-                        lv2_atom_forge_key(&forge, pExt->uridKvtEntryValue);
-                        lv2_atom_forge_object(&forge, &obj, 0, pExt->uridBlobType);
-                        {
-                            if (p->blob.ctype != NULL)
-                            {
-                                lv2_atom_forge_key(&forge, pExt->uridContentType);
-                                lv2_atom_forge_typed_string(&forge, forge.String, p->blob.ctype, ::strlen(p->blob.ctype));
-                            }
-
-                            uint32_t size = ((p->blob.size > 0) && (p->blob.data != NULL)) ? p->blob.size : 0;
-                            lv2_atom_forge_key(&forge, pExt->uridContent);
-                            lv2_atom_forge_atom(&forge, size, forge.Chunk);
-                            if (size > 0)
-                                lv2_atom_forge_write(&forge, p->blob.data, size);
-                        }
-                        lv2_atom_forge_pop(&forge, &obj);
-                        break;
-                    }
-
-                    default:
-                        lsp_warn("Invalid KVT property type: %d", int(p->type));
-                        res     = STATUS_BAD_TYPE;
-                        break;
-                }
-
-                // Flags
-                lv2_atom_forge_key(&forge, pExt->uridKvtEntryFlags);
-                lv2_atom_forge_int(&forge, flags);
-
-                // End of object
-                lv2_atom_forge_pop(&forge, &prop);
-
-                // Successful status?
-                if (res != STATUS_OK)
-                    break;
-            } // while
-
-            if ((res != STATUS_OK) ||(sink.res != STATUS_OK))
+            // Serialize all KVT parameters as a single chunk
+            core::KVTSnapshot snapshot;
+            status_t res = snapshot.save(&sKVT);
+            if (res != STATUS_OK)
             {
-                lsp_trace("Failed execution, result=%d, sink state=%d", int(res), int(sink.res));
+                lsp_warn("Error serializing KVT snapshot, code=%d", int(res));
                 return;
             }
 
-            lsp_trace("Generated memory chunk of %d bytes, capacity is %d bytes", int(sink.size), int(sink.cap));
-
-            // TEST
-            /*{
-                kvt_param_t xp;
-                xp.blob.ctype   = "text/plain";
-                xp.blob.data    = "Test text";
-                xp.blob.size    = strlen("Test text") + 1;
-                p = &xp;
-
-                LV2_Atom_Forge_Frame obj;
-                LV2_URID key        =  pExt->map_kvt("/TEST_BLOB");
-
-                lv2_atom_forge_key(&forge, key);
-                lv2_atom_forge_object(&forge, &obj, 0, pExt->uridBlobType);
-                {
-                    if (p->blob.ctype != NULL)
-                    {
-                        lv2_atom_forge_key(&forge, pExt->uridContentType);
-                        lv2_atom_forge_typed_string(&forge, forge.String, p->blob.ctype, ::strlen(p->blob.ctype));
-                    }
-
-                    uint32_t size = ((p->blob.size > 0) && (p->blob.data != NULL)) ? p->blob.size : 0;
-                    lv2_atom_forge_key(&forge, pExt->uridContent);
-                    lv2_atom_forge_atom(&forge, size, forge.Chunk);
-                    if (size > 0)
-                        lv2_atom_forge_write(&forge, p->blob.data, size);
-                }
-                lv2_atom_forge_pop(&forge, &obj);
-            }*/
-
-            lv2_atom_forge_pop(&forge, &frame);
-            LV2_Atom *msg = reinterpret_cast<LV2_Atom *>(sink.buf);
-            pExt->store_value(pExt->uridKvtObject, msg->type, &msg[1], msg->size);
+            lsp_trace("Generated KVT snapshot of %d bytes", int(snapshot.size()));
+            pExt->store_value(pExt->uridKvtObject, pExt->forge.Chunk, snapshot.data(), snapshot.size());
         }
 
         void Wrapper::save_preset_state(const core::preset_state_t *state)
@@ -2111,6 +2013,12 @@ namespace lsp
                 const LV2_Atom *body = static_cast<const LV2_Atom *>(ptr);
                 parse_kvt_v2(body, p_size);
             }
+            else if (p_type == pExt->forge.Chunk)
+            {
+                status_t res = core::KVTSnapshot::restore(&sKVT, ptr, p_size, core::KVT_TX | core::KVT_STATE);
+                if (res != STATUS_OK)
+                    lsp_warn("Error deserializing KVT snapshot, code=%d", int(res));
+            }
             else
                 lsp_warn("Unsupported KVT property type: %s", pExt->unmap_urid(p_type));
         }
@@ -2459,9 +2367,11 @@ namespace lsp
             // Restore KVT state
             if (sKVTMutex.lock())
             {
-                // Clear KVT
+                // Clear KVT and restore parameters as a single transaction
+                sKVT.begin_transaction();
                 sKVT.clear();
                 restore_kvt_parameters();
+                sKVT.commit_transaction();
                 sKVT.gc();
                 sKVTMutex.unlock();
             }
@@ -2538,11 +2448,11 @@ namespace lsp
             }
             else
             {
-                lsp_trace("Creating native executor service");
-                ipc::NativeExecutor *exec = new ipc::NativeExecutor();
+                lsp_trace("Creating shared executor service");
+                core::SharedExecutor *exec = new core::SharedExecutor();
                 if (exec == NULL)
                     return NULL;
-                status_t res = exec->start();
+                status_t res = exec->init();
                 if (res != STATUS_OK)
                 {
                     delete exec;
@@ -28,7 +28,10 @@
 #include <lsp-plug.in/dsp/dsp.h>
 #include <lsp-plug.in/plug-fw/core/AudioBuffer.h>
 #include <lsp-plug.in/plug-fw/core/AudioTracer.h>
+#include <lsp-plug.in/plug-fw/core/decimate.h>
+#include <lsp-plug.in/plug-fw/core/delta.h>
 #include <lsp-plug.in/plug-fw/core/osc_buffer.h>
+#include <lsp-plug.in/plug-fw/core/sanitize.h>
 #include <lsp-plug.in/plug-fw/plug.h>
 #include <lsp-plug.in/plug-fw/meta/func.h>
 #include <lsp-plug.in/plug-fw/meta/ports.h>
@@ -118,6 +121,12 @@ namespace lsp
                  */
                 virtual bool tx_pending()                   { return false;     }
 
+                /** Check that the port has more pending data than can be transmitted by a single message
+                 *
+                 * @return true if the port has fallen behind and should be transmitted without waiting for the sync
+                 */
+                virtual bool tx_backlog()                   { return false;     }
+
                 /**
                  * Reset transfer pending
                  */
@@ -128,6 +137,11 @@ namespace lsp
                  */
                 virtual void ui_connected()                 { }
 
+                /**
+                 * Callback: UI has disconnected from backend
+                 */
+                virtual void ui_disconnected()              { }
+
             public:
                 /** Get the URID of the port in terms of Atom
                  *
@@ -167,6 +181,7 @@ namespace lsp
                 float     *pData;
                 float     *pSanitized;
                 bool       bZero;
+                bool       bAliased;    // Input buffer is shared with one of output buffers
 
                 IF_DEBUG( core::AudioTracer sTracer; )
 
@@ -177,6 +192,7 @@ namespace lsp
                     pData          = NULL;
                     pSanitized     = NULL;
                     bZero          = false;
+                    bAliased       = false;
 
                     if (meta::is_in_port(pMetadata))
                     {
@@ -216,6 +232,12 @@ namespace lsp
                 virtual void *buffer() override { return pBuffer; };
 
             public:
+                // Get the buffer bound by the host
+                inline float *data() const              { return pData; }
+
+                // Mark that the host passes the same buffer for this input and some output
+                inline void set_aliased(bool aliased)   { bAliased = aliased; }
+
                 // Should be always called at least once after bind() and before process() call
                 void sanitize_before(size_t off, size_t samples)
                 {
@@ -227,6 +249,12 @@ namespace lsp
                     if (pData != NULL)
                     {
                         IF_DEBUG( sTracer.submit(&pData[off], samples) ); // Trace input data
+
+                        // Pass the host buffer as is if it does not contain non-normal values. The buffer
+                        // shared with output may be overwritten by the plugin before it reads the input.
+                        if ((!bAliased) && (!core::need_sanitize(pBuffer, samples)))
+                            return;
+
                         dsp::sanitize2(pSanitized, pBuffer, samples);
                         bZero      = false;
                     }
@@ -620,11 +648,48 @@ namespace lsp
         {
             protected:
                 lv2_mesh_t                 sMesh;
+                lv2_mesh_t                 sDecimated;      // Decimated data for the delta encoder
+                core::DeltaEncoder         sEncoder;        // Delta encoder
+                size_t                     nDisplayWidth;   // Display width requested by the UI
+                float                     *pData;           // Buffer for decimated data
+                bool                       bDelta;          // Transmit only changed data
+
+            protected:
+                void serialize_delta(plug::mesh_t *mesh)
+                {
+                    // Reduce mesh to the display width if requested
+                    const float * const *src = mesh->pvData;
+                    size_t items        = core::decimated_size(mesh->nItems, nDisplayWidth);
+                    if ((items < mesh->nItems) && (sDecimated.pMesh != NULL))
+                    {
+                        core::decimate_mesh(sDecimated.pMesh->pvData, mesh->pvData, mesh->nBuffers, mesh->nItems, nDisplayWidth);
+                        src                 = sDecimated.pMesh->pvData;
+                    }
+                    else
+                        items               = mesh->nItems;
+
+                    // Emit only changed data
+                    const size_t size   = sEncoder.encode(src, mesh->nBuffers, items);
+                    if (size <= 0)
+                        return;
+
+                    pExt->forge_key(pExt->uridMeshDelta);
+                    pExt->forge_chunk(sEncoder.data(), size);
+                }
 
             public:
                 explicit MeshPort(const meta::port_t *meta, lv2::Extensions *ext): Port(meta, ext)
                 {
                     sMesh.init(meta);
+                    nDisplayWidth   = 0;
+                    pData           = NULL;
+                    bDelta          = (meta->flags & meta::F_DELTA) &&
+                                      (sEncoder.init(sMesh.nBuffers, sMesh.nMaxItems, meta->flags & meta::F_HALF) == STATUS_OK);
+
+                    if (bDelta)
+                        sDecimated.init(meta);
+                    else
+                        pData           = reinterpret_cast<float *>(::malloc(sizeof(float) * sMesh.nMaxItems));
                 }
 
                 MeshPort(const MeshPort &) = delete;
@@ -632,6 +697,26 @@ namespace lsp
                 MeshPort & operator = (const MeshPort &) = delete;
                 MeshPort & operator = (MeshPort &&) = delete;
 
+                virtual ~MeshPort() override
+                {
+                    if (pData != NULL)
+                    {
+                        ::free(pData);
+                        pData       = NULL;
+                    }
+                }
+
+            public:
+                /**
+                 * Set the display width requested by the UI, the maximum width requested
+                 * by all connected UIs is used
+                 * @param width display width, zero means no decimation
+                 */
+                inline void set_display_width(size_t width)
+                {
+                    nDisplayWidth   = lsp_max(nDisplayWidth, width);
+                }
+
             public:
                 virtual LV2_URID get_type_urid() override
                 {
@@ -653,9 +738,29 @@ namespace lsp
                     return mesh->containsData();
                 };
 
+                virtual void ui_connected() override
+                {
+                    // The connected client does not know the previous state of the mesh
+                    sEncoder.reset();
+                }
+
+                virtual void ui_disconnected() override
+                {
+                    // Remaining clients receive the mesh in original resolution until they request the width again
+                    nDisplayWidth   = 0;
+                }
+
                 virtual void serialize() override
                 {
                     plug::mesh_t *mesh = sMesh.pMesh;
+                    if (bDelta)
+                    {
+                        serialize_delta(mesh);
+                        mesh->set_waiting();
+                        return;
+                    }
+
+                    const size_t items = (pData != NULL) ? core::decimated_size(mesh->nItems, nDisplayWidth) : mesh->nItems;
 
                     // Forge number of vectors (dimensions)
                     pExt->forge_key(pExt->uridMeshDimensions);
@@ -663,13 +768,23 @@ namespace lsp
 
                     // Forge number of items per vector
                     pExt->forge_key(pExt->uridMeshItems);
-                    pExt->forge_int(mesh->nItems);
+                    pExt->forge_int(items);
 
-                    // Forge vectors
+                    // Forge vectors, reduce them to the display width if requested
                     for (size_t i=0; i < mesh->nBuffers; ++i)
                     {
+                        const float *v = mesh->pvData[i];
+                        if (items < mesh->nItems)
+                        {
+                            if (i == 0)
+                                core::decimate_argument(pData, v, mesh->nItems, nDisplayWidth);
+                            else
+                                core::decimate_envelope(pData, v, mesh->nItems, nDisplayWidth);
+                            v           = pData;
+                        }
+
                         pExt->forge_key(pExt->uridMeshData);
-                        pExt->forge_vector(sizeof(float), pExt->forge.Float, mesh->nItems, mesh->pvData[i]);
+                        pExt->forge_vector(sizeof(float), pExt->forge.Float, items, v);
                     }
 
                     // Set mesh waiting until next frame is allowed
@@ -725,6 +840,11 @@ namespace lsp
                     return nFrameID != pStream->frame_id();
                 }
 
+                virtual bool tx_backlog() override
+                {
+                    return uint32_t(pStream->frame_id() - nFrameID) > STREAM_BULK_MAX;
+                }
+
                 virtual void ui_connected() override
                 {
                     // We need to replay buffer contents for the connected client
@@ -777,12 +897,21 @@ namespace lsp
                             // Forge vectors
                             for (size_t i=0; i < nbuffers; ++i)
                             {
-                                pStream->read_frame(frame_id, i, pData, 0, size);
+                                // Copy the frame data only if it is split by the ring buffer
+                                plug::data_view_t v;
+                                const float *data = pData;
+                                if (pStream->view_frame(frame_id, i, &v, 0, size) == size)
+                                {
+                                    if (v.tail != NULL)
+                                        v.copy_to(pData);
+                                    else
+                                        data            = v.head;
+                                }
 
                                 pExt->forge_key(pExt->uridStreamFrameData);
 //                                lsp_trace("forge_vector i=%d, nbuffers=%d, size=%d, pData=%p",
 //                                    int(i), int(nbuffers), int(size), pData);
-                                pExt->forge_vector(sizeof(float), pExt->forge.Float, size, pData);
+                                pExt->forge_vector(sizeof(float), pExt->forge.Float, size, data);
                             }
                         }
                         pExt->forge_pop(&frame);
@@ -799,12 +928,15 @@ namespace lsp
             protected:
                 plug::frame_buffer_t   sFB;
                 size_t                 nRowID;
+                uint16_t              *pHalf;       // Row converted to 16-bit floating-point values
 
             public:
                 explicit FrameBufferPort(const meta::port_t *meta, lv2::Extensions *ext): Port(meta, ext)
                 {
                     sFB.init(meta->start, meta->step);
                     nRowID = 0;
+                    pHalf  = (meta->flags & meta::F_HALF) ?
+                        reinterpret_cast<uint16_t *>(::malloc(sizeof(uint16_t) * sFB.cols())) : NULL;
                 }
 
                 FrameBufferPort(const FrameBufferPort &) = delete;
@@ -815,6 +947,11 @@ namespace lsp
                 virtual ~FrameBufferPort() override
                 {
                     sFB.destroy();
+                    if (pHalf != NULL)
+                    {
+                        ::free(pHalf);
+                        pHalf       = NULL;
+                    }
                 };
 
             public:
@@ -833,6 +970,11 @@ namespace lsp
                     return sFB.next_rowid() != nRowID;
                 }
 
+                virtual bool tx_backlog() override
+                {
+                    return uint32_t(sFB.next_rowid() - nRowID) > FRAMEBUFFER_BULK_MAX;
+                }
+
                 virtual void ui_connected() override
                 {
                     // We need to replay buffer contents for the connected client
@@ -861,11 +1003,17 @@ namespace lsp
                     pExt->forge_key(pExt->uridFrameBufferLastRowID);
                     pExt->forge_int(last_row);
 
-                    // Forge vectors
+                    // Forge vectors, display-only rows are transmitted as 16-bit floating-point values
                     while (first_row != last_row)
                     {
                         pExt->forge_key(pExt->uridFrameBufferData);
-                        pExt->forge_vector(sizeof(float), pExt->forge.Float, sFB.cols(), sFB.get_row(first_row++));
+                        if (pHalf != NULL)
+                        {
+                            core::encode_half(pHalf, sFB.get_row(first_row++), sFB.cols());
+                            pExt->forge_chunk(pHalf, sizeof(uint16_t) * sFB.cols());
+                        }
+                        else
+                            pExt->forge_vector(sizeof(float), pExt->forge.Float, sFB.cols(), sFB.get_row(first_row++));
                     }
 
                     // Update current RowID
@@ -1161,7 +1309,14 @@ namespace lsp
 
                 virtual void save() override
                 {
-                    const char *path = (pValue != NULL) ? pValue->sData : pMetadata->value;
+                    // Take the consistent copy of the value since it can be changed by the real-time thread
+                    char *value = (pValue != NULL) ? pValue->snapshot() : NULL;
+                    lsp_finally {
+                        if (value != NULL)
+                            free(value);
+                    };
+
+                    const char *path = (value != NULL) ? value : pMetadata->value;
                     lsp_trace("save port id=%s, urid=%d (%s), value=%s", pMetadata->id, urid, get_uri(), path);
 
                     pExt->store_value(urid, pExt->forge.String, path, ::strlen(path) + sizeof(char));
@@ -24,6 +24,8 @@
 
 #include <lsp-plug.in/plug-fw/version.h>
 
+#include <lsp-plug.in/plug-fw/core/decimate.h>
+#include <lsp-plug.in/plug-fw/core/delta.h>
 #include <lsp-plug.in/plug-fw/meta/func.h>
 #include <lsp-plug.in/plug-fw/meta/types.h>
 #include <lsp-plug.in/plug-fw/ui.h>
@@ -402,6 +404,8 @@ namespace lsp
         {
             protected:
                 lv2_mesh_t              sMesh;
+                core::DeltaDecoder      sDecoder;
+                size_t                  nDisplayWidth;
                 bool                    bParsed;
                 lv2::MeshPort          *pPort;
 
@@ -409,8 +413,9 @@ namespace lsp
                 explicit UIMeshPort(const meta::port_t *meta, lv2::Extensions *ext, lv2::Port *xport) : UIPort(meta, ext)
                 {
                     sMesh.init(meta);
-                    bParsed     = false;
-                    pPort       = NULL;
+                    nDisplayWidth   = 0;
+                    bParsed         = false;
+                    pPort           = NULL;
 
                     lsp_trace("id=%s, ext=%p, xport=%p", meta->id, ext, xport);
 
@@ -450,6 +455,23 @@ namespace lsp
     //                lsp_trace("body->key (%d) = %s", int(body->key), pExt->unmap_urid(body->key));
     //                lsp_trace("body->value.type (%d) = %s", int(body->value.type), pExt->unmap_urid(body->value.type));
 
+                    // Apply delta-encoded data to the previous state of the mesh
+                    if ((body->key == pExt->uridMeshDelta) && (body->value.type == pExt->forge.Chunk))
+                    {
+                        size_t buffers  = 0;
+                        size_t items    = 0;
+                        if (sDecoder.decode(
+                            sMesh.pMesh->pvData, &buffers, &items,
+                            sMesh.nBuffers, sMesh.nMaxItems,
+                            &body[1], body->value.size))
+                        {
+                            sMesh.pMesh->nBuffers   = buffers;
+                            sMesh.pMesh->nItems     = items;
+                            bParsed                 = true;
+                        }
+                        return;
+                    }
+
                     if ((body->key != pExt->uridMeshDimensions) || (body->value.type != pExt->forge.Int))
                         return;
                     ssize_t dimensions = (reinterpret_cast<const LV2_Atom_Int *>(& body->value))->body;
@@ -526,10 +548,10 @@ namespace lsp
                     if ((mesh == NULL) || (!mesh->containsData()))
                         return false;
 
-                    // Copy mesh data
-                    for (size_t i=0; i < mesh->nBuffers; ++i)
-                        dsp::copy_saturated(sMesh.pMesh->pvData[i], mesh->pvData[i], mesh->nItems);
-                    sMesh.pMesh->data(mesh->nBuffers, mesh->nItems);
+                    // Copy mesh data, reduce it to the display width if requested
+                    const size_t items = core::decimate_mesh_saturated(
+                        sMesh.pMesh->pvData, mesh->pvData, mesh->nBuffers, mesh->nItems, nDisplayWidth);
+                    sMesh.pMesh->data(mesh->nBuffers, items);
     //                lsp_trace("Directly received mesh port id=%s, buffers=%d, items=%d",
     //                        pPort->metadata()->id, int(sMesh.pMesh->nBuffers), int(sMesh.pMesh->nItems));
 
@@ -538,6 +560,16 @@ namespace lsp
                     bParsed = true;
                     return sMesh.pMesh->containsData();
                 }
+
+                virtual void set_display_width(size_t width) override
+                {
+                    if (width <= nDisplayWidth)
+                        return;
+
+                    // Request the DSP to reduce the mesh before transmission
+                    nDisplayWidth   = width;
+                    pExt->ui_write_mesh_display_width(this, nDisplayWidth);
+                }
         };
 
         class UIStreamPort: public UIPort
@@ -836,7 +868,19 @@ namespace lsp
     //                    lsp_trace("body->key (%d) = %s", int(body->key), pExt->unmap_urid(body->key));
     //                    lsp_trace("body->value.type (%d) = %s", int(body->value.type), pExt->unmap_urid(body->value.type));
 
-                        if ((body->key != pExt->uridFrameBufferData) || (body->value.type != pExt->forge.Vector))
+                        if (body->key != pExt->uridFrameBufferData)
+                            return;
+
+                        // Display-only rows are transmitted as 16-bit floating-point values
+                        if (body->value.type == pExt->forge.Chunk)
+                        {
+                            if (body->value.size != sizeof(uint16_t) * cols)
+                                return;
+                            core::decode_half(sFB.get_row(first_row++), reinterpret_cast<const uint16_t *>(&body[1]), cols);
+                            continue;
+                        }
+
+                        if (body->value.type != pExt->forge.Vector)
                             return;
                         const LV2_Atom_Vector *v = reinterpret_cast<const LV2_Atom_Vector *>(&body->value);
 
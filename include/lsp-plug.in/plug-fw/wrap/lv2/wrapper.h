@@ -24,14 +24,15 @@
 
 #include <lsp-plug.in/plug-fw/version.h>
 
-#include <lsp-plug.in/ipc/NativeExecutor.h>
 #include <lsp-plug.in/lltl/hash_index.h>
 #include <lsp-plug.in/lltl/parray.h>
 #include <lsp-plug.in/plug-fw/plug.h>
 #include <lsp-plug.in/plug-fw/core/KVTDispatcher.h>
 #include <lsp-plug.in/plug-fw/core/KVTStorage.h>
 #include <lsp-plug.in/plug-fw/core/SamplePlayer.h>
+#include <lsp-plug.in/plug-fw/core/SharedExecutor.h>
 #include <lsp-plug.in/plug-fw/core/ShmClient.h>
+#include <lsp-plug.in/plug-fw/core/SilenceDetector.h>
 #include <lsp-plug.in/plug-fw/wrap/lv2/executor.h>
 #include <lsp-plug.in/plug-fw/wrap/lv2/extensions.h>
 #include <lsp-plug.in/plug-fw/wrap/lv2/ports.h>
@@ -77,6 +78,7 @@ namespace lsp
                         virtual void created(core::KVTStorage *storage, const char *id, const core::kvt_param_t *param, size_t pending);
                         virtual void changed(core::KVTStorage *storage, const char *id, const core::kvt_param_t *oval, const core::kvt_param_t *nval, size_t pending);
                         virtual void removed(core::KVTStorage *storage, const char *id, const core::kvt_param_t *param, size_t pending);
+                        virtual void transaction(core::KVTStorage *storage, size_t changes);
                 };
 
             protected:
@@ -115,7 +117,6 @@ namespace lsp
                 bool                    bStateManage;   // State management barrier
                 bool                    bSendPreset;    // Need to send preset state to UI
                 float                   fSampleRate;
-                uint8_t                *pOscPacket;     // OSC packet data
                 uatomic_t               nStateMode;     // State change flag
                 uatomic_t               nDumpReq;
                 uatomic_t               nDumpResp;
@@ -131,6 +132,7 @@ namespace lsp
                 wssize_t                nPlayLength;        // Sample playback length
 
                 core::ShmClient        *pShmClient;         // Shared memory client
+                core::SilenceDetector  sSilence;            // Silence detector for processing suspend
 
                 core::preset_state_t    sPresetState;       // Preset state
 
@@ -139,6 +141,7 @@ namespace lsp
             protected:
                 lv2::Port                      *create_port(lltl::parray<plug::IPort> *plugin_ports, const meta::port_t *meta, const char *postfix, bool virt);
                 void                            clear_midi_ports();
+                void                            detect_aliased_inputs();
                 void                            save_kvt_parameters();
                 void                            save_preset_state(const core::preset_state_t *state);
                 void                            restore_kvt_parameters();
@@ -151,7 +154,7 @@ namespace lsp
                 bool                            parse_kvt_value(core::kvt_param_t *param, const LV2_Atom *value);
 
                 void                            transmit_patch_state_to_clients(bool force);
-                void                            transmit_port_data_to_clients(bool sync_req);
+                void                            transmit_port_data_to_clients(bool sync);
                 void                            transmit_time_position_to_clients();
                 void                            transmit_play_position_to_clients();
                 void                            transmit_shm_state_to_clients();
@@ -179,7 +182,7 @@ namespace lsp
                 void                            destroy();
 
             public:
-                inline void                     activate()          { pPlugin->activate(); }
+                inline void                     activate()          { pPlugin->activate(); sSilence.reset(); }
                 inline void                     deactivate()        { pPlugin->deactivate(); }
 
                 inline void                     connect(size_t id, void *data);
@@ -325,8 +325,8 @@ namespace lsp
                 } while (vup->sync_again());
             } // for port_id
 
-            // Perform KVT synchronization
-            core::KVTStorage *kvt = pWrapper->kvt_lock();
+            // Perform KVT synchronization, do not block the UI if the KVT is busy
+            core::KVTStorage *kvt = pWrapper->kvt_trylock();
             if (kvt != NULL)
             {
                 // Synchronize DSP -> UI transfer
@@ -26,13 +26,14 @@
 #include <lsp-plug.in/plug-fw/wrap/vst2/wrapper.h>
 #include <lsp-plug.in/plug-fw/meta/func.h>
 #include <lsp-plug.in/plug-fw/meta/manifest.h>
+#include <lsp-plug.in/plug-fw/core/KVTSnapshot.h>
+#include <lsp-plug.in/plug-fw/core/SharedExecutor.h>
 #include <lsp-plug.in/plug-fw/wrap/vst2/defs.h>
 #include <lsp-plug.in/plug-fw/wrap/vst2/helpers.h>
 #include <lsp-plug.in/runtime/system.h>
 
 #include <lsp-plug.in/common/debug.h>
 #include <lsp-plug.in/common/endian.h>
-#include <lsp-plug.in/ipc/NativeExecutor.h>
 
 #ifdef WITH_UI_FEATURE
     #include <lsp-plug.in/plug-fw/wrap/vst2/ui_wrapper.h>
@@ -176,6 +177,7 @@ namespace lsp
 
             // Initialize plugin
             pPlugin->init(this, plugin_ports.array());
+            sSilence.init(pPlugin, plugin_ports.array(), plugin_ports.size());
 
             // Create sample player if required
             if (m->extensions & meta::E_FILE_PREVIEW)
@@ -211,6 +213,9 @@ namespace lsp
             }
         #endif /* WITH_UI_FEATURE */
 
+            // Destroy silence detector
+            sSilence.destroy();
+
             // Destroy sample player
             if (pSamplePlayer != NULL)
             {
@@ -478,7 +483,10 @@ namespace lsp
         void Wrapper::mains_changed(VstIntPtr value)
         {
             if (value)
+            {
                 pPlugin->activate();
+                sSilence.reset();
+            }
             else
                 pPlugin->deactivate();
         }
@@ -499,11 +507,11 @@ namespace lsp
             if (pExecutor != NULL)
                 return pExecutor;
 
-            lsp_trace("Creating native executor service");
-            ipc::NativeExecutor *exec = new ipc::NativeExecutor();
+            lsp_trace("Creating shared executor service");
+            core::SharedExecutor *exec = new core::SharedExecutor();
             if (exec == NULL)
                 return NULL;
-            if (exec->start() != STATUS_OK)
+            if (exec->init() != STATUS_OK)
             {
                 delete exec;
                 return NULL;
@@ -537,6 +545,26 @@ namespace lsp
         }
     #endif /* WITH_UI_FEATURE */
 
+        void Wrapper::detect_aliased_inputs()
+        {
+            for (size_t i=0, n=vAudioPorts.size(); i<n; ++i)
+            {
+                vst2::AudioPort *in = vAudioPorts.uget(i);
+                if ((in == NULL) || (!meta::is_audio_in_port(in->metadata())))
+                    continue;
+
+                const void *data    = in->buffer();
+                bool aliased        = false;
+                for (size_t j=0; (j<n) && (!aliased) && (data != NULL); ++j)
+                {
+                    vst2::AudioPort *out = vAudioPorts.uget(j);
+                    aliased             = (out != NULL) && (meta::is_audio_out_port(out->metadata())) && (out->buffer() == data);
+                }
+
+                in->set_aliased(aliased);
+            }
+        }
+
         void Wrapper::sync_position()
         {
             VstTimeInfo *info   = FromVstPtr<VstTimeInfo>(pMaster(pEffect, audioMasterGetTime, 0, kVstPpqPosValid | kVstTempoValid | kVstBarsValid | kVstCyclePosValid | kVstTimeSigValid, NULL, 0.0f));
@@ -645,6 +673,8 @@ namespace lsp
                 return;
             }
 
+            const uint64_t block_ts = profile_begin();
+
         #ifdef WITH_UI_FEATURE
             // Sync UI state
             const uatomic_t ui_req = nUIReq;
@@ -661,7 +691,7 @@ namespace lsp
             // Synchronize position
             sync_position();
 
-            // Bind input audio data and sanitize ports
+            // Bind input audio data
             for (size_t i=0, n=vAudioPorts.size(); i<n; ++i)
             {
                 vst2::AudioPort *port = vAudioPorts.uget(i);
@@ -670,18 +700,34 @@ namespace lsp
 
                 float *data = (meta::is_audio_in_port(port->metadata())) ? *(inputs++) : *(outputs++);
                 port->bind(data);
-                port->sanitize_before(samples);
+            }
+
+            // The host may process data in place, such inputs can not be passed to the plugin as is
+            detect_aliased_inputs();
+
+            // Sanitize ports
+            for (size_t i=0, n=vAudioPorts.size(); i<n; ++i)
+            {
+                vst2::AudioPort *port = vAudioPorts.uget(i);
+                if (port != NULL)
+                    port->sanitize_before(samples);
             }
 
             // Process ALL parameter ports for changes
             if (check_parameters_updated())
+            {
+                const uint64_t apply_ts = profile_begin();
                 apply_settings_update();
+                profile_end(core::DSP_PROBE_SETTINGS, apply_ts, samples);
+            }
 
             // Check that input parameters have changed
             if (bUpdateSettings)
             {
                 lsp_trace("updating settings");
+                const uint64_t settings_ts = profile_begin();
                 pPlugin->update_settings();
+                profile_end(core::DSP_PROBE_SETTINGS, settings_ts, samples);
                 if (pShmClient != NULL)
                     pShmClient->update_settings();
                 bUpdateSettings     = false;
@@ -698,19 +744,34 @@ namespace lsp
             if (pShmClient != NULL)
             {
                 pShmClient->begin(samples);
+                const uint64_t shm_ts = profile_begin();
                 pShmClient->pre_process(samples);
+                profile_end(core::DSP_PROBE_SHM_PRE, shm_ts, samples);
             }
 
             // Process samples
-            pPlugin->process(samples);
+            if (sSilence.idle(samples))
+                sSilence.silence(samples);
+            else
+            {
+                const uint64_t process_ts = profile_begin();
+                pPlugin->process(samples);
+                profile_end(core::DSP_PROBE_PROCESS, process_ts, samples);
+            }
 
             // Launch the sample player
             if (pSamplePlayer != NULL)
+            {
+                const uint64_t player_ts = profile_begin();
                 pSamplePlayer->process(samples);
+                profile_end(core::DSP_PROBE_SAMPLE_PLAYER, player_ts, samples);
+            }
 
             if (pShmClient != NULL)
             {
+                const uint64_t shm_ts = profile_begin();
                 pShmClient->post_process(samples);
+                profile_end(core::DSP_PROBE_SHM_POST, shm_ts, samples);
                 pShmClient->end();
             }
 
@@ -732,6 +793,8 @@ namespace lsp
 
             // Report latency
             report_latency();
+
+            profile_end(core::DSP_PROBE_BLOCK, block_ts, samples);
         }
 
         void Wrapper::process_events(const VstEvents *e)
@@ -791,128 +854,33 @@ namespace lsp
                 return sChunk.res;
             }
 
-            status_t res = STATUS_OK;
-
-            // Serialize KVT storage
+            // Serialize KVT storage as a single snapshot
             {
                 if (!sKVTMutex.lock())
                     return STATUS_BAD_STATE;
-                lsp_finally { sKVTMutex.unlock(); };
-
-                const core::kvt_param_t *p;
+                lsp_finally {
+                    sKVT.gc();
+                    sKVTMutex.unlock();
+                };
 
-                // Read the whole KVT storage
-                core::KVTIterator *it = sKVT.enum_all();
-                while (it->next() == STATUS_OK)
+                core::KVTSnapshot snapshot;
+                status_t res = snapshot.save(&sKVT);
+                if (res != STATUS_OK)
                 {
-                    res             = it->get(&p);
-                    if (res == STATUS_NOT_FOUND) // Not a parameter
-                        continue;
-                    else if (res != STATUS_OK)
-                    {
-                        lsp_warn("it->get() returned %d", int(res));
-                        break;
-                    }
-                    else if (it->is_transient()) // Skip transient parameters
-                        continue;
-
-                    const char *name = it->name();
-                    if (name == NULL)
-                    {
-                        lsp_trace("it->name() returned NULL");
-                        break;
-                    }
-
-                    uint8_t flags = 0;
-                    if (it->is_private())
-                        flags      |= vst2::FLAG_PRIVATE;
-
-                    kvt_dump_parameter("Saving state of KVT parameter: %s = ", p, name);
-
-                    param_off   = sChunk.write(uint32_t(0)); // Reserve space for size
-                    sChunk.write_string(name); // Name of the KVT parameter
-                    sChunk.write_byte(flags);
-
-                    // Serialize parameter according to it's type
-                    switch (p->type)
-                    {
-                        case core::KVT_INT32:
-                        {
-                            sChunk.write_byte(vst2::TYPE_INT32);
-                            sChunk.write(p->i32);
-                            break;
-                        };
-                        case core::KVT_UINT32:
-                        {
-                            sChunk.write_byte(vst2::TYPE_UINT32);
-                            sChunk.write(p->u32);
-                            break;
-                        }
-                        case core::KVT_INT64:
-                        {
-                            sChunk.write_byte(vst2::TYPE_INT64);
-                            sChunk.write(p->i64);
-                            break;
-                        };
-                        case core::KVT_UINT64:
-                        {
-                            sChunk.write_byte(vst2::TYPE_UINT64);
-                            sChunk.write(p->u64);
-                            break;
-                        }
-                        case core::KVT_FLOAT32:
-                        {
-                            sChunk.write_byte(vst2::TYPE_FLOAT32);
-                            sChunk.write(p->f32);
-                            break;
-                        }
-                        case core::KVT_FLOAT64:
-                        {
-                            sChunk.write_byte(vst2::TYPE_FLOAT64);
-                            sChunk.write(p->f64);
-                            break;
-                        }
-                        case core::KVT_STRING:
-                        {
-                            sChunk.write_byte(vst2::TYPE_STRING);
-                            sChunk.write_string((p->str != NULL) ? p->str : "");
-                            break;
-                        }
-                        case core::KVT_BLOB:
-                        {
-                            if ((p->blob.size > 0) && (p->blob.data == NULL))
-                            {
-                                res = STATUS_INVALID_VALUE;
-                                break;
-                            }
-
-                            sChunk.write_byte(vst2::TYPE_BLOB);
-                            sChunk.write_string((p->blob.ctype != NULL) ? p->blob.ctype : "");
-                            if (p->blob.size > 0)
-                                sChunk.write(p->blob.data, p->blob.size);
-                            break;
-                        }
-
-                        default:
-                            res     = STATUS_BAD_TYPE;
-                            break;
-                    }
-
-                    // Successful status?
-                    if (res != STATUS_OK)
-                    {
-                        lsp_trace("KVT serialization failed");
-                        break;
-                    }
-
-                    // Complete the parameter size
-                    sChunk.write_at(param_off, uint32_t(sChunk.offset - param_off - sizeof(uint32_t))); // Write the actual size
+                    lsp_warn("Error serializing KVT snapshot, code=%d", int(res));
+                    return res;
                 }
 
-                sKVT.gc();
+                param_off   = sChunk.write(uint32_t(0)); // Reserve space for size
+                sChunk.write_string("!kvt_snapshot");
+                sChunk.write(snapshot.data(), snapshot.size());
+                sChunk.write_at(param_off, uint32_t(sChunk.offset - param_off - sizeof(uint32_t))); // Write the actual size
             }
 
-            return res;
+            if (sChunk.res != STATUS_OK)
+                lsp_warn("Error serializing KVT snapshot, code=%d", int(sChunk.res));
+
+            return sChunk.res;
         }
 
         size_t Wrapper::serialize_state(const void **dst, bool program)
@@ -1332,6 +1300,24 @@ namespace lsp
                 else
                     lsp_trace("Failed parsing preset state: head=%p > tail=%p", head, tail);
             }
+            else if (strcmp(name, "!kvt_snapshot") == 0)
+            {
+                if (!sKVTMutex.lock())
+                    return false;
+                sKVT.begin_transaction();
+                lsp_finally {
+                    sKVT.commit_transaction();
+                    sKVT.gc();
+                    sKVTMutex.unlock();
+                };
+
+                sKVT.clear();
+                status_t res = core::KVTSnapshot::restore(&sKVT, head, tail - head, core::KVT_TX | core::KVT_STATE);
+                if (res == STATUS_OK)
+                    return true;
+
+                lsp_trace("Failed restoring KVT snapshot, code=%d", int(res));
+            }
             else
                 lsp_warn("Unknown special variable: %s, skipping", name);
 
@@ -1411,7 +1397,12 @@ namespace lsp
             {
                 if (!sKVTMutex.lock())
                     return;
-                lsp_finally {sKVTMutex.unlock(); };
+                sKVT.begin_transaction();
+                lsp_finally {
+                    sKVT.commit_transaction();
+                    sKVT.gc();
+                    sKVTMutex.unlock();
+                };
 
                 sKVT.clear();
 
@@ -1534,8 +1525,6 @@ namespace lsp
                     // Move to next parameter
                     head        = next;
                 }
-
-                sKVT.gc();
             }
         }
 
@@ -26,6 +26,7 @@
 #include <lsp-plug.in/plug-fw/core/AudioBuffer.h>
 #include <lsp-plug.in/plug-fw/core/AudioTracer.h>
 #include <lsp-plug.in/plug-fw/core/osc_buffer.h>
+#include <lsp-plug.in/plug-fw/core/sanitize.h>
 #include <lsp-plug.in/plug-fw/meta/func.h>
 #include <lsp-plug.in/plug-fw/meta/types.h>
 #include <lsp-plug.in/plug-fw/plug.h>
@@ -252,6 +253,7 @@ namespace lsp
                 float          *pBuffer;
                 float          *pSanitized;
                 size_t          nBufSize;
+                bool            bAliased;       // Input buffer is shared with one of output buffers
 
                 IF_DEBUG( core::AudioTracer sTracer; )
 
@@ -262,6 +264,7 @@ namespace lsp
                     pBuffer     = NULL;
                     pSanitized  = NULL;
                     nBufSize    = 0;
+                    bAliased    = false;
                 }
 
                 AudioPort(const AudioPort &) = delete;
@@ -294,6 +297,12 @@ namespace lsp
                     pBuffer     = data;
                 }
 
+                // Mark that the host passes the same buffer for this input and some output
+                inline void set_aliased(bool aliased)
+                {
+                    bAliased    = aliased;
+                }
+
                 void sanitize_before(size_t samples)
                 {
                     if (pSanitized == NULL)
@@ -301,6 +310,11 @@ namespace lsp
 
                     IF_DEBUG( sTracer.submit(pBuffer, samples) ); // Trace input data
 
+                    // Pass the host buffer as is if it does not contain non-normal values. The buffer
+                    // shared with output may be overwritten by the plugin before it reads the input.
+                    if ((!bAliased) && (!core::need_sanitize(pBuffer, samples)))
+                        return;
+
                     // Perform sanitize() if possible
                     if (samples > nBufSize)
                     {
@@ -1108,7 +1122,13 @@ namespace lsp
 
                 virtual void serialize(vst2::chunk_t *chunk) override
                 {
-                    chunk->write_string(pValue->sData);
+                    // Take the consistent copy of the value since it can be changed by the real-time thread
+                    char *str = pValue->snapshot();
+                    if (str == NULL)
+                        return;
+
+                    chunk->write_string(str);
+                    free(str);
                 }
 
                 virtual ssize_t deserialize_v1(const void *data, size_t length) override
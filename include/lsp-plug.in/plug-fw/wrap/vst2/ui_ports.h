@@ -23,6 +23,7 @@
 #define LSP_PLUG_IN_PLUG_FW_WRAP_VST2_UI_PORTS_H_
 
 #include <lsp-plug.in/plug-fw/version.h>
+#include <lsp-plug.in/plug-fw/core/decimate.h>
 #include <lsp-plug.in/plug-fw/core/osc_buffer.h>
 #include <lsp-plug.in/plug-fw/wrap/vst2/ports.h>
 #include <lsp-plug.in/plug-fw/ui.h>
@@ -255,12 +256,14 @@ namespace lsp
         {
             private:
                 plug::mesh_t   *pMesh;
+                size_t          nDisplayWidth;
 
             public:
                 explicit UIMeshPort(const meta::port_t *meta, vst2::Port *port):
                     UIPort(meta, port)
                 {
-                    pMesh       = vst2::create_mesh(meta);
+                    pMesh           = vst2::create_mesh(meta);
+                    nDisplayWidth   = 0;
                 }
 
                 UIMeshPort(const UIMeshPort &) = delete;
@@ -282,10 +285,10 @@ namespace lsp
                     if ((mesh == NULL) || (!mesh->containsData()))
                         return false;
 
-                    // Copy mesh data
-                    for (size_t i=0; i < mesh->nBuffers; ++i)
-                        dsp::copy_saturated(pMesh->pvData[i], mesh->pvData[i], mesh->nItems);
-                    pMesh->data(mesh->nBuffers, mesh->nItems);
+                    // Copy mesh data, reduce it to the display width if requested
+                    const size_t items = core::decimate_mesh_saturated(
+                        pMesh->pvData, mesh->pvData, mesh->nBuffers, mesh->nItems, nDisplayWidth);
+                    pMesh->data(mesh->nBuffers, items);
 
                     // Clean source mesh
                     mesh->cleanup();
@@ -297,6 +300,11 @@ namespace lsp
                 {
                     return pMesh;
                 }
+
+                virtual void set_display_width(size_t width) override
+                {
+                    nDisplayWidth   = lsp_max(nDisplayWidth, width);
+                }
         };
 
         class UIStreamPort: public UIPort
@@ -27,6 +27,7 @@
 #include <lsp-plug.in/plug-fw/core/KVTStorage.h>
 #include <lsp-plug.in/plug-fw/core/SamplePlayer.h>
 #include <lsp-plug.in/plug-fw/core/ShmClient.h>
+#include <lsp-plug.in/plug-fw/core/SilenceDetector.h>
 #include <lsp-plug.in/plug-fw/core/presets.h>
 #include <lsp-plug.in/plug-fw/meta/types.h>
 #include <lsp-plug.in/plug-fw/plug.h>
@@ -80,6 +81,7 @@ namespace lsp
                 vst2::Port                         *pBypass;
                 core::SamplePlayer                 *pSamplePlayer;  // Sample player
                 core::ShmClient                    *pShmClient;     // Shared memory client
+                core::SilenceDetector              sSilence;        // Silence detector for processing suspend
                 core::preset_state_t                sPresetState;   // Preset state
                 uatomic_t                           nPresetFlags;   // Preset flags
 
@@ -107,6 +109,7 @@ namespace lsp
                 void                        deserialize_v2_v3(const uint8_t *data, size_t bytes);
                 void                        deserialize_new_chunk_format(const uint8_t *data, size_t bytes);
                 void                        sync_position();
+                void                        detect_aliased_inputs();
                 status_t                    serialize_port_data();
                 bool                        check_parameters_updated();
                 void                        apply_settings_update();
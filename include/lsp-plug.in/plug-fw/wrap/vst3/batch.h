@@ -0,0 +1,268 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_PLUG_FW_WRAP_VST3_BATCH_H_
+#define LSP_PLUG_IN_PLUG_FW_WRAP_VST3_BATCH_H_
+
+#include <lsp-plug.in/plug-fw/version.h>
+
+#include <lsp-plug.in/common/types.h>
+
+namespace lsp
+{
+    namespace vst3
+    {
+        /**
+         * Type of the batch entry
+         */
+        enum batch_type_t
+        {
+            BATCH_METER,
+            BATCH_MESH,
+            BATCH_FBUFFER,
+            BATCH_STREAM,
+            BATCH_MESH_DELTA,               // Delta-encoded mesh, see core::DeltaEncoder
+            BATCH_FBUFFER_HALF              // Frame buffer with rows of 16-bit floating-point values
+        };
+
+        /**
+         * Header of the batch, all fields are stored in the byte order of the sender
+         */
+        typedef struct batch_header_t
+        {
+            uint32_t    signature;          // Signature of the batch
+            uint32_t    entries;            // Number of entries in the index
+            uint32_t    size;               // Overall size of the batch in bytes
+        } batch_header_t;
+
+        /**
+         * Index entry of the batch, all offsets are relative to the beginning of the batch
+         */
+        typedef struct batch_entry_t
+        {
+            uint32_t    type;               // Type of the entry, see batch_type_t
+            uint32_t    id;                 // Offset of the null-terminated port identifier
+            uint32_t    offset;             // Offset of the payload
+            uint32_t    size;               // Size of the payload in bytes
+        } batch_entry_t;
+
+        /**
+         * Batch writer: packs data of multiple ports into one contiguous binary blob.
+         * The blob consists of the header, the data area and the index of entries at
+         * the end of the blob, so the data is written directly at it's final location.
+         * Allocated memory is retained between batches to avoid reallocations.
+         */
+        class BatchWriter
+        {
+            public:
+                static constexpr uint32_t SIGNATURE         = 0x4c535042; // 'LSPB'
+
+            private:
+                uint8_t        *vData;          // Blob: header and data area
+                size_t          nSize;          // Size of the header and the data area
+                size_t          nDataCap;       // Capacity of the blob
+                batch_entry_t  *vIndex;         // Index of entries
+                size_t          nEntries;       // Number of entries
+                size_t          nIndexCap;      // Capacity of the index
+                batch_entry_t  *pCurr;          // Current entry
+
+            protected:
+                uint8_t        *append(size_t bytes);
+
+            public:
+                BatchWriter();
+                BatchWriter(const BatchWriter &) = delete;
+                BatchWriter(BatchWriter &&) = delete;
+                ~BatchWriter();
+
+                BatchWriter & operator = (const BatchWriter &) = delete;
+                BatchWriter & operator = (BatchWriter &&) = delete;
+
+            public:
+                /**
+                 * Drop all entries of the batch, allocated memory is retained
+                 */
+                void            clear();
+
+                /**
+                 * Check that batch has no entries
+                 * @return true if batch has no entries
+                 */
+                inline bool     is_empty() const    { return nEntries <= 0; }
+
+                /**
+                 * Get number of entries in the batch
+                 * @return number of entries in the batch
+                 */
+                inline size_t   entries() const     { return nEntries;      }
+
+                /**
+                 * Begin new entry
+                 * @param type type of the entry
+                 * @param id port identifier
+                 * @return true on success
+                 */
+                bool            begin(batch_type_t type, const char *id);
+
+                /**
+                 * Write unsigned integer value to the current entry
+                 * @param value value to write
+                 * @return true on success
+                 */
+                bool            write_uint32(uint32_t value);
+
+                /**
+                 * Write floating-point value to the current entry
+                 * @param value value to write
+                 * @return true on success
+                 */
+                bool            write_float(float value);
+
+                /**
+                 * Write array of floating-point values to the current entry
+                 * @param v pointer to the array
+                 * @param count number of elements
+                 * @return true on success
+                 */
+                bool            write_floats(const float *v, size_t count);
+
+                /**
+                 * Reserve space for array of floating-point values in the current entry,
+                 * the caller should fill the reserved space with data
+                 * @param count number of elements
+                 * @return pointer to the reserved space or NULL on error
+                 */
+                float          *reserve_floats(size_t count);
+
+                /**
+                 * Write raw bytes to the current entry, the data is padded to 32-bit boundary
+                 * @param data pointer to the data
+                 * @param bytes number of bytes
+                 * @return true on success
+                 */
+                bool            write_bytes(const void *data, size_t bytes);
+
+                /**
+                 * Complete the current entry and add it to the index
+                 */
+                void            end();
+
+                /**
+                 * Cancel the current entry and discard all data written to it
+                 */
+                void            cancel();
+
+                /**
+                 * Build the contiguous binary blob: complete the header and append the index
+                 * to the data area, the data itself is not copied
+                 * @param size pointer to store the size of the blob
+                 * @return pointer to the blob valid until next modification of the batch or NULL on error
+                 */
+                const void     *build(size_t *size);
+        };
+
+        /**
+         * Batch reader: iterates over the entries of the binary blob produced by BatchWriter
+         */
+        class BatchReader
+        {
+            private:
+                const uint8_t          *pData;      // Pointer to the blob
+                size_t                  nSize;      // Size of the blob
+                const batch_entry_t    *vIndex;     // Index of entries
+                size_t                  nEntries;   // Number of entries
+                size_t                  nEntry;     // Index of the next entry
+                const uint8_t          *pHead;      // Read position of the current entry
+                const uint8_t          *pTail;      // End of the current entry
+                bool                    bSwap;      // Swap byte order
+
+            protected:
+                uint32_t                fetch(uint32_t value) const;
+
+            public:
+                BatchReader();
+                BatchReader(const BatchReader &) = delete;
+                BatchReader(BatchReader &&) = delete;
+                ~BatchReader();
+
+                BatchReader & operator = (const BatchReader &) = delete;
+                BatchReader & operator = (BatchReader &&) = delete;
+
+            public:
+                /**
+                 * Initialize reader and validate the header of the blob
+                 * @param data pointer to the blob
+                 * @param size size of the blob
+                 * @param swap swap byte order of the data
+                 * @return true if blob is valid
+                 */
+                bool                    init(const void *data, size_t size, bool swap);
+
+                /**
+                 * Check that values need byte swapping
+                 * @return true if values need byte swapping
+                 */
+                inline bool             swapped() const     { return bSwap;     }
+
+                /**
+                 * Advance to the next entry
+                 * @param type pointer to store the type of the entry
+                 * @param id pointer to store the port identifier
+                 * @return true if entry has been read, false on end of data or error
+                 */
+                bool                    next(uint32_t *type, const char **id);
+
+                /**
+                 * Read unsigned integer value from the current entry
+                 * @param value pointer to store the value
+                 * @return true on success
+                 */
+                bool                    read_uint32(uint32_t *value);
+
+                /**
+                 * Read floating-point value from the current entry
+                 * @param value pointer to store the value
+                 * @return true on success
+                 */
+                bool                    read_float(float *value);
+
+                /**
+                 * Read array of floating-point values from the current entry. The values are
+                 * returned as is, the caller should swap them if swapped() returns true
+                 * @param count number of elements
+                 * @return pointer to the array or NULL on error
+                 */
+                const float            *read_floats(size_t count);
+
+                /**
+                 * Read raw bytes from the current entry, the data is padded to 32-bit boundary.
+                 * The bytes are returned as is, byte order is not changed
+                 * @param bytes number of bytes
+                 * @return pointer to the data or NULL on error
+                 */
+                const void             *read_bytes(size_t bytes);
+        };
+
+    } /* namespace vst3 */
+} /* namespace lsp */
+
+
+#endif /* LSP_PLUG_IN_PLUG_FW_WRAP_VST3_BATCH_H_ */
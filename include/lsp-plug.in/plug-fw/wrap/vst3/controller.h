@@ -33,6 +33,7 @@
 
 #include <steinberg/vst3.h>
 
+#include <lsp-plug.in/plug-fw/wrap/vst3/batch.h>
 #include <lsp-plug.in/plug-fw/wrap/vst3/factory.h>
 #include <lsp-plug.in/plug-fw/wrap/vst3/string_buf.h>
 #include <lsp-plug.in/plug-fw/wrap/vst3/sync.h>
@@ -102,6 +103,12 @@ namespace lsp
                 vst3::CtlParamPort                 *find_param(Steinberg::Vst::ParamID param_id);
                 void                                receive_raw_osc_packet(const void *data, size_t size);
                 void                                parse_raw_osc_event(osc::parse_frame_t *frame);
+                bool                                receive_data_batch(const void *data, size_t size, bool swap);
+                bool                                receive_batch_meter(vst3::CtlPort *port, vst3::BatchReader *rd);
+                bool                                receive_batch_mesh(vst3::CtlPort *port, vst3::BatchReader *rd);
+                bool                                receive_batch_mesh_delta(vst3::CtlPort *port, vst3::BatchReader *rd);
+                bool                                receive_batch_frame_buffer(vst3::CtlPort *port, vst3::BatchReader *rd, bool half);
+                bool                                receive_batch_stream(vst3::CtlPort *port, vst3::BatchReader *rd);
                 status_t                            load_state(Steinberg::IBStream *is);
                 void                                send_kvt_state();
                 status_t                            deserialize_preset_state(core::preset_state_t *state, Steinberg::IBStream *is);
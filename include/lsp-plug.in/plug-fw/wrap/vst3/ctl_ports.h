@@ -25,6 +25,7 @@
 #include <lsp-plug.in/plug-fw/version.h>
 
 #include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/plug-fw/core/delta.h>
 #include <lsp-plug.in/plug-fw/meta/func.h>
 #include <lsp-plug.in/plug-fw/meta/types.h>
 #include <lsp-plug.in/plug-fw/wrap/vst3/data.h>
@@ -140,6 +141,12 @@ namespace lsp
                     return --nEditCounter == 0;
                 }
 
+                /**
+                 * Request the display width for the mesh data
+                 * @param width display width in pixels
+                 */
+                virtual void        set_display_width(size_t width) {}
+
             public:
                 /**
                  * Get serial version of the port
@@ -460,18 +467,24 @@ namespace lsp
         class CtlMeshPort: public CtlPort
         {
             protected:
+                CtlPortChangeHandler   *pHandler;
                 plug::mesh_t           *pMesh;
+                core::DeltaDecoder      sDecoder;
+                size_t                  nDisplayWidth;
 
             public:
-                explicit CtlMeshPort(const meta::port_t *meta) : CtlPort(meta)
+                explicit CtlMeshPort(const meta::port_t *meta, CtlPortChangeHandler *handler) : CtlPort(meta)
                 {
+                    pHandler            = handler;
                     pMesh               = vst3::create_mesh(meta);
+                    nDisplayWidth       = 0;
                 }
 
                 virtual ~CtlMeshPort() override
                 {
                     vst3::destroy_mesh(pMesh);
                     pMesh               = NULL;
+                    pHandler            = NULL;
                 }
 
                 CtlMeshPort(const CtlMeshPort &) = delete;
@@ -485,6 +498,37 @@ namespace lsp
                 {
                     return pMesh;
                 }
+
+                virtual void set_display_width(size_t width) override
+                {
+                    // Use the maximum width requested by all UI instances
+                    if (width <= nDisplayWidth)
+                        return;
+                    nDisplayWidth       = width;
+                    if (pHandler != NULL)
+                        pHandler->port_write(this, 0);
+                }
+
+                /**
+                 * Apply delta-encoded data to the mesh
+                 * @param data packet data
+                 * @param size size of the packet
+                 * @return true if mesh contains valid data
+                 */
+                bool apply_delta(const void *data, size_t size)
+                {
+                    size_t buffers  = 0;
+                    size_t items    = 0;
+                    if (!sDecoder.decode(pMesh->pvData, &buffers, &items, pMetadata->step, pMetadata->start, data, size))
+                        return false;
+
+                    pMesh->data(buffers, items);
+                    return true;
+                }
+
+            public:
+                inline size_t display_width() const     { return nDisplayWidth; }
+                inline void reset_display_width()       { nDisplayWidth = 0;    }
         };
 
         class CtlFrameBufferPort: public CtlPort
@@ -45,13 +45,11 @@ namespace lsp
         constexpr const char *ID_MSG_MUSIC_POSITION         = "MusicPosition";
         constexpr const char *ID_MSG_PLAY_SAMPLE_POSITION   = "PlaySamplePosition";
         constexpr const char *ID_MSG_VIRTUAL_PARAMETER      = "VParam";
-        constexpr const char *ID_MSG_METERS                 = "Meters";
         constexpr const char *ID_MSG_PATH                   = "Path";
         constexpr const char *ID_MSG_STRING                 = "String";
         constexpr const char *ID_MSG_SHM_STATE              = "ShmState";
-        constexpr const char *ID_MSG_MESH                   = "Mesh";
-        constexpr const char *ID_MSG_FRAMEBUFFER            = "FrameBuffer";
-        constexpr const char *ID_MSG_STREAM                 = "Stream";
+        constexpr const char *ID_MSG_DATA_BATCH             = "DataBatch";
+        constexpr const char *ID_MSG_MESH_DISPLAY_WIDTH     = "MeshDisplayWidth";
         constexpr const char *ID_MSG_KVT                    = "KVT";
         constexpr const char *ID_MSG_ACTIVATE_UI            = "UIActivate";
         constexpr const char *ID_MSG_DEACTIVATE_UI          = "UIDeactivate";
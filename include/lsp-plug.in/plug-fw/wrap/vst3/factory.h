@@ -34,6 +34,7 @@
 #include <lsp-plug.in/lltl/ptrset.h>
 #include <lsp-plug.in/plug-fw/meta/manifest.h>
 #include <lsp-plug.in/plug-fw/core/CatalogManager.h>
+#include <lsp-plug.in/plug-fw/core/ExecutorPool.h>
 #include <lsp-plug.in/plug-fw/core/ICatalogFactory.h>
 #include <lsp-plug.in/plug-fw/core/Resources.h>
 
@@ -65,7 +66,7 @@ namespace lsp
                 ipc::Mutex                              sMutex;         // Mutex for managing factory state
                 ipc::Mutex                              sDataMutex;     // Mutex for managing data synchronization primitives
                 resource::ILoader                      *pLoader;        // Resource loader
-                ipc::IExecutor                         *pExecutor;      // Offline task executor
+                core::ExecutorPool                     *pExecutor;      // Offline task executor
                 AppTimer                               *pAppTimer;      // Application timer
                 meta::package_t                        *pPackage;       // Package manifest
                 void                                   *pActiveSync;    // Active data sync
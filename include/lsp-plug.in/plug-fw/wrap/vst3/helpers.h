@@ -38,6 +38,7 @@
 #include <lsp-plug.in/stdlib/string.h>
 
 #include <steinberg/vst3.h>
+#include <lsp-plug.in/plug-fw/core/KVTSnapshot.h>
 #include <lsp-plug.in/plug-fw/core/KVTStorage.h>
 #include <lsp-plug.in/plug-fw/wrap/vst3/data.h>
 #include <lsp-plug.in/plug-fw/wrap/vst3/message.h>
@@ -1154,6 +1155,42 @@ namespace lsp
             return (szof == in_szof) ? STATUS_OK : STATUS_CORRUPTED;
         }
 
+        inline status_t serialize_kvt_snapshot(Steinberg::IBStream *os, core::KVTStorage *kvt)
+        {
+            status_t res;
+            core::KVTSnapshot snapshot;
+
+            // Serialize all KVT parameters as a single snapshot
+            if ((res = snapshot.save(kvt)) != STATUS_OK)
+                return res;
+            if ((res = write_string(os, "!kvt_snapshot")) != STATUS_OK)
+                return res;
+            if ((res = write_varint(os, snapshot.size())) != STATUS_OK)
+                return res;
+            return write_fully(os, snapshot.data(), snapshot.size());
+        }
+
+        inline status_t deserialize_kvt_snapshot(core::KVTStorage *kvt, Steinberg::IBStream *is, size_t flags, size_t skip)
+        {
+            status_t res;
+            size_t size = 0;
+
+            if ((res = read_varint(is, &size)) != STATUS_OK)
+                return res;
+            if (size == 0)
+                return STATUS_CORRUPTED;
+
+            uint8_t *data = static_cast<uint8_t *>(malloc(size));
+            if (data == NULL)
+                return STATUS_NO_MEM;
+            lsp_finally { free(data); };
+
+            if ((res = read_fully(is, data, size)) != STATUS_OK)
+                return res;
+
+            return core::KVTSnapshot::restore(kvt, data, size, flags, skip);
+        }
+
     } /* namespace vst3 */
 } /* namespace lsp */
 
@@ -0,0 +1,364 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSP_PLUG_IN_PLUG_FW_WRAP_VST3_IMPL_BATCH_H_
+#define LSP_PLUG_IN_PLUG_FW_WRAP_VST3_IMPL_BATCH_H_
+
+#include <lsp-plug.in/plug-fw/version.h>
+
+#include <lsp-plug.in/common/endian.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/plug-fw/wrap/vst3/batch.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+namespace lsp
+{
+    namespace vst3
+    {
+        //---------------------------------------------------------------------
+        BatchWriter::BatchWriter()
+        {
+            vData       = NULL;
+            nSize       = sizeof(batch_header_t);
+            nDataCap    = 0;
+            vIndex      = NULL;
+            nEntries    = 0;
+            nIndexCap   = 0;
+            pCurr       = NULL;
+        }
+
+        BatchWriter::~BatchWriter()
+        {
+            if (vData != NULL)
+            {
+                free(vData);
+                vData       = NULL;
+            }
+            if (vIndex != NULL)
+            {
+                free(vIndex);
+                vIndex      = NULL;
+            }
+        }
+
+        uint8_t *BatchWriter::append(size_t bytes)
+        {
+            // All data in the batch is aligned to 32-bit boundary
+            bytes       = align_size(bytes, sizeof(uint32_t));
+            const size_t size = nSize + bytes;
+            if (size > nDataCap)
+            {
+                const size_t cap    = lsp_max(size, nDataCap << 1);
+                uint8_t *ptr        = static_cast<uint8_t *>(realloc(vData, cap));
+                if (ptr == NULL)
+                    return NULL;
+                vData       = ptr;
+                nDataCap    = cap;
+            }
+
+            uint8_t *res    = &vData[nSize];
+            nSize           = size;
+            return res;
+        }
+
+        void BatchWriter::clear()
+        {
+            nSize       = sizeof(batch_header_t);
+            nEntries    = 0;
+            pCurr       = NULL;
+        }
+
+        bool BatchWriter::begin(batch_type_t type, const char *id)
+        {
+            if (pCurr != NULL)
+                cancel();
+
+            // Allocate new index entry
+            if (nEntries >= nIndexCap)
+            {
+                const size_t cap    = lsp_max(nIndexCap << 1, size_t(16));
+                batch_entry_t *ptr  = static_cast<batch_entry_t *>(realloc(vIndex, cap * sizeof(batch_entry_t)));
+                if (ptr == NULL)
+                    return false;
+                vIndex      = ptr;
+                nIndexCap   = cap;
+            }
+
+            // Store the port identifier
+            const size_t offset = nSize;
+            const size_t len    = strlen(id) + 1;
+            uint8_t *dst        = append(len);
+            if (dst == NULL)
+                return false;
+            memcpy(dst, id, len);
+            memset(&dst[len], 0, nSize - offset - len);
+
+            // Initialize the entry
+            pCurr           = &vIndex[nEntries];
+            pCurr->type     = type;
+            pCurr->id       = offset;
+            pCurr->offset   = nSize;
+            pCurr->size     = 0;
+
+            return true;
+        }
+
+        bool BatchWriter::write_uint32(uint32_t value)
+        {
+            if (pCurr == NULL)
+                return false;
+            uint8_t *dst        = append(sizeof(uint32_t));
+            if (dst == NULL)
+                return false;
+            memcpy(dst, &value, sizeof(uint32_t));
+            return true;
+        }
+
+        bool BatchWriter::write_float(float value)
+        {
+            if (pCurr == NULL)
+                return false;
+            uint8_t *dst        = append(sizeof(float));
+            if (dst == NULL)
+                return false;
+            memcpy(dst, &value, sizeof(float));
+            return true;
+        }
+
+        bool BatchWriter::write_floats(const float *v, size_t count)
+        {
+            if (pCurr == NULL)
+                return false;
+            if (count <= 0)
+                return true;
+            uint8_t *dst        = append(count * sizeof(float));
+            if (dst == NULL)
+                return false;
+            memcpy(dst, v, count * sizeof(float));
+            return true;
+        }
+
+        float *BatchWriter::reserve_floats(size_t count)
+        {
+            if (pCurr == NULL)
+                return NULL;
+            return reinterpret_cast<float *>(append(count * sizeof(float)));
+        }
+
+        bool BatchWriter::write_bytes(const void *data, size_t bytes)
+        {
+            if (pCurr == NULL)
+                return false;
+            if (bytes <= 0)
+                return true;
+            uint8_t *dst        = append(bytes);
+            if (dst == NULL)
+                return false;
+            memcpy(dst, data, bytes);
+            memset(&dst[bytes], 0, align_size(bytes, sizeof(uint32_t)) - bytes);
+            return true;
+        }
+
+        void BatchWriter::end()
+        {
+            if (pCurr == NULL)
+                return;
+
+            pCurr->size     = nSize - pCurr->offset;
+            pCurr           = NULL;
+            ++nEntries;
+        }
+
+        void BatchWriter::cancel()
+        {
+            if (pCurr == NULL)
+                return;
+
+            nSize           = pCurr->id;
+            pCurr           = NULL;
+        }
+
+        const void *BatchWriter::build(size_t *size)
+        {
+            if (pCurr != NULL)
+                cancel();
+
+            // Append the index to the end of the data area, entries already have offsets
+            // relative to the beginning of the blob. The size of the data area is restored
+            // so the index gets overwritten by the next entry
+            const size_t data_size  = nSize;
+            const size_t index_size = nEntries * sizeof(batch_entry_t);
+            uint8_t *dst            = append(index_size);
+            if (dst == NULL)
+                return NULL;
+            if (index_size > 0)
+                memcpy(dst, vIndex, index_size);
+            const size_t total      = nSize;
+            nSize                   = data_size;
+
+            // Emit header
+            batch_header_t *hdr     = reinterpret_cast<batch_header_t *>(vData);
+            hdr->signature          = SIGNATURE;
+            hdr->entries            = nEntries;
+            hdr->size               = total;
+
+            *size                   = total;
+            return vData;
+        }
+
+        //---------------------------------------------------------------------
+        BatchReader::BatchReader()
+        {
+            pData       = NULL;
+            nSize       = 0;
+            vIndex      = NULL;
+            nEntries    = 0;
+            nEntry      = 0;
+            pHead       = NULL;
+            pTail       = NULL;
+            bSwap       = false;
+        }
+
+        BatchReader::~BatchReader()
+        {
+            pData       = NULL;
+            vIndex      = NULL;
+            pHead       = NULL;
+            pTail       = NULL;
+        }
+
+        uint32_t BatchReader::fetch(uint32_t value) const
+        {
+            return (bSwap) ? byte_swap(value) : value;
+        }
+
+        bool BatchReader::init(const void *data, size_t size, bool swap)
+        {
+            pData       = NULL;
+            nSize       = 0;
+            vIndex      = NULL;
+            nEntries    = 0;
+            nEntry      = 0;
+            pHead       = NULL;
+            pTail       = NULL;
+            bSwap       = swap;
+
+            // Validate the header
+            if ((data == NULL) || (size < sizeof(batch_header_t)))
+                return false;
+            if (reinterpret_cast<uintptr_t>(data) % sizeof(uint32_t))
+                return false;
+
+            const batch_header_t *hdr   = static_cast<const batch_header_t *>(data);
+            if (fetch(hdr->signature) != BatchWriter::SIGNATURE)
+                return false;
+            if (fetch(hdr->size) != size)
+                return false;
+            const size_t entries        = fetch(hdr->entries);
+            if (entries > (size - sizeof(batch_header_t)) / sizeof(batch_entry_t))
+                return false;
+
+            // The index is located at the end of the blob, entries may refer the data area only
+            pData       = static_cast<const uint8_t *>(data);
+            nSize       = size - entries * sizeof(batch_entry_t);
+            vIndex      = reinterpret_cast<const batch_entry_t *>(&pData[nSize]);
+            nEntries    = entries;
+
+            return true;
+        }
+
+        bool BatchReader::next(uint32_t *type, const char **id)
+        {
+            if (nEntry >= nEntries)
+                return false;
+
+            // Validate the entry
+            const batch_entry_t *e  = &vIndex[nEntry++];
+            const size_t id_off     = fetch(e->id);
+            const size_t offset     = fetch(e->offset);
+            const size_t size       = fetch(e->size);
+            if ((id_off >= offset) || (offset > nSize) || (size > nSize - offset))
+                return false;
+            if ((offset | size) % sizeof(uint32_t))
+                return false;
+
+            // Port identifier should be null-terminated
+            const char *str         = reinterpret_cast<const char *>(&pData[id_off]);
+            if (memchr(str, '\0', offset - id_off) == NULL)
+                return false;
+
+            *type       = fetch(e->type);
+            *id         = str;
+            pHead       = &pData[offset];
+            pTail       = &pHead[size];
+
+            return true;
+        }
+
+        bool BatchReader::read_uint32(uint32_t *value)
+        {
+            if (size_t(pTail - pHead) < sizeof(uint32_t))
+                return false;
+
+            uint32_t v;
+            memcpy(&v, pHead, sizeof(uint32_t));
+            pHead      += sizeof(uint32_t);
+            *value      = fetch(v);
+            return true;
+        }
+
+        bool BatchReader::read_float(float *value)
+        {
+            uint32_t v;
+            if (!read_uint32(&v))
+                return false;
+            memcpy(value, &v, sizeof(float));
+            return true;
+        }
+
+        const float *BatchReader::read_floats(size_t count)
+        {
+            const size_t bytes  = count * sizeof(float);
+            if (size_t(pTail - pHead) < bytes)
+                return NULL;
+
+            const float *res    = reinterpret_cast<const float *>(pHead);
+            pHead              += bytes;
+            return res;
+        }
+
+        const void *BatchReader::read_bytes(size_t bytes)
+        {
+            const size_t padded = align_size(bytes, sizeof(uint32_t));
+            if (size_t(pTail - pHead) < padded)
+                return NULL;
+
+            const void *res     = pHead;
+            pHead              += padded;
+            return res;
+        }
+
+    } /* namespace vst3 */
+} /* namespace lsp */
+
+
+#endif /* LSP_PLUG_IN_PLUG_FW_WRAP_VST3_IMPL_BATCH_H_ */
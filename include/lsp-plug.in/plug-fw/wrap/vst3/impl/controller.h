@@ -139,7 +139,7 @@ namespace lsp
 
                 case meta::R_MESH:
                     lsp_trace("creating mesh port %s", port->id);
-                    vup = new vst3::CtlMeshPort(port);
+                    vup = new vst3::CtlMeshPort(port, this);
                     break;
 
                 case meta::R_STREAM:
@@ -534,6 +534,252 @@ namespace lsp
             return NULL;
         }
 
+        bool Controller::receive_batch_meter(vst3::CtlPort *port, vst3::BatchReader *rd)
+        {
+            const meta::port_t *meta = port->metadata();
+            if ((meta == NULL) || (meta->role != meta::R_METER))
+                return false;
+
+            // Fetch meter value
+            float value = 0.0f;
+            if (!rd->read_float(&value))
+                return false;
+
+            // Sync value with meter port and notify listeners if value has changed
+            vst3::CtlMeterPort *p = static_cast<vst3::CtlMeterPort *>(port);
+            if (p->commit_value(value))
+                p->mark_changed();
+
+            return true;
+        }
+
+        bool Controller::receive_batch_mesh(vst3::CtlPort *port, vst3::BatchReader *rd)
+        {
+            const meta::port_t *meta = port->metadata();
+            if ((meta == NULL) || (!meta::is_mesh_port(meta)))
+                return false;
+
+            // Read number of buffers and number of elements per buffer
+            uint32_t buffers = 0, items = 0;
+            if ((!rd->read_uint32(&buffers)) || (!rd->read_uint32(&items)))
+                return false;
+            if ((buffers > meta->step) || (items > meta->start))
+            {
+                lsp_trace("Invalid mesh size buffers=%d, items=%d", int(buffers), int(items));
+                return false;
+            }
+
+            // Decode data for each buffer
+            plug::mesh_t *mesh = port->buffer<plug::mesh_t>();
+            for (size_t i=0; i<buffers; ++i)
+            {
+                const float *src = rd->read_floats(items);
+                if (src == NULL)
+                    return false;
+
+                if (rd->swapped())
+                {
+                    byte_swap_copy(mesh->pvData[i], src, items);
+                    dsp::saturate(mesh->pvData[i], items);
+                }
+                else
+                    dsp::copy_saturated(mesh->pvData[i], src, items);
+            }
+
+            // Update state of the mesh and notify
+            mesh->data(buffers, items);
+            port->mark_changed();
+
+            return true;
+        }
+
+        bool Controller::receive_batch_mesh_delta(vst3::CtlPort *port, vst3::BatchReader *rd)
+        {
+            const meta::port_t *meta = port->metadata();
+            if ((meta == NULL) || (!meta::is_mesh_port(meta)))
+                return false;
+
+            // Read the packet, it's byte order does not depend on the byte order of the batch
+            uint32_t size = 0;
+            if (!rd->read_uint32(&size))
+                return false;
+            const void *data = rd->read_bytes(size);
+            if (data == NULL)
+                return false;
+
+            // Apply changes to the mesh and notify
+            vst3::CtlMeshPort *p = static_cast<vst3::CtlMeshPort *>(port);
+            if (!p->apply_delta(data, size))
+                return false;
+            p->mark_changed();
+
+            return true;
+        }
+
+        bool Controller::receive_batch_frame_buffer(vst3::CtlPort *port, vst3::BatchReader *rd, bool half)
+        {
+            const meta::port_t *meta = port->metadata();
+            if ((meta == NULL) || (!meta::is_framebuffer_port(meta)))
+                return false;
+
+            // Read dimensions and range of rows
+            uint32_t rows = 0, cols = 0, first_row_id = 0, last_row_id = 0;
+            if ((!rd->read_uint32(&rows)) ||
+                (!rd->read_uint32(&cols)) ||
+                (!rd->read_uint32(&first_row_id)) ||
+                (!rd->read_uint32(&last_row_id)))
+                return false;
+            if ((rows > meta->start) || (cols > meta->step))
+                return false;
+
+            // Now parse each row
+            plug::frame_buffer_t *fbuffer = port->buffer<plug::frame_buffer_t>();
+            if ((!half) && (!rd->swapped()) && (cols == fbuffer->cols()))
+            {
+                // Rows are stored contiguously, copy them at once
+                const size_t count  = last_row_id - first_row_id;
+                if (count > fbuffer->rows())
+                    return false;
+                const float *src    = rd->read_floats(count * cols);
+                if (src == NULL)
+                    return false;
+                fbuffer->write_rows(first_row_id, src, count);
+            }
+            else
+            {
+                for (uint32_t row=first_row_id; row != last_row_id; ++row)
+                {
+                    // 16-bit floating-point values are always stored in little-endian byte order
+                    if (half)
+                    {
+                        const uint16_t *src = static_cast<const uint16_t *>(rd->read_bytes(cols * sizeof(uint16_t)));
+                        if (src == NULL)
+                            return false;
+                        core::decode_half(fbuffer->get_row(row), src, cols);
+                    }
+                    else
+                    {
+                        const float *src = rd->read_floats(cols);
+                        if (src == NULL)
+                            return false;
+
+                        float *dst = fbuffer->get_row(row);
+                        if (rd->swapped())
+                            byte_swap_copy(dst, src, cols);
+                        else
+                            dsp::copy(dst, src, cols);
+                    }
+                }
+            }
+
+            // Update state of the frame buffer and notify
+            fbuffer->seek(first_row_id);
+            port->mark_changed();
+
+            return true;
+        }
+
+        bool Controller::receive_batch_stream(vst3::CtlPort *port, vst3::BatchReader *rd)
+        {
+            const meta::port_t *meta = port->metadata();
+            if ((meta == NULL) || (!meta::is_stream_port(meta)))
+                return false;
+
+            // Read number of buffers and frames
+            uint32_t buffers = 0, frames = 0;
+            if ((!rd->read_uint32(&buffers)) || (!rd->read_uint32(&frames)))
+                return false;
+
+            // Read stream content
+            plug::stream_t *stream = port->buffer<plug::stream_t>();
+            if (buffers > stream->channels())
+                return false;
+
+            for (size_t i=0; i<frames; ++i)
+            {
+                // Read frame number and frame size
+                uint32_t frame_id = 0, frame_size = 0;
+                if ((!rd->read_uint32(&frame_id)) || (!rd->read_uint32(&frame_size)))
+                    return false;
+
+                // Cleanup stream if it is too far from actual state
+                uint32_t prev_id    = frame_id - 1;
+                if (stream->frame_id() != prev_id)
+                    stream->clear(prev_id);
+
+                // Read frame components
+                size_t f_size   = stream->add_frame(frame_size);
+                for (size_t j=0; j < buffers; ++j)
+                {
+                    const float *src = rd->read_floats(frame_size);
+                    if (src == NULL)
+                        return false;
+
+                    if (rd->swapped())
+                    {
+                        // The frame can be split into parts because of the frame buffer
+                        size_t count = 0;
+                        float *dst = stream->frame_data(j, 0, &count);
+                        byte_swap_copy(dst, src, count);
+                        if (count < f_size)
+                        {
+                            dst     = stream->frame_data(j, count, NULL);
+                            byte_swap_copy(dst, &src[count], f_size - count);
+                        }
+                    }
+                    else
+                        stream->write_frame(j, src, 0, f_size);
+                }
+
+                // Commit the frame for the stream
+                stream->commit_frame();
+            }
+            port->mark_changed();
+
+            return true;
+        }
+
+        bool Controller::receive_data_batch(const void *data, size_t size, bool swap)
+        {
+            vst3::BatchReader rd;
+            if (!rd.init(data, size, swap))
+            {
+                lsp_trace("Invalid data batch of size=%d", int(size));
+                return false;
+            }
+
+            uint32_t type = 0;
+            const char *id = NULL;
+            while (rd.next(&type, &id))
+            {
+                // Get port
+                vst3::CtlPort *port     = port_by_id(id);
+                if (port == NULL)
+                {
+                    lsp_trace("Not found port id=%s", id);
+                    continue;
+                }
+
+                // Decode the entry
+                bool decoded = false;
+                switch (type)
+                {
+                    case vst3::BATCH_METER:         decoded = receive_batch_meter(port, &rd); break;
+                    case vst3::BATCH_MESH:          decoded = receive_batch_mesh(port, &rd); break;
+                    case vst3::BATCH_FBUFFER:       decoded = receive_batch_frame_buffer(port, &rd, false); break;
+                    case vst3::BATCH_STREAM:        decoded = receive_batch_stream(port, &rd); break;
+                    case vst3::BATCH_MESH_DELTA:    decoded = receive_batch_mesh_delta(port, &rd); break;
+                    case vst3::BATCH_FBUFFER_HALF:  decoded = receive_batch_frame_buffer(port, &rd, true); break;
+                    default: break;
+                }
+
+                if (!decoded)
+                    lsp_trace("Failed to decode batch entry type=%d, id=%s", int(type), id);
+            }
+
+            return true;
+        }
+
         Steinberg::tresult PLUGIN_API Controller::notify(Steinberg::Vst::IMessage *message)
         {
             // Obtain the message data
@@ -663,29 +909,7 @@ namespace lsp
                 }
             #endif /* WITH_UI_FEATURE */
             }
-            else if (!strcmp(message_id, ID_MSG_METERS))
-            {
-                double value = 0.0;
-//                lsp_trace("Received message id=%s", message_id);
-
-                // Get actual value for each meter
-                for (lltl::iterator<vst3::CtlMeterPort> it = vMeters.values(); it; ++it)
-                {
-                    vst3::CtlMeterPort *p = it.get();
-                    if (p == NULL)
-                        continue;
-
-                    // Fetch meter value
-                    if (atts->getFloat(p->id(), value) != Steinberg::kResultOk)
-                        continue;
-
-                    // Sync value with meter port and notify listeners if value has changed
-//                    lsp_trace("Received meter id=%s, value=%f", p->id(), value);
-                    if (p->commit_value(value))
-                        p->mark_changed();
-                }
-            }
-            else if (!strcmp(message_id, ID_MSG_MESH))
+            else if (!strcmp(message_id, ID_MSG_DATA_BATCH))
             {
 //                lsp_trace("Received message id=%s", message_id);
 
@@ -693,255 +917,13 @@ namespace lsp
                 if (atts->getInt("endian", byte_order) != Steinberg::kResultOk)
                     return Steinberg::kResultFalse;
 
-                // Read identifier of the mesh port
-                const char *param_id = sRxNotifyBuf.get_string(atts, "id", byte_order);
-                if (param_id == NULL)
-                {
-                    lsp_trace("No mesh port identifier");
-                    return Steinberg::kResultFalse;
-                }
-
-                // Get port and validate it's type
-                vst3::CtlPort *port     = port_by_id(param_id);
-                if (port == NULL)
-                {
-                    lsp_trace("Not found mesh port id=%s", param_id);
-                    return Steinberg::kResultFalse;
-                }
-                const meta::port_t *meta = port->metadata();
-                if ((meta == NULL) || (!meta::is_mesh_port(meta)))
-                {
-                    lsp_trace("Not a mesh port id=%s", param_id);
-                    return Steinberg::kResultFalse;
-                }
-
-                // Read number of buffers
-                Steinberg::int64 buffers = 0;
-                if (atts->getInt("buffers", buffers) != Steinberg::kResultOk)
-                {
-                    lsp_trace("Not found attribute 'buffers'");
-                    return Steinberg::kResultFalse;
-                }
-                if ((buffers < 0) || (buffers > meta->step))
-                {
-                    lsp_trace("Invalid value buffers=%d", int(buffers));
-                    return Steinberg::kResultFalse;
-                }
-
-                // Read number of elements per buffer
-                Steinberg::int64 items = 0;
-                if (atts->getInt("items", items) != Steinberg::kResultOk)
-                {
-                    lsp_trace("Not found attribute 'items'");
-                    return Steinberg::kResultFalse;
-                }
-                if ((items < 0) || (items > meta->start))
-                {
-                    lsp_trace("Invalid value items=%d", int(items));
-                    return Steinberg::kResultFalse;
-                }
-
-                // Encode data for each buffer
-                plug::mesh_t *mesh = port->buffer<plug::mesh_t>();
-                const void *data = NULL;
-                Steinberg::uint32 sizeInBytes = 0;
-                for (size_t i=0, n=size_t(buffers); i<n; ++i)
-                {
-                    snprintf(key, sizeof(key), "data[%d]", int(i));
-                    if (atts->getBinary(key, data, sizeInBytes) != Steinberg::kResultOk)
-                    {
-                        lsp_trace("Failed to get binary for key=%s", key);
-                        return Steinberg::kResultFalse;
-                    }
-                    if (sizeInBytes != items * sizeof(float))
-                    {
-                        lsp_trace("size of binary key=%s does not match: size=%d, expected=%d",
-                            key, int(sizeInBytes), int(items * sizeof(float)));
-                        return Steinberg::kResultFalse;
-                    }
-
-                    if (byte_order != VST3_BYTEORDER)
-                    {
-                        byte_swap_copy(mesh->pvData[i], static_cast<const float *>(data), items);
-                        dsp::saturate(mesh->pvData[i], items);
-                    }
-                    else
-                        dsp::copy_saturated(mesh->pvData[i], static_cast<const float *>(data), items);
-                }
-
-                // Update state of the mesh and notify
-//                lsp_trace("Committed mesh data buffers=%d, items=%d", int(buffers), int(items));
-                mesh->data(buffers, items);
-                port->mark_changed();
-            }
-            else if (!strcmp(message_id, ID_MSG_FRAMEBUFFER))
-            {
-                // lsp_trace("Received message id=%s", message_id);
-
-                // Read endianess
-                if (atts->getInt("endian", byte_order) != Steinberg::kResultOk)
-                    return Steinberg::kResultFalse;
-
-                // Read identifier of the mesh port
-                const char *param_id = sRxNotifyBuf.get_string(atts, "id", byte_order);
-                if (param_id == NULL)
-                    return Steinberg::kResultFalse;
-
-                // Get port and validate it's type
-                vst3::CtlPort *port     = port_by_id(param_id);
-                if (port == NULL)
-                    return Steinberg::kResultFalse;
-                const meta::port_t *meta = port->metadata();
-                if ((meta == NULL) || (!meta::is_framebuffer_port(meta)))
-                    return Steinberg::kResultFalse;
-
-                // Read number of rows
-                Steinberg::int64 rows = 0;
-                if (atts->getInt("rows", rows) != Steinberg::kResultOk)
-                    return Steinberg::kResultFalse;
-                if ((rows < 0) || (rows > meta->start))
-                    return Steinberg::kResultFalse;
-
-                // Read number of columns
-                Steinberg::int64 cols = 0;
-                if (atts->getInt("cols", cols) != Steinberg::kResultOk)
-                    return Steinberg::kResultFalse;
-                if ((cols < 0) || (cols > meta->step))
-                    return Steinberg::kResultFalse;
-
-                // Read first row identifier
-                Steinberg::int64 first_row_id = 0;
-                if (atts->getInt("first_row_id", first_row_id) != Steinberg::kResultOk)
-                    return Steinberg::kResultFalse;
-                if (first_row_id < 0)
-                    return Steinberg::kResultFalse;
-
-                // Read first row identifier
-                Steinberg::int64 last_row_id = 0;
-                if (atts->getInt("last_row_id", last_row_id) != Steinberg::kResultOk)
-                    return Steinberg::kResultFalse;
-                if (last_row_id < 0)
-                    return Steinberg::kResultFalse;
-
-                // Now parse each vector
-                plug::frame_buffer_t *fbuffer = port->buffer<plug::frame_buffer_t>();
+                // Read the batch and decode it
                 const void *data = NULL;
                 Steinberg::uint32 sizeInBytes = 0;
-
-                for (uint32_t first_row=first_row_id, last_row=last_row_id, i=0; first_row != last_row; ++first_row, ++i)
-                {
-                    snprintf(key, sizeof(key), "row[%d]", int(i));
-                    if (atts->getBinary(key, data, sizeInBytes) != Steinberg::kResultOk)
-                        return Steinberg::kResultFalse;
-                    if (sizeInBytes != cols * sizeof(float))
-                        return Steinberg::kResultFalse;
-
-                    float *dst = fbuffer->get_row(first_row);
-                    if (byte_order != VST3_BYTEORDER)
-                        byte_swap_copy(dst, static_cast<const float *>(data), cols);
-                    else
-                        dsp::copy(dst, static_cast<const float *>(data), cols);
-                }
-
-                // Update state of the mesh and notify
-                fbuffer->seek(first_row_id);
-                port->mark_changed();
-            }
-            else if (!strcmp(message_id, ID_MSG_STREAM))
-            {
-//                lsp_trace("Received message id=%s", message_id);
-
-                // Read endianess
-                if (atts->getInt("endian", byte_order) != Steinberg::kResultOk)
-                    return Steinberg::kResultFalse;
-
-                // Read identifier of the mesh port
-                const char *param_id = sRxNotifyBuf.get_string(atts, "id", byte_order);
-                if (param_id == NULL)
-                    return Steinberg::kResultFalse;
-
-                // Get port and validate it's type
-                vst3::CtlPort *port    = port_by_id(param_id);
-                if (port == NULL)
-                    return Steinberg::kResultFalse;
-                const meta::port_t *meta = port->metadata();
-                if ((meta == NULL) || (!meta::is_stream_port(meta)))
-                    return Steinberg::kResultFalse;
-
-                // Read number of buffers
-                Steinberg::int64 buffers = 0;
-                if (atts->getInt("buffers", buffers) != Steinberg::kResultOk)
-                    return Steinberg::kResultFalse;
-                if (buffers < 0)
-                    return Steinberg::kResultFalse;
-
-                // Read number of frames
-                Steinberg::int64 frames = 0;
-                if (atts->getInt("frames", frames) != Steinberg::kResultOk)
+                if (atts->getBinary("data", data, sizeInBytes) != Steinberg::kResultOk)
                     return Steinberg::kResultFalse;
-                if (frames < 0)
+                if (!receive_data_batch(data, sizeInBytes, byte_order != VST3_BYTEORDER))
                     return Steinberg::kResultFalse;
-
-                // Read stream content
-                const void *data = NULL;
-                Steinberg::uint32 sizeInBytes = 0;
-                plug::stream_t *stream = port->buffer<plug::stream_t>();
-
-                for (size_t i=0, n=frames; i<n; ++i)
-                {
-                    // Read frame number
-                    Steinberg::int64 frame_id = 0;
-                    snprintf(key, sizeof(key), "frame_id[%d]", int(i));
-                    if (atts->getInt(key, frame_id) != Steinberg::kResultOk)
-                        return Steinberg::kResultFalse;
-
-                    // Read frame size
-                    Steinberg::int64 frame_size = 0;
-                    snprintf(key, sizeof(key), "frame_size[%d]", int(i));
-                    if (atts->getInt(key, frame_size) != Steinberg::kResultOk)
-                        return Steinberg::kResultFalse;
-
-                    // Cleanup stream if it is too far from actual state
-                    uint32_t prev_id    = frame_id - 1;
-                    if (stream->frame_id() != prev_id)
-                        stream->clear(prev_id);
-
-                    // Read frame components
-                    size_t f_size   = stream->add_frame(frame_size);
-                    for (size_t j=0, m=buffers; j < m; ++j)
-                    {
-                        snprintf(key, sizeof(key), "data[%d][%d]", int(i), int(j));
-                        if (atts->getBinary(key, data, sizeInBytes) != Steinberg::kResultOk)
-                            return Steinberg::kResultFalse;
-                        if (sizeInBytes != frame_size * sizeof(float))
-                        {
-//                            lsp_trace("mismatched size in bytes %d vs %d", int(sizeInBytes), int(frame_size * sizeof(float)));
-                            return Steinberg::kResultFalse;
-                        }
-
-                        // Copy frame buffer
-                        const float *src = reinterpret_cast<const float *>(data);
-                        if (byte_order != VST3_BYTEORDER)
-                        {
-                            // The frame can be split into parts because of the frame buffer
-                            size_t count = 0;
-                            float *dst = stream->frame_data(j, 0, &count);
-                            byte_swap_copy(dst, src, count);
-                            if (count < f_size)
-                            {
-                                dst     = stream->frame_data(j, count, NULL);
-                                byte_swap_copy(dst, &src[count], f_size - count);
-                            }
-                        }
-                        else
-                            stream->write_frame(j, src, 0, f_size);
-                    }
-
-                    // Commit the frame for the stream
-                    stream->commit_frame();
-//                    lsp_trace("deserialized frame id=%d of %d elements", int(frame_id), int(f_size));
-                }
-                port->mark_changed();
             }
             else if (!strcmp(message_id, ID_MSG_STRING))
             {
@@ -1172,13 +1154,15 @@ namespace lsp
                 return STATUS_CORRUPTED;
             }
 
-            // Lock the KVT
+            // Lock the KVT and apply all changes as a single transaction
             if (!sKVTMutex.lock())
             {
                 lsp_warn("Failed to lock KVT");
                 return STATUS_UNKNOWN_ERR;
             }
+            sKVT.begin_transaction();
             lsp_finally {
+                sKVT.commit_transaction();
                 sKVT.gc();
                 sKVTMutex.unlock();
             };
@@ -1242,6 +1226,15 @@ namespace lsp
 
                         core::copy_preset_state(&sPresetState, &state);
                     }
+                    else if (strcmp(name, "!kvt_snapshot") == 0)
+                    {
+                        // Skip private data for DSP code
+                        if ((res = vst3::deserialize_kvt_snapshot(&sKVT, is, core::KVT_TX | core::KVT_STATE, core::KVT_PRIVATE)) != STATUS_OK)
+                        {
+                            lsp_warn("Failed to deserialize KVT snapshot, error code=%d", int(res));
+                            return res;
+                        }
+                    }
                     else
                     {
                         lsp_warn("Unknown special variable: %s, skipping", name);
@@ -1699,6 +1692,14 @@ namespace lsp
                     return STATUS_NOT_FOUND;
             }
 
+            // The backend forgets the display widths requested for meshes
+            for (lltl::iterator<vst3::CtlPort> it=vPorts.values(); it; ++it)
+            {
+                vst3::CtlPort *p = it.get();
+                if ((p != NULL) && (meta::is_mesh_port(p->metadata())))
+                    static_cast<vst3::CtlMeshPort *>(p)->reset_display_width();
+            }
+
             // Notify backend about UI deactivation
             if (pPeerConnection != NULL)
             {
@@ -2080,6 +2081,38 @@ namespace lsp
                 pPeerConnection->notify(msg);
                 notify_preset_changed();
             }
+            else if (meta::is_mesh_port(meta))
+            {
+                vst3::CtlMeshPort *mp = static_cast<vst3::CtlMeshPort *>(port);
+                lsp_trace("port write: id=%s, display width=%d", port->id(), int(mp->display_width()));
+
+                // Check that we are available to send messages
+                if (pPeerConnection == NULL)
+                    return;
+
+                // Allocate new message
+                Steinberg::Vst::IMessage *msg = alloc_message(pHostApplication, bMsgWorkaround);
+                if (msg == NULL)
+                    return;
+                lsp_finally { safe_release(msg); };
+
+                // Initialize the message
+                msg->setMessageID(vst3::ID_MSG_MESH_DISPLAY_WIDTH);
+                Steinberg::Vst::IAttributeList *list = msg->getAttributes();
+
+                // Write port identifier
+                if (!sTxNotifyBuf.set_string(list, "id", meta->id))
+                    return;
+                // Write endianess
+                if (list->setInt("endian", VST3_BYTEORDER) != Steinberg::kResultOk)
+                    return;
+                // Write the display width
+                if (list->setInt("width", mp->display_width()) != Steinberg::kResultOk)
+                    return;
+
+                // Finally, we're ready to send message
+                pPeerConnection->notify(msg);
+            }
             else
             {
                 vst3::CtlParamPort *ip = static_cast<vst3::CtlParamPort *>(port);
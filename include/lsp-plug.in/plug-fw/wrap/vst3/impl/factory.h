@@ -25,12 +25,12 @@
 #include <lsp-plug.in/plug-fw/version.h>
 
 #include <lsp-plug.in/common/atomic.h>
-#include <lsp-plug.in/ipc/NativeExecutor.h>
 #include <lsp-plug.in/ipc/Thread.h>
 #include <lsp-plug.in/lltl/darray.h>
 #include <lsp-plug.in/lltl/phashset.h>
 #include <lsp-plug.in/plug-fw/const.h>
 #include <lsp-plug.in/plug-fw/plug.h>
+#include <lsp-plug.in/plug-fw/core/ExecutorPool.h>
 #include <lsp-plug.in/plug-fw/meta/types.h>
 #include <lsp-plug.in/plug-fw/meta/manifest.h>
 #include <lsp-plug.in/plug-fw/meta/func.h>
@@ -557,20 +557,12 @@ namespace lsp
                 return pExecutor;
             }
 
-            // Create executor
-            ipc::NativeExecutor *executor = new ipc::NativeExecutor();
+            // Acquire the process-wide executor pool. The pool is passed to plugins directly:
+            // each plugin wraps it with own executor which keeps track of submitted tasks
+            core::ExecutorPool *executor = core::ExecutorPool::acquire();
             if (executor == NULL)
                 return NULL;
-            lsp_trace("Allocated executor=%p", executor);
-
-            // Launch executor
-            status_t res = executor->start();
-            if (res != STATUS_OK)
-            {
-                lsp_trace("Failed to start executor=%p, code=%d", executor, int(res));
-                delete executor;
-                return NULL;
-            }
+            lsp_trace("Acquired executor=%p", executor);
 
             // Update status
             ++nRefExecutor;
@@ -590,9 +582,8 @@ namespace lsp
             if (pExecutor == NULL)
                 return;
 
-            lsp_trace("Destroying executor pExecutor=%p", pExecutor);
-            pExecutor->shutdown();
-            delete pExecutor;
+            lsp_trace("Releasing executor pExecutor=%p", pExecutor);
+            core::ExecutorPool::release(pExecutor);
             pExecutor   = NULL;
         }
 
@@ -29,6 +29,7 @@
 #include <lsp-plug.in/lltl/darray.h>
 #include <lsp-plug.in/lltl/phashset.h>
 #include <lsp-plug.in/plug-fw/const.h>
+#include <lsp-plug.in/plug-fw/core/decimate.h>
 #include <lsp-plug.in/plug-fw/plug.h>
 #include <lsp-plug.in/plug-fw/meta/types.h>
 #include <lsp-plug.in/plug-fw/meta/manifest.h>
@@ -52,17 +53,26 @@ namespace lsp
         //---------------------------------------------------------------------
         void Wrapper::VST3KVTListener::created(core::KVTStorage *storage, const char *id, const core::kvt_param_t *param, size_t pending)
         {
-            pWrapper->state_changed();
+            if (!(pending & core::KVT_BATCH))
+                pWrapper->state_changed();
         }
 
         void Wrapper::VST3KVTListener::changed(core::KVTStorage *storage, const char *id, const core::kvt_param_t *oval, const core::kvt_param_t *nval, size_t pending)
         {
-            pWrapper->state_changed();
+            if (!(pending & core::KVT_BATCH))
+                pWrapper->state_changed();
         }
 
         void Wrapper::VST3KVTListener::removed(core::KVTStorage *storage, const char *id, const core::kvt_param_t *param, size_t pending)
         {
-            pWrapper->state_changed();
+            if (!(pending & core::KVT_BATCH))
+                pWrapper->state_changed();
+        }
+
+        void Wrapper::VST3KVTListener::transaction(core::KVTStorage *storage, size_t changes)
+        {
+            if (changes > 0)
+                pWrapper->state_changed();
         }
 
         //---------------------------------------------------------------------
@@ -86,7 +96,9 @@ namespace lsp
             sUIPosition         = sPosition;
 
             pKVTDispatcher      = NULL;
-            pOscPacket          = NULL;
+            vParamQueues        = NULL;
+            nParamQueues        = 0;
+            nParamQueuesMax     = 0;
 
             atomic_init(nPositionLock);
             nUICounterReq       = 0;
@@ -872,12 +884,6 @@ namespace lsp
                 return Steinberg::kInternalError;
             }
 
-            // Allocate OSC packet data
-            lsp_trace("Creating OSC data buffer");
-            pOscPacket      = reinterpret_cast<uint8_t *>(::malloc(OSC_PACKET_MAX));
-            if (pOscPacket == NULL)
-                return Steinberg::kOutOfMemory;
-
             if (meta->extensions & meta::E_KVT_SYNC)
             {
                 lsp_trace("Binding KVT listener");
@@ -889,6 +895,7 @@ namespace lsp
             // Initialize plugin
             lsp_trace("Initializing plugin");
             pPlugin->init(this, plugin_ports.array());
+            sSilence.init(pPlugin, plugin_ports.array(), plugin_ports.size());
 
             // Create sample player if required
             if (meta->extensions & meta::E_FILE_PREVIEW)
@@ -930,6 +937,9 @@ namespace lsp
                 pExecutor       = NULL;
             }
 
+            // Destroy silence detector
+            sSilence.destroy();
+
             // Destroy sample player
             if (pSamplePlayer != NULL)
             {
@@ -953,12 +963,6 @@ namespace lsp
                 pPlugin         = NULL;
             }
 
-            // Delete temporary buffer for OSC serialization
-            if (pOscPacket != NULL)
-            {
-                ::free(pOscPacket);
-                pOscPacket = NULL;
-            }
 
             // Release host context
             safe_release(pHostContext);
@@ -994,6 +998,13 @@ namespace lsp
             vFBuffers.flush();
             vStreams.flush();
             vParamMapping.flush();
+            if (vParamQueues != NULL)
+            {
+                ::free(vParamQueues);
+                vParamQueues        = NULL;
+            }
+            nParamQueues    = 0;
+            nParamQueuesMax = 0;
             pEventsIn   = NULL;
             pEventsOut  = NULL;
 
@@ -1221,7 +1232,10 @@ namespace lsp
             if (state != pPlugin->active())
             {
                 if (state)
+                {
                     pPlugin->activate();
+                    sSilence.reset();
+                }
                 else
                     pPlugin->deactivate();
             }
@@ -1229,59 +1243,6 @@ namespace lsp
             return Steinberg::kResultOk;
         }
 
-        status_t Wrapper::save_kvt_parameters_v1(Steinberg::IBStream *os, core::KVTStorage *kvt)
-        {
-            status_t res;
-            const core::kvt_param_t *p = NULL;
-
-            // Read the whole KVT storage
-            core::KVTIterator *it = kvt->enum_all();
-            while (it->next() == STATUS_OK)
-            {
-                // Get parameter
-                res             = it->get(&p);
-                if (res == STATUS_NOT_FOUND) // Not a parameter
-                    continue;
-                else if (res != STATUS_OK)
-                {
-                    lsp_warn("it->get() returned %d", int(res));
-                    return res;
-                }
-                else if (it->is_transient()) // Skip transient parameters
-                    continue;
-
-                // Privacy flag
-                uint8_t flags   = 0;
-                if (it->is_private())
-                    flags          |= vst3::FLAG_PRIVATE;
-
-                const char *name = it->name();
-                if (name == NULL)
-                {
-                    lsp_trace("it->name() returned NULL");
-                    return STATUS_CORRUPTED;
-                }
-
-                kvt_dump_parameter("Saving state of KVT parameter: %s = ", p, name);
-
-                // Serialize parameter name and flags
-                if ((res = write_string(os, name)) != STATUS_OK)
-                {
-                    lsp_warn("Failed to save KVT parameter name for id = %s", name);
-                    return res;
-                }
-
-                // Successful status?
-                if ((res = write_kvt_value(os, p, flags)) != STATUS_OK)
-                {
-                    lsp_warn("KVT parameter serialization failed id=%s", name);
-                    return res;
-                }
-            } // while
-
-            return STATUS_OK;
-        }
-
         status_t Wrapper::save_state(Steinberg::IBStream *os)
         {
             status_t res;
@@ -1326,12 +1287,15 @@ namespace lsp
                 }
                 else if (meta::is_string_holding_port(meta))
                 {
-                    const char *str = p->buffer<char>();
+                    // Take the consistent copy of the value since it can be changed by the real-time thread
+                    plug::string_t *xs  = static_cast<vst3::StringPort *>(p)->data();
+                    char *str = (xs != NULL) ? xs->snapshot() : NULL;
                     if (str == NULL)
                     {
                         lsp_trace("value == NULL for STRING port");
                         return STATUS_CORRUPTED;
                     }
+                    lsp_finally { free(str); };
 
                     lsp_trace("Saving state of string parameter: %s = %s", meta->id, str);
                     if ((res = write_value(os, meta->id, 's', str)) != STATUS_OK)
@@ -1369,7 +1333,7 @@ namespace lsp
             if (sKVTMutex.lock())
             {
                 lsp_finally { sKVTMutex.unlock(); };
-                res = save_kvt_parameters_v1(os, &sKVT);
+                res = serialize_kvt_snapshot(os, &sKVT);
                 if (res != STATUS_OK)
                     lsp_trace("Failed saving KVT parameters");
                 sKVT.gc();
@@ -1417,13 +1381,15 @@ namespace lsp
                 return STATUS_CORRUPTED;
             }
 
-            // Lock the KVT
+            // Lock the KVT and apply all changes as a single transaction
             if (!sKVTMutex.lock())
             {
                 lsp_warn("Failed to lock KVT");
                 return STATUS_UNKNOWN_ERR;
             }
+            sKVT.begin_transaction();
             lsp_finally {
+                sKVT.commit_transaction();
                 sKVT.gc();
                 sKVTMutex.unlock();
             };
@@ -1490,6 +1456,14 @@ namespace lsp
 
                         set_preset_state(&state, PT_STATE);
                     }
+                    else if (strcmp(name, "!kvt_snapshot") == 0)
+                    {
+                        if ((res = deserialize_kvt_snapshot(&sKVT, is, core::KVT_TX | core::KVT_STATE, 0)) != STATUS_OK)
+                        {
+                            lsp_warn("Failed to deserialize KVT snapshot, error code=%d", int(res));
+                            return res;
+                        }
+                    }
                     else
                     {
                         lsp_warn("Unknown special variable: %s, skipping", name);
@@ -1865,6 +1839,18 @@ namespace lsp
             if (setup.symbolicSampleSize != Steinberg::Vst::kSample32)
                 return Steinberg::kInvalidArgument;
 
+            // Pre-allocate the heap of parameter change queues to avoid allocations in the processing thread,
+            // the host passes not more than one queue per parameter
+            if (nParamQueuesMax < vParams.size())
+            {
+                param_queue_t *queues   = static_cast<param_queue_t *>(::realloc(vParamQueues, sizeof(param_queue_t) * vParams.size()));
+                if (queues == NULL)
+                    return Steinberg::kOutOfMemory;
+                vParamQueues        = queues;
+                nParamQueuesMax     = vParams.size();
+            }
+            nParamQueues        = 0;
+
             // Save new sample rate
             size_t sample_rate = setup.sampleRate;
             if (sample_rate > MAX_SAMPLE_RATE)
@@ -1988,22 +1974,64 @@ namespace lsp
             return NULL;
         }
 
-        size_t Wrapper::prepare_block(int32_t frame, Steinberg::Vst::ProcessData *data)
+        bool Wrapper::param_queue_less(const param_queue_t *a, const param_queue_t *b)
         {
+            if (a->nOffset != b->nOffset)
+                return a->nOffset < b->nOffset;
+            return a->nOrder < b->nOrder;
+        }
+
+        bool Wrapper::fetch_param_change(param_queue_t *q)
+        {
+            if (q->nIndex >= q->nCount)
+                return false;
+
+            Steinberg::int32 sampleOffset;
+            if (q->pQueue->getPoint(q->nIndex++, sampleOffset, q->fValue) != Steinberg::kResultOk)
+                return false;
+
+            // Points of the queue should be ordered, do not allow them to move back in time
+            q->nOffset      = lsp_max(q->nOffset, int32_t(sampleOffset));
+            return true;
+        }
+
+        void Wrapper::sift_param_queue(size_t index)
+        {
+            param_queue_t tmp   = vParamQueues[index];
+
+            while (true)
+            {
+                size_t child        = index * 2 + 1;
+                if (child >= nParamQueues)
+                    break;
+                if (((child + 1) < nParamQueues) && (param_queue_less(&vParamQueues[child + 1], &vParamQueues[child])))
+                    ++child;
+                if (!param_queue_less(&vParamQueues[child], &tmp))
+                    break;
+
+                vParamQueues[index] = vParamQueues[child];
+                index               = child;
+            }
+
+            vParamQueues[index] = tmp;
+        }
+
+        void Wrapper::build_param_changes(Steinberg::Vst::ProcessData *data)
+        {
+            nParamQueues    = 0;
+
             // Obtain number of parameters
             Steinberg::Vst::IParameterChanges *changes = data->inputParameterChanges;
-            size_t num_params = (changes != NULL) ? changes->getParameterCount() : 0;
+            const size_t num_params = (changes != NULL) ? changes->getParameterCount() : 0;
             if (num_params <= 0)
-                return data->numSamples - frame;
-
-            int32_t first_change = data->numSamples;
-            Steinberg::int32 sampleOffset;
-            Steinberg::Vst::ParamValue value;
+                return;
 
-            // Pass 1: find the most recent change in change queues
-            for (size_t i=0; i<num_params; ++i)
+            // Resolve the port of each queue once, the points of each queue are already ordered by time
+            for (size_t i=0; (i<num_params) && (nParamQueues < nParamQueuesMax); ++i)
             {
                 Steinberg::Vst::IParamValueQueue *queue = changes->getParameterData(i);
+                if (queue == NULL)
+                    continue;
                 // We do not analyze MIDI mapping ports here
                 if (queue->getParameterId() >= vst3::MIDI_MAPPING_PARAM_BASE)
                     continue;
@@ -2011,53 +2039,51 @@ namespace lsp
                 if (port == NULL)
                     continue;
 
-                // Lookup for the first change
-                for (ssize_t index = port->change_index(), changes = queue->getPointCount(); index < changes; )
-                {
-                    if (queue->getPoint(index, sampleOffset, value) != Steinberg::kResultOk)
-                        break;
+                param_queue_t *q    = &vParamQueues[nParamQueues];
+                q->pQueue           = queue;
+                q->pPort            = port;
+                q->fValue           = 0.0;
+                q->nOffset          = 0;
+                q->nIndex           = 0;
+                q->nCount           = queue->getPointCount();
+                q->nOrder           = uint32_t(i);
 
-                    if (sampleOffset < frame)
-                        port->set_change_index(++index);
-                    else
-                    {
-                        first_change = lsp_min(first_change, sampleOffset);
-                        break;
-                    }
-                }
+                if (fetch_param_change(q))
+                    ++nParamQueues;
             }
 
-            // Pass 2: adjust port values accoding to the pending changes
-            for (size_t i=0; i<num_params; ++i)
-            {
-                Steinberg::Vst::IParamValueQueue *queue = changes->getParameterData(i);
+            // Build the min-heap of queues ordered by the offset of the next change
+            for (size_t i = nParamQueues >> 1; i > 0; )
+                sift_param_queue(--i);
+        }
 
-                // We do not analyze MIDI mapping ports here
-                if (queue->getParameterId() >= vst3::MIDI_MAPPING_PARAM_BASE)
-                    continue;
-                vst3::ParameterPort *port = input_parameter(queue->getParameterId());
-                if (port == NULL)
-                    continue;
+        size_t Wrapper::prepare_block(int32_t frame, Steinberg::Vst::ProcessData *data)
+        {
+            if (nParamQueues <= 0)
+                return data->numSamples - frame;
 
-                // Obtain the change point
-                const ssize_t index = port->change_index();
-                if (index >= queue->getPointCount())
-                    continue;
-                if (queue->getPoint(index, sampleOffset, value) != Steinberg::kResultOk)
-                    continue;
+            // Apply all changes that happen at the nearest change point, the queues are merged
+            // on the fly by taking the next change from the queue at the top of the heap.
+            // Points placed by the host past the end of the block are applied with the last sub-block.
+            const int32_t num_samples   = data->numSamples;
+            const int32_t first_change  = lsp_max(frame, lsp_min(vParamQueues[0].nOffset, num_samples));
+            while ((nParamQueues > 0) && (lsp_min(vParamQueues[0].nOffset, num_samples) <= first_change))
+            {
+                param_queue_t *q            = &vParamQueues[0];
+                vst3::ParameterPort *port   = q->pPort;
+                const float value           = vst3::from_vst_value(port->metadata(), q->fValue);
 
-                // The value has changed?
-                if (sampleOffset <= first_change)
+                if (port->commit_value(value))
                 {
-                    port->set_change_index(index + 1);  // We already can move the change index forward
-                    value = vst3::from_vst_value(port->metadata(), value);
-
-                    if (port->commit_value(value))
-                    {
-                        lsp_trace("port changed: %s=%f", port->id(), value);
-                        bUpdateSettings     = true;
-                    }
+                    lsp_trace("port changed: %s=%f", port->id(), value);
+                    bUpdateSettings     = true;
                 }
+
+                // Advance the queue or remove it from the heap
+                if (!fetch_param_change(q))
+                    vParamQueues[0]     = vParamQueues[--nParamQueues];
+                if (nParamQueues > 0)
+                    sift_param_queue(0);
             }
 
             return first_change - frame;
@@ -2379,7 +2405,7 @@ namespace lsp
                     continue;
 
                 plug::midi_t *queue = p->queue();
-                queue->clear();
+                p->clear();
 
                 // Process parameter changes
                 if (bMidiMapping)
@@ -2420,7 +2446,7 @@ namespace lsp
                             if (decode_parameter_as_midi_event(e, offset, id - vst3::MIDI_MAPPING_PARAM_BASE, value))
                             {
                                 port->commit_value(value);
-                                queue->push(e);
+                                queue->insert(e);
                             }
                         }
                     }
@@ -2443,11 +2469,8 @@ namespace lsp
 
                     // Process the event
                     if (decode_midi_event(e, ev))
-                        queue->push(e);
+                        queue->insert(e);
                 }
-
-                // Sort input events
-                queue->sort();
             }
         }
 
@@ -2608,7 +2631,7 @@ namespace lsp
             {
                 vst3::MidiPort *p = pEventsOut->vPorts[i];
                 if (p != NULL)
-                    p->queue()->clear();
+                    p->clear();
             }
         }
 
@@ -2627,8 +2650,7 @@ namespace lsp
 
                 plug::midi_t *queue = p->queue();
 
-                // Sort and encode events
-                queue->sort();
+                // Events are merged in chronological order on commit, just encode them
 
                 for (size_t j=0; j<queue->nEvents; ++j)
                 {
@@ -2692,6 +2714,8 @@ namespace lsp
             if (data.symbolicSampleSize != Steinberg::Vst::kSample32)
                 return Steinberg::kInternalError;
 
+            const uint64_t block_ts = profile_begin();
+
             // Update UI activity state
             toggle_ui_state();
 
@@ -2703,13 +2727,8 @@ namespace lsp
             clear_output_events();
             process_input_events(data.inputEvents, data.inputParameterChanges);
 
-            // Reset change indices for parameters
-            for (size_t i=0, n=vParams.size(); i<n; ++i)
-            {
-                vst3::ParameterPort *p = vParams.uget(i);
-                if (p != NULL)
-                    p->set_change_index(0);
-            }
+            // Build the schedule of parameter changes
+            build_param_changes(&data);
 
             // Trigger settings update if any of input parameters has changed
             check_parameters_updated();
@@ -2728,7 +2747,9 @@ namespace lsp
             if (pShmClient != NULL)
             {
                 pShmClient->begin(data.numSamples);
+                const uint64_t shm_ts = profile_begin();
                 pShmClient->pre_process(data.numSamples);
+                profile_end(core::DSP_PROBE_SHM_PRE, shm_ts, data.numSamples);
             }
 
             for (int32_t frame=0; frame < data.numSamples; )
@@ -2739,7 +2760,12 @@ namespace lsp
 //                lsp_trace("block size=%d", int(block_size));
 
                 // Update the settings for the plugin
-                apply_settings_update();
+                if (bUpdateSettings)
+                {
+                    const uint64_t settings_ts = profile_begin();
+                    apply_settings_update();
+                    profile_end(core::DSP_PROBE_SETTINGS, settings_ts, block_size);
+                }
 
                 // Call the plugin for processing
                 if (block_size > 0)
@@ -2753,11 +2779,22 @@ namespace lsp
 
                     sPosition.frame     = frame;
                     pPlugin->set_position(&sPosition);
-                    pPlugin->process(block_size);
+                    if (sSilence.idle(block_size))
+                        sSilence.silence(block_size);
+                    else
+                    {
+                        const uint64_t process_ts = profile_begin();
+                        pPlugin->process(block_size);
+                        profile_end(core::DSP_PROBE_PROCESS, process_ts, block_size);
+                    }
 
                     // Call the sampler for processing
                     if (pSamplePlayer != NULL)
+                    {
+                        const uint64_t player_ts = profile_begin();
                         pSamplePlayer->process(block_size);
+                        profile_end(core::DSP_PROBE_SAMPLE_PLAYER, player_ts, block_size);
+                    }
 
                     // Do the post-processing stuff
                     if (pEventsOut != NULL)
@@ -2778,7 +2815,9 @@ namespace lsp
 
             if (pShmClient != NULL)
             {
+                const uint64_t shm_ts = profile_begin();
                 pShmClient->post_process(data.numSamples);
+                profile_end(core::DSP_PROBE_SHM_POST, shm_ts, data.numSamples);
                 pShmClient->end();
             }
 
@@ -2790,6 +2829,8 @@ namespace lsp
                 nDumpResp               = dump_req;
             }
 
+            profile_end(core::DSP_PROBE_BLOCK, block_ts, data.numSamples);
+
             return Steinberg::kResultOk;
         }
 
@@ -2999,6 +3040,39 @@ namespace lsp
                     str->submit(in_str, false);
                 }
             }
+            else if (!strcmp(message_id, ID_MSG_MESH_DISPLAY_WIDTH))
+            {
+                // Get endianess
+                if ((res = atts->getInt("endian", byte_order)) != Steinberg::kResultOk)
+                {
+                    lsp_warn("Failed to read property 'endian'");
+                    return Steinberg::kResultFalse;
+                }
+
+                // Get port identifier
+                const char *id = sRxNotifyBuf.get_string(atts, "id", byte_order);
+                if (id == NULL)
+                    return Steinberg::kResultFalse;
+
+                // Find mesh port
+                plug::IPort *p = find_port(id, &vMeshes);
+                if (p == NULL)
+                {
+                    lsp_warn("Invalid mesh port specified: %s", id);
+                    return Steinberg::kResultFalse;
+                }
+
+                // Get the display width
+                Steinberg::int64 width = 0;
+                if ((res = atts->getInt("width", width)) != Steinberg::kResultOk)
+                {
+                    lsp_warn("Failed to read property 'width'");
+                    return Steinberg::kResultFalse;
+                }
+
+                lsp_trace("mesh %s display width = %d", id, int(width));
+                static_cast<vst3::MeshPort *>(p)->set_display_width(lsp_max(width, 0));
+            }
             else if (!strcmp(message_id, vst3::ID_MSG_VIRTUAL_PARAMETER))
             {
                 // Get port identifier
@@ -3046,6 +3120,10 @@ namespace lsp
             else if (!strcmp(message_id, vst3::ID_MSG_DEACTIVATE_UI))
             {
                 atomic_add(&nUICounterReq, -1);
+
+                // Remaining UIs receive meshes in original resolution until they request the width again
+                for (lltl::iterator<plug::IPort> it=vMeshes.values(); it; ++it)
+                    static_cast<vst3::MeshPort *>(it.get())->reset_display_width();
             }
             else if (!strcmp(message_id, vst3::ID_MSG_DUMP_STATE))
             {
@@ -3242,20 +3320,25 @@ namespace lsp
             if (pKVTDispatcher == NULL)
                 return;
 
-            size_t size = 0;
+            osc::packet_t packet;
             bool encoded = true;
 
             do
             {
                 pKVTDispatcher->iterate();
-                status_t res = pKVTDispatcher->fetch(pOscPacket, &size, OSC_PACKET_MAX);
+                if (!pKVTDispatcher->tx_trylock())
+                    break;
+                lsp_finally { pKVTDispatcher->tx_unlock(); };
+
+                status_t res = pKVTDispatcher->peek(&packet);
 
                 switch (res)
                 {
                     case STATUS_OK:
                     {
-                        lsp_trace("Sending DSP->UI KVT message of %d bytes", int(size));
-//                        osc::dump_packet(pOscPacket, size);
+                        lsp_trace("Sending DSP->UI KVT message of %d bytes", int(packet.size));
+//                        osc::dump_packet(&packet);
+                        lsp_finally { pKVTDispatcher->release(); };
 
                         // Allocate new message
                         Steinberg::Vst::IMessage *msg = alloc_message(pHostApplication, bMsgWorkaround);
@@ -3267,16 +3350,11 @@ namespace lsp
                         msg->setMessageID(vst3::ID_MSG_KVT);
                         Steinberg::Vst::IAttributeList *list = msg->getAttributes();
 
-                        encoded = list->setBinary("data", pOscPacket, size) == Steinberg::kResultOk;
+                        encoded = list->setBinary("data", packet.data, packet.size) == Steinberg::kResultOk;
                         pPeerConnection->notify(msg);
                         break;
                     }
 
-                    case STATUS_OVERFLOW:
-                        lsp_warn("Received too big OSC packet, skipping");
-                        pKVTDispatcher->skip();
-                        break;
-
                     case STATUS_NO_DATA:
                         encoded = false;
                         break;
@@ -3289,36 +3367,27 @@ namespace lsp
             } while (encoded);
         }
 
-        void Wrapper::transmit_meter_values()
+        void Wrapper::batch_meter_values()
         {
-            if (vMeters.is_empty())
-                return;
-
-            // Allocate new message
-            Steinberg::Vst::IMessage *msg = alloc_message(pHostApplication, bMsgWorkaround);
-            if (msg == NULL)
-                return;
-            lsp_finally { safe_release(msg); };
-
-            // Initialize the message
-            msg->setMessageID(vst3::ID_MSG_METERS);
-            Steinberg::Vst::IAttributeList *list = msg->getAttributes();
-
             for (lltl::iterator<vst3::MeterPort> it = vMeters.values(); it; ++it)
             {
-                // Write the actual value
-                if (list->setFloat(it->id(), it->display()) != Steinberg::kResultOk)
+                vst3::MeterPort *p = it.get();
+                if (p == NULL)
+                    continue;
+
+                if (!sTxBatch.begin(vst3::BATCH_METER, p->id()))
                     return;
+                if (!sTxBatch.write_float(p->display()))
+                {
+                    sTxBatch.cancel();
+                    return;
+                }
+                sTxBatch.end();
             }
-
-            // Notify receiver
-            pPeerConnection->notify(msg);
         }
 
-        void Wrapper::transmit_mesh_states()
+        void Wrapper::batch_mesh_states()
         {
-            Steinberg::char8 key[32];
-
             for (lltl::iterator<plug::IPort> it = vMeshes.values(); it; ++it)
             {
                 // Check that we have data in mesh
@@ -3329,54 +3398,57 @@ namespace lsp
                 if ((mesh == NULL) || (!mesh->containsData()))
                     continue;
 
-                // Allocate new message
-                Steinberg::Vst::IMessage *msg = alloc_message(pHostApplication, bMsgWorkaround);
-                if (msg == NULL)
-                    continue;
-                lsp_finally { safe_release(msg); };
-
-                // Initialize the message
-                msg->setMessageID(vst3::ID_MSG_MESH);
-                Steinberg::Vst::IAttributeList *list = msg->getAttributes();
-
-                // Write endianess
-                if (list->setInt("endian", VST3_BYTEORDER) != Steinberg::kResultOk)
-                    continue;
-                // Write identifier of the mesh port
-                if (!sTxNotifyBuf.set_string(list, "id", m_port->metadata()->id))
-                    continue;
-                // Write number of buffers
-                if (list->setInt("buffers", mesh->nBuffers) != Steinberg::kResultOk)
-                    continue;
-                // Write number of elements per buffer
-                if (list->setInt("items", mesh->nItems) != Steinberg::kResultOk)
-                    continue;
-
-                // Encode data for each buffer
-                bool encoded = true;
-                for (size_t i=0; i<mesh->nBuffers; ++i)
+                bool encoded        = false;
+                if (m_port->delta())
                 {
-                    snprintf(key, sizeof(key), "data[%d]", int(i));
-                    if (list->setBinary(key, mesh->pvData[i], mesh->nItems * sizeof(float)) != Steinberg::kResultOk)
+                    // Write only changed data of the mesh
+                    const size_t size   = m_port->encode_delta();
+                    if (size <= 0)
+                        continue;
+                    if (!sTxBatch.begin(vst3::BATCH_MESH_DELTA, m_port->metadata()->id))
                     {
-                        encoded     = false;
-                        break;
+                        m_port->reset_delta();
+                        continue;
+                    }
+                    encoded = (sTxBatch.write_uint32(size)) && (sTxBatch.write_bytes(m_port->delta_data(), size));
+                }
+                else
+                {
+                    // Write header and data for each buffer, reduce data to the display width if requested
+                    const size_t width  = m_port->display_width();
+                    const size_t items  = core::decimated_size(mesh->nItems, width);
+                    if (!sTxBatch.begin(vst3::BATCH_MESH, m_port->metadata()->id))
+                        continue;
+                    encoded = (sTxBatch.write_uint32(mesh->nBuffers)) && (sTxBatch.write_uint32(items));
+                    for (size_t i=0; (encoded) && (i<mesh->nBuffers); ++i)
+                    {
+                        float *dst  = sTxBatch.reserve_floats(items);
+                        if (dst == NULL)
+                            encoded     = false;
+                        else if (i == 0)
+                            core::decimate_argument(dst, mesh->pvData[i], mesh->nItems, width);
+                        else
+                            core::decimate_envelope(dst, mesh->pvData[i], mesh->nItems, width);
                     }
                 }
-                if (!encoded)
-                    continue;
 
-                // Finally, we're ready to send message
-                if (pPeerConnection->notify(msg) == Steinberg::kResultOk)
-                    mesh->cleanup();
+                // Remember mesh for cleanup after transmission
+                batch_commit_t *c = (encoded) ? vTxCommits.add() : NULL;
+                if (c == NULL)
+                {
+                    sTxBatch.cancel();
+                    m_port->reset_delta();
+                    continue;
+                }
+                c->pPort        = m_port;
+                c->nType        = vst3::BATCH_MESH;
+                c->nId          = 0;
+                sTxBatch.end();
             }
         }
 
-        void Wrapper::transmit_frame_buffers()
+        void Wrapper::batch_frame_buffers()
         {
-            Steinberg::char8 key[32];
-
-            // Synchronize frame buffers
             for (lltl::iterator<plug::IPort> it=vFBuffers.values(); it; ++it)
             {
                 // Get the frame buffer data
@@ -3387,79 +3459,62 @@ namespace lsp
                 if (fb == NULL)
                     continue;
 
-                // Serialize not more than 4 rows
+                // Serialize not more than FRAMEBUFFER_BULK_MAX rows
                 size_t delta = fb->next_rowid() - fb_port->row_id();
                 if (delta == 0)
                     continue;
                 uint32_t first_row = (delta > fb->rows()) ? fb->next_rowid() - fb->rows() : fb_port->row_id();
                 if (delta > FRAMEBUFFER_BULK_MAX)
                     delta = FRAMEBUFFER_BULK_MAX;
-                uint32_t last_row = first_row + delta;
+                const uint32_t last_row = first_row + delta;
 
-                // lsp_trace("id = %s, first=%d, last=%d", fb_port->metadata()->id, int(first_row), int(last_row));
-
-                // Allocate new message
-                Steinberg::Vst::IMessage *msg = alloc_message(pHostApplication, bMsgWorkaround);
-                if (msg == NULL)
+                // Write header and data for each row, display-only rows are transmitted as 16-bit floating-point values
+                uint16_t *half      = fb_port->half_row();
+                if (!sTxBatch.begin((half != NULL) ? vst3::BATCH_FBUFFER_HALF : vst3::BATCH_FBUFFER, fb_port->metadata()->id))
                     continue;
-                lsp_finally { safe_release(msg); };
-
-                // Initialize the message
-                msg->setMessageID(vst3::ID_MSG_FRAMEBUFFER);
-                Steinberg::Vst::IAttributeList *list = msg->getAttributes();
-
-                // Write endianess
-                if (list->setInt("endian", VST3_BYTEORDER) != Steinberg::kResultOk)
-                    continue;
-                // Write identifier of the frame buffer port
-                if (!sTxNotifyBuf.set_string(list, "id", fb_port->metadata()->id))
-                    continue;
-                // Write number of rows
-                if (list->setInt("rows", fb->rows()) != Steinberg::kResultOk)
-                    continue;
-                // Write number of columns
-                if (list->setInt("cols", fb->cols()) != Steinberg::kResultOk)
-                    continue;
-                // Write number of first row
-                if (list->setInt("first_row_id", first_row) != Steinberg::kResultOk)
-                    continue;
-                // Write number of last row
-                if (list->setInt("last_row_id", last_row) != Steinberg::kResultOk)
-                    continue;
-
-                // Encode data for each row
-                bool encoded = true;
-                for (size_t i=0; first_row != last_row; ++i, ++first_row)
-                {
-                    snprintf(key, sizeof(key), "row[%d]", int(i));
-                    if (list->setBinary(key, fb->get_row(first_row), fb->cols() * sizeof(float)) != Steinberg::kResultOk)
+                bool encoded =
+                    (sTxBatch.write_uint32(fb->rows())) &&
+                    (sTxBatch.write_uint32(fb->cols())) &&
+                    (sTxBatch.write_uint32(first_row)) &&
+                    (sTxBatch.write_uint32(last_row));
+                if (half != NULL)
+                {
+                    for ( ; (encoded) && (first_row != last_row); ++first_row)
                     {
-                        encoded     = false;
-                        break;
+                        core::encode_half(half, fb->get_row(first_row), fb->cols());
+                        encoded     = sTxBatch.write_bytes(half, fb->cols() * sizeof(uint16_t));
                     }
                 }
-                if (!encoded)
-                    continue;
+                else if (encoded)
+                {
+                    // Write the whole range of rows directly from the frame buffer
+                    plug::data_view_t v;
+                    fb->view_rows(&v, first_row, last_row - first_row);
+                    encoded     = (sTxBatch.write_floats(v.head, v.head_size)) && (sTxBatch.write_floats(v.tail, v.tail_size));
+                }
 
-                // Finally, we're ready to send message
-                if (pPeerConnection->notify(msg) == Steinberg::kResultOk)
-                    fb_port->set_row_id(first_row);
+                // Remember the last row for commit after transmission
+                batch_commit_t *c = (encoded) ? vTxCommits.add() : NULL;
+                if (c == NULL)
+                {
+                    sTxBatch.cancel();
+                    continue;
+                }
+                c->pPort        = fb_port;
+                c->nType        = vst3::BATCH_FBUFFER;
+                c->nId          = last_row;
+                sTxBatch.end();
             }
         }
 
-        void Wrapper::transmit_streams()
+        void Wrapper::batch_streams()
         {
-            Steinberg::char8 key[32];
-
-            // Synchronize streams
             for (lltl::iterator<plug::IPort> it=vStreams.values(); it; ++it)
             {
-                // Get the frame buffer data
+                // Get the stream data
                 vst3::StreamPort *s_port = static_cast<vst3::StreamPort *>(it.get());
                 if (s_port == NULL)
-                {
                     continue;
-                }
                 plug::stream_t *s        = it->buffer<plug::stream_t>();
                 if (s == NULL)
                     continue;
@@ -3473,90 +3528,123 @@ namespace lsp
                     continue;
 
                 frame_id            = src_id - delta + 1;
-                delta               = lsp_min(delta, uint32_t(STREAM_BULK_MAX)); // Limit number of frames per message
-                uint32_t last_id    = frame_id + delta;
+                delta               = lsp_min(delta, uint32_t(STREAM_BULK_MAX)); // Limit number of frames per entry
+                const uint32_t last_id  = frame_id + delta;
                 const size_t nbuffers   = s->channels();
 
-//                lsp_trace("src_id=%d, port_frame=%d, frame_id=%d, last_id=%d, delta=%d, num_frames=%d",
-//                        int(src_id), int(s_port->frame_id()), int(frame_id), int(last_id), int(delta), int(num_frames));
+                // Count valid frames, they are written to the header of the entry
+                uint32_t frames     = 0;
+                for (uint32_t id = frame_id; id != last_id; ++id)
+                    if (s->get_frame_size(id) >= 0)
+                        ++frames;
 
-                // Allocate new message
-                Steinberg::Vst::IMessage *msg = alloc_message(pHostApplication, bMsgWorkaround);
-                if (msg == NULL)
+                // Write header and data for each frame
+                if (!sTxBatch.begin(vst3::BATCH_STREAM, s_port->metadata()->id))
                     continue;
-                lsp_finally { safe_release(msg); };
+                bool encoded = (sTxBatch.write_uint32(nbuffers)) && (sTxBatch.write_uint32(frames));
+                for ( ; (encoded) && (frame_id != last_id); ++frame_id)
+                {
+                    ssize_t frame_size = s->get_frame_size(frame_id);
+                    if (frame_size < 0)
+                        continue;
 
-                // Initialize the message
-                msg->setMessageID(vst3::ID_MSG_STREAM);
-                Steinberg::Vst::IAttributeList *list = msg->getAttributes();
+                    encoded     = (sTxBatch.write_uint32(frame_id)) && (sTxBatch.write_uint32(frame_size));
+                    for (size_t i=0; (encoded) && (i < nbuffers); ++i)
+                    {
+                        // Write frame data directly from the stream
+                        plug::data_view_t v;
+                        if (s->view_frame(frame_id, i, &v, 0, frame_size) != frame_size)
+                            encoded     = false;
+                        else
+                            encoded     = (sTxBatch.write_floats(v.head, v.head_size)) && (sTxBatch.write_floats(v.tail, v.tail_size));
+                    }
+                }
 
-                // Write endianess
-                if (list->setInt("endian", VST3_BYTEORDER) != Steinberg::kResultOk)
+                // Remember the last frame for commit after transmission
+                batch_commit_t *c = (encoded) ? vTxCommits.add() : NULL;
+                if (c == NULL)
+                {
+                    sTxBatch.cancel();
                     continue;
+                }
+                c->pPort        = s_port;
+                c->nType        = vst3::BATCH_STREAM;
+                c->nId          = uint32_t(last_id - 1);
+                sTxBatch.end();
+            }
+        }
 
-                // Write identifier of the frame buffer port
-                if (!sTxNotifyBuf.set_string(list, "id", s_port->metadata()->id))
-                    continue;
+        bool Wrapper::send_data_batch(const void *data, size_t size)
+        {
+            // Allocate new message
+            Steinberg::Vst::IMessage *msg = alloc_message(pHostApplication, bMsgWorkaround);
+            if (msg == NULL)
+                return false;
+            lsp_finally { safe_release(msg); };
 
-                // Write number of buffers
-                if (list->setInt("buffers", nbuffers) != Steinberg::kResultOk)
-                    continue;
+            // Initialize the message
+            msg->setMessageID(vst3::ID_MSG_DATA_BATCH);
+            Steinberg::Vst::IAttributeList *list = msg->getAttributes();
+
+            // Write endianess and the batch itself
+            if (list->setInt("endian", VST3_BYTEORDER) != Steinberg::kResultOk)
+                return false;
+            if (list->setBinary("data", data, size) != Steinberg::kResultOk)
+                return false;
 
-                // Forge vectors
-                size_t frames = 0;
-                bool encoded = true;
-                for ( ; frame_id != last_id; ++frame_id)
+            // Send the message
+            return pPeerConnection->notify(msg) == Steinberg::kResultOk;
+        }
+
+        void Wrapper::transmit_data_batch()
+        {
+            sTxBatch.clear();
+            vTxCommits.clear();
+
+            // Pack all data ports into one batch
+            batch_meter_values();
+            batch_mesh_states();
+            batch_frame_buffers();
+            batch_streams();
+            if (sTxBatch.is_empty())
+                return;
+
+            size_t size = 0;
+            const void *data = sTxBatch.build(&size);
+            if ((data == NULL) || (!send_data_batch(data, size)))
+            {
+                // The receiver did not get delta-encoded meshes, key packets should be sent next time
+                for (size_t i=0, n=vTxCommits.size(); i<n; ++i)
                 {
-                    ssize_t frame_size = s->get_frame_size(frame_id);
-                    if (frame_size < 0)
-                    {
-//                        lsp_trace("Invalid frame size");
-                        continue;
-                    }
+                    const batch_commit_t *c = vTxCommits.uget(i);
+                    if (c->nType == vst3::BATCH_MESH)
+                        static_cast<vst3::MeshPort *>(c->pPort)->reset_delta();
+                }
+                return;
+            }
 
-                    // Forge frame number
-                    snprintf(key, sizeof(key), "frame_id[%d]", int(frames));
-                    if (list->setInt(key, frame_id) != Steinberg::kResultOk)
+            // Commit the state of transmitted ports
+            for (size_t i=0, n=vTxCommits.size(); i<n; ++i)
+            {
+                const batch_commit_t *c = vTxCommits.uget(i);
+                switch (c->nType)
+                {
+                    case vst3::BATCH_MESH:
                     {
-                        encoded = false;
+                        plug::mesh_t *mesh = c->pPort->buffer<plug::mesh_t>();
+                        if (mesh != NULL)
+                            mesh->cleanup();
                         break;
                     }
-                    snprintf(key, sizeof(key), "frame_size[%d]", int(frames));
-                    if (list->setInt(key, frame_size) != Steinberg::kResultOk)
-                    {
-                        encoded = false;
+                    case vst3::BATCH_FBUFFER:
+                        static_cast<vst3::FrameBufferPort *>(c->pPort)->set_row_id(c->nId);
                         break;
-                    }
-
-                    // Forge vectors
-                    for (size_t i=0; i < nbuffers; ++i)
-                    {
-                        float *data = s_port->read_frame(frame_id, i, 0, frame_size);
-
-                        snprintf(key, sizeof(key), "data[%d][%d]", int(frames), int(i));
-                        if (list->setBinary(key, data, frame_size * sizeof(float)) != Steinberg::kResultOk)
-                        {
-                            encoded     = false;
-                            break;
-                        }
-                    }
-                    if (!encoded)
+                    case vst3::BATCH_STREAM:
+                        static_cast<vst3::StreamPort *>(c->pPort)->set_frame_id(c->nId);
+                        break;
+                    default:
                         break;
-
-                    // Increment number of frames
-                    ++frames;
-//                    lsp_trace("serialized frame id=%d, size=%d", int(frame_id), int(frame_size));
                 }
-
-                if (!encoded)
-                    continue;
-                if (list->setInt("frames", frames) != Steinberg::kResultOk)
-                    continue;
-
-                // Update current RowID
-//                 lsp_trace("committed frame id=%d", int(uint32_t(frame_id - 1)));
-                if (pPeerConnection->notify(msg) == Steinberg::kResultOk)
-                    s_port->set_frame_id(uint32_t(frame_id - 1));
             }
         }
 
@@ -3713,10 +3801,7 @@ namespace lsp
             if (nUICounterResp > 0)
             {
                 transmit_preset_state();
-                transmit_meter_values();
-                transmit_mesh_states();
-                transmit_frame_buffers();
-                transmit_streams();
+                transmit_data_batch();
                 transmit_play_position();
                 transmit_strings();
                 transmit_shm_state();
@@ -28,6 +28,8 @@
 #include <lsp-plug.in/dsp/dsp.h>
 #include <lsp-plug.in/plug-fw/core/AudioBuffer.h>
 #include <lsp-plug.in/plug-fw/core/AudioTracer.h>
+#include <lsp-plug.in/plug-fw/core/decimate.h>
+#include <lsp-plug.in/plug-fw/core/delta.h>
 #include <lsp-plug.in/plug-fw/core/osc_buffer.h>
 #include <lsp-plug.in/plug-fw/meta/func.h>
 #include <lsp-plug.in/plug-fw/plug.h>
@@ -248,22 +250,32 @@ namespace lsp
             protected:
                 plug::midi_t    sQueue;             // MIDI event buffer
                 plug::midi_t    sSlice;             // MIDI event buffer (slice)
+                size_t          nSplit;             // Index of the first event in the queue for the next slice
 
             public:
                 explicit MidiPort(const meta::port_t *meta): Port(meta)
                 {
                     sQueue.clear();
                     sSlice.clear();
+                    nSplit      = 0;
                 }
 
             public:
+                void clear()
+                {
+                    sQueue.clear();
+                    sSlice.clear();
+                    nSplit      = 0;
+                }
+
                 void prepare(size_t offset, size_t count)
                 {
                     if (!meta::is_in_port(pMetadata))
                         return;
 
+                    // Blocks are prepared sequentially, continue from the end of the previous slice
                     sSlice.clear();
-                    sSlice.push_slice(&sQueue, offset, offset + count);
+                    nSplit      = sSlice.push_split(&sQueue, nSplit, offset, offset + count);
                 }
 
                 void commit(size_t offset)
@@ -271,7 +283,9 @@ namespace lsp
                     if (!meta::is_out_port(pMetadata))
                         return;
 
-                    sQueue.push_all_shifted(&sSlice, offset);
+                    // Merge the block into the queue, it is an append operation for chronologically ordered output
+                    sSlice.sort();
+                    sQueue.merge_shifted(&sSlice, offset);
                     sSlice.clear();
                 }
 
@@ -291,7 +305,6 @@ namespace lsp
             protected:
                 float                   fValue;         // The actual value of the port
                 float                   fPending;       // The pending value
-                uint32_t                nChangeIndex;   // The current index of a change in a queue
                 Steinberg::Vst::ParamID nID;            // Unique identifier of the port (parameter tag)
                 bool                    bVirtual;       // Indicates that port is virtual
 
@@ -300,7 +313,6 @@ namespace lsp
                 {
                     fValue              = meta->start;
                     fPending            = fValue;
-                    nChangeIndex        = 0;
                     nID                 = id;
                     bVirtual            = virt;
                 }
@@ -313,8 +325,6 @@ namespace lsp
 
             public:
                 inline Steinberg::Vst::ParamID parameter_id() const { return nID; }
-                inline uint32_t change_index() const    { return nChangeIndex;          }
-                inline void     set_change_index(uint32_t index)    { nChangeIndex = index; }
                 inline bool     is_virtual() const      { return bVirtual;              }
 
                 bool commit_value(float value)
@@ -437,18 +447,30 @@ namespace lsp
         {
             private:
                 plug::mesh_t       *pMesh;
+                plug::mesh_t       *pDecimated;         // Decimated data for the delta encoder
+                core::DeltaEncoder  sEncoder;           // Delta encoder
+                uatomic_t           nDisplayWidth;
+                bool                bDelta;             // Transmit only changed data
 
             public:
                 explicit MeshPort(const meta::port_t *meta) :
                     Port(meta)
                 {
-                    pMesh   = vst3::create_mesh(meta);
+                    pMesh       = vst3::create_mesh(meta);
+                    pDecimated  = NULL;
+                    bDelta      = (meta->flags & meta::F_DELTA) &&
+                                  (sEncoder.init(meta->step, meta->start, meta->flags & meta::F_HALF) == STATUS_OK);
+                    if (bDelta)
+                        pDecimated  = vst3::create_mesh(meta);
+                    atomic_store(&nDisplayWidth, 0);
                 }
 
                 virtual ~MeshPort() override
                 {
                     vst3::destroy_mesh(pMesh);
+                    vst3::destroy_mesh(pDecimated);
                     pMesh = NULL;
+                    pDecimated = NULL;
                 }
 
                 MeshPort(const MeshPort &) = delete;
@@ -462,13 +484,55 @@ namespace lsp
                 {
                     return pMesh;
                 }
+
+            public:
+                inline size_t display_width() const         { return atomic_load(&nDisplayWidth);   }
+                inline void reset_display_width()           { atomic_store(&nDisplayWidth, 0);      }
+                inline bool delta() const                   { return bDelta;                        }
+                inline const void *delta_data() const       { return sEncoder.data();               }
+                inline void reset_delta()                   { sEncoder.reset();                     }
+
+                /**
+                 * Set the display width requested by the UI, the maximum width requested
+                 * by all UI instances is used. Should be called from the single thread.
+                 * @param width display width, zero means no decimation
+                 */
+                inline void set_display_width(size_t width)
+                {
+                    if (width > atomic_load(&nDisplayWidth))
+                        atomic_store(&nDisplayWidth, width);
+                }
+
+                /**
+                 * Encode changed data of the mesh reduced to the display width,
+                 * the encoded packet is available via delta_data()
+                 * @return size of the encoded packet or zero on error
+                 */
+                size_t encode_delta()
+                {
+                    if (!bDelta)
+                        return 0;
+
+                    // Reduce mesh to the display width if requested
+                    const size_t width  = display_width();
+                    const float * const *src = pMesh->pvData;
+                    size_t items        = core::decimated_size(pMesh->nItems, width);
+                    if ((items < pMesh->nItems) && (pDecimated != NULL))
+                    {
+                        core::decimate_mesh(pDecimated->pvData, pMesh->pvData, pMesh->nBuffers, pMesh->nItems, width);
+                        src                 = pDecimated->pvData;
+                    }
+                    else
+                        items               = pMesh->nItems;
+
+                    return sEncoder.encode(src, pMesh->nBuffers, items);
+                }
         };
 
         class StreamPort: public Port
         {
             private:
                 plug::stream_t     *pStream;
-                float              *pData;
                 uint32_t            nFrameID;
 
             public:
@@ -476,7 +540,6 @@ namespace lsp
                     Port(meta)
                 {
                     pStream     = plug::stream_t::create(pMetadata->min, pMetadata->max, pMetadata->start);
-                    pData       = reinterpret_cast<float *>(::malloc(sizeof(float) * STREAM_MAX_FRAME_SIZE));
                     nFrameID    = 0;
                 }
 
@@ -484,12 +547,6 @@ namespace lsp
                 {
                     plug::stream_t::destroy(pStream);
                     pStream     = NULL;
-
-                    if (pData != NULL)
-                    {
-                        free(pData);
-                        pData       = NULL;
-                    }
                 }
 
                 StreamPort(const StreamPort &) = delete;
@@ -507,12 +564,6 @@ namespace lsp
             public:
                 inline uint32_t frame_id() const                { return nFrameID;      }
                 inline void set_frame_id(uint32_t frame_id)     { nFrameID = frame_id;  }
-
-                inline float *read_frame(uint32_t frame_id, size_t channel, size_t off, size_t count)
-                {
-                    pStream->read_frame(frame_id, channel, pData, off, count);
-                    return pData;
-                }
         };
 
         class FrameBufferPort: public Port
@@ -520,6 +571,7 @@ namespace lsp
             private:
                 plug::frame_buffer_t    sFB;
                 uint32_t                nRowID;
+                uint16_t               *pHalf;      // Row converted to 16-bit floating-point values
 
             public:
                 explicit FrameBufferPort(const meta::port_t *meta):
@@ -527,11 +579,18 @@ namespace lsp
                 {
                     sFB.init(pMetadata->start, pMetadata->step);
                     nRowID              = 0;
+                    pHalf               = (pMetadata->flags & meta::F_HALF) ?
+                        static_cast<uint16_t *>(malloc(sizeof(uint16_t) * sFB.cols())) : NULL;
                 }
 
                 virtual ~FrameBufferPort() override
                 {
                     sFB.destroy();
+                    if (pHalf != NULL)
+                    {
+                        free(pHalf);
+                        pHalf               = NULL;
+                    }
                 }
 
                 FrameBufferPort(const FrameBufferPort &) = delete;
@@ -549,6 +608,7 @@ namespace lsp
             public:
                 inline uint32_t row_id() const          { return nRowID;    }
                 void set_row_id(uint32_t row_id)        { nRowID = row_id;  }
+                inline uint16_t *half_row()             { return pHalf;     }
         };
 
         class PathPort: public Port
@@ -117,6 +117,11 @@ namespace lsp
                     ui::IPort::notify_all(flags);
                 }
 
+                virtual void        set_display_width(size_t width) override
+                {
+                    pPort->set_display_width(width);
+                }
+
             public:
                 virtual bool        begin_edit() override
                 {
@@ -37,10 +37,12 @@
 #include <lsp-plug.in/plug-fw/core/Resources.h>
 #include <lsp-plug.in/plug-fw/core/SamplePlayer.h>
 #include <lsp-plug.in/plug-fw/core/ShmClient.h>
+#include <lsp-plug.in/plug-fw/core/SilenceDetector.h>
 #include <lsp-plug.in/plug-fw/plug.h>
 
 #include <steinberg/vst3.h>
 
+#include <lsp-plug.in/plug-fw/wrap/vst3/batch.h>
 #include <lsp-plug.in/plug-fw/wrap/vst3/sync.h>
 #include <lsp-plug.in/plug-fw/wrap/vst3/factory.h>
 #include <lsp-plug.in/plug-fw/wrap/vst3/string_buf.h>
@@ -84,6 +86,24 @@ namespace lsp
                     vst3::MidiPort                 *vPorts[];   // List of ports related to the event bus
                 } event_bus_t;
 
+                typedef struct param_queue_t
+                {
+                    Steinberg::Vst::IParamValueQueue   *pQueue;     // Queue of parameter changes
+                    vst3::ParameterPort                *pPort;      // Parameter port
+                    Steinberg::Vst::ParamValue          fValue;     // Normalized value of the next change
+                    int32_t                             nOffset;    // Sample offset of the next change
+                    int32_t                             nIndex;     // Index of the next change in the queue
+                    int32_t                             nCount;     // Number of changes in the queue
+                    uint32_t                            nOrder;     // Order of the queue to keep the order of changes
+                } param_queue_t;
+
+                typedef struct batch_commit_t
+                {
+                    plug::IPort                    *pPort;      // Data port
+                    uint32_t                        nType;      // Type of the batch entry
+                    uint32_t                        nId;        // Row or frame identifier to commit
+                } batch_commit_t;
+
                 enum preset_type_t
                 {
                     PT_NONE     = 0,
@@ -108,6 +128,7 @@ namespace lsp
                         virtual void created(core::KVTStorage *storage, const char *id, const core::kvt_param_t *param, size_t pending);
                         virtual void changed(core::KVTStorage *storage, const char *id, const core::kvt_param_t *oval, const core::kvt_param_t *nval, size_t pending);
                         virtual void removed(core::KVTStorage *storage, const char *id, const core::kvt_param_t *param, size_t pending);
+                        virtual void transaction(core::KVTStorage *storage, size_t changes);
                 };
 
             protected:
@@ -130,11 +151,15 @@ namespace lsp
                 lltl::parray<plug::IPort>           vFBuffers;              // Frame buffer ports
                 lltl::parray<plug::IPort>           vStreams;               // Streaming ports
                 lltl::pphash<char, vst3::Port>      vParamMapping;          // Virtual input port mapping
+                param_queue_t                      *vParamQueues;           // Min-heap of parameter change queues ordered by the next change
+                size_t                              nParamQueues;           // Number of queues with pending changes
+                size_t                              nParamQueuesMax;        // Capacity of the heap
                 lltl::parray<meta::port_t>          vGenMetadata;           // Generated metadata for virtual ports
                 event_bus_t                        *pEventsIn;              // Input event bus
                 event_bus_t                        *pEventsOut;             // Output event bus
                 core::SamplePlayer                 *pSamplePlayer;          // Sample player
                 core::ShmClient                    *pShmClient;             // Shared memory client
+                core::SilenceDetector               sSilence;                // Silence detector for processing suspend
                 wssize_t                            nPlayPosition;          // Sample playback position
                 wssize_t                            nPlayLength;            // Sample playback length
                 plug::position_t                    sUIPosition;            // Position notified to UI
@@ -142,11 +167,12 @@ namespace lsp
 
                 vst3::string_buf                    sRxNotifyBuf;           // Notify buffer for notify() processing
                 vst3::string_buf                    sTxNotifyBuf;           // Notify buffer for sync_data()
+                vst3::BatchWriter                   sTxBatch;               // Data port batch for sync_data()
+                lltl::darray<batch_commit_t>        vTxCommits;             // Port states to commit after the batch has been sent
                 core::KVTStorage                    sKVT;                   // KVT storage
                 ipc::Mutex                          sKVTMutex;              // KVT storage access mutex
                 VST3KVTListener                     sKVTListener;           // KVT state listener
                 core::KVTDispatcher                *pKVTDispatcher;         // KVT dispatcher
-                uint8_t                            *pOscPacket;             // OSC packet data
 
                 uatomic_t                           nPositionLock;          // Position lock
                 uatomic_t                           nUICounterReq;          // UI counter request
@@ -182,6 +208,8 @@ namespace lsp
                 static ssize_t              compare_audio_ports_by_speaker(const vst3::AudioPort *a, const vst3::AudioPort *b);
 
                 static ssize_t              compare_in_param_ports(const vst3::ParameterPort *a, const vst3::ParameterPort *b);
+                static inline bool          param_queue_less(const param_queue_t *a, const param_queue_t *b);
+                static bool                 fetch_param_change(param_queue_t *q);
 
                 void                        receive_raw_osc_event(osc::parse_frame_t *frame);
 
@@ -190,9 +218,10 @@ namespace lsp
                 status_t                    create_ports(lltl::parray<plug::IPort> *plugin_ports, const meta::plugin_t *meta);
                 bool                        create_busses(const meta::plugin_t *meta);
                 void                        sync_position(Steinberg::Vst::ProcessContext *pctx);
+                void                        build_param_changes(Steinberg::Vst::ProcessData *pdata);
+                void                        sift_param_queue(size_t index);
                 size_t                      prepare_block(int32_t frame, Steinberg::Vst::ProcessData *pdata);
                 vst3::ParameterPort        *input_parameter(Steinberg::Vst::ParamID id);
-                status_t                    save_kvt_parameters_v1(Steinberg::IBStream *os, core::KVTStorage *kvt);
                 bool                        check_parameters_updated();
                 void                        apply_settings_update();
 
@@ -215,10 +244,12 @@ namespace lsp
                 void                        report_state_change();
                 void                        report_music_position();
                 void                        transmit_kvt_changes();
-                void                        transmit_meter_values();
-                void                        transmit_mesh_states();
-                void                        transmit_frame_buffers();
-                void                        transmit_streams();
+                void                        batch_meter_values();
+                void                        batch_mesh_states();
+                void                        batch_frame_buffers();
+                void                        batch_streams();
+                bool                        send_data_batch(const void *data, size_t size);
+                void                        transmit_data_batch();
                 void                        transmit_play_position();
                 void                        transmit_strings();
                 void                        transmit_shm_state();
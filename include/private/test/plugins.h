@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_TEST_PLUGINS_H_
+#define PRIVATE_TEST_PLUGINS_H_
+
+#include <lsp-plug.in/plug-fw/meta/types.h>
+
+namespace lsp
+{
+    namespace test
+    {
+        /**
+         * Find the first plugin in the plugin factories that has both audio inputs and audio outputs
+         * and can be instantiated by the offline host
+         * @return plugin metadata or NULL if there is no such plugin
+         */
+        const meta::plugin_t *find_audio_plugin();
+    } /* namespace test */
+} /* namespace lsp */
+
+#endif /* PRIVATE_TEST_PLUGINS_H_ */
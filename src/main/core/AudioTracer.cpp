@@ -36,12 +36,26 @@ namespace lsp
             pId             = NULL;
             pInstance       = NULL;
             nFrameId        = 0;
+
+            pWriter         = NULL;
+            vRing           = NULL;
+            atomic_store(&nHead, 0);
+            atomic_store(&nTail, 0);
+            atomic_store(&nDropped, 0);
+            atomic_store(&nDropEvents, 0);
+            nReported       = 0;
         }
 
         AudioTracer::~AudioTracer()
         {
             stop_trace();
             sSample.destroy();
+
+            if (vRing != NULL)
+            {
+                free(vRing);
+                vRing           = NULL;
+            }
         }
 
         void AudioTracer::stop_trace()
@@ -49,12 +63,24 @@ namespace lsp
             if (pInstance == NULL)
                 return;
 
-            // Save frame if present
-            save_frame();
-
-            // Turn off tracing
+            // Turn off tracing, this prevents submission of new data
             lsp_trace("Turning OFF data trace for instance=%p, object=%s", pInstance, pId);
             pInstance       = NULL;
+
+            // Stop the writer thread
+            if (pWriter != NULL)
+            {
+                pWriter->cancel();
+                pWriter->join();
+                delete pWriter;
+                pWriter         = NULL;
+            }
+
+            // Flush the remaining data and save frame if present
+            drain_ring();
+            save_frame();
+            report_drops();
+
             if (pId != NULL)
             {
                 free(pId);
@@ -108,20 +134,55 @@ namespace lsp
             if (!sSample.init(1, FRAME_LENTH, 0))
             {
                 lsp_warn("Failed to initialize trace frame for instance=%p, object=%s", instance, id);
-                return res;
+                return STATUS_NO_MEM;
             }
             sSample.set_sample_rate(SAMPLE_RATE);
 
+            if (vRing == NULL)
+            {
+                vRing           = static_cast<float *>(malloc(sizeof(float) * RING_LENGTH));
+                if (vRing == NULL)
+                {
+                    lsp_warn("Failed to allocate ring buffer for trace of instance=%p, object=%s", instance, id);
+                    return STATUS_NO_MEM;
+                }
+            }
+
             if ((pId = strdup(id)) == NULL)
             {
                 lsp_warn("Failed to allocate memory for trace of instance=%p, object=%s", instance, id);
-                return res;
+                return STATUS_NO_MEM;
             }
 
-            pInstance       = instance;
             nFrameId        = 0;
+            atomic_store(&nHead, 0);
+            atomic_store(&nTail, 0);
+            atomic_store(&nDropped, 0);
+            atomic_store(&nDropEvents, 0);
+            nReported       = 0;
             sPath.swap(&wpath);
 
+            // Launch the writer thread
+            pWriter         = new ipc::Thread(writer_main, this);
+            if (pWriter == NULL)
+            {
+                lsp_warn("Failed to create writer thread for trace of instance=%p, object=%s", instance, id);
+                free(pId);
+                pId             = NULL;
+                return STATUS_NO_MEM;
+            }
+            if ((res = pWriter->start()) != STATUS_OK)
+            {
+                lsp_warn("Failed to start writer thread for trace of instance=%p, object=%s: code=%d", instance, id, int(res));
+                delete pWriter;
+                pWriter         = NULL;
+                free(pId);
+                pId             = NULL;
+                return res;
+            }
+
+            pInstance       = instance;
+
             lsp_trace("Turning ON data trace for instance=%p, object=%s, location='%s'", pInstance, pId, sPath.as_native());
 
             return STATUS_OK;
@@ -164,22 +225,84 @@ namespace lsp
             if (pInstance == NULL)
                 return;
 
-            for (size_t offset = 0; offset < count;)
+            // Estimate the free space in the ring buffer
+            const uatomic_t head    = atomic_load(&nHead);
+            const size_t used       = uatomic_t(head - atomic_load(&nTail));
+            const size_t to_submit  = lsp_min(count, RING_LENGTH - used);
+            if (to_submit < count)
+            {
+                atomic_add(&nDropped, count - to_submit);
+                atomic_add(&nDropEvents, 1);
+            }
+
+            // Copy data to the ring buffer
+            for (size_t offset = 0; offset < to_submit;)
+            {
+                const size_t pos        = (head + offset) & (RING_LENGTH - 1);
+                const size_t to_do      = lsp_min(to_submit - offset, RING_LENGTH - pos);
+                dsp::copy(&vRing[pos], &data[offset], to_do);
+                offset                 += to_do;
+            }
+
+            // Commit data
+            atomic_store(&nHead, head + to_submit);
+        }
+
+        size_t AudioTracer::drain_ring()
+        {
+            const uatomic_t head    = atomic_load(&nHead);
+            uatomic_t tail          = atomic_load(&nTail);
+            size_t processed        = 0;
+
+            while (tail != head)
             {
                 // Can append data to the sample?
-                const size_t to_do      = lsp_min(count - offset, sSample.max_length() - sSample.length());
+                const size_t pos        = tail & (RING_LENGTH - 1);
+                size_t to_do            = uatomic_t(head - tail);
+                to_do                   = lsp_min(to_do, RING_LENGTH - pos);
+                to_do                   = lsp_min(to_do, sSample.max_length() - sSample.length());
                 if (to_do > 0)
                 {
                     float * const dst       = sSample.channel(0, sSample.length());
-                    dsp::copy(dst, &data[offset], to_do);
+                    dsp::copy(dst, &vRing[pos], to_do);
                     sSample.set_length(sSample.length() + to_do);
+
+                    tail                   += to_do;
+                    processed              += to_do;
+                    atomic_store(&nTail, tail);
                 }
-                offset                 += to_do;
 
                 // Need to flush sample to disk?
                 if (sSample.length() >= sSample.max_length())
                     save_frame();
             }
+
+            return processed;
+        }
+
+        void AudioTracer::report_drops()
+        {
+            const uatomic_t dropped = atomic_load(&nDropped);
+            if (dropped == nReported)
+                return;
+
+            lsp_warn("Trace of object=%s, location='%s' dropped %d samples (total: %d samples in %d events)",
+                pId, sPath.as_native(), int(dropped - nReported), int(dropped), int(atomic_load(&nDropEvents)));
+            nReported       = dropped;
+        }
+
+        status_t AudioTracer::writer_main(void *arg)
+        {
+            AudioTracer *self   = static_cast<AudioTracer *>(arg);
+
+            while (!ipc::Thread::is_cancelled())
+            {
+                self->report_drops();
+                if (self->drain_ring() <= 0)
+                    ipc::Thread::sleep(IDLE_DELAY);
+            }
+
+            return STATUS_OK;
         }
 
     } /* namespace core */
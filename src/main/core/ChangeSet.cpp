@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/plug-fw/core/ChangeSet.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+
+namespace lsp
+{
+    namespace core
+    {
+        ChangeSet::ChangeSet()
+        {
+            vWords          = NULL;
+            nWords          = 0;
+            nItems          = 0;
+            atomic_store(&nRequest, 0);
+            nResponse       = 0;
+
+            nWord           = 0;
+            nBase           = 0;
+            nBits           = 0;
+        }
+
+        ChangeSet::~ChangeSet()
+        {
+            destroy();
+        }
+
+        status_t ChangeSet::init(size_t items)
+        {
+            destroy();
+
+            const size_t words  = (items + WORD_BITS - 1) / WORD_BITS;
+            if (words > 0)
+            {
+                vWords              = static_cast<uatomic_t *>(malloc(sizeof(uatomic_t) * words));
+                if (vWords == NULL)
+                    return STATUS_NO_MEM;
+                for (size_t i=0; i<words; ++i)
+                    atomic_store(&vWords[i], 0);
+            }
+
+            nWords          = words;
+            nItems          = items;
+            nWord           = words;
+            nBase           = 0;
+            nBits           = 0;
+
+            return STATUS_OK;
+        }
+
+        void ChangeSet::destroy()
+        {
+            if (vWords != NULL)
+            {
+                free(vWords);
+                vWords          = NULL;
+            }
+
+            nWords          = 0;
+            nItems          = 0;
+            nWord           = 0;
+            nBase           = 0;
+            nBits           = 0;
+        }
+
+        void ChangeSet::mark(size_t index)
+        {
+            if (index >= nItems)
+                return;
+
+            uatomic_t *word         = &vWords[index / WORD_BITS];
+            const uatomic_t mask    = uatomic_t(1) << (index % WORD_BITS);
+
+            while (true)
+            {
+                const uatomic_t value   = atomic_load(word);
+                if (value & mask)
+                    return; // Already marked and not yet consumed
+                if (atomic_cas(word, value, value | mask))
+                    break;
+            }
+
+            // Notify the consumer
+            atomic_add(&nRequest, 1);
+        }
+
+        void ChangeSet::mark_all()
+        {
+            if (nWords <= 0)
+                return;
+
+            for (size_t i=0; i<nWords; ++i)
+                atomic_swap(&vWords[i], ~uatomic_t(0));
+            atomic_add(&nRequest, 1);
+        }
+
+        bool ChangeSet::begin()
+        {
+            const uatomic_t request = atomic_load(&nRequest);
+            if (request == nResponse)
+                return false;
+
+            nResponse       = request;
+            nWord           = 0;
+            nBase           = 0;
+            nBits           = 0;
+
+            return true;
+        }
+
+        ssize_t ChangeSet::next()
+        {
+            while (true)
+            {
+                // Process bits of the current word
+                if (nBits != 0)
+                {
+                    for ( ; !(nBits & 1); nBits >>= 1)
+                        ++nBase;
+
+                    const size_t index  = nBase++;
+                    nBits             >>= 1;
+                    if (index < nItems)
+                        return index;
+                    continue;
+                }
+
+                // Fetch the next word and reset it's state
+                if (nWord >= nWords)
+                    return -1;
+
+                nBase           = nWord * WORD_BITS;
+                nBits           = atomic_swap(&vWords[nWord++], uatomic_t(0));
+            }
+        }
+
+    } /* namespace core */
+} /* namespace lsp */
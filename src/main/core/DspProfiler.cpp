@@ -0,0 +1,282 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/plug-fw/const.h>
+#include <lsp-plug.in/plug-fw/core/DspProfiler.h>
+#include <lsp-plug.in/plug-fw/core/JsonDumper.h>
+#include <lsp-plug.in/common/debug.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/runtime/system.h>
+#include <lsp-plug.in/stdlib/math.h>
+
+#if defined(PLATFORM_WINDOWS)
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif /* PLATFORM_WINDOWS */
+
+namespace lsp
+{
+    namespace core
+    {
+        static const char *probe_names[] =
+        {
+            "block",
+            "process",
+            "update_settings",
+            "shm_pre_process",
+            "shm_post_process",
+            "sample_player"
+        };
+
+        DspProfiler::DspProfiler(const char *uid)
+        {
+            sUID            = uid;
+
+            for (size_t i=0; i<DSP_PROBE_TOTAL; ++i)
+            {
+                probe_t *p      = &vProbes[i];
+                for (size_t j=0; j<BUCKETS; ++j)
+                    atomic_store(&p->vBuckets[j], 0);
+                atomic_store(&p->nCount, 0);
+                p->fMinLoad     = 0.0f;
+                p->fMaxLoad     = 0.0f;
+                p->fSumLoad     = 0.0;
+                p->fMinTime     = 0.0f;
+                p->fMaxTime     = 0.0f;
+                p->fSumTime     = 0.0;
+            }
+        }
+
+        DspProfiler::~DspProfiler()
+        {
+            sUID            = NULL;
+        }
+
+        bool DspProfiler::enabled()
+        {
+            LSPString value;
+            if (system::get_env_var(LSP_DSP_PROFILE_VAR, &value) != STATUS_OK)
+                return false;
+            return !value.is_empty();
+        }
+
+        DspProfiler *DspProfiler::create(const char *uid)
+        {
+            LSPString value;
+            if (system::get_env_var(LSP_DSP_PROFILE_VAR, &value) != STATUS_OK)
+                return NULL;
+            if (value.is_empty())
+                return NULL;
+
+            DspProfiler *p = new DspProfiler(uid);
+            if (p == NULL)
+                return NULL;
+            if (p->sPath.set(&value) != STATUS_OK)
+            {
+                delete p;
+                return NULL;
+            }
+
+            lsp_info("DSP profiling is enabled for %s, reports will be stored to %s", uid, p->sPath.as_utf8());
+            return p;
+        }
+
+        uint64_t DspProfiler::timestamp()
+        {
+            // Use monotonic clock: the wall clock may be adjusted while measuring
+        #if defined(PLATFORM_WINDOWS)
+            static LARGE_INTEGER freq = { };
+            if (freq.QuadPart <= 0)
+                ::QueryPerformanceFrequency(&freq);
+
+            LARGE_INTEGER t;
+            ::QueryPerformanceCounter(&t);
+            const uint64_t ticks    = t.QuadPart;
+            const uint64_t rate     = freq.QuadPart;
+            return (ticks / rate) * 1000000000ULL + ((ticks % rate) * 1000000000ULL) / rate;
+        #else
+            struct timespec t;
+            ::clock_gettime(CLOCK_MONOTONIC, &t);
+            return uint64_t(t.tv_sec) * 1000000000ULL + t.tv_nsec;
+        #endif /* PLATFORM_WINDOWS */
+        }
+
+        const char *DspProfiler::probe_name(dsp_probe_t probe)
+        {
+            return (probe < DSP_PROBE_TOTAL) ? probe_names[probe] : NULL;
+        }
+
+        void DspProfiler::commit(dsp_probe_t probe, uint64_t start, size_t samples, size_t sample_rate)
+        {
+            const uint64_t end  = timestamp();
+            if ((probe >= DSP_PROBE_TOTAL) || (end < start) || (sample_rate <= 0))
+                return;
+
+            probe_t *p          = &vProbes[probe];
+            const float time    = (end - start) * 1e-3f;                    // [us]
+            const float deadline= (samples * 1e+6f) / float(sample_rate);   // [us]
+            const float load    = (deadline > 0.0f) ? time / deadline : 0.0f;
+
+            // Update histogram, only DSP thread modifies the data so there is no contention
+            const size_t bucket = lsp_min(size_t(load * BUCKET_SCALE), BUCKETS - 1);
+            atomic_add(&p->vBuckets[bucket], 1);
+
+            if (atomic_load(&p->nCount) > 0)
+            {
+                p->fMinLoad         = lsp_min(p->fMinLoad, load);
+                p->fMaxLoad         = lsp_max(p->fMaxLoad, load);
+                p->fMinTime         = lsp_min(p->fMinTime, time);
+                p->fMaxTime         = lsp_max(p->fMaxTime, time);
+            }
+            else
+            {
+                p->fMinLoad         = load;
+                p->fMaxLoad         = load;
+                p->fMinTime         = time;
+                p->fMaxTime         = time;
+            }
+            p->fSumLoad        += load;
+            p->fSumTime        += time;
+
+            atomic_add(&p->nCount, 1);
+        }
+
+        void DspProfiler::stats(dsp_stats_t *dst, dsp_probe_t probe) const
+        {
+            dst->count          = 0;
+            dst->min_load       = 0.0f;
+            dst->avg_load       = 0.0f;
+            dst->p99_load       = 0.0f;
+            dst->max_load       = 0.0f;
+            dst->min_time       = 0.0f;
+            dst->avg_time       = 0.0f;
+            dst->max_time       = 0.0f;
+
+            if (probe >= DSP_PROBE_TOTAL)
+                return;
+            const probe_t *p    = &vProbes[probe];
+            const size_t count  = atomic_load(&p->nCount);
+            if (count <= 0)
+                return;
+
+            // Values are read without synchronization and may be slightly inconsistent
+            dst->count          = count;
+            dst->min_load       = p->fMinLoad;
+            dst->avg_load       = p->fSumLoad / count;
+            dst->max_load       = p->fMaxLoad;
+            dst->min_time       = p->fMinTime;
+            dst->avg_time       = p->fSumTime / count;
+            dst->max_time       = p->fMaxTime;
+
+            // Estimate the 99th percentile from the histogram
+            size_t total        = 0;
+            for (size_t i=0; i<BUCKETS; ++i)
+                total              += atomic_load(&p->vBuckets[i]);
+
+            const size_t limit  = total - total / 100;
+            for (size_t i=0, sum=0; i<BUCKETS; ++i)
+            {
+                sum                += atomic_load(&p->vBuckets[i]);
+                if (sum >= limit)
+                {
+                    dst->p99_load       = lsp_min(float(i + 1) / BUCKET_SCALE, dst->max_load);
+                    break;
+                }
+            }
+        }
+
+        void DspProfiler::dump(dspu::IStateDumper *v) const
+        {
+            dsp_stats_t s;
+
+            for (size_t i=0; i<DSP_PROBE_TOTAL; ++i)
+            {
+                const dsp_probe_t probe = dsp_probe_t(i);
+                stats(&s, probe);
+                if (s.count <= 0)
+                    continue;
+
+                v->begin_object(probe_name(probe), &vProbes[i], sizeof(probe_t));
+                {
+                    v->write("count", s.count);
+                    v->write("min_load", s.min_load);
+                    v->write("avg_load", s.avg_load);
+                    v->write("p99_load", s.p99_load);
+                    v->write("max_load", s.max_load);
+                    v->write("min_time_us", s.min_time);
+                    v->write("avg_time_us", s.avg_time);
+                    v->write("max_time_us", s.max_time);
+                    v->writev("histogram", &vProbes[i].vBuckets[0], BUCKETS);
+                }
+                v->end_object();
+            }
+        }
+
+        status_t DspProfiler::save() const
+        {
+            status_t res;
+            io::Path path;
+            if ((res = path.set(&sPath)) != STATUS_OK)
+                return res;
+            if ((res = path.mkdir(true)) != STATUS_OK)
+                return res;
+
+            // Build the file name
+            system::localtime_t t;
+            system::get_localtime(&t);
+
+            LSPString fname;
+            if (!fname.fmt_ascii("%04d%02d%02d-%02d%02d%02d-%03d-%s-dsp.json",
+                    t.year, t.month, t.mday, t.hour, t.min, t.sec, int(t.nanos / 1000000),
+                    sUID))
+                return STATUS_NO_MEM;
+
+            if ((res = path.append_child(&fname)) != STATUS_OK)
+                return res;
+
+            // Write the report
+            JsonDumper v;
+            if ((res = v.open(&path)) != STATUS_OK)
+                return res;
+
+            v.begin_raw_object();
+            {
+                v.write("uid", sUID);
+                v.write("bucket_scale", BUCKET_SCALE);
+                v.begin_raw_object("probes");
+                {
+                    dump(&v);
+                }
+                v.end_raw_object();
+            }
+            v.end_raw_object();
+
+            if ((res = v.close()) != STATUS_OK)
+                return res;
+
+            lsp_info("DSP profile has been saved to file:\n%s", path.as_utf8());
+            return STATUS_OK;
+        }
+
+    } /* namespace core */
+} /* namespace lsp */
@@ -0,0 +1,320 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/plug-fw/const.h>
+#include <lsp-plug.in/plug-fw/core/ExecutorPool.h>
+#include <lsp-plug.in/common/debug.h>
+#include <lsp-plug.in/runtime/LSPString.h>
+#include <lsp-plug.in/runtime/system.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+
+#include <errno.h>
+
+namespace lsp
+{
+    namespace core
+    {
+        // Static variables
+        ipc::Mutex ExecutorPool::sInstanceMutex;
+        ExecutorPool *ExecutorPool::pInstance       = NULL;
+        size_t ExecutorPool::nInstanceRefs          = 0;
+
+        ExecutorPool::ExecutorPool()
+        {
+            atomic_store(&nNextWorker, 0);
+            atomic_store(&nPending, 0);
+        }
+
+        ExecutorPool::~ExecutorPool()
+        {
+            shutdown();
+        }
+
+        status_t ExecutorPool::start(size_t threads)
+        {
+            if (vWorkers.size() > 0)
+                return STATUS_BAD_STATE;
+
+            threads     = lsp_limit(threads, 1u, THREADS_MAX);
+
+            // Allocate all workers first since each worker accesses queues of other workers
+            for (size_t i=0; i<threads; ++i)
+            {
+                worker_t *w     = new worker_t;
+                if (w == NULL)
+                {
+                    shutdown();
+                    return STATUS_NO_MEM;
+                }
+
+                w->pPool        = this;
+                w->pThread      = NULL;
+                w->nIndex       = i;
+
+                if (!vWorkers.add(w))
+                {
+                    delete w;
+                    shutdown();
+                    return STATUS_NO_MEM;
+                }
+
+                w->pThread      = new ipc::Thread(worker_main, w);
+                if (w->pThread == NULL)
+                {
+                    shutdown();
+                    return STATUS_NO_MEM;
+                }
+            }
+
+            // Launch worker threads
+            for (size_t i=0; i<threads; ++i)
+            {
+                worker_t *w     = vWorkers.uget(i);
+                status_t res    = w->pThread->start();
+                if (res != STATUS_OK)
+                {
+                    shutdown();
+                    return res;
+                }
+            }
+
+            return STATUS_OK;
+        }
+
+        void ExecutorPool::shutdown()
+        {
+            // Stop all threads first since they may access queues of each other
+            for (size_t i=0, n=vWorkers.size(); i<n; ++i)
+            {
+                worker_t *w     = vWorkers.uget(i);
+                if (w->pThread != NULL)
+                {
+                    w->pThread->cancel();
+                    w->sWakeup.notify();
+                }
+            }
+
+            for (size_t i=0, n=vWorkers.size(); i<n; ++i)
+            {
+                worker_t *w     = vWorkers.uget(i);
+                if (w->pThread != NULL)
+                {
+                    w->pThread->join();
+                    delete w->pThread;
+                    w->pThread      = NULL;
+                }
+
+                // Return non-executed tasks to the idle state
+                for (size_t j=0, m=w->vTasks.size(); j<m; ++j)
+                    set_task_state(w->vTasks.uget(j), ipc::ITask::TS_IDLE);
+                w->vTasks.flush();
+
+                delete w;
+            }
+
+            vWorkers.flush();
+            atomic_store(&nPending, 0);
+        }
+
+        bool ExecutorPool::submit(ipc::ITask *task)
+        {
+            const size_t count  = vWorkers.size();
+            if (count <= 0)
+                return false;
+
+            // Check state of task
+            if (!change_task_state(task, ipc::ITask::TS_IDLE, ipc::ITask::TS_SUBMITTED))
+                return false;
+
+            // Distribute tasks between workers in round-robin manner, idle workers will steal them
+            worker_t *w         = vWorkers.uget(size_t(atomic_add(&nNextWorker, 1)) % count);
+            bool added          = false;
+            if (w->sMutex.lock())
+            {
+                lsp_finally { w->sMutex.unlock(); };
+                if ((added = w->vTasks.add(task)))
+                    atomic_add(&nPending, 1);
+            }
+
+            if (added)
+            {
+                w->sWakeup.notify();
+                return true;
+            }
+
+            // Failed to submit task, return status back
+            set_task_state(task, ipc::ITask::TS_IDLE);
+            return false;
+        }
+
+        ipc::ITask *ExecutorPool::fetch_task(worker_t *w)
+        {
+            if (atomic_load(&nPending) <= 0)
+                return NULL;
+
+            if (!w->sMutex.lock())
+                return NULL;
+            lsp_finally { w->sMutex.unlock(); };
+
+            // The owner of the queue takes the oldest task
+            ipc::ITask *task    = w->vTasks.first();
+            if (task == NULL)
+                return NULL;
+
+            w->vTasks.remove(size_t(0));
+            atomic_add(&nPending, -1);
+
+            return task;
+        }
+
+        ipc::ITask *ExecutorPool::steal_task(worker_t *w)
+        {
+            for (size_t i=1, n=vWorkers.size(); i<n; ++i)
+            {
+                if (atomic_load(&nPending) <= 0)
+                    return NULL;
+
+                // Do not block on busy queues, just try the next one
+                worker_t *victim    = vWorkers.uget((w->nIndex + i) % n);
+                if (!victim->sMutex.try_lock())
+                    continue;
+                lsp_finally { victim->sMutex.unlock(); };
+
+                // The thief takes the most recent task
+                ipc::ITask *task    = victim->vTasks.pop();
+                if (task != NULL)
+                {
+                    atomic_add(&nPending, -1);
+                    return task;
+                }
+            }
+
+            return NULL;
+        }
+
+        void ExecutorPool::wakeup_next(worker_t *w)
+        {
+            // Pass the remaining work to the next worker, it will steal the task if it is idle
+            const size_t count  = vWorkers.size();
+            if ((count > 1) && (atomic_load(&nPending) > 0))
+                vWorkers.uget((w->nIndex + 1) % count)->sWakeup.notify();
+        }
+
+        status_t ExecutorPool::worker_main(void *arg)
+        {
+            worker_t *w         = static_cast<worker_t *>(arg);
+            ExecutorPool *pool  = w->pPool;
+
+            while (!ipc::Thread::is_cancelled())
+            {
+                ipc::ITask *task    = pool->fetch_task(w);
+                if (task == NULL)
+                    task                = pool->steal_task(w);
+
+                // Sleep until a new task is submitted to the queue
+                if (task == NULL)
+                {
+                    w->sWakeup.wait(IDLE_DELAY);
+                    continue;
+                }
+
+                pool->wakeup_next(w);
+                run_task(task);
+            }
+
+            return STATUS_OK;
+        }
+
+        size_t ExecutorPool::default_threads()
+        {
+            LSPString value;
+            if (system::get_env_var(LSP_EXECUTOR_THREADS_VAR, &value) == STATUS_OK)
+            {
+                const char *str     = value.get_utf8();
+                char *end           = NULL;
+                errno               = 0;
+                const long threads  = (str != NULL) ? strtol(str, &end, 10) : 0;
+
+                if ((errno == 0) && (end != str) && (threads > 0))
+                    return lsp_min(size_t(threads), THREADS_MAX);
+
+                lsp_warn("Invalid value of " LSP_EXECUTOR_THREADS_VAR " environment variable: %s", str);
+            }
+
+            return lsp_limit(ipc::Thread::system_cores(), 1u, THREADS_MAX);
+        }
+
+        ExecutorPool *ExecutorPool::acquire()
+        {
+            if (!sInstanceMutex.lock())
+                return NULL;
+            lsp_finally { sInstanceMutex.unlock(); };
+
+            // Try to perform quick access
+            if (pInstance != NULL)
+            {
+                ++nInstanceRefs;
+                return pInstance;
+            }
+
+            // Create and launch the pool
+            ExecutorPool *pool  = new ExecutorPool();
+            if (pool == NULL)
+                return NULL;
+
+            const size_t threads = default_threads();
+            status_t res        = pool->start(threads);
+            if (res != STATUS_OK)
+            {
+                lsp_warn("Failed to start executor pool, code=%d", int(res));
+                delete pool;
+                return NULL;
+            }
+            lsp_trace("Started executor pool=%p, threads=%d", pool, int(threads));
+
+            // Update status
+            nInstanceRefs       = 1;
+            return pInstance = pool;
+        }
+
+        void ExecutorPool::release(ExecutorPool *pool)
+        {
+            if (pool == NULL)
+                return;
+
+            if (!sInstanceMutex.lock())
+                return;
+            lsp_finally { sInstanceMutex.unlock(); };
+
+            if (pool != pInstance)
+                return;
+            if ((--nInstanceRefs) > 0)
+                return;
+
+            lsp_trace("Destroying executor pool=%p", pInstance);
+            pInstance->shutdown();
+            delete pInstance;
+            pInstance       = NULL;
+        }
+
+    } /* namespace core */
+} /* namespace lsp */
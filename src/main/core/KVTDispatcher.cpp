@@ -22,12 +22,75 @@
 #include <lsp-plug.in/plug-fw/const.h>
 #include <lsp-plug.in/plug-fw/core/KVTDispatcher.h>
 #include <lsp-plug.in/plug-fw/plug.h>
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/stdlib/string.h>
 
 namespace lsp
 {
     namespace core
     {
-        KVTDispatcher::KVTDispatcher(KVTStorage *kvt, ipc::Mutex *mutex)
+        static inline size_t osc_string_size(const char *s)
+        {
+            return (s != NULL) ? align_size(strlen(s) + 1, sizeof(uint32_t)) : 0;
+        }
+
+        /**
+         * Estimate the size of the OSC message that transfers the KVT parameter
+         * @param kvt_name name of the KVT parameter
+         * @param p KVT parameter
+         * @return estimated size of the message, not less than the actual size
+         */
+        static size_t estimate_message_size(const char *kvt_name, const kvt_param_t *p)
+        {
+            // Address, type tags and some space for the arguments of unknown type
+            size_t size     = align_size(strlen("/KVT") + strlen(kvt_name) + 1, sizeof(uint32_t)) + 16;
+
+            switch (p->type)
+            {
+                case KVT_STRING:
+                    size           += osc_string_size(p->str);
+                    break;
+                case KVT_BLOB:
+                    size           += osc_string_size(p->blob.ctype) + sizeof(uint32_t) + align_size(p->blob.size, sizeof(uint32_t));
+                    break;
+                default:
+                    size           += sizeof(uint64_t);
+                    break;
+            }
+
+            return lsp_min(size, size_t(OSC_PACKET_MAX));
+        }
+
+        KVTDispatcher::Listener::Listener(KVTDispatcher *dispatcher)
+        {
+            pDispatcher     = dispatcher;
+        }
+
+        KVTDispatcher::Listener::~Listener()
+        {
+            pDispatcher     = NULL;
+        }
+
+        void KVTDispatcher::Listener::created(KVTStorage *storage, const char *id, const kvt_param_t *param, size_t pending)
+        {
+            if ((pending & (KVT_TX | KVT_BATCH)) == KVT_TX)
+                pDispatcher->wakeup();
+        }
+
+        void KVTDispatcher::Listener::changed(KVTStorage *storage, const char *id, const kvt_param_t *oval, const kvt_param_t *nval, size_t pending)
+        {
+            if ((pending & (KVT_TX | KVT_BATCH)) == KVT_TX)
+                pDispatcher->wakeup();
+        }
+
+        void KVTDispatcher::Listener::transaction(KVTStorage *storage, size_t changes)
+        {
+            if (changes > 0)
+                pDispatcher->wakeup();
+        }
+
+        KVTDispatcher::KVTDispatcher(KVTStorage *kvt, ipc::Mutex *mutex):
+            sListener(this)
         {
             pRx         = core::osc_buffer_t::create(OSC_BUFFER_MAX);
             pTx         = core::osc_buffer_t::create(OSC_BUFFER_MAX);
@@ -36,10 +99,20 @@ namespace lsp
             pPacket     = reinterpret_cast<uint8_t *>(::malloc(OSC_PACKET_MAX));
             atomic_store(&nClients, 0);
             atomic_store(&nTxRequest, 0);
+            atomic_store(&nTxBlocked, 0);
+            atomic_init(nTxLock);
+
+            // Wake up the dispatcher on each change of the KVT that should be transmitted
+            pKVT->bind(&sListener);
         }
 
         KVTDispatcher::~KVTDispatcher()
         {
+            if (pKVT != NULL)
+            {
+                pKVT->unbind(&sListener);
+                pKVT    = NULL;
+            }
             if (pRx != NULL)
             {
                 core::osc_buffer_t::destroy(pRx);
@@ -59,22 +132,25 @@ namespace lsp
 
         size_t  KVTDispatcher::receive_changes()
         {
-            size_t size, changes = 0;
+            osc::packet_t packet;
+            size_t changes = 0;
 
             while (true)
             {
-                // Fetch the packet
-                status_t res    = pRx->fetch(pPacket, &size, OSC_PACKET_MAX);
+                // Peek the packet, it is parsed directly in the buffer
+                status_t res    = pRx->peek(&packet);
 
                 switch (res)
                 {
                     case STATUS_OK:
                     {
-                        lsp_trace("Received OSC message (%d bytes)", int(size));
-                        osc::dump_packet(pPacket, size);
+                        lsp_trace("Received OSC message (%d bytes)", int(packet.size));
+                        osc::dump_packet(&packet);
 
                         // Analyze parsing result
-                        if ((res = parse_message(pKVT, pPacket, size, KVT_RX)) != STATUS_OK)
+                        res             = parse_message(pKVT, &packet, KVT_RX);
+                        pRx->release();
+                        if (res != STATUS_OK)
                         {
                             // Skipped message?
                             if (res != STATUS_SKIP)
@@ -84,12 +160,6 @@ namespace lsp
                         break;
                     }
 
-                    case STATUS_OVERFLOW:
-                        ++changes;
-                        lsp_warn("Received too big OSC packet, skipping");
-                        pRx->skip();
-                        break;
-
                     case STATUS_NO_DATA:
                         return changes;
 
@@ -131,8 +201,16 @@ namespace lsp
                 if (kvt_name == NULL)
                     continue;;
 
-                // Try to serialize changes
-                res = build_message(kvt_name, p, pPacket, &size, OSC_PACKET_MAX);
+                // Try to serialize changes directly into the queue, use temporary buffer if there is no space
+                // or the message does not fit into the estimated size
+                const size_t estimated = estimate_message_size(kvt_name, p);
+                void *data  = pTx->reserve_packet(estimated);
+                res = (data != NULL) ? build_message(kvt_name, p, data, &size, estimated) : STATUS_OVERFLOW;
+                if (res != STATUS_OK)
+                {
+                    data        = NULL;
+                    res         = build_message(kvt_name, p, pPacket, &size, OSC_PACKET_MAX);
+                }
                 if (res != STATUS_OK)
                 {
                     iter->commit(KVT_TX);
@@ -143,7 +221,7 @@ namespace lsp
 //                osc::dump_packet(pPacket, size);
 
                 // Submit to queue
-                res = pTx->submit(pPacket, size);
+                res = (data != NULL) ? pTx->commit_packet(size) : pTx->submit(pPacket, size);
 
                 switch (res)
                 {
@@ -156,7 +234,8 @@ namespace lsp
                         iter->commit(KVT_TX);
                         break;
 
-                    case STATUS_OVERFLOW: // Not enough space to store the packet
+                    case STATUS_OVERFLOW: // Not enough space to store the packet, wait for the client
+                        atomic_store(&nTxBlocked, 1);
                         return changes;
 
                     default:
@@ -173,7 +252,7 @@ namespace lsp
             {
                 ssize_t changes     = iterate();
                 if (changes <= 0)
-                    Thread::sleep(100);     // No changes? Sleep for a while
+                    sNotifier.wait(IDLE_DELAY); // No changes? Wait for the notification
             }
 
             return STATUS_OK;
@@ -202,7 +281,12 @@ namespace lsp
             }
             else
             {
-                pTx->clear();
+                // Do not reset the transmission queue while it is being read
+                if (tx_trylock())
+                {
+                    pTx->clear();
+                    tx_unlock();
+                }
                 pRx->clear();
             }
             pKVT->gc();                         // Perform garbage collection
@@ -212,33 +296,77 @@ namespace lsp
 
         status_t KVTDispatcher::submit(const void *data, size_t size)
         {
-            return pRx->submit(data, size);
+            status_t res = pRx->submit(data, size);
+            if (res == STATUS_OK)
+                sNotifier.notify();
+            return res;
         }
 
         status_t KVTDispatcher::submit(const osc::packet_t *packet)
         {
-            return pRx->submit(packet);
+            status_t res = pRx->submit(packet);
+            if (res == STATUS_OK)
+                sNotifier.notify();
+            return res;
+        }
+
+        bool KVTDispatcher::tx_trylock()
+        {
+            return atomic_trylock(nTxLock);
+        }
+
+        void KVTDispatcher::tx_unlock()
+        {
+            atomic_unlock(nTxLock);
         }
 
         status_t KVTDispatcher::fetch(void *data, size_t *size, size_t limit)
         {
-            return pTx->fetch(data, size, limit);
+            status_t res = pTx->fetch(data, size, limit);
+            if ((res == STATUS_OK) && (atomic_load(&nTxBlocked)))
+                wakeup();
+            return res;
         }
 
         status_t KVTDispatcher::fetch(osc::packet_t *packet, size_t limit)
         {
-            return pTx->fetch(packet, limit);
+            status_t res = pTx->fetch(packet, limit);
+            if ((res == STATUS_OK) && (atomic_load(&nTxBlocked)))
+                wakeup();
+            return res;
+        }
+
+        status_t KVTDispatcher::peek(osc::packet_t *packet)
+        {
+            return pTx->peek(packet);
+        }
+
+        void KVTDispatcher::release()
+        {
+            pTx->release();
+            if (atomic_load(&nTxBlocked))
+                wakeup();
         }
 
         status_t KVTDispatcher::skip()
         {
-            return pTx->skip();
+            status_t res = pTx->skip();
+            if (atomic_load(&nTxBlocked))
+                wakeup();
+            return res;
+        }
+
+        void KVTDispatcher::wakeup()
+        {
+            atomic_store(&nTxBlocked, 0);
+            sNotifier.notify();
         }
 
         void KVTDispatcher::connect_client()
         {
             atomic_add(&nClients, 1);
             atomic_add(&nTxRequest, 1);
+            sNotifier.notify();
         }
 
         void KVTDispatcher::disconnect_client()
@@ -0,0 +1,422 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/debug.h>
+#include <lsp-plug.in/common/endian.h>
+#include <lsp-plug.in/plug-fw/core/KVTSnapshot.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+namespace lsp
+{
+    namespace core
+    {
+        static constexpr size_t SNAPSHOT_ALIGN          = sizeof(uint64_t);
+        static constexpr size_t SNAPSHOT_HEADER_SIZE    = sizeof(uint32_t) * 4;
+        static constexpr size_t SNAPSHOT_RECORD_SIZE    = sizeof(uint32_t) * 4 + sizeof(uint64_t);
+        static constexpr size_t SNAPSHOT_MIN_CAPACITY   = 0x1000;
+
+        enum snapshot_type_t
+        {
+            ST_INT32        = 'i',
+            ST_UINT32       = 'u',
+            ST_INT64        = 'I',
+            ST_UINT64       = 'U',
+            ST_FLOAT32      = 'f',
+            ST_FLOAT64      = 'F',
+            ST_STRING       = 's',
+            ST_BLOB         = 'B'
+        };
+
+        enum snapshot_flags_t
+        {
+            SF_PRIVATE      = 1 << 0
+        };
+
+        template <class T>
+        static inline void put_value(uint8_t *dst, T value)
+        {
+            value   = CPU_TO_LE(value);
+            memcpy(dst, &value, sizeof(value));
+        }
+
+        template <class T>
+        static inline T get_value(const uint8_t *src)
+        {
+            T value;
+            memcpy(&value, src, sizeof(value));
+            return LE_TO_CPU(value);
+        }
+
+        static inline size_t text_size(size_t len)
+        {
+            return align_size(len + 1, SNAPSHOT_ALIGN);
+        }
+
+        static inline const char *fetch_text(const uint8_t **src, const uint8_t *end, size_t len)
+        {
+            const size_t avail  = end - *src;
+            if ((len >= avail) || (text_size(len) > avail))
+                return NULL;
+
+            const char *text    = reinterpret_cast<const char *>(*src);
+            if (text[len] != '\0')
+                return NULL;
+
+            *src               += text_size(len);
+            return text;
+        }
+
+        KVTSnapshot::KVTSnapshot()
+        {
+            pData       = NULL;
+            nSize       = 0;
+            nCapacity   = 0;
+        }
+
+        KVTSnapshot::~KVTSnapshot()
+        {
+            destroy();
+        }
+
+        void KVTSnapshot::clear()
+        {
+            nSize       = 0;
+        }
+
+        void KVTSnapshot::destroy()
+        {
+            if (pData != NULL)
+            {
+                free(pData);
+                pData       = NULL;
+            }
+            nSize       = 0;
+            nCapacity   = 0;
+        }
+
+        uint8_t *KVTSnapshot::append(size_t bytes)
+        {
+            const size_t size   = nSize + bytes;
+            if (size > nCapacity)
+            {
+                size_t cap          = lsp_max(nCapacity, SNAPSHOT_MIN_CAPACITY);
+                while (cap < size)
+                    cap               <<= 1;
+
+                uint8_t *data       = static_cast<uint8_t *>(realloc(pData, cap));
+                if (data == NULL)
+                    return NULL;
+
+                pData               = data;
+                nCapacity           = cap;
+            }
+
+            uint8_t *res        = &pData[nSize];
+            memset(res, 0, bytes);
+            nSize               = size;
+
+            return res;
+        }
+
+        status_t KVTSnapshot::save(KVTStorage *kvt)
+        {
+            const kvt_param_t *p;
+
+            // Reserve space for the header
+            clear();
+            if (append(SNAPSHOT_HEADER_SIZE) == NULL)
+                return STATUS_NO_MEM;
+
+            uint32_t count      = 0;
+            KVTIterator *it     = kvt->enum_all();
+            while (it->next() == STATUS_OK)
+            {
+                status_t res        = it->get(&p);
+                if (res == STATUS_NOT_FOUND) // Not a parameter
+                    continue;
+                else if (res != STATUS_OK)
+                {
+                    lsp_warn("it->get() returned %d", int(res));
+                    return res;
+                }
+                else if (it->is_transient()) // Skip transient parameters
+                    continue;
+
+                const char *name    = it->name();
+                if (name == NULL)
+                {
+                    lsp_trace("it->name() returned NULL");
+                    return STATUS_BAD_STATE;
+                }
+
+                kvt_dump_parameter("Saving state of KVT parameter: %s = ", p, name);
+
+                // Estimate the size of the record
+                const char *text    = NULL;
+                uint64_t value      = 0;
+                size_t data_size    = 0;
+                uint8_t type;
+
+                switch (p->type)
+                {
+                    case KVT_INT32:     type = ST_INT32;    value = uint32_t(p->i32);   break;
+                    case KVT_UINT32:    type = ST_UINT32;   value = p->u32;             break;
+                    case KVT_INT64:     type = ST_INT64;    value = uint64_t(p->i64);   break;
+                    case KVT_UINT64:    type = ST_UINT64;   value = p->u64;             break;
+                    case KVT_FLOAT32:
+                    {
+                        uint32_t bits;
+                        memcpy(&bits, &p->f32, sizeof(bits));
+                        type        = ST_FLOAT32;
+                        value       = bits;
+                        break;
+                    }
+                    case KVT_FLOAT64:
+                        type        = ST_FLOAT64;
+                        memcpy(&value, &p->f64, sizeof(value));
+                        break;
+                    case KVT_STRING:
+                        type        = ST_STRING;
+                        text        = (p->str != NULL) ? p->str : "";
+                        break;
+                    case KVT_BLOB:
+                        if ((p->blob.size > 0) && (p->blob.data == NULL))
+                            return STATUS_INVALID_VALUE;
+                        type        = ST_BLOB;
+                        text        = (p->blob.ctype != NULL) ? p->blob.ctype : "";
+                        data_size   = p->blob.size;
+                        value       = data_size;
+                        break;
+                    default:
+                        lsp_warn("Invalid KVT property type: %d", int(p->type));
+                        return STATUS_BAD_TYPE;
+                }
+
+                const size_t name_len   = strlen(name);
+                const size_t text_len   = (text != NULL) ? strlen(text) : 0;
+                const size_t size       =
+                    SNAPSHOT_RECORD_SIZE +
+                    text_size(name_len) +
+                    ((text != NULL) ? text_size(text_len) : 0) +
+                    align_size(data_size, SNAPSHOT_ALIGN);
+                if (size > UINT32_MAX)
+                    return STATUS_OVERFLOW;
+
+                // Emit the record
+                uint8_t *dst        = append(size);
+                if (dst == NULL)
+                    return STATUS_NO_MEM;
+
+                put_value(&dst[0], uint32_t(size));
+                dst[4]              = type;
+                dst[5]              = (it->is_private()) ? SF_PRIVATE : 0;
+                put_value(&dst[8], uint32_t(name_len));
+                put_value(&dst[12], uint32_t(text_len));
+                put_value(&dst[16], value);
+                dst                += SNAPSHOT_RECORD_SIZE;
+
+                memcpy(dst, name, name_len);
+                dst                += text_size(name_len);
+                if (text != NULL)
+                {
+                    memcpy(dst, text, text_len);
+                    dst                += text_size(text_len);
+                }
+                if (data_size > 0)
+                    memcpy(dst, p->blob.data, data_size);
+
+                ++count;
+            }
+
+            if (nSize > UINT32_MAX)
+                return STATUS_OVERFLOW;
+
+            // Commit the header
+            put_value(&pData[0], SIGNATURE);
+            put_value(&pData[4], VERSION);
+            put_value(&pData[8], count);
+            put_value(&pData[12], uint32_t(nSize));
+
+            lsp_trace("Saved KVT snapshot: %d parameters, %d bytes", int(count), int(nSize));
+
+            return STATUS_OK;
+        }
+
+        bool KVTSnapshot::probe(const void *data, size_t size)
+        {
+            if ((data == NULL) || (size < SNAPSHOT_HEADER_SIZE))
+                return false;
+
+            const uint8_t *src  = static_cast<const uint8_t *>(data);
+            return (get_value<uint32_t>(&src[0]) == SIGNATURE) &&
+                   (get_value<uint16_t>(&src[4]) == VERSION);
+        }
+
+        static status_t fetch_record(const char **name, kvt_param_t *p, uint8_t *rflags, const uint8_t **head, const uint8_t *tail)
+        {
+            // Validate the record header
+            const uint8_t *rec      = *head;
+            if (size_t(tail - rec) < SNAPSHOT_RECORD_SIZE)
+                return STATUS_CORRUPTED;
+
+            const size_t len        = get_value<uint32_t>(&rec[0]);
+            const uint8_t type      = rec[4];
+            const size_t name_len   = get_value<uint32_t>(&rec[8]);
+            const size_t text_len   = get_value<uint32_t>(&rec[12]);
+            const uint64_t value    = get_value<uint64_t>(&rec[16]);
+
+            if ((len < SNAPSHOT_RECORD_SIZE) || (len > size_t(tail - rec)) || (len % SNAPSHOT_ALIGN))
+                return STATUS_CORRUPTED;
+
+            const uint8_t *next     = &rec[len];
+            const uint8_t *src      = &rec[SNAPSHOT_RECORD_SIZE];
+            *head                   = next;
+            *rflags                 = rec[5];
+
+            // Fetch the key
+            if ((*name = fetch_text(&src, next, name_len)) == NULL)
+                return STATUS_CORRUPTED;
+
+            // Fetch the value
+            p->type                 = KVT_ANY;
+
+            switch (type)
+            {
+                case ST_INT32:
+                    p->type     = KVT_INT32;
+                    p->i32      = int32_t(uint32_t(value));
+                    break;
+                case ST_UINT32:
+                    p->type     = KVT_UINT32;
+                    p->u32      = uint32_t(value);
+                    break;
+                case ST_INT64:
+                    p->type     = KVT_INT64;
+                    p->i64      = int64_t(value);
+                    break;
+                case ST_UINT64:
+                    p->type     = KVT_UINT64;
+                    p->u64      = value;
+                    break;
+                case ST_FLOAT32:
+                {
+                    const uint32_t bits = uint32_t(value);
+                    p->type     = KVT_FLOAT32;
+                    memcpy(&p->f32, &bits, sizeof(bits));
+                    break;
+                }
+                case ST_FLOAT64:
+                    p->type     = KVT_FLOAT64;
+                    memcpy(&p->f64, &value, sizeof(value));
+                    break;
+                case ST_STRING:
+                case ST_BLOB:
+                {
+                    const char *text    = fetch_text(&src, next, text_len);
+                    if (text == NULL)
+                        return STATUS_CORRUPTED;
+
+                    if (type == ST_STRING)
+                    {
+                        p->type         = KVT_STRING;
+                        p->str          = text;
+                        break;
+                    }
+
+                    if (value > uint64_t(next - src))
+                        return STATUS_CORRUPTED;
+                    p->type         = KVT_BLOB;
+                    p->blob.ctype   = text;
+                    p->blob.size    = size_t(value);
+                    p->blob.data    = (value > 0) ? src : NULL;
+                    break;
+                }
+                default:
+                    return STATUS_BAD_TYPE;
+            }
+
+            return ((*name)[0] == '/') ? STATUS_OK : STATUS_INVALID_VALUE;
+        }
+
+        status_t KVTSnapshot::restore(KVTStorage *kvt, const void *data, size_t size, size_t flags, size_t skip)
+        {
+            if (!probe(data, size))
+                return STATUS_BAD_FORMAT;
+
+            const uint8_t *head = static_cast<const uint8_t *>(data);
+            const size_t count  = get_value<uint32_t>(&head[8]);
+            const size_t bytes  = get_value<uint32_t>(&head[12]);
+            if ((bytes < SNAPSHOT_HEADER_SIZE) || (bytes > size))
+                return STATUS_CORRUPTED;
+
+            const uint8_t *tail = &head[bytes];
+            head               += SNAPSHOT_HEADER_SIZE;
+
+            const char *name;
+            kvt_param_t p;
+            uint8_t rflags;
+
+            // Validate all records first, the storage should not be modified if the snapshot is corrupted
+            const uint8_t *src  = head;
+            for (size_t i=0; i<count; ++i)
+            {
+                if (fetch_record(&name, &p, &rflags, &src, tail) == STATUS_CORRUPTED)
+                    return STATUS_CORRUPTED;
+            }
+
+            // Store parameters
+            for (size_t i=0; i<count; ++i)
+            {
+                status_t res            = fetch_record(&name, &p, &rflags, &head, tail);
+                if (res == STATUS_INVALID_VALUE)
+                {
+                    lsp_warn("Invalid KVT parameter name, skipping");
+                    continue;
+                }
+                else if (res == STATUS_BAD_TYPE)
+                {
+                    lsp_warn("Unknown KVT parameter type for id=%s, skipping", name);
+                    continue;
+                }
+
+                size_t kflags           = flags;
+                if (rflags & SF_PRIVATE)
+                {
+                    if (skip & KVT_PRIVATE)
+                        continue;
+                    kflags                 |= KVT_PRIVATE;
+                }
+
+                kvt_dump_parameter("Fetched KVT parameter %s = ", &p, name);
+                res                     = kvt->put(name, &p, kflags);
+                if (res != STATUS_OK)
+                    lsp_warn("Could not store parameter %s to KVT, error: %d", name, int(res));
+            }
+
+            return STATUS_OK;
+        }
+
+    } /* namespace core */
+} /* namespace lsp */
+
+
@@ -27,6 +27,19 @@ namespace lsp
 {
     namespace core
     {
+        constexpr uint32_t KVT_HASH_BASIS       = 2166136261u;  // FNV-1a offset basis
+        constexpr uint32_t KVT_HASH_PRIME       = 16777619u;    // FNV-1a prime
+        constexpr size_t KVT_HASH_MIN_CAP       = 0x40;         // Minimum number of bins in the hash index
+        constexpr size_t KVT_POOL_MIN           = 0x40;         // Minimum number of parameters kept for reuse
+        constexpr size_t KVT_DATA_ALIGN         = 0x20;         // Alignment of the parameter's data buffer
+
+        static inline uint32_t kvt_hash(uint32_t hash, const char *s, size_t len)
+        {
+            for (size_t i=0; i<len; ++i)
+                hash    = (hash ^ uint8_t(s[i])) * KVT_HASH_PRIME;
+            return hash;
+        }
+
         KVTListener::KVTListener()
         {
         }
@@ -71,6 +84,10 @@ namespace lsp
         {
         }
 
+        void KVTListener::transaction(KVTStorage *storage, size_t changes)
+        {
+        }
+
 
         KVTStorage::KVTStorage(char separator)
         {
@@ -88,11 +105,17 @@ namespace lsp
             sGarbage.prev       = NULL;
             sGarbage.node       = NULL;
             pTrash              = NULL;
+            pPool               = NULL;
             pIterators          = NULL;
+            vHash               = NULL;
+            nHashCap            = 0;
+            nHashSize           = 0;
+            nPoolSize           = 0;
             nNodes              = 0;
             nValues             = 0;
             nTxPending          = 0;
             nRxPending          = 0;
+            nTransaction        = 0;
 
             init_node(&sRoot, NULL, 0);
             ++sRoot.refs;
@@ -107,6 +130,10 @@ namespace lsp
         {
             unbind_all();
 
+            // Drop the transaction
+            vBatch.flush();
+            nTransaction        = 0;
+
             // Destroy trash
             while (pTrash != NULL)
             {
@@ -115,6 +142,14 @@ namespace lsp
                 pTrash      = next;
             }
 
+            // Destroy pool of parameters
+            while (pPool != NULL)
+            {
+                kvt_gcparam_t *next = pPool->next;
+                destroy_parameter(pPool);
+                pPool       = next;
+            }
+
             // Destroy all iterators
             while (pIterators != NULL)
             {
@@ -143,6 +178,8 @@ namespace lsp
             sRoot.id            = NULL;
             sRoot.idlen         = 0;
             sRoot.parent        = NULL;
+            sRoot.hash          = KVT_HASH_BASIS;
+            sRoot.hnext         = NULL;
             sRoot.refs          = 0;
             sRoot.param         = NULL;
             sRoot.gc.next       = NULL;
@@ -172,8 +209,19 @@ namespace lsp
             sGarbage.prev       = NULL;
             sGarbage.node       = NULL;
             pTrash              = NULL;
+            pPool               = NULL;
             pIterators          = NULL;
 
+            // Destroy the hash index
+            if (vHash != NULL)
+            {
+                ::free(vHash);
+                vHash               = NULL;
+            }
+            nHashCap            = 0;
+            nHashSize           = 0;
+            nPoolSize           = 0;
+
             nNodes              = 0;
             nValues             = 0;
             nTxPending          = 0;
@@ -190,6 +238,8 @@ namespace lsp
             node->id            = (name != NULL) ? reinterpret_cast<char *>(&node[1]) : NULL;
             node->idlen         = len;
             node->parent        = NULL;
+            node->hash          = KVT_HASH_BASIS;
+            node->hnext         = NULL;
             node->refs          = 0;
             node->param         = NULL;
             node->pending       = 0;
@@ -202,6 +252,9 @@ namespace lsp
             node->rx.next       = NULL;
             node->rx.prev       = NULL;
             node->rx.node       = node;
+            node->bparam        = NULL;
+            node->bpending      = 0;
+            node->batched       = false;
             node->children      = NULL;
             node->nchildren     = 0;
             node->capacity      = 0;
@@ -407,12 +460,275 @@ namespace lsp
             }
         }
 
+        void KVTStorage::notify_transaction(size_t changes)
+        {
+            for (size_t i=0, n=vListeners.size(); i<n; ++i)
+            {
+                KVTListener *listener = vListeners.uget(i);
+                if (listener != NULL)
+                    listener->transaction(this, changes);
+            }
+        }
+
+        bool KVTStorage::defer_change(kvt_node_t *node, kvt_gcparam_t *oval, size_t pending)
+        {
+            if (nTransaction <= 0)
+                return false;
+
+            // Remember the value of the parameter before the first change
+            if (!node->batched)
+            {
+                if (!vBatch.add(node))
+                    return false;       // Notify immediately if there is no memory
+                node->bparam        = oval;
+                node->bpending      = 0;
+                node->batched       = true;
+            }
+            node->bpending     |= pending;
+
+            return true;
+        }
+
+        status_t KVTStorage::begin_transaction()
+        {
+            ++nTransaction;
+            return STATUS_OK;
+        }
+
+        status_t KVTStorage::commit_transaction()
+        {
+            if (nTransaction <= 0)
+                return STATUS_BAD_STATE;
+            if (nTransaction > 1)
+            {
+                --nTransaction;
+                return STATUS_OK;
+            }
+
+            char *str = NULL, *path;
+            size_t capacity = 0, changes = 0;
+            status_t res = STATUS_OK;
+            lltl::parray<kvt_node_t> batch;
+
+            // The transaction remains active while delivering notifications, so changes
+            // made by listeners are also batched and the garbage collection is deferred
+            while (vBatch.size() > 0)
+            {
+                batch.swap(&vBatch);
+
+                for (size_t i=0, n=batch.size(); i<n; ++i)
+                {
+                    kvt_node_t *node        = batch.uget(i);
+                    kvt_gcparam_t *oval     = node->bparam;
+                    kvt_gcparam_t *nval     = node->param;
+                    const size_t pending    = node->bpending | KVT_BATCH;
+
+                    node->bparam            = NULL;
+                    node->bpending          = 0;
+                    node->batched           = false;
+
+                    // Parameter has been created and removed within the transaction?
+                    if ((oval == NULL) && (nval == NULL))
+                        continue;
+
+                    // Build path to node
+                    path = build_path(&str, &capacity, node);
+                    if (path == NULL)
+                    {
+                        res     = STATUS_NO_MEM;
+                        continue;
+                    }
+
+                    if (oval == NULL)
+                        notify_created(path, nval, pending);
+                    else if (nval == NULL)
+                        notify_removed(path, oval, pending);
+                    else
+                        notify_changed(path, oval, nval, pending);
+                    ++changes;
+                }
+
+                batch.clear();
+            }
+
+            if (str != NULL)
+                ::free(str);
+
+            nTransaction        = 0;
+            notify_transaction(changes);
+
+            return res;
+        }
+
         void KVTStorage::destroy_parameter(kvt_gcparam_t *param)
         {
-            kvt_destroy_parameter(param);
+            if (param->delegated)
+                kvt_destroy_parameter(param);
+            if (param->data != NULL)
+                ::free(param->data);
             ::free(param);
         }
 
+        void KVTStorage::recycle_parameter(kvt_gcparam_t *param)
+        {
+            // Do not keep too many parameters in the pool
+            if (nPoolSize >= lsp_max(nValues, KVT_POOL_MIN))
+            {
+                destroy_parameter(param);
+                return;
+            }
+
+            // Drop delegated contents but keep the data buffer for further reuse
+            if (param->delegated)
+            {
+                kvt_destroy_parameter(param);
+                param->delegated    = false;
+            }
+
+            param->next         = pPool;
+            pPool               = param;
+            ++nPoolSize;
+        }
+
+        KVTStorage::kvt_gcparam_t *KVTStorage::allocate_parameter()
+        {
+            // Try to obtain parameter from the pool first
+            kvt_gcparam_t *gcp  = pPool;
+            if (gcp != NULL)
+            {
+                pPool               = gcp->next;
+                --nPoolSize;
+                return gcp;
+            }
+
+            gcp                 = static_cast<kvt_gcparam_t *>(::malloc(sizeof(kvt_gcparam_t)));
+            if (gcp == NULL)
+                return NULL;
+
+            gcp->data           = NULL;
+            gcp->capacity       = 0;
+            gcp->delegated      = false;
+
+            return gcp;
+        }
+
+        bool KVTStorage::reserve_index()
+        {
+            if (nHashSize < nHashCap)
+                return true;
+
+            // Grow the index and re-distribute nodes between bins
+            const size_t ncap   = lsp_max(nHashCap << 1, KVT_HASH_MIN_CAP);
+            kvt_node_t **bins   = static_cast<kvt_node_t **>(::calloc(ncap, sizeof(kvt_node_t *)));
+            if (bins == NULL)
+                return false;
+
+            for (size_t i=0; i<nHashCap; ++i)
+            {
+                for (kvt_node_t *node = vHash[i]; node != NULL; )
+                {
+                    kvt_node_t *next    = node->hnext;
+                    kvt_node_t **bin    = &bins[node->hash & (ncap - 1)];
+                    node->hnext         = *bin;
+                    *bin                = node;
+                    node                = next;
+                }
+            }
+
+            if (vHash != NULL)
+                ::free(vHash);
+            vHash               = bins;
+            nHashCap            = ncap;
+
+            return true;
+        }
+
+        void KVTStorage::index_node(kvt_node_t *node)
+        {
+            kvt_node_t **bin    = &vHash[node->hash & (nHashCap - 1)];
+            node->hnext         = *bin;
+            *bin                = node;
+            ++nHashSize;
+        }
+
+        void KVTStorage::unindex_node(kvt_node_t *node)
+        {
+            if (vHash == NULL)
+                return;
+
+            for (kvt_node_t **bin = &vHash[node->hash & (nHashCap - 1)]; *bin != NULL; bin = &(*bin)->hnext)
+            {
+                if (*bin == node)
+                {
+                    *bin                = node->hnext;
+                    node->hnext         = NULL;
+                    --nHashSize;
+                    return;
+                }
+            }
+        }
+
+        bool KVTStorage::match_path(const kvt_node_t *node, const char *name, size_t len) const
+        {
+            // Compare the path from the leaf to the root
+            for ( ; node != &sRoot; node = node->parent)
+            {
+                if ((node == NULL) || (len <= node->idlen))
+                    return false;
+
+                len    -= node->idlen;
+                if (::memcmp(&name[len], node->id, node->idlen) != 0)
+                    return false;
+                if (name[--len] != cSeparator)
+                    return false;
+            }
+
+            return len == 0;
+        }
+
+        status_t KVTStorage::lookup_node(kvt_node_t **out, const char *name)
+        {
+            if (*name != cSeparator)
+                return STATUS_INVALID_VALUE;
+            if (name[1] == '\0')
+            {
+                *out    = &sRoot;
+                return STATUS_OK;
+            }
+
+            // Validate the path and compute it's hash
+            uint32_t hash   = kvt_hash(KVT_HASH_BASIS, name, 1);
+            size_t len      = 1;
+            for (char prev = cSeparator; ; prev = name[len++])
+            {
+                const char c    = name[len];
+                if ((c == '\0') || (c == cSeparator))
+                {
+                    if (prev == cSeparator) // Do not allow empty names
+                        return STATUS_INVALID_VALUE;
+                    if (c == '\0')
+                        break;
+                }
+                hash            = kvt_hash(hash, &c, 1);
+            }
+
+            // Lookup the hash index
+            *out            = NULL;
+            if (vHash == NULL)
+                return STATUS_OK;
+
+            for (kvt_node_t *node = vHash[hash & (nHashCap - 1)]; node != NULL; node = node->hnext)
+            {
+                if ((node->hash == hash) && (match_path(node, name, len)))
+                {
+                    *out            = node;
+                    break;
+                }
+            }
+
+            return STATUS_OK;
+        }
+
         char *KVTStorage::build_path(char **path, size_t *capacity, const kvt_node_t *node)
         {
             // Estimate number of bytes required
@@ -469,6 +785,8 @@ namespace lsp
             }
 
             // Create new node and add to the tree
+            if (!reserve_index())
+                return NULL;
             node        = allocate_node(name, len);
             if (node == NULL)
                 return NULL;
@@ -493,61 +811,81 @@ namespace lsp
             node->parent            = base;
             ++base->nchildren;
 
+            // Add node to the hash index
+            node->hash              = kvt_hash(kvt_hash(base->hash, &cSeparator, 1), name, len);
+            index_node(node);
+
             // Return node
             return node;
         }
 
-        KVTStorage::kvt_node_t *KVTStorage::get_node(kvt_node_t *base, const char *name, size_t len)
-        {
-            kvt_node_t *node        = NULL;
-            ssize_t first = 0, last = base->nchildren-1;
-
-            // Seek for existing node
-            while (first <= last)
-            {
-                ssize_t middle      = (first + last) >> 1;
-                node                = base->children[middle];
-
-                // Compare strings
-                ssize_t cmp         = len - node->idlen;
-                if (cmp == 0)
-                    cmp                 = ::memcmp(name, node->id, len);
-
-                // Check result
-                if (cmp < 0)
-                    last    = middle - 1;
-                else if (cmp > 0)
-                    first   = middle + 1;
-                else
-                    return node;
-            }
-
-            return NULL;
-        }
-
         KVTStorage::kvt_gcparam_t *KVTStorage::copy_parameter(const kvt_param_t *src, size_t flags)
         {
-            kvt_gcparam_t *gcp  = reinterpret_cast<kvt_gcparam_t *>(::malloc(sizeof(kvt_gcparam_t)));
+            kvt_gcparam_t *gcp  = allocate_parameter();
             if (gcp == NULL)
                 return NULL;
 
             gcp->flags          = flags & (KVT_PRIVATE | KVT_TRANSIENT);
             gcp->next           = NULL;
+            gcp->delegated      = flags & KVT_DELEGATE;
+
+            // Make simple copy
+            kvt_param_t *dst    = gcp;
+            *dst                = *src;
+            if (gcp->delegated)
+                return gcp;
 
-            if (flags & KVT_DELEGATE)
+            // Estimate the size of data to store in the parameter's buffer
+            size_t ctype_len    = 0, size = 0;
+            if (src->type == KVT_STRING)
+                size                = (src->str != NULL) ? ::strlen(src->str) + 1 : 0;
+            else if (src->type == KVT_BLOB)
             {
-                // Make simple copy and return
-                kvt_param_t *dst    = gcp;
-                *dst                = *src;
+                ctype_len           = (src->blob.ctype != NULL) ? ::strlen(src->blob.ctype) + 1 : 0;
+                size                = ((src->blob.data != NULL) ? align_size(src->blob.size, DEFAULT_ALIGN) : 0) + ctype_len;
+            }
+            else
                 return gcp;
+
+            // Ensure that the buffer has enough capacity, reuse the previously allocated one
+            if (size > gcp->capacity)
+            {
+                const size_t cap    = align_size(size, KVT_DATA_ALIGN);
+                uint8_t *buf        = static_cast<uint8_t *>(::malloc(cap));
+                if (buf == NULL)
+                {
+                    recycle_parameter(gcp);
+                    return NULL;
+                }
+                if (gcp->data != NULL)
+                    ::free(gcp->data);
+                gcp->data           = buf;
+                gcp->capacity       = cap;
             }
 
-            // Make deep copy
-            status_t res        = kvt_copy_parameter(gcp, src);
-            if (res != STATUS_OK)
+            // Make deep copy: blob data is stored first to keep alignment, then the content type
+            if (src->type == KVT_STRING)
             {
-                ::free(gcp);
-                return NULL;
+                if (src->str != NULL)
+                {
+                    ::memcpy(gcp->data, src->str, size);
+                    dst->str            = reinterpret_cast<const char *>(gcp->data);
+                }
+            }
+            else
+            {
+                uint8_t *ptr        = gcp->data;
+                if (src->blob.data != NULL)
+                {
+                    ::memcpy(ptr, src->blob.data, src->blob.size);
+                    dst->blob.data      = ptr;
+                    ptr                += size - ctype_len;
+                }
+                if (src->blob.ctype != NULL)
+                {
+                    ::memcpy(ptr, src->blob.ctype, ctype_len);
+                    dst->blob.ctype     = reinterpret_cast<const char *>(ptr);
+                }
             }
 
             return gcp;
@@ -571,7 +909,8 @@ namespace lsp
                 node->param     = copy;
                 ++nValues;
 
-                notify_created(name, copy, state | pending);
+                if (!defer_change(node, NULL, state | pending))
+                    notify_created(name, copy, state | pending);
                 return STATUS_OK;
             }
 
@@ -593,7 +932,8 @@ namespace lsp
             pTrash              = curr;
             node->param         = copy;
 
-            notify_changed(name, curr, copy, state | pending);
+            if (!defer_change(node, curr, state | pending))
+                notify_changed(name, curr, copy, state | pending);
             return STATUS_OK;
         }
 
@@ -605,10 +945,20 @@ namespace lsp
             const char *path    = name;
             if (!validate_type(value->type))
                 return STATUS_BAD_TYPE;
-            else if (*(path++) != cSeparator)
+
+            // Lookup for the existing node first
+            kvt_node_t *curr    = NULL;
+            status_t res        = lookup_node(&curr, path);
+            if (res != STATUS_OK)
+                return res;
+            else if (curr == &sRoot)
                 return STATUS_INVALID_VALUE;
+            else if (curr != NULL)
+                return commit_parameter(name, curr, value, flags);
 
-            kvt_node_t *curr = &sRoot;
+            // Create all missing nodes
+            curr                = &sRoot;
+            ++path;
 
             while (true)
             {
@@ -641,48 +991,15 @@ namespace lsp
 
         status_t KVTStorage::walk_node(kvt_node_t **out, const char *name)
         {
-            const char *path    = name;
-            if (*(path++) != cSeparator)
-                return STATUS_INVALID_VALUE;
-
-            kvt_node_t *curr    = &sRoot;
-            if (*path == '\0')
-            {
-                *out    = curr;
-                return STATUS_OK;
-            }
-
-            while (true)
-            {
-                const char *item = ::strchr(path, cSeparator);
-                if (item != NULL) // It is a branch
-                {
-                    // Estimate the length of the name
-                    size_t len  = item - path;
-                    if (!len) // Do not allow empty names
-                        return STATUS_INVALID_VALUE;
-
-                    curr = get_node(curr, path, len);
-                    if ((curr == NULL) || (curr->refs <= 0))
-                        return STATUS_NOT_FOUND;
-                }
-                else // It is a leaf
-                {
-                    size_t len  = ::strlen(path);
-                    if (!len) // Do not allow empty names
-                        return STATUS_INVALID_VALUE;
-
-                    curr = get_node(curr, path, len);
-                    if ((curr == NULL) || (curr->refs <= 0))
-                        return STATUS_NOT_FOUND;
-
-                    *out    = curr;
-                    return STATUS_OK;
-                }
+            kvt_node_t *node    = NULL;
+            status_t res        = lookup_node(&node, name);
+            if (res != STATUS_OK)
+                return res;
+            if ((node == NULL) || (node->refs <= 0))
+                return STATUS_NOT_FOUND;
 
-                // Point to next after separator character
-                path    = item + 1;
-            }
+            *out    = node;
+            return STATUS_OK;
         }
 
         status_t KVTStorage::get(const char *name, const kvt_param_t **value, kvt_param_type_t type)
@@ -772,7 +1089,8 @@ namespace lsp
             node->param         = NULL;
             --nValues;
 
-            notify_removed(name, param, pending);
+            if (!defer_change(node, param, pending))
+                notify_removed(name, param, pending);
 
             // All seems to be OK
             if (value != NULL)
@@ -819,9 +1137,13 @@ namespace lsp
             size_t np = set_pending_state(node, op | flags);
 
             const size_t state = flags & KVT_STATE;
-            if ((op ^ np) & KVT_TX) // TX flag has set?
+            const size_t changed = (op ^ np) & (KVT_TX | KVT_RX);
+            if ((changed) && (defer_change(node, param, state | changed)))
+                return STATUS_OK;
+
+            if (changed & KVT_TX) // TX flag has set?
                 notify_changed(name, param, param, state | KVT_TX);
-            if ((op ^ np) & KVT_RX) // RX flag has set?
+            if (changed & KVT_RX) // RX flag has set?
                 notify_changed(name, param, param, state | KVT_RX);
 
             return STATUS_OK;
@@ -920,6 +1242,9 @@ namespace lsp
                 // State has changed?
                 if (op != np)
                 {
+                    if (defer_change(node, node->param, state | ((op ^ np) & (KVT_TX | KVT_RX))))
+                        continue;
+
                     // Build path to node
                     path = build_path(&str, &capacity, node);
                     if (path == NULL)
@@ -1044,17 +1369,20 @@ namespace lsp
                     node->param         = NULL;
                     --nValues;
 
-                    // Build path to node
-                    path = build_path(&str, &capacity, node);
-                    if (path == NULL)
+                    if (!defer_change(node, param, pending))
                     {
-                        if (str != NULL)
-                            ::free(str);
-                        return STATUS_NO_MEM;
-                    }
+                        // Build path to node
+                        path = build_path(&str, &capacity, node);
+                        if (path == NULL)
+                        {
+                            if (str != NULL)
+                                ::free(str);
+                            return STATUS_NO_MEM;
+                        }
 
-                    // Notify listeners
-                    notify_removed(path, param, pending);
+                        // Notify listeners
+                        notify_removed(path, param, pending);
+                    }
                 }
 
                 // Generate tasks for recursive search
@@ -1482,6 +1810,10 @@ namespace lsp
 
         status_t KVTStorage::gc()
         {
+            // Parameters and nodes referenced by the transaction should stay alive
+            if (nTransaction > 0)
+                return STATUS_OK;
+
             // Part 0: Destroy all iterators
             while (pIterators != NULL)
             {
@@ -1490,11 +1822,11 @@ namespace lsp
                 pIterators          = next;
             }
 
-            // Part 1: Collect all garbage parameters
+            // Part 1: Collect all garbage parameters for further reuse
             while (pTrash != NULL)
             {
                 kvt_gcparam_t *next = pTrash->next;
-                destroy_parameter(pTrash);
+                recycle_parameter(pTrash);
                 pTrash      = next;
             }
 
@@ -1548,6 +1880,7 @@ namespace lsp
                 unlink_list(&node->tx);
                 unlink_list(&node->rx);
                 unlink_list(&node->gc);
+                unindex_node(node);
 
                 destroy_node(node);
             }
@@ -1593,6 +1926,11 @@ namespace lsp
             sFake.id        = NULL;
             sFake.idlen     = 0;
             sFake.parent    = node;
+            sFake.hash      = KVT_HASH_BASIS;
+            sFake.hnext     = NULL;
+            sFake.bparam    = NULL;
+            sFake.bpending  = 0;
+            sFake.batched   = false;
             sFake.refs      = 0;
             sFake.param     = NULL;
             sFake.pending   = 0;
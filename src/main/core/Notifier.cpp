@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/plug-fw/core/Notifier.h>
+
+#if defined(PLATFORM_WINDOWS)
+    #include <windows.h>
+#elif defined(PLATFORM_LINUX)
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <time.h>
+    #include <unistd.h>
+#elif defined(PLATFORM_MACOSX)
+    #include <dispatch/dispatch.h>
+    #include <unistd.h>
+#else
+    #include <errno.h>
+    #include <time.h>
+    #include <unistd.h>
+#endif /* PLATFORM_WINDOWS, PLATFORM_LINUX, PLATFORM_MACOSX */
+
+namespace lsp
+{
+    namespace core
+    {
+    #if !defined(PLATFORM_WINDOWS)
+        enum notifier_state_t
+        {
+            NS_IDLE,            // No notification and no thread waiting
+            NS_SIGNALED,        // Notification is pending
+            NS_WAITING          // The thread waits for the notification
+        };
+    #endif /* PLATFORM_WINDOWS */
+
+    #if defined(PLATFORM_WINDOWS)
+        Notifier::Notifier()
+        {
+            hEvent      = ::CreateEventW(NULL, FALSE, FALSE, NULL);
+        }
+
+        Notifier::~Notifier()
+        {
+            if (hEvent != NULL)
+            {
+                ::CloseHandle(hEvent);
+                hEvent      = NULL;
+            }
+        }
+
+        void Notifier::notify()
+        {
+            // SetEvent() does not block the caller
+            if (hEvent != NULL)
+                ::SetEvent(hEvent);
+        }
+
+        bool Notifier::wait(size_t millis)
+        {
+            if (hEvent == NULL)
+            {
+                ::Sleep(DWORD(millis));
+                return false;
+            }
+
+            return ::WaitForSingleObject(hEvent, DWORD(millis)) == WAIT_OBJECT_0;
+        }
+
+    #elif defined(PLATFORM_LINUX)
+        static_assert(sizeof(atomic_t) == sizeof(int), "Futex word should be of int size");
+
+        Notifier::Notifier()
+        {
+            atomic_store(&nState, NS_IDLE);
+        }
+
+        Notifier::~Notifier()
+        {
+        }
+
+        void Notifier::notify()
+        {
+            // Wake up the thread only if it sleeps
+            if (atomic_swap(&nState, NS_SIGNALED) == NS_WAITING)
+                ::syscall(SYS_futex, &nState, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+        }
+
+        bool Notifier::wait(size_t millis)
+        {
+            // Consume pending notification or announce that we are going to sleep
+            if (!atomic_cas(&nState, NS_IDLE, NS_WAITING))
+                return atomic_swap(&nState, NS_IDLE) == NS_SIGNALED;
+
+            // The futex call returns immediately if the state has been changed after the announce
+            struct timespec ts;
+            ts.tv_sec       = millis / 1000;
+            ts.tv_nsec      = (millis % 1000) * 1000000;
+            ::syscall(SYS_futex, &nState, FUTEX_WAIT_PRIVATE, NS_WAITING, &ts, NULL, 0);
+
+            // Timeouts and spurious wakeups leave the NS_WAITING state
+            return atomic_swap(&nState, NS_IDLE) == NS_SIGNALED;
+        }
+
+    #elif defined(PLATFORM_MACOSX)
+        Notifier::Notifier()
+        {
+            atomic_store(&nState, NS_IDLE);
+            hSemaphore  = ::dispatch_semaphore_create(0);
+        }
+
+        Notifier::~Notifier()
+        {
+            if (hSemaphore != NULL)
+            {
+                ::dispatch_release(static_cast<dispatch_semaphore_t>(hSemaphore));
+                hSemaphore  = NULL;
+            }
+        }
+
+        void Notifier::notify()
+        {
+            // Signal the semaphore only if the thread sleeps, signaling never blocks
+            if (atomic_swap(&nState, NS_SIGNALED) != NS_WAITING)
+                return;
+            if (hSemaphore != NULL)
+                ::dispatch_semaphore_signal(static_cast<dispatch_semaphore_t>(hSemaphore));
+        }
+
+        bool Notifier::wait(size_t millis)
+        {
+            if (hSemaphore == NULL)
+            {
+                ::usleep(millis * 1000);
+                return atomic_swap(&nState, NS_IDLE) == NS_SIGNALED;
+            }
+            dispatch_semaphore_t sem = static_cast<dispatch_semaphore_t>(hSemaphore);
+
+            // Drop the wakeup left by the notification that has been issued after the previous timeout
+            ::dispatch_semaphore_wait(sem, DISPATCH_TIME_NOW);
+
+            // Consume pending notification or announce that we are going to sleep
+            if (!atomic_cas(&nState, NS_IDLE, NS_WAITING))
+                return atomic_swap(&nState, NS_IDLE) == NS_SIGNALED;
+
+            ::dispatch_semaphore_wait(sem, ::dispatch_time(DISPATCH_TIME_NOW, int64_t(millis) * NSEC_PER_MSEC));
+
+            // Timeouts leave the NS_WAITING state
+            return atomic_swap(&nState, NS_IDLE) == NS_SIGNALED;
+        }
+
+    #else
+        Notifier::Notifier()
+        {
+            atomic_store(&nState, NS_IDLE);
+            bValid      = ::sem_init(&sSemaphore, 0, 0) == 0;
+        }
+
+        Notifier::~Notifier()
+        {
+            if (!bValid)
+                return;
+
+            ::sem_destroy(&sSemaphore);
+            bValid      = false;
+        }
+
+        void Notifier::notify()
+        {
+            // Post the semaphore only if the thread sleeps, sem_post() never blocks
+            if (atomic_swap(&nState, NS_SIGNALED) != NS_WAITING)
+                return;
+            if (bValid)
+                ::sem_post(&sSemaphore);
+        }
+
+        bool Notifier::wait(size_t millis)
+        {
+            if (!bValid)
+            {
+                ::usleep(millis * 1000);
+                return atomic_swap(&nState, NS_IDLE) == NS_SIGNALED;
+            }
+
+            // Drop the wakeup left by the notification that has been issued after the previous timeout
+            while (::sem_trywait(&sSemaphore) == 0)
+                /* nothing */ ;
+
+            // Consume pending notification or announce that we are going to sleep
+            if (!atomic_cas(&nState, NS_IDLE, NS_WAITING))
+                return atomic_swap(&nState, NS_IDLE) == NS_SIGNALED;
+
+            // Compute the deadline
+            struct timespec ts;
+            ::clock_gettime(CLOCK_REALTIME, &ts);
+            const size_t nsec   = ts.tv_nsec + (millis % 1000) * 1000000;
+            ts.tv_sec          += millis / 1000 + nsec / 1000000000;
+            ts.tv_nsec          = nsec % 1000000000;
+
+            // Wait for the notification
+            while (::sem_timedwait(&sSemaphore, &ts) != 0)
+            {
+                if (errno != EINTR)
+                    break;
+            }
+
+            // Timeouts leave the NS_WAITING state
+            return atomic_swap(&nState, NS_IDLE) == NS_SIGNALED;
+        }
+
+    #endif /* PLATFORM_WINDOWS, PLATFORM_LINUX, PLATFORM_MACOSX */
+    } /* namespace core */
+} /* namespace lsp */
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/plug-fw/core/SharedExecutor.h>
+#include <lsp-plug.in/ipc/Thread.h>
+
+namespace lsp
+{
+    namespace core
+    {
+        SharedExecutor::SharedExecutor()
+        {
+            pPool           = NULL;
+            atomic_store(&nActiveTasks, 0);
+        }
+
+        SharedExecutor::~SharedExecutor()
+        {
+            shutdown();
+        }
+
+        status_t SharedExecutor::init()
+        {
+            if (pPool != NULL)
+                return STATUS_BAD_STATE;
+
+            pPool           = ExecutorPool::acquire();
+            return (pPool != NULL) ? STATUS_OK : STATUS_NO_MEM;
+        }
+
+        void SharedExecutor::task_finished(ipc::ITask *task)
+        {
+            set_executor(task, NULL);
+            atomic_add(&nActiveTasks, -1);
+        }
+
+        bool SharedExecutor::submit(ipc::ITask *task)
+        {
+            if (pPool == NULL)
+                return false;
+
+            // Try to submit task
+            atomic_add(&nActiveTasks, 1);
+            set_executor(task, this);
+            if (pPool->submit(task))
+                return true;
+
+            // Failed to submit task, release resources
+            set_executor(task, NULL);
+            atomic_add(&nActiveTasks, -1);
+
+            return false;
+        }
+
+        void SharedExecutor::shutdown()
+        {
+            if (pPool == NULL)
+                return;
+
+            // Wait only for tasks submitted by this executor
+            while (atomic_load(&nActiveTasks) > 0)
+                ipc::Thread::sleep(10);
+
+            ExecutorPool::release(pPool);
+            pPool           = NULL;
+        }
+
+    } /* namespace core */
+} /* namespace lsp */
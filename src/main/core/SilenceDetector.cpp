@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/debug.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/plug-fw/core/AudioBuffer.h>
+#include <lsp-plug.in/plug-fw/core/SilenceDetector.h>
+#include <lsp-plug.in/plug-fw/meta/func.h>
+
+namespace lsp
+{
+    namespace core
+    {
+        SilenceDetector::SilenceDetector()
+        {
+            pPlugin         = NULL;
+            nSilence        = 0;
+            bEnabled        = false;
+            bSuspended      = false;
+        }
+
+        SilenceDetector::~SilenceDetector()
+        {
+            destroy();
+        }
+
+        void SilenceDetector::init(plug::Module *plugin, plug::IPort **ports, size_t count)
+        {
+            destroy();
+
+            // The plugin should explicitly allow suspension: the default tail size is zero,
+            // so plugins that do not report it would have their tails cut
+            const meta::plugin_t *meta = plugin->metadata();
+            if ((meta == NULL) || (!(meta->extensions & meta::E_SILENCE_SUSPEND)))
+                return;
+
+            bool enabled    = true;
+            for (size_t i=0; i<count; ++i)
+            {
+                plug::IPort *p              = ports[i];
+                const meta::port_t *pm      = (p != NULL) ? p->metadata() : NULL;
+                if (pm == NULL)
+                    continue;
+
+                bool res    = true;
+                if (meta::is_audio_in_port(pm))
+                    res         = vInputs.add(p);
+                else if (meta::is_audio_out_port(pm))
+                    res         = vOutputs.add(p);
+                else if (meta::is_audio_send_port(pm))
+                    res         = vSends.add(p);
+                else if ((meta::is_meter_port(pm)) && (meta::is_out_port(pm)))
+                    res         = vMeters.add(p);
+                else if ((meta::is_midi_in_port(pm)) ||
+                         (meta::is_osc_in_port(pm)) ||
+                         (meta::is_audio_return_port(pm)))
+                    enabled     = false; // Output may be produced without any audio on inputs
+
+                if (!res)
+                    enabled     = false;
+            }
+
+            // Plugins without audio inputs are generators, never suspend them
+            if ((!enabled) || (vInputs.is_empty()))
+            {
+                destroy();
+                return;
+            }
+
+            pPlugin         = plugin;
+            bEnabled        = true;
+        }
+
+        void SilenceDetector::destroy()
+        {
+            vInputs.flush();
+            vOutputs.flush();
+            vSends.flush();
+            vMeters.flush();
+
+            pPlugin         = NULL;
+            nSilence        = 0;
+            bEnabled        = false;
+            bSuspended      = false;
+        }
+
+        void SilenceDetector::reset()
+        {
+            nSilence        = 0;
+            bSuspended      = false;
+        }
+
+        bool SilenceDetector::idle(size_t samples)
+        {
+            if (!bEnabled)
+                return false;
+
+            // Scan inputs for any signal
+            for (size_t i=0, n=vInputs.size(); i<n; ++i)
+            {
+                plug::IPort *p      = vInputs.uget(i);
+                const float *buf    = p->buffer<float>();
+                if ((buf != NULL) && (dsp::abs_max(buf, samples) > THRESHOLD))
+                {
+                    if (bSuspended)
+                        lsp_trace("Resuming plugin %s", pPlugin->metadata()->uid);
+                    nSilence            = 0;
+                    bSuspended          = false;
+                    return false;
+                }
+            }
+
+            // The inputs are silent, the plugin can be suspended only when the tail expires
+            const ssize_t tail  = pPlugin->tail_size();
+            if (tail < 0)
+            {
+                nSilence            = 0;
+                bSuspended          = false;
+                return false;
+            }
+
+            if (!bSuspended)
+            {
+                const wsize_t delay = wsize_t(pPlugin->latency()) + wsize_t(tail) +
+                                      wsize_t(pPlugin->sample_rate() * HOLD_TIME);
+                if (nSilence < delay)
+                {
+                    nSilence           += samples;
+                    return false;
+                }
+
+                lsp_trace("Suspending plugin %s", pPlugin->metadata()->uid);
+                bSuspended          = true;
+            }
+
+            return true;
+        }
+
+        void SilenceDetector::silence(size_t samples)
+        {
+            for (size_t i=0, n=vOutputs.size(); i<n; ++i)
+            {
+                float *buf      = vOutputs.uget(i)->buffer<float>();
+                if (buf != NULL)
+                    dsp::fill_zero(buf, samples);
+            }
+
+            for (size_t i=0, n=vSends.size(); i<n; ++i)
+            {
+                core::AudioBuffer *ab = vSends.uget(i)->buffer<core::AudioBuffer>();
+                if (ab != NULL)
+                    ab->set_clean();
+            }
+
+            for (size_t i=0, n=vMeters.size(); i<n; ++i)
+            {
+                plug::IPort *p  = vMeters.uget(i);
+                p->set_value(p->metadata()->start);
+            }
+        }
+
+    } /* namespace core */
+} /* namespace lsp */
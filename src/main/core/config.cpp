@@ -23,7 +23,10 @@
 #include <lsp-plug.in/plug-fw/core/config.h>
 #include <lsp-plug.in/plug-fw/meta/func.h>
 #include <lsp-plug.in/fmt/config/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
 #include <lsp-plug.in/dsp-units/units.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
 
 namespace lsp
 {
@@ -224,6 +227,103 @@ namespace lsp
             return STATUS_OK;
         }
 
+        float deserialize_control_value(const meta::port_t *meta, const config::param_t *param)
+        {
+            if (meta::is_discrete_unit(meta->unit))
+            {
+                if (meta::is_bool_unit(meta->unit))
+                    return (param->to_bool()) ? 1.0f : 0.0f;
+                return param->to_int();
+            }
+
+            float v = param->to_float();
+
+            // Decode decibels to values
+            if ((meta::is_decibel_unit(meta->unit)) && (param->is_decibel()))
+            {
+                if ((meta->unit == meta::U_GAIN_AMP) || (meta->unit == meta::U_GAIN_POW))
+                {
+                    if (v < -250.0f)
+                        v       = 0.0f;
+                    else if (v > 250.0f)
+                        v       = (meta->unit == meta::U_GAIN_AMP) ? dspu::db_to_gain(250.0f) : dspu::db_to_power(250.0f);
+                    else
+                        v       = (meta->unit == meta::U_GAIN_AMP) ? dspu::db_to_gain(v) : dspu::db_to_power(v);
+                }
+            }
+
+            return v;
+        }
+
+        status_t deserialize_kvt_param(KVTStorage *kvt, const config::param_t *param, size_t flags)
+        {
+            kvt_param_t kp;
+
+            switch (param->type())
+            {
+                case config::SF_TYPE_I32:
+                    kp.type         = KVT_INT32;
+                    kp.i32          = param->v.i32;
+                    break;
+                case config::SF_TYPE_U32:
+                    kp.type         = KVT_UINT32;
+                    kp.u32          = param->v.u32;
+                    break;
+                case config::SF_TYPE_I64:
+                    kp.type         = KVT_INT64;
+                    kp.i64          = param->v.i64;
+                    break;
+                case config::SF_TYPE_U64:
+                    kp.type         = KVT_UINT64;
+                    kp.u64          = param->v.u64;
+                    break;
+                case config::SF_TYPE_F32:
+                    kp.type         = KVT_FLOAT32;
+                    kp.f32          = param->v.f32;
+                    break;
+                case config::SF_TYPE_F64:
+                    kp.type         = KVT_FLOAT64;
+                    kp.f64          = param->v.f64;
+                    break;
+                case config::SF_TYPE_BOOL:
+                    kp.type         = KVT_FLOAT32;
+                    kp.f32          = (param->v.bval) ? 1.0f : 0.0f;
+                    break;
+                case config::SF_TYPE_STR:
+                    kp.type         = KVT_STRING;
+                    kp.str          = param->v.str;
+                    break;
+                case config::SF_TYPE_BLOB:
+                    kp.type         = KVT_BLOB;
+                    kp.blob.size    = param->v.blob.length;
+                    kp.blob.ctype   = param->v.blob.ctype;
+                    kp.blob.data    = NULL;
+                    if (param->v.blob.data != NULL)
+                    {
+                        // Allocate memory
+                        size_t src_left = strlen(param->v.blob.data);
+                        size_t dst_left = 0x10 + param->v.blob.length;
+                        void *blob      = ::malloc(dst_left);
+                        if (blob == NULL)
+                            return STATUS_NO_MEM;
+                        lsp_finally { ::free(blob); };
+
+                        // Decode
+                        size_t n = dsp::base64_dec(blob, &dst_left, param->v.blob.data, &src_left);
+                        if ((n != param->v.blob.length) || (src_left != 0))
+                            return STATUS_CORRUPTED;
+                        kp.blob.data    = blob;
+
+                        return kvt->put(param->name.get_utf8(), &kp, flags);
+                    }
+                    break;
+                default:
+                    return STATUS_BAD_TYPE;
+            }
+
+            return kvt->put(param->name.get_utf8(), &kp, flags);
+        }
+
     } /* namespace core */
 } /* namespace lsp */
 
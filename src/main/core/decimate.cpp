@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/plug-fw/core/decimate.h>
+
+namespace lsp
+{
+    namespace core
+    {
+        size_t decimated_size(size_t items, size_t width)
+        {
+            return ((width > 0) && (items > width * 2)) ? width * 2 : items;
+        }
+
+        size_t decimate_argument(float *dst, const float *src, size_t items, size_t width)
+        {
+            const size_t count  = decimated_size(items, width);
+            if (count >= items)
+            {
+                if (dst != src)
+                    dsp::copy(dst, src, items);
+                return items;
+            }
+
+            // Each segment contains at least two items, so the in-place operation
+            // never overwrites items of the segments that are not processed yet
+            for (size_t i=0, first=0; i<width; ++i)
+            {
+                const size_t next   = ((i + 1) * items) / width;
+                const float a       = src[first];
+                const float b       = src[next - 1];
+                dst[i*2]            = a;
+                dst[i*2 + 1]        = b;
+                first               = next;
+            }
+
+            return count;
+        }
+
+        size_t decimate_envelope(float *dst, const float *src, size_t items, size_t width)
+        {
+            const size_t count  = decimated_size(items, width);
+            if (count >= items)
+            {
+                if (dst != src)
+                    dsp::copy(dst, src, items);
+                return items;
+            }
+
+            for (size_t i=0, first=0; i<width; ++i)
+            {
+                const size_t next   = ((i + 1) * items) / width;
+                size_t imin = 0, imax = 0;
+                dsp::minmax_index(&src[first], next - first, &imin, &imax);
+
+                // Keep the original order of extremums
+                const float vmin    = src[first + imin];
+                const float vmax    = src[first + imax];
+                dst[i*2]            = (imin <= imax) ? vmin : vmax;
+                dst[i*2 + 1]        = (imin <= imax) ? vmax : vmin;
+                first               = next;
+            }
+
+            return count;
+        }
+
+        size_t decimate_mesh(float * const *dst, const float * const *src, size_t buffers, size_t items, size_t width)
+        {
+            if (buffers <= 0)
+                return decimated_size(items, width);
+
+            const size_t count  = decimate_argument(dst[0], src[0], items, width);
+            for (size_t i=1; i<buffers; ++i)
+                decimate_envelope(dst[i], src[i], items, width);
+
+            return count;
+        }
+
+        size_t decimate_mesh_saturated(float * const *dst, const float * const *src, size_t buffers, size_t items, size_t width)
+        {
+            const size_t count  = decimated_size(items, width);
+            if (count >= items)
+            {
+                for (size_t i=0; i<buffers; ++i)
+                    dsp::copy_saturated(dst[i], src[i], items);
+                return items;
+            }
+
+            decimate_mesh(dst, src, buffers, items, width);
+            for (size_t i=0; i<buffers; ++i)
+                dsp::saturate(dst[i], count);
+
+            return count;
+        }
+
+    } /* namespace core */
+} /* namespace lsp */
@@ -0,0 +1,438 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/common/endian.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/plug-fw/core/delta.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+namespace lsp
+{
+    namespace core
+    {
+        static constexpr size_t DELTA_HEADER_SIZE       = sizeof(uint32_t) * 4;
+        static constexpr size_t DELTA_RANGE_SIZE        = sizeof(uint32_t) * 2;
+
+        static inline uint32_t float_bits(float value)
+        {
+            uint32_t res;
+            memcpy(&res, &value, sizeof(res));
+            return res;
+        }
+
+        static inline float bits_float(uint32_t value)
+        {
+            float res;
+            memcpy(&res, &value, sizeof(res));
+            return res;
+        }
+
+        static uint16_t float_to_half(float value)
+        {
+            const uint32_t x    = float_bits(value);
+            const uint32_t sign = (x >> 16) & 0x8000;
+            const uint32_t exp  = (x >> 23) & 0xff;
+            uint32_t mant       = x & 0x7fffff;
+
+            // Infinity and NaN
+            if (exp == 0xff)
+                return sign | 0x7c00 | ((mant) ? 0x200 : 0);
+
+            // Overflow
+            const ssize_t e     = ssize_t(exp) - 127 + 15;
+            if (e >= 0x1f)
+                return sign | 0x7c00;
+
+            // Subnormal values and underflow
+            if (e <= 0)
+            {
+                if (e < -10)
+                    return sign;
+
+                mant               |= 0x800000;
+                const uint32_t shift= 14 - e;
+                const uint32_t h    = mant >> shift;
+                const uint32_t rem  = mant & ((uint32_t(1) << shift) - 1);
+                const uint32_t mid  = uint32_t(1) << (shift - 1);
+                return sign | (h + (((rem > mid) || ((rem == mid) && (h & 1))) ? 1 : 0));
+            }
+
+            // Normal values, the carry of rounding may correctly propagate to the exponent
+            uint32_t h          = (uint32_t(e) << 10) | (mant >> 13);
+            const uint32_t rem  = mant & 0x1fff;
+            if ((rem > 0x1000) || ((rem == 0x1000) && (h & 1)))
+                ++h;
+            return sign | h;
+        }
+
+        static float half_to_float(uint16_t value)
+        {
+            const uint32_t sign = uint32_t(value & 0x8000) << 16;
+            const uint32_t exp  = (value >> 10) & 0x1f;
+            uint32_t mant       = value & 0x3ff;
+
+            // Infinity and NaN
+            if (exp == 0x1f)
+                return bits_float(sign | 0x7f800000 | (mant << 13));
+            // Normal values
+            if (exp != 0)
+                return bits_float(sign | ((exp + 112) << 23) | (mant << 13));
+            // Zero
+            if (mant == 0)
+                return bits_float(sign);
+
+            // Subnormal values, normalize them
+            uint32_t e          = 113;
+            for ( ; !(mant & 0x400); --e)
+                mant              <<= 1;
+            return bits_float(sign | (e << 23) | ((mant & 0x3ff) << 13));
+        }
+
+        static inline float quantize(float value, bool half)
+        {
+            return (half) ? half_to_float(float_to_half(value)) : value;
+        }
+
+        static inline void put_uint32(uint8_t *dst, uint32_t value)
+        {
+            value   = CPU_TO_LE(value);
+            memcpy(dst, &value, sizeof(value));
+        }
+
+        static inline uint32_t get_uint32(const uint8_t *src)
+        {
+            uint32_t value;
+            memcpy(&value, src, sizeof(value));
+            return LE_TO_CPU(value);
+        }
+
+        static inline size_t values_size(size_t count, bool half)
+        {
+            return align_size(count * ((half) ? sizeof(uint16_t) : sizeof(float)), sizeof(uint32_t));
+        }
+
+        static inline size_t key_size(size_t buffers, size_t items, bool half)
+        {
+            return DELTA_HEADER_SIZE + buffers * (sizeof(uint32_t) + DELTA_RANGE_SIZE + values_size(items, half));
+        }
+
+        static size_t put_values(uint8_t *dst, const float *src, size_t count, bool half)
+        {
+            const size_t bytes  = values_size(count, half);
+            if (half)
+            {
+                uint16_t *v         = reinterpret_cast<uint16_t *>(dst);
+                encode_half(v, src, count);
+                if (count & 1)
+                    v[count]            = 0;
+            }
+            else
+            {
+                for (size_t i=0; i<count; ++i, dst += sizeof(uint32_t))
+                    put_uint32(dst, float_bits(src[i]));
+            }
+
+            return bytes;
+        }
+
+        void encode_half(uint16_t *dst, const float *src, size_t count)
+        {
+            for (size_t i=0; i<count; ++i)
+                dst[i]      = CPU_TO_LE(float_to_half(src[i]));
+        }
+
+        void decode_half(float *dst, const uint16_t *src, size_t count)
+        {
+            for (size_t i=0; i<count; ++i)
+                dst[i]      = half_to_float(LE_TO_CPU(src[i]));
+        }
+
+        DeltaEncoder::DeltaEncoder()
+        {
+            vRef            = NULL;
+            vPacket         = NULL;
+            nMaxBuffers     = 0;
+            nMaxItems       = 0;
+            nCapacity       = 0;
+            nBuffers        = 0;
+            nItems          = 0;
+            nSerial         = 0;
+            nFrames         = 0;
+            bHalf           = false;
+            bKey            = true;
+        }
+
+        DeltaEncoder::~DeltaEncoder()
+        {
+            destroy();
+        }
+
+        status_t DeltaEncoder::init(size_t buffers, size_t items, bool half)
+        {
+            destroy();
+
+            const size_t capacity   = key_size(buffers, items, half);
+            float *ref              = static_cast<float *>(malloc(sizeof(float) * lsp_max(buffers * items, size_t(1))));
+            if (ref == NULL)
+                return STATUS_NO_MEM;
+            uint8_t *packet         = static_cast<uint8_t *>(malloc(capacity));
+            if (packet == NULL)
+            {
+                free(ref);
+                return STATUS_NO_MEM;
+            }
+
+            vRef            = ref;
+            vPacket         = packet;
+            nMaxBuffers     = buffers;
+            nMaxItems       = items;
+            nCapacity       = capacity;
+            bHalf           = half;
+
+            return STATUS_OK;
+        }
+
+        void DeltaEncoder::destroy()
+        {
+            if (vRef != NULL)
+            {
+                free(vRef);
+                vRef            = NULL;
+            }
+            if (vPacket != NULL)
+            {
+                free(vPacket);
+                vPacket         = NULL;
+            }
+
+            nMaxBuffers     = 0;
+            nMaxItems       = 0;
+            nCapacity       = 0;
+            nBuffers        = 0;
+            nItems          = 0;
+            nFrames         = 0;
+            bKey            = true;
+        }
+
+        size_t DeltaEncoder::encode_key(const float * const *src, size_t buffers, size_t items)
+        {
+            uint8_t *ptr    = vPacket;
+            put_uint32(&ptr[0], DELTA_KEY | ((bHalf) ? DELTA_HALF : 0));
+            put_uint32(&ptr[4], nSerial);
+            put_uint32(&ptr[8], buffers);
+            put_uint32(&ptr[12], items);
+            ptr            += DELTA_HEADER_SIZE;
+
+            for (size_t i=0; i<buffers; ++i)
+            {
+                // Update the reference data and emit one range containing all items
+                float *ref      = &vRef[i * nMaxItems];
+                const float *s  = src[i];
+                for (size_t j=0; j<items; ++j)
+                    ref[j]          = quantize(s[j], bHalf);
+
+                put_uint32(&ptr[0], 1);
+                put_uint32(&ptr[4], 0);
+                put_uint32(&ptr[8], items);
+                ptr            += sizeof(uint32_t) + DELTA_RANGE_SIZE;
+                ptr            += put_values(ptr, ref, items, bHalf);
+            }
+
+            return ptr - vPacket;
+        }
+
+        size_t DeltaEncoder::encode_delta(const float * const *src, size_t buffers, size_t items)
+        {
+            // The range header costs as much as this number of unchanged items,
+            // so shorter gaps between changed items are transmitted as is
+            const size_t gap    = DELTA_RANGE_SIZE / ((bHalf) ? sizeof(uint16_t) : sizeof(float));
+            const uint8_t *end  = &vPacket[key_size(buffers, items, bHalf)];
+
+            uint8_t *ptr    = vPacket;
+            put_uint32(&ptr[0], (bHalf) ? DELTA_HALF : 0);
+            put_uint32(&ptr[4], nSerial);
+            put_uint32(&ptr[8], buffers);
+            put_uint32(&ptr[12], items);
+            ptr            += DELTA_HEADER_SIZE;
+
+            for (size_t i=0; i<buffers; ++i)
+            {
+                float *ref      = &vRef[i * nMaxItems];
+                const float *s  = src[i];
+                uint8_t *head   = ptr;
+                uint32_t ranges = 0;
+                ptr            += sizeof(uint32_t);
+
+                for (size_t j=0; j<items; )
+                {
+                    // Find the first changed item
+                    float v         = quantize(s[j], bHalf);
+                    if (float_bits(v) == float_bits(ref[j]))
+                    {
+                        ++j;
+                        continue;
+                    }
+
+                    // Find the end of the range
+                    const size_t first  = j;
+                    size_t last         = j + 1;
+                    for (ref[j++] = v; j<items; ++j)
+                    {
+                        v               = quantize(s[j], bHalf);
+                        if (float_bits(v) != float_bits(ref[j]))
+                        {
+                            ref[j]          = v;
+                            last            = j + 1;
+                        }
+                        else if ((j - last) >= gap)
+                            break;
+                    }
+
+                    // Emit the range, fall back to the key packet if delta packet is not smaller
+                    const size_t count  = last - first;
+                    if (ptr + DELTA_RANGE_SIZE + values_size(count, bHalf) >= end)
+                        return 0;
+                    put_uint32(&ptr[0], first);
+                    put_uint32(&ptr[4], count);
+                    ptr            += DELTA_RANGE_SIZE;
+                    ptr            += put_values(ptr, &ref[first], count, bHalf);
+                    ++ranges;
+                }
+
+                put_uint32(head, ranges);
+            }
+
+            return ptr - vPacket;
+        }
+
+        size_t DeltaEncoder::encode(const float * const *src, size_t buffers, size_t items)
+        {
+            if ((vPacket == NULL) || (buffers > nMaxBuffers) || (items > nMaxItems))
+                return 0;
+
+            ++nSerial;
+            if ((!bKey) && (nFrames < KEY_INTERVAL) && (buffers == nBuffers) && (items == nItems))
+            {
+                const size_t size   = encode_delta(src, buffers, items);
+                if (size > 0)
+                {
+                    ++nFrames;
+                    return size;
+                }
+            }
+
+            const size_t size   = encode_key(src, buffers, items);
+            nBuffers        = buffers;
+            nItems          = items;
+            nFrames         = 0;
+            bKey            = false;
+
+            return size;
+        }
+
+        DeltaDecoder::DeltaDecoder()
+        {
+            nSerial         = 0;
+            nBuffers        = 0;
+            nItems          = 0;
+            bValid          = false;
+        }
+
+        DeltaDecoder::~DeltaDecoder()
+        {
+        }
+
+        bool DeltaDecoder::decode(
+            float * const *dst, size_t *buffers, size_t *items,
+            size_t max_buffers, size_t max_items,
+            const void *data, size_t size)
+        {
+            const uint8_t *ptr  = static_cast<const uint8_t *>(data);
+            const uint8_t *end  = &ptr[size];
+
+            // Validate the header
+            if (size < DELTA_HEADER_SIZE)
+                return bValid = false;
+            const uint32_t flags    = get_uint32(&ptr[0]);
+            const uint32_t serial   = get_uint32(&ptr[4]);
+            const size_t n_buffers  = get_uint32(&ptr[8]);
+            const size_t n_items    = get_uint32(&ptr[12]);
+            ptr                    += DELTA_HEADER_SIZE;
+
+            if ((n_buffers > max_buffers) || (n_items > max_items))
+                return bValid = false;
+            if (!(flags & DELTA_KEY))
+            {
+                // Delta packet can be applied only to the state of the previous packet
+                if ((!bValid) || (serial != uint32_t(nSerial + 1)) || (n_buffers != nBuffers) || (n_items != nItems))
+                    return bValid = false;
+            }
+
+            // Apply ranges, the destination becomes invalid on any error
+            const bool half         = flags & DELTA_HALF;
+            for (size_t i=0; i<n_buffers; ++i)
+            {
+                if (ptr + sizeof(uint32_t) > end)
+                    return bValid = false;
+                const size_t ranges     = get_uint32(ptr);
+                ptr                    += sizeof(uint32_t);
+
+                for (size_t j=0; j<ranges; ++j)
+                {
+                    if (ptr + DELTA_RANGE_SIZE > end)
+                        return bValid = false;
+                    const size_t offset     = get_uint32(&ptr[0]);
+                    const size_t count      = get_uint32(&ptr[4]);
+                    ptr                    += DELTA_RANGE_SIZE;
+                    if ((offset > n_items) || (count > n_items - offset))
+                        return bValid = false;
+                    const size_t bytes      = values_size(count, half);
+                    if (ptr + bytes > end)
+                        return bValid = false;
+
+                    float *v                = &dst[i][offset];
+                    if (half)
+                        decode_half(v, reinterpret_cast<const uint16_t *>(ptr), count);
+                    else
+                    {
+                        for (size_t k=0; k<count; ++k)
+                            v[k]                    = bits_float(get_uint32(&ptr[k * sizeof(uint32_t)]));
+                    }
+                    dsp::saturate(v, count);
+                    ptr                    += bytes;
+                }
+            }
+
+            nSerial         = serial;
+            nBuffers        = n_buffers;
+            nItems          = n_items;
+            bValid          = true;
+
+            *buffers        = n_buffers;
+            *items          = n_items;
+
+            return true;
+        }
+
+    } /* namespace core */
+} /* namespace lsp */
@@ -32,6 +32,7 @@ namespace lsp
     namespace core
     {
         constexpr size_t DEFAULT_TEMP_BUFFER_SIZE   = 0x1000;
+        constexpr uint32_t PACKET_PADDING           = 0xffffffff;   // Size marker of the padding until the end of the buffer
 
         //-------------------------------------------------------------------------
         // osc_buffer_t methods
@@ -60,6 +61,8 @@ namespace lsp
             res->nCapacity      = capacity;
             res->nHead          = 0;
             res->nTail          = 0;
+            res->nReserved      = 0;
+            res->nPadding       = 0;
             res->pBuffer        = ptr;
             res->pTempBuf       = tmp;
             res->nTempSize      = DEFAULT_TEMP_BUFFER_SIZE;
@@ -82,43 +85,71 @@ namespace lsp
                 free_aligned(buf->pData);
         }
 
-        status_t osc_buffer_t::submit(const void *data, size_t size)
+        void *osc_buffer_t::reserve_packet(size_t size)
         {
             if ((!size) || (size % sizeof(uint32_t)))
-                return STATUS_BAD_ARGUMENTS;
+                return NULL;
+
+            // The packet should be stored as contiguous region, pad the end of the buffer if it does not fit.
+            // The head belongs to the reader, so it gets realigned only by the padding record. The largest
+            // contiguous region of the empty buffer is at least half of its capacity.
+            const size_t length = size + sizeof(uint32_t);
+            const size_t tail   = nCapacity - nTail;
+            const size_t pad    = (tail < length) ? tail : 0;
 
             // Ensure that there is enough space in buffer
-            size_t oldsize  = atomic_load(&nSize);
-            size_t newsize  = oldsize + size + sizeof(uint32_t);
-            if (newsize > nCapacity)
-                return (oldsize == 0) ? STATUS_TOO_BIG : STATUS_OVERFLOW;
+            if ((atomic_load(&nSize) + pad + length) > nCapacity)
+                return NULL;
 
-            // Store packet size to the buffer and move the tail
-            *(reinterpret_cast<uint32_t *>(&pBuffer[nTail])) = CPU_TO_BE(uint32_t(size));
-            nTail          += sizeof(uint32_t);
-            if (nTail > nCapacity)
-                nTail          -= nCapacity;
+            nReserved       = size;
+            nPadding        = pad;
+
+            return &pBuffer[((pad > 0) ? 0 : nTail) + sizeof(uint32_t)];
+        }
+
+        status_t osc_buffer_t::commit_packet(size_t size)
+        {
+            if ((!size) || (size % sizeof(uint32_t)))
+                return STATUS_BAD_ARGUMENTS;
+            if (size > nReserved)
+                return STATUS_OVERFLOW;
 
-            // Store packet data and move the tail
-            size_t head     = nCapacity - nTail;
-            if (size > head)
+            // Store the padding marker
+            if (nPadding > 0)
             {
-                const uint8_t *src  = reinterpret_cast<const uint8_t *>(data);
-                ::memcpy(&pBuffer[nTail], src, head);
-                ::memcpy(pBuffer, &src[head], size - head);
+                *(reinterpret_cast<uint32_t *>(&pBuffer[nTail])) = PACKET_PADDING;
+                nTail           = 0;
             }
-            else
-                ::memcpy(&pBuffer[nTail], data, size);
 
-            nTail          += size;
-            if (nTail > nCapacity)
+            // Store packet size to the buffer and move the tail
+            *(reinterpret_cast<uint32_t *>(&pBuffer[nTail])) = CPU_TO_BE(uint32_t(size));
+            nTail          += size + sizeof(uint32_t);
+            if (nTail >= nCapacity)
                 nTail          -= nCapacity;
 
-            // Update the size
-            atomic_store(&nSize, newsize);
+            // Update the size, the reader may decrement it concurrently
+            atomic_add(&nSize, nPadding + size + sizeof(uint32_t));
+            nReserved       = 0;
+            nPadding        = 0;
+
             return STATUS_OK;
         }
 
+        status_t osc_buffer_t::submit(const void *data, size_t size)
+        {
+            if ((!size) || (size % sizeof(uint32_t)))
+                return STATUS_BAD_ARGUMENTS;
+            if ((size + sizeof(uint32_t)) > nCapacity)
+                return STATUS_TOO_BIG;
+
+            void *dst       = reserve_packet(size);
+            if (dst == NULL)
+                return (atomic_load(&nSize) == 0) ? STATUS_TOO_BIG : STATUS_OVERFLOW;
+
+            ::memcpy(dst, data, size);
+            return commit_packet(size);
+        }
+
         status_t osc_buffer_t::reserve(size_t size)
         {
             if (nTempSize >= size)
@@ -144,8 +175,10 @@ namespace lsp
         void osc_buffer_t::clear()
         {
             atomic_store(&nSize, size_t(0));
-            nHead   = 0;
-            nTail   = 0;
+            nHead       = 0;
+            nTail       = 0;
+            nReserved   = 0;
+            nPadding    = 0;
         }
 
     #define SUBMIT_SIMPLE_IMPL(address, func, ...) \
@@ -153,7 +186,9 @@ namespace lsp
             osc::forge_t forge; \
             osc::forge_frame_t sframe, message; \
             \
-            status_t res = osc::forge_begin_fixed(&sframe, &forge, pTempBuf, nTempSize); \
+            uint8_t *buf = static_cast<uint8_t *>(reserve_packet(nTempSize)); \
+            const bool in_place = buf != NULL; \
+            status_t res = osc::forge_begin_fixed(&sframe, &forge, (in_place) ? buf : pTempBuf, nTempSize); \
             status_t res2; \
             if (res == STATUS_OK) {\
                 res     = osc::forge_begin_message(&message, &sframe, address); \
@@ -167,7 +202,9 @@ namespace lsp
             if (res == STATUS_OK) res = res2; \
             res2   = osc::forge_destroy(&forge); \
             if (res == STATUS_OK) res = res2; \
-            return (res == STATUS_OK) ? submit(&packet) : res;
+            if (res != STATUS_OK) \
+                return res; \
+            return (in_place) ? commit_packet(packet.size) : submit(&packet);
 
         status_t osc_buffer_t::submit_int32(const char *address, int32_t value)
         {
@@ -266,7 +303,11 @@ namespace lsp
             osc::forge_t forge;
             osc::forge_frame_t sframe;
 
-            status_t res = osc::forge_begin_fixed(&sframe, &forge, pTempBuf, nTempSize);
+            // Try to forge the message directly in the buffer
+            uint8_t *buf        = static_cast<uint8_t *>(reserve_packet(nTempSize));
+            const bool in_place = buf != NULL;
+
+            status_t res = osc::forge_begin_fixed(&sframe, &forge, (in_place) ? buf : pTempBuf, nTempSize);
             if (res == STATUS_OK)
                 res     = osc::forge_message(&sframe, address, params, args);
 
@@ -275,47 +316,63 @@ namespace lsp
                 res         = osc::forge_close(&packet, &forge);
 
             res     = update_status(res, osc::forge_destroy(&forge));
-            return (res == STATUS_OK) ? submit(&packet) : res;
+            if (res != STATUS_OK)
+                return res;
+
+            return (in_place) ? commit_packet(packet.size) : submit(&packet);
         }
 
-        status_t osc_buffer_t::fetch(void *data, size_t *size, size_t limit)
+        status_t osc_buffer_t::peek(osc::packet_t *packet)
         {
-            if ((data == NULL) || (size == NULL) || (!limit))
+            if (packet == NULL)
                 return STATUS_BAD_ARGUMENTS;
 
-            // There is enough space in the buffer?
             size_t bufsz    = atomic_load(&nSize);
-            if (bufsz < sizeof(uint32_t))
-                return STATUS_NO_DATA;
-
-            // Read size, analyze state of the record and update head
-            size_t psize    = BE_TO_CPU(*(reinterpret_cast<uint32_t *>(&pBuffer[nHead])));
-            if (psize > limit) // We have enough space to store the data?
-                return STATUS_OVERFLOW;
-            if ((psize + sizeof(uint32_t)) > bufsz) // Record is valid?
-                return STATUS_CORRUPTED;
-            *size           = psize;
-            nHead          += sizeof(uint32_t);
-            if (nHead > nCapacity)
-                nHead          -= nCapacity;
-
-            // Copy the buffer contents
-            size_t head     = nCapacity - nHead;
-            if (head < psize)
+            while (true)
             {
-                uint8_t *dst    = reinterpret_cast<uint8_t *>(data);
-                ::memcpy(dst, &pBuffer[nHead], head);
-                ::memcpy(&dst[head], pBuffer, psize - head);
+                // There is enough space in the buffer?
+                if (bufsz < sizeof(uint32_t))
+                    return STATUS_NO_DATA;
+
+                // Skip the padding at the end of the buffer
+                const uint32_t psize = *(reinterpret_cast<uint32_t *>(&pBuffer[nHead]));
+                if (psize == PACKET_PADDING)
+                {
+                    const size_t pad    = nCapacity - nHead;
+                    if (pad > bufsz) // Record is valid?
+                        return STATUS_CORRUPTED;
+                    nHead               = 0;
+                    atomic_add(&nSize, -pad);
+                    bufsz              -= pad;
+                    continue;
+                }
+
+                // Analyze state of the record
+                packet->size    = BE_TO_CPU(psize);
+                if ((packet->size + sizeof(uint32_t)) > bufsz) // Record is valid?
+                    return STATUS_CORRUPTED;
+                packet->data    = &pBuffer[nHead + sizeof(uint32_t)];
+
+                return STATUS_OK;
             }
-            else
-                ::memcpy(data, &pBuffer[nHead], psize);
+        }
 
-            nHead          += psize;
-            if (nHead > nCapacity)
-                nHead          -= nCapacity;
+        status_t osc_buffer_t::fetch(void *data, size_t *size, size_t limit)
+        {
+            if ((data == NULL) || (size == NULL) || (!limit))
+                return STATUS_BAD_ARGUMENTS;
+
+            osc::packet_t packet;
+            status_t res    = peek(&packet);
+            if (res != STATUS_OK)
+                return res;
+            if (packet.size > limit) // We have enough space to store the data?
+                return STATUS_OVERFLOW;
 
-            // Decrement size
-            atomic_add(&nSize, -(psize + sizeof(uint32_t)));
+            // Copy the buffer contents and release the record
+            ::memcpy(data, packet.data, packet.size);
+            *size           = packet.size;
+            skip();
 
             return STATUS_OK;
         }
@@ -327,22 +384,18 @@ namespace lsp
 
         size_t osc_buffer_t::skip()
         {
-            size_t bufsz    = atomic_load(&nSize);
-            if (bufsz < sizeof(uint32_t))
-                return 0;
-
-            size_t ihead    = nHead;
-            uint32_t *head  = reinterpret_cast<uint32_t *>(&pBuffer[ihead]);
-            size_t psize    = BE_TO_CPU(*head);
-
-            if ((psize + sizeof(uint32_t)) > bufsz) // Record is valid?
+            osc::packet_t packet;
+            if (peek(&packet) != STATUS_OK)
                 return 0;
 
             // Decrement the size and update the head
-            nHead           = (ihead + psize + sizeof(uint32_t)) % nCapacity;
-            atomic_add(&nSize, -(psize + sizeof(uint32_t)));
+            const size_t length = packet.size + sizeof(uint32_t);
+            nHead          += length;
+            if (nHead >= nCapacity)
+                nHead          -= nCapacity;
+            atomic_add(&nSize, -length);
 
-            return psize;
+            return packet.size;
         }
 
     } /* namespace core */
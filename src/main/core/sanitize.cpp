@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/plug-fw/core/sanitize.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+namespace lsp
+{
+    namespace core
+    {
+        static constexpr size_t SANITIZE_CHUNK      = 64;
+
+        bool need_sanitize(const float *src, size_t count)
+        {
+            // lsp-dsp-lib has no primitive that reports denormals, so the scan is scalar.
+            // Process data in chunks using branch-free code to allow auto-vectorization
+            // and perform early exit when non-normal value has been detected
+            for (size_t offset = 0; offset < count; )
+            {
+                const size_t to_do  = lsp_min(count - offset, SANITIZE_CHUNK);
+                uint32_t bad        = 0;
+
+                for (size_t i=0; i<to_do; ++i)
+                {
+                    // Read the bit pattern through memcpy() to avoid strict aliasing violation,
+                    // the compiler reduces it to a plain load
+                    uint32_t a;
+                    memcpy(&a, &src[offset + i], sizeof(a));
+                    a                  &= 0x7fffffff;
+                    // Denormal: 0 < a < 0x00800000, NaN or Inf: a >= 0x7f800000
+                    bad                |= uint32_t((a - 1) < 0x007fffff) | uint32_t(a >= 0x7f800000);
+                }
+
+                if (bad)
+                    return true;
+                offset             += to_do;
+            }
+
+            return false;
+        }
+
+    } /* namespace core */
+} /* namespace lsp */
@@ -22,6 +22,7 @@
 #include <lsp-plug.in/common/debug.h>
 #include <lsp-plug.in/plug-fw/ctl.h>
 #include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/plug-fw/core/DspProfiler.h>
 #include <lsp-plug.in/plug-fw/core/presets.h>
 #include <lsp-plug.in/plug-fw/meta/func.h>
 #include <lsp-plug.in/plug-fw/meta/ports.h>
@@ -463,8 +464,8 @@ namespace lsp
                 itm->slots()->bind(tk::SLOT_SUBMIT, slot_show_user_paths_dialog, this);
                 wMenu->add(itm);
 
-                // Create 'Dump state' menu item if supported
-                if (meta->extensions & meta::E_DUMP_STATE)
+                // Create 'Dump state' menu item if supported, the dump also contains DSP timings when profiling is enabled
+                if ((meta->extensions & meta::E_DUMP_STATE) || (core::DspProfiler::enabled()))
                 {
                     itm     = new tk::MenuItem(dpy);
                     widgets()->add(itm);
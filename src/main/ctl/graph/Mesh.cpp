@@ -70,6 +70,7 @@ namespace lsp
 
             bStream         = stream;
             bStrobe         = false;
+            bDecimate       = false;
             nXIndex         = -1;
             nYIndex         = -1;
             nSIndex         = -1;
@@ -102,6 +103,8 @@ namespace lsp
                 sSIndex.init(pWrapper, this);
                 sMaxDots.init(pWrapper, this);
                 sStrobe.init(pWrapper, this);
+
+                gm->slots()->bind(tk::SLOT_RESIZE_PARENT, slot_graph_resize, this);
             }
 
             return STATUS_OK;
@@ -153,6 +156,8 @@ namespace lsp
                 set_expr(&sSIndex, "s", name, value);
                 set_expr(&sMaxDots, "dots.max", name, value);
                 set_expr(&sStrobe, "strobe", name, value);
+
+                set_value(&bDecimate, "decimate", name, value);
             }
 
             return Widget::set(ctx, name, value);
@@ -213,12 +218,44 @@ namespace lsp
                 (sStrobe.depends(port)))
             {
                 trigger_expr();
+                request_display_width();
                 commit_data();
             }
             else if ((pPort == port) && (pPort != NULL))
                 commit_data();
         }
 
+        void Mesh::request_display_width()
+        {
+            if (pPort == NULL)
+                return;
+
+            // Decimation is possible only if the first buffer of the mesh is the argument,
+            // otherwise prevent other widgets bound to the same port from requesting it
+            if ((!bDecimate) || (bStream) || (bStrobe) || (nXIndex != 0))
+            {
+                pPort->set_display_width(ui::DISPLAY_WIDTH_FULL);
+                return;
+            }
+
+            tk::GraphMesh *gm   = tk::widget_cast<tk::GraphMesh>(wWidget);
+            tk::Graph *g        = (gm != NULL) ? gm->graph() : NULL;
+            if (g == NULL)
+                return;
+
+            const ssize_t width = g->canvas_width();
+            if (width > 0)
+                pPort->set_display_width(width);
+        }
+
+        status_t Mesh::slot_graph_resize(tk::Widget *sender, void *ptr, void *data)
+        {
+            ctl::Mesh *self     = static_cast<ctl::Mesh *>(ptr);
+            if (self != NULL)
+                self->request_display_width();
+            return STATUS_OK;
+        }
+
         ssize_t Mesh::get_strobe_block_size(const float *s, size_t size)
         {
             for (ssize_t i=size-1; i>=0; --i)
@@ -353,6 +390,7 @@ namespace lsp
         {
             Widget::end(ctx);
             trigger_expr();
+            request_display_width();
         }
 
     } /* namespace ctl */
@@ -568,6 +568,10 @@ namespace lsp
 
         void AudioSample::end(ui::UIContext *ctx)
         {
+            // The channel data of the mesh should not be decimated
+            if (pMeshPort != NULL)
+                pMeshPort->set_display_width(ui::DISPLAY_WIDTH_FULL);
+
             sync_status();
             sync_mesh();
             sync_labels();
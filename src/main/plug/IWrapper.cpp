@@ -35,8 +35,13 @@ namespace lsp
             pPlugin         = plugin;
             pLoader         = loader;
             pCanvas         = NULL;
+            pProfiler       = NULL;
 
             position_t::init(&sPosition);
+
+            const meta::plugin_t *meta = (plugin != NULL) ? plugin->metadata() : NULL;
+            if (meta != NULL)
+                pProfiler       = core::DspProfiler::create(meta->uid);
         }
 
         IWrapper::~IWrapper()
@@ -48,10 +53,20 @@ namespace lsp
                 delete pCanvas;
             }
 
+            // Store the DSP profile and drop the profiler
+            if (pProfiler != NULL)
+            {
+                status_t res = pProfiler->save();
+                if (res != STATUS_OK)
+                    lsp_warn("Could not save DSP profile: %d", int(res));
+                delete pProfiler;
+            }
+
             // Clear fields
             pPlugin         = NULL;
             pLoader         = NULL;
             pCanvas         = NULL;
+            pProfiler       = NULL;
         }
 
         ipc::IExecutor *IWrapper::executor()
@@ -59,6 +74,12 @@ namespace lsp
             return NULL;
         }
 
+        void IWrapper::profile_end(core::dsp_probe_t probe, uint64_t start, size_t samples)
+        {
+            if ((pProfiler != NULL) && (pPlugin != NULL))
+                pProfiler->commit(probe, start, samples, pPlugin->sample_rate());
+        }
+
         void IWrapper::query_display_draw()
         {
         }
@@ -205,12 +226,29 @@ namespace lsp
                     pPlugin->dump(&v);
                 }
                 v.end_raw_object();
+
+                // Dump DSP timings
+                if (pProfiler != NULL)
+                {
+                    v.begin_raw_object("timings");
+                    {
+                        pProfiler->dump(&v);
+                    }
+                    v.end_raw_object();
+                }
             }
 
             v.end_raw_object();
             v.close();
 
             lsp_info("State has been dumped to file:\n%s", path.as_utf8());
+
+            // Store the machine-readable DSP profile
+            if (pProfiler != NULL)
+            {
+                if ((res = pProfiler->save()) != STATUS_OK)
+                    lsp_warn("Could not save DSP profile: %d", int(res));
+            }
         }
 
         const meta::package_t *IWrapper::package() const
@@ -49,29 +49,138 @@ namespace lsp
             return count >= src->nEvents;
         }
 
-        bool midi_t::push_slice(const midi_t *src, uint32_t start, uint32_t end)
+        bool midi_t::insert(const midi::event_t *me)
         {
-            // Find the start position to perform the copy of events, assuming events being sorted
-            const midi::event_t *se;
-            ssize_t first=0, last=src->nEvents - 1;
+            if (nEvents >= MIDI_EVENTS_MAX)
+                return false;
+
+            // Find the position after all events with the same timestamp, skip search for chronological order
+            size_t index        = nEvents;
+            if ((index > 0) && (vEvents[index - 1].timestamp > me->timestamp))
+            {
+                size_t first = 0, last = index - 1;
+                while (first < last)
+                {
+                    const size_t middle = (first + last) >> 1;
+                    if (vEvents[middle].timestamp > me->timestamp)
+                        last    = middle;
+                    else
+                        first   = middle + 1;
+                }
+
+                index               = first;
+                ::memmove(&vEvents[index + 1], &vEvents[index], (nEvents - index) * sizeof(midi::event_t));
+            }
+
+            vEvents[index]      = *me;
+            ++nEvents;
+
+            return true;
+        }
+
+        size_t midi_t::lower_bound(uint32_t timestamp) const
+        {
+            size_t first = 0, last = nEvents;
             while (first < last)
             {
-                ssize_t middle = (first + last) >> 1;
-                se = &src->vEvents[middle];
-                if (se->timestamp >= start)
-                    last    = middle - 1;
-                else
+                const size_t middle = (first + last) >> 1;
+                if (vEvents[middle].timestamp < timestamp)
                     first   = middle + 1;
+                else
+                    last    = middle;
+            }
+
+            return first;
+        }
+
+        size_t midi_t::push_split(const midi_t *src, size_t first, uint32_t start, uint32_t end)
+        {
+            size_t i = first;
+            for ( ; i<src->nEvents; ++i)
+            {
+                // Check that event's timestamp is within the block
+                const midi::event_t *se = &src->vEvents[i];
+                if (se->timestamp >= end)
+                    break;
+
+                // Events that do not fit into the queue are dropped
+                if (nEvents >= MIDI_EVENTS_MAX)
+                    continue;
+
+                // Copy event and update timestamp
+                midi::event_t *ev   = &vEvents[nEvents++];
+                *ev                 = *se;
+                ev->timestamp       = (se->timestamp > start) ? se->timestamp - start : 0;
+            }
+
+            return i;
+        }
+
+        bool midi_t::merge(const midi_t *src)
+        {
+            return merge_shifted(src, 0);
+        }
+
+        bool midi_t::merge_shifted(const midi_t *src, uint32_t offset)
+        {
+            const size_t count  = src->nEvents;
+            if (count <= 0)
+                return true;
+
+            // Source events follow all events of the queue: just append them
+            if ((nEvents <= 0) || (vEvents[nEvents - 1].timestamp <= src->vEvents[0].timestamp + offset))
+                return push_all_shifted(src, offset);
+
+            // Merge queues starting from the tail, the latest events are dropped on overflow
+            const size_t total  = lsp_min(nEvents + count, MIDI_EVENTS_MAX);
+            const bool res      = (nEvents + count) <= MIDI_EVENTS_MAX;
+            size_t skip         = nEvents + count - total;
+            ssize_t i           = nEvents - 1;
+            ssize_t j           = count - 1;
+            ssize_t k           = total - 1;
+
+            while (j >= 0)
+            {
+                const midi::event_t *se = &src->vEvents[j];
+                const uint32_t ts       = se->timestamp + offset;
+
+                if ((i >= 0) && (vEvents[i].timestamp > ts))
+                {
+                    if (skip > 0)
+                        --skip;
+                    else
+                        vEvents[k--]        = vEvents[i];
+                    --i;
+                }
+                else
+                {
+                    if (skip > 0)
+                        --skip;
+                    else
+                    {
+                        midi::event_t *ev   = &vEvents[k--];
+                        *ev                 = *se;
+                        ev->timestamp       = ts;
+                    }
+                    --j;
+                }
             }
 
-            // Copy events
-            for (size_t i=first; i<src->nEvents; ++i)
+            // Remaining events of the queue are already at their places
+            nEvents             = total;
+
+            return res;
+        }
+
+        bool midi_t::push_slice(const midi_t *src, uint32_t start, uint32_t end)
+        {
+            // Copy events starting with the first event within the range, assuming events being sorted
+            const midi::event_t *se;
+            for (size_t i=src->lower_bound(start); i<src->nEvents; ++i)
             {
                 // Check that event's timestamp is within the specified range
                 se                  = &src->vEvents[i];
-                if (se->timestamp < start)
-                    continue;
-                else if (se->timestamp >= end)
+                if (se->timestamp >= end)
                     return true;
 
                 // Check that we are able to add one more event
@@ -144,6 +253,22 @@ namespace lsp
 
         //-------------------------------------------------------------------------
         // string_t methods
+        static inline uint32_t string_next_serial(string_t *s, bool state)
+        {
+            // Serial numbers are allocated by both writers and real-time thread, so use atomic addition
+            const uint32_t serial = atomic_add(&s->nRequest, 2) + 2;
+            return (serial & (~uint32_t(1))) | (state ? 1 : 0);
+        }
+
+        static inline uint32_t string_publish(string_t *s, bool state)
+        {
+            // Exchange the back buffer with the middle buffer and mark it pending
+            const uint32_t serial   = string_next_serial(s, state);
+            s->vSerials[s->nBack]   = serial;
+            s->nBack                = atomic_swap(&s->nMiddle, s->nBack | string_t::SB_PENDING) & string_t::SB_INDEX;
+            return serial;
+        }
+
         uint32_t string_t::submit(const char *str, bool state)
         {
             // Acquire lock
@@ -170,7 +295,7 @@ namespace lsp
             size_t len = lsp_min(str->length(), nCapacity);
             const char *src = str->get_utf8(0, len);
             if (src == NULL)
-                return nRequest;
+                return atomic_load(&nRequest);
 
             // Acquire lock
             while (!atomic_trylock(nLock))
@@ -178,65 +303,78 @@ namespace lsp
             lsp_finally { atomic_unlock(nLock); };
 
             // Update string
-            strcpy(sPending, src);
-
-            const uint32_t serial = ((nRequest + 2) & (~uint32_t(1))) | (state ? 1 : 0);
-            nRequest        = serial;
-            return serial;
+            strcpy(vBuffers[nBack], src);
+            return string_publish(this, state);
         }
 
         uint32_t string_t::set(const char *str, bool state)
         {
             // Update string
-            utf8_strncpy(sPending, nCapacity, str);
-            const uint32_t serial = ((nRequest + 2) & (~uint32_t(1))) | (state ? 1 : 0);
-            nRequest        = serial;
-            return serial;
+            utf8_strncpy(vBuffers[nBack], nCapacity, str);
+            return string_publish(this, state);
         }
 
         uint32_t string_t::set(const void *buffer, size_t size, bool state)
         {
             // Update string
-            utf8_strncpy(sPending, nCapacity, buffer, size);
-            const uint32_t serial = ((nRequest + 2) & (~uint32_t(1))) | (state ? 1 : 0);
-            nRequest        = serial;
-            return serial;
+            utf8_strncpy(vBuffers[nBack], nCapacity, buffer, size);
+            return string_publish(this, state);
         }
 
         bool string_t::fetch(uint32_t *serial, char *dst, size_t size)
         {
-            const uint32_t s = atomic_load(&nSerial);
-            if (s == *serial)
+            if (atomic_load(&nSerial) == *serial)
                 return false;
 
-            // Acquire lock
-            while (!atomic_trylock(nLock))
-                ipc::Thread::yield();
-            lsp_finally {
-                atomic_unlock(nLock);
-            };
+            *serial = read(dst, size);
+            return true;
+        }
+
+        uint32_t string_t::read(char *dst, size_t size) const
+        {
+            while (true)
+            {
+                // The front buffer may be exchanged and overwritten while copying,
+                // in this case the version changes and the copy is repeated
+                const uint32_t version = atomic_load(&nVersion);
+                if (version & 1)
+                {
+                    ipc::Thread::yield();
+                    continue;
+                }
 
-            // Copy data
-            strncpy(dst, sData, size);
-            sData[size-1] = '\0';
-            *serial = s;
+                const uint32_t serial = atomic_load(&nSerial);
+                const char *src = vBuffers[atomic_load(&nFront) & SB_INDEX];
+                strncpy(dst, src, size);
+                dst[size-1] = '\0';
 
-            return true;
+                if (atomic_load(&nVersion) == version)
+                    return serial;
+            }
         }
 
-        bool string_t::sync()
+        char *string_t::snapshot() const
         {
-            if (!atomic_trylock(nLock))
-                return false;
-            lsp_finally { atomic_unlock(nLock); };
+            const size_t size = max_bytes() + 1;
+            char *res = static_cast<char *>(malloc(size));
+            if (res != NULL)
+                read(res, size);
+            return res;
+        }
 
-            uint32_t serial = atomic_load(&nSerial);
-            if (serial == nRequest)
+        bool string_t::sync()
+        {
+            if (!(atomic_load(&nMiddle) & SB_PENDING))
                 return false;
 
-            // Copy contents and update state
-            strcpy(sData, sPending);
-            atomic_store(&nSerial, nRequest);
+            // Exchange the front buffer with the middle buffer, the previous front buffer
+            // becomes available to writers, so readers should repeat the copy
+            atomic_add(&nVersion, 1);
+            const uint32_t front = atomic_swap(&nMiddle, nFront) & SB_INDEX;
+            sData           = vBuffers[front];
+            atomic_store(&nFront, front);
+            atomic_store(&nSerial, vSerials[front]);
+            atomic_add(&nVersion, 1);
 
             return true;
         }
@@ -258,15 +396,17 @@ namespace lsp
 
         void string_t::touch()
         {
-            const uint32_t serial = (atomic_load(&nSerial) + 2) & (~uint32_t(1));
+            const uint32_t serial   = string_next_serial(this, false);
+            vSerials[nFront]        = serial;
             atomic_store(&nSerial, serial);
+            atomic_add(&nVersion, 2);
         }
 
         string_t *string_t::allocate(size_t max_length)
         {
             const size_t szof_type      = align_size(sizeof(string_t), DEFAULT_ALIGN);
             const size_t szof_data      = align_size(max_length * 4 + 1, DEFAULT_ALIGN); // Max 4 bytes per code point + end of line
-            const size_t to_alloc       = szof_type + 2 * szof_data;
+            const size_t to_alloc       = szof_type + 3 * szof_data;
 
             uint8_t *ptr                = reinterpret_cast<uint8_t *>(malloc(to_alloc));
             if (ptr == NULL)
@@ -274,15 +414,23 @@ namespace lsp
 
             // Initialize object
             string_t *res               = advance_ptr_bytes<string_t>(ptr, szof_type);
-            res->sData                  = advance_ptr_bytes<char>(ptr, szof_data);
-            res->sPending               = advance_ptr_bytes<char>(ptr, szof_data);
+            for (size_t i=0; i<3; ++i)
+            {
+                res->vBuffers[i]            = advance_ptr_bytes<char>(ptr, szof_data);
+                res->vSerials[i]            = 0;
+            }
+            res->sData                  = res->vBuffers[0];
+            res->nFront                 = 0;
+            res->nBack                  = 1;
+            res->nMiddle                = 2;
             res->nCapacity              = max_length;
             atomic_init(res->nLock);
             res->nSerial                = 0;
             res->nRequest               = 0;
+            res->nVersion               = 0;
 
             // Cleanup string content
-            bzero(res->sData, szof_data * 2);
+            bzero(res->vBuffers[0], szof_data * 3);
 
             return res;
         }
@@ -293,6 +441,16 @@ namespace lsp
                 free(str);
         }
 
+        //-------------------------------------------------------------------------
+        // data_view_t methods
+        void data_view_t::copy_to(float *dst) const
+        {
+            if (head_size > 0)
+                dsp::copy(dst, head, head_size);
+            if (tail_size > 0)
+                dsp::copy(&dst[head_size], tail, tail_size);
+        }
+
         //-------------------------------------------------------------------------
         // stream_t methods
         stream_t *stream_t::create(size_t channels, size_t frames, size_t capacity)
@@ -528,49 +686,64 @@ namespace lsp
             return &dst[head];
         }
 
-        ssize_t stream_t::read_frame(uint32_t frame_id, size_t channel, float *data, size_t off, size_t count)
+        ssize_t stream_t::view_frame(uint32_t frame_id, size_t channel, data_view_t *view, size_t off, size_t count) const
         {
             if (channel >= nChannels)
                 return -STATUS_INVALID_VALUE;
-            frame_t *frame = &vFrames[frame_id & (nFrameCap - 1)];
+            const frame_t *frame = &vFrames[frame_id & (nFrameCap - 1)];
             if (atomic_load(&frame->id) != frame_id)
                 return -STATUS_BAD_STATE;
 
-            // Estimate number of items to copy
+            // Estimate number of items to view
             if (off >= frame->size)
                 return -STATUS_EOF;
             count           = lsp_min(count, frame->size - off);
 
-            // Copy data from the frame
-            float *dst      = vChannels[channel];
+            // Compute the view of the frame
+            const float *s  = vChannels[channel];
             size_t head     = frame->head + off;
             if (head >= nBufCap)
                 head           -= nBufCap;
 
             size_t tail     = head + count;
+            view->head      = &s[head];
             if (tail > nBufCap)
             {
-                dsp::copy(data, &dst[head], nBufCap - head);
-                dsp::copy(&data[nBufCap - head], dst, tail - nBufCap);
+                view->head_size = nBufCap - head;
+                view->tail      = s;
+                view->tail_size = tail - nBufCap;
             }
             else
-                dsp::copy(data, &dst[head], count);
+            {
+                view->head_size = count;
+                view->tail      = NULL;
+                view->tail_size = 0;
+            }
 
             return count;
         }
 
-        ssize_t stream_t::read(size_t channel, float *data, size_t off, size_t count)
+        ssize_t stream_t::read_frame(uint32_t frame_id, size_t channel, float *data, size_t off, size_t count)
+        {
+            data_view_t v;
+            const ssize_t res   = view_frame(frame_id, channel, &v, off, count);
+            if (res > 0)
+                v.copy_to(data);
+            return res;
+        }
+
+        ssize_t stream_t::view(size_t channel, data_view_t *view, size_t off, size_t count) const
         {
             if (channel >= nChannels)
                 return -STATUS_INVALID_VALUE;
 
             // Check that we're reading proper frame
             const size_t frame_id       = atomic_load(&nFrameId);
-            frame_t *frm                = &vFrames[frame_id & (nFrameCap - 1)];
+            const frame_t *frm          = &vFrames[frame_id & (nFrameCap - 1)];
             if (atomic_load(&frm->id) != frame_id)
                 return -STATUS_BAD_STATE;
 
-            // Estimate the offset and number of items to read
+            // Estimate the offset and number of items to view
             if (off >= frm->length)
                 return -STATUS_EOF;
             count               = lsp_min(count, frm->length - off);
@@ -582,17 +755,32 @@ namespace lsp
 
             size_t tail         = head + count;
             const float *s      = vChannels[channel];
+            view->head          = &s[head];
             if (tail > nBufCap)
             {
-                dsp::copy(data, &s[head], nBufCap - head);
-                dsp::copy(&data[nBufCap - head], s, tail - nBufCap);
+                view->head_size     = nBufCap - head;
+                view->tail          = s;
+                view->tail_size     = tail - nBufCap;
             }
             else
-                dsp::copy(data, &s[head], count);
+            {
+                view->head_size     = count;
+                view->tail          = NULL;
+                view->tail_size     = 0;
+            }
 
             return count;
         }
 
+        ssize_t stream_t::read(size_t channel, float *data, size_t off, size_t count)
+        {
+            data_view_t v;
+            const ssize_t res   = view(channel, &v, off, count);
+            if (res > 0)
+                v.copy_to(data);
+            return res;
+        }
+
         bool stream_t::commit_frame()
         {
             const size_t prev_id    = atomic_load(&nFrameId);
@@ -756,6 +944,20 @@ namespace lsp
             return &vData[off * nCols];
         }
 
+        size_t frame_buffer_t::view_rows(data_view_t *view, uint32_t row_id, size_t count) const
+        {
+            count           = lsp_min(count, size_t(nCapacity));
+            const size_t off    = row_id & (nCapacity - 1);
+            const size_t head   = lsp_min(count, nCapacity - off);
+
+            view->head      = &vData[off * nCols];
+            view->head_size = head * nCols;
+            view->tail      = (head < count) ? vData : NULL;
+            view->tail_size = (count - head) * nCols;
+
+            return count;
+        }
+
         void frame_buffer_t::write_row(const float *row)
         {
             uint32_t off    = atomic_load(&nRowID) & (nCapacity - 1);
@@ -769,6 +971,20 @@ namespace lsp
             dsp::copy(&vData[off * nCols], row, nCols);
         }
 
+        void frame_buffer_t::write_rows(uint32_t row_id, const float *rows, size_t count)
+        {
+            while (count > 0)
+            {
+                const size_t off    = row_id & (nCapacity - 1);
+                const size_t n      = lsp_min(count, size_t(nCapacity - off));
+                dsp::copy(&vData[off * nCols], rows, n * nCols);
+
+                rows               += n * nCols;
+                row_id             += n;
+                count              -= n;
+            }
+        }
+
         void frame_buffer_t::write_row()
         {
             atomic_add(&nRowID, 1); // Just increment row identifier
@@ -788,13 +1004,16 @@ namespace lsp
             else if (delta > nRows)
                 dst_rid = src_rid - nRows;
 
-            // Synchronize buffer data
+            // Synchronize buffer data, copy contiguous ranges of rows at once
             while (dst_rid != src_rid)
             {
-                const float *row = fb->get_row(dst_rid);
-                size_t off      = (dst_rid) & (nCapacity - 1);
-                dsp::copy(&vData[off * nCols], row, nCols);
-                dst_rid++;
+                const size_t src_off    = dst_rid & (fb->nCapacity - 1);
+                const size_t dst_off    = dst_rid & (nCapacity - 1);
+                size_t count            = lsp_min(size_t(src_rid - dst_rid), size_t(fb->nCapacity - src_off));
+                count                   = lsp_min(count, size_t(nCapacity - dst_off));
+
+                dsp::copy(&vData[dst_off * nCols], &fb->vData[src_off * nCols], count * nCols);
+                dst_rid                += count;
             }
 
             atomic_store(&nRowID, dst_rid);
@@ -902,9 +1121,17 @@ namespace lsp
                     (e1->timestamp > e2->timestamp) ? 1 : 0;
         }
 
+        bool midi_t::is_sorted() const
+        {
+            for (size_t i=1; i<nEvents; ++i)
+                if (vEvents[i].timestamp < vEvents[i-1].timestamp)
+                    return false;
+            return true;
+        }
+
         void midi_t::sort()
         {
-            if (nEvents > 1)
+            if ((nEvents > 1) && (!is_sorted()))
                 ::qsort(vEvents, nEvents, sizeof(midi::event_t), compare_midi_events);
         }
 
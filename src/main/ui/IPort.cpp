@@ -149,6 +149,10 @@ namespace lsp
             return nEditCounter > 0;
         };
 
+        void IPort::set_display_width(size_t width)
+        {
+        }
+
     } /* namespace ui */
 } /* namespace lsp */
 
@@ -317,6 +317,13 @@ namespace lsp
             return true;
         }
 
+        void SwitchedPort::set_display_width(size_t width)
+        {
+            ui::IPort *p  = current();
+            if (p != NULL)
+                p->set_display_width(width);
+        }
+
     } /* namespace ctl */
 } /* namespace lsp */
 
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/plug-fw/meta/func.h>
+#include <lsp-plug.in/plug-fw/plug.h>
+#include <lsp-plug.in/plug-fw/util/offline/offline.h>
+
+#include <private/test/plugins.h>
+
+namespace lsp
+{
+    namespace test
+    {
+        const meta::plugin_t *find_audio_plugin()
+        {
+            for (plug::Factory *f = plug::Factory::root(); f != NULL; f = f->next())
+            {
+                for (size_t i=0; ; ++i)
+                {
+                    const meta::plugin_t *meta = f->enumerate(i);
+                    if (meta == NULL)
+                        break;
+                    if (!offline::supported(meta))
+                        continue;
+
+                    bool has_in = false, has_out = false;
+                    for (const meta::port_t *p = meta->ports; (p != NULL) && (p->id != NULL); ++p)
+                    {
+                        has_in     |= meta::is_audio_in_port(p);
+                        has_out    |= meta::is_audio_out_port(p);
+                    }
+                    if ((has_in) && (has_out))
+                        return meta;
+                }
+            }
+
+            return NULL;
+        }
+    } /* namespace test */
+} /* namespace lsp */
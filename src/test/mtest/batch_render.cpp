@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/mtest.h>
+#include <lsp-plug.in/dsp-units/sampling/Sample.h>
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/lltl/parray.h>
+#include <lsp-plug.in/plug-fw/const.h>
+#include <lsp-plug.in/plug-fw/util/batch_render/batch_render.h>
+#include <lsp-plug.in/runtime/system.h>
+#include <lsp-plug.in/stdlib/math.h>
+
+#include <private/test/plugins.h>
+
+MTEST_BEGIN("", batch_render)
+
+    void make_input_file(const io::Path *path)
+    {
+        // Two seconds of stereo sine sweep, long enough to pass several processing blocks
+        constexpr size_t sample_rate    = 48000;
+        constexpr size_t length         = sample_rate * 2;
+
+        dspu::Sample s;
+        MTEST_ASSERT(s.init(2, length, length));
+        s.set_sample_rate(sample_rate);
+
+        for (size_t i=0; i<s.channels(); ++i)
+        {
+            float *dst = s.channel(i);
+            for (size_t j=0; j<length; ++j)
+            {
+                const float t   = float(j) / float(sample_rate);
+                dst[j]          = 0.5f * sinf(2.0f * M_PI * (100.0f + 1000.0f * t * (i + 1)) * t);
+            }
+        }
+
+        MTEST_ASSERT(s.save(path) > 0);
+    }
+
+    MTEST_MAIN
+    {
+        // Pass the path to resource directory
+        io::Path resdir;
+        resdir.set(tempdir(), "resources");
+        system::set_env_var(LSP_RESOURCE_PATH_VAR, resdir.as_string());
+
+        // Pass arguments to the tool if they are specified
+        if (argc > 0)
+        {
+            lltl::parray<char> args;
+            MTEST_ASSERT(args.add(const_cast<char *>(full_name())));
+            for (int i=0; i<argc; ++i)
+                MTEST_ASSERT(args.add(const_cast<char *>(argv[i])));
+
+            MTEST_ASSERT(lsp::batch_render::main(args.size(), const_cast<const char **>(args.array())) == STATUS_OK);
+            return;
+        }
+
+        // Render the generated file with the first plugin that processes audio
+        const meta::plugin_t *meta = test::find_audio_plugin();
+        if (meta == NULL)
+        {
+            printf("No audio plugins available, skipping the rendering\n");
+            return;
+        }
+
+        io::Path outdir, infile, outfile;
+        MTEST_ASSERT(outdir.fmt("%s/mtest-%s", tempdir(), full_name()) > 0);
+        MTEST_ASSERT(outdir.mkdir(true) == STATUS_OK);
+        MTEST_ASSERT(infile.fmt("%s/input.wav", tempdir()) > 0);
+        MTEST_ASSERT(outfile.set(&outdir, "input.wav") == STATUS_OK);
+        make_input_file(&infile);
+        outfile.remove();
+
+        const char *args[] =
+        {
+            full_name(),
+            "-p", meta->uid,
+            "-o", outdir.as_native(),
+            "-b", "256",
+            "-j", "1",
+            "-t", "0.5",
+            infile.as_native()
+        };
+        MTEST_ASSERT(lsp::batch_render::main(sizeof(args)/sizeof(const char *), args) == STATUS_OK);
+
+        // Check the result: the output should contain the input and the tail
+        dspu::Sample out;
+        MTEST_ASSERT(out.load(&outfile) == STATUS_OK);
+        MTEST_ASSERT(out.sample_rate() == 48000);
+        MTEST_ASSERT(out.length() >= 48000 * 2);
+    }
+
+MTEST_END
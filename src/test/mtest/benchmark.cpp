@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/mtest.h>
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/lltl/parray.h>
+#include <lsp-plug.in/plug-fw/const.h>
+#include <lsp-plug.in/plug-fw/util/benchmark/benchmark.h>
+#include <lsp-plug.in/runtime/system.h>
+
+#include <private/test/plugins.h>
+
+MTEST_BEGIN("", benchmark)
+
+    MTEST_MAIN
+    {
+        // Pass the path to resource directory
+        io::Path resdir;
+        resdir.set(tempdir(), "resources");
+        system::set_env_var(LSP_RESOURCE_PATH_VAR, resdir.as_string());
+
+        // Pass arguments to the tool if they are specified
+        if (argc > 0)
+        {
+            lltl::parray<char> args;
+            MTEST_ASSERT(args.add(const_cast<char *>(full_name())));
+            for (int i=0; i<argc; ++i)
+                MTEST_ASSERT(args.add(const_cast<char *>(argv[i])));
+
+            MTEST_ASSERT(lsp::benchmark::main(args.size(), const_cast<const char **>(args.array())) == STATUS_OK);
+            return;
+        }
+
+        // Run a short measurement of the first plugin that processes audio
+        const meta::plugin_t *meta = test::find_audio_plugin();
+        if (meta == NULL)
+        {
+            printf("No audio plugins available, skipping the measurement\n");
+            return;
+        }
+
+        io::Path outfile;
+        MTEST_ASSERT(outfile.fmt("%s/mtest-%s.csv", tempdir(), full_name()) > 0);
+        outfile.remove();
+
+        const char *args[] =
+        {
+            full_name(),
+            "-b", "64,1024",
+            "-r", "48000",
+            "-d", "0.5",
+            "-o", outfile.as_native(),
+            meta->uid
+        };
+        MTEST_ASSERT(lsp::benchmark::main(sizeof(args)/sizeof(const char *), args) == STATUS_OK);
+
+        // The report should contain the header and one line per block size
+        FILE *fd = fopen(outfile.as_native(), "r");
+        MTEST_ASSERT(fd != NULL);
+        size_t lines = 0;
+        for (int c; (c = fgetc(fd)) != EOF; )
+            lines  += (c == '\n') ? 1 : 0;
+        fclose(fd);
+        MTEST_ASSERT(lines >= 3);
+    }
+
+MTEST_END
@@ -0,0 +1,545 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/endian.h>
+#include <lsp-plug.in/plug-fw/core/delta.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+UTEST_BEGIN("core", delta)
+
+    static constexpr size_t BUFFERS         = 3;
+    static constexpr size_t ITEMS           = 97;
+    static constexpr size_t HEADER_SIZE     = sizeof(uint32_t) * 4;
+
+    typedef struct mesh_t
+    {
+        float       v[BUFFERS][ITEMS];
+        float      *ptr[BUFFERS];
+        size_t      buffers;
+        size_t      items;
+
+        void init()
+        {
+            for (size_t i=0; i<BUFFERS; ++i)
+            {
+                ptr[i]      = v[i];
+                for (size_t j=0; j<ITEMS; ++j)
+                    v[i][j]     = 0.0f;
+            }
+            buffers     = 0;
+            items       = 0;
+        }
+    } mesh_t;
+
+    uint32_t    nSeed;
+
+    float next_random()
+    {
+        nSeed       = nSeed * 1103515245 + 12345;
+        return float((nSeed >> 8) & 0xffff) / 65536.0f;
+    }
+
+    static uint32_t bits(float value)
+    {
+        uint32_t res;
+        memcpy(&res, &value, sizeof(res));
+        return res;
+    }
+
+    static float from_bits(uint32_t value)
+    {
+        float res;
+        memcpy(&res, &value, sizeof(res));
+        return res;
+    }
+
+    static uint32_t get_field(const void *data, size_t index)
+    {
+        uint32_t value;
+        memcpy(&value, static_cast<const uint8_t *>(data) + index * sizeof(uint32_t), sizeof(value));
+        return LE_TO_CPU(value);
+    }
+
+    static void set_field(void *data, size_t index, uint32_t value)
+    {
+        value       = CPU_TO_LE(value);
+        memcpy(static_cast<uint8_t *>(data) + index * sizeof(uint32_t), &value, sizeof(value));
+    }
+
+    static bool is_key(const void *data)
+    {
+        return get_field(data, 0) & core::DELTA_KEY;
+    }
+
+    static uint16_t to_half(float value)
+    {
+        uint16_t h;
+        core::encode_half(&h, &value, 1);
+        return LE_TO_CPU(h);
+    }
+
+    static float to_float(uint16_t value)
+    {
+        float f;
+        value       = CPU_TO_LE(value);
+        core::decode_half(&f, &value, 1);
+        return f;
+    }
+
+    static float quantize(float value, bool half)
+    {
+        return (half) ? to_float(to_half(value)) : value;
+    }
+
+    void randomize(mesh_t *m, size_t buffers, size_t items)
+    {
+        for (size_t i=0; i<buffers; ++i)
+            for (size_t j=0; j<items; ++j)
+                m->v[i][j]      = next_random() * 2.0f - 1.0f;
+        m->buffers      = buffers;
+        m->items        = items;
+    }
+
+    void check_mesh(const mesh_t *dst, const mesh_t *src, bool half)
+    {
+        UTEST_ASSERT(dst->buffers == src->buffers);
+        UTEST_ASSERT(dst->items == src->items);
+        for (size_t i=0; i<src->buffers; ++i)
+            for (size_t j=0; j<src->items; ++j)
+            {
+                const float expected = quantize(src->v[i][j], half);
+                UTEST_ASSERT_MSG(bits(dst->v[i][j]) == bits(expected),
+                    "buffer=%d, item=%d: got %g, expected %g",
+                    int(i), int(j), dst->v[i][j], expected);
+            }
+    }
+
+    bool decode(core::DeltaDecoder *dec, mesh_t *dst, const void *data, size_t size)
+    {
+        return dec->decode(dst->ptr, &dst->buffers, &dst->items, BUFFERS, ITEMS, data, size);
+    }
+
+    void test_half_conversion()
+    {
+        printf("Testing float <-> half conversion\n");
+
+        // Exactly representable values
+        UTEST_ASSERT(to_half(0.0f) == 0x0000);
+        UTEST_ASSERT(to_half(-0.0f) == 0x8000);
+        UTEST_ASSERT(to_half(1.0f) == 0x3c00);
+        UTEST_ASSERT(to_half(-2.0f) == 0xc000);
+        UTEST_ASSERT(to_half(65504.0f) == 0x7bff);
+        UTEST_ASSERT(to_half(ldexpf(1.0f, -14)) == 0x0400);     // Minimum normal
+        UTEST_ASSERT(to_half(ldexpf(1.0f, -24)) == 0x0001);     // Minimum subnormal
+        UTEST_ASSERT(to_half(ldexpf(1023.0f, -24)) == 0x03ff);  // Maximum subnormal
+        UTEST_ASSERT(to_half(-ldexpf(1.0f, -24)) == 0x8001);
+
+        // Rounding to nearest even
+        UTEST_ASSERT(to_half(1.0f + ldexpf(1.0f, -11)) == 0x3c00);
+        UTEST_ASSERT(to_half(1.0f + ldexpf(3.0f, -11)) == 0x3c02);
+        UTEST_ASSERT(to_half(1.0f + ldexpf(1.0f, -11) + ldexpf(1.0f, -20)) == 0x3c01);
+        UTEST_ASSERT(to_half(1.0f + ldexpf(1.0f, -11) - ldexpf(1.0f, -20)) == 0x3c00);
+        UTEST_ASSERT(to_half(ldexpf(1.0f, -25)) == 0x0000);     // Half of minimum subnormal, tie to even
+        UTEST_ASSERT(to_half(ldexpf(3.0f, -25)) == 0x0002);     // 1.5 of minimum subnormal, tie to even
+        UTEST_ASSERT(to_half(ldexpf(1.0f, -26)) == 0x0000);
+        UTEST_ASSERT(to_half(-ldexpf(1.0f, -30)) == 0x8000);
+        UTEST_ASSERT(to_half(ldexpf(1.0f, -14) - ldexpf(1.0f, -26)) == 0x0400); // Subnormal rounded up to normal
+        UTEST_ASSERT(to_half(65520.0f) == 0x7c00);               // Rounded up to infinity
+        UTEST_ASSERT(to_half(65519.0f) == 0x7bff);
+
+        // Overflow, infinities and NaN
+        UTEST_ASSERT(to_half(1e+10f) == 0x7c00);
+        UTEST_ASSERT(to_half(-1e+10f) == 0xfc00);
+        UTEST_ASSERT(to_half(INFINITY) == 0x7c00);
+        UTEST_ASSERT(to_half(-INFINITY) == 0xfc00);
+        UTEST_ASSERT((to_half(NAN) & 0x7c00) == 0x7c00);
+        UTEST_ASSERT((to_half(NAN) & 0x03ff) != 0);
+
+        UTEST_ASSERT(isinf(to_float(0x7c00)) && (to_float(0x7c00) > 0.0f));
+        UTEST_ASSERT(isinf(to_float(0xfc00)) && (to_float(0xfc00) < 0.0f));
+        UTEST_ASSERT(isnan(to_float(0x7e00)));
+        UTEST_ASSERT(isnan(to_float(0xfc01)));
+
+        // Subnormal values are decoded
+        UTEST_ASSERT(to_float(0x0001) == ldexpf(1.0f, -24));
+        UTEST_ASSERT(to_float(0x8001) == -ldexpf(1.0f, -24));
+        UTEST_ASSERT(to_float(0x03ff) == ldexpf(1023.0f, -24));
+        UTEST_ASSERT(to_float(0x0200) == ldexpf(1.0f, -15));
+        UTEST_ASSERT(bits(to_float(0x8000)) == bits(-0.0f));
+
+        // All non-NaN values survive the round trip
+        for (size_t i=0; i<0x10000; ++i)
+        {
+            const uint16_t h    = uint16_t(i);
+            const float f       = to_float(h);
+            if (((h & 0x7c00) == 0x7c00) && (h & 0x03ff))
+            {
+                UTEST_ASSERT_MSG(isnan(f), "value=0x%04x", int(h));
+                UTEST_ASSERT_MSG((to_half(f) & 0x7fff) > 0x7c00, "value=0x%04x", int(h));
+                continue;
+            }
+            UTEST_ASSERT_MSG(to_half(f) == h, "value=0x%04x, got=0x%04x", int(h), int(to_half(f)));
+        }
+
+        // Float values round to the nearest half value
+        for (size_t i=0; i<0x7bff; ++i)
+        {
+            const float lo      = to_float(uint16_t(i));
+            const float hi      = to_float(uint16_t(i + 1));
+            const float mid     = (lo + hi) * 0.5f;
+            const uint16_t even = (i & 1) ? uint16_t(i + 1) : uint16_t(i);
+
+            UTEST_ASSERT_MSG(to_half(from_bits(bits(mid) - 1)) == i, "value=0x%04x", int(i));
+            UTEST_ASSERT_MSG(to_half(mid) == even, "value=0x%04x", int(i));
+            UTEST_ASSERT_MSG(to_half(from_bits(bits(mid) + 1)) == i + 1, "value=0x%04x", int(i));
+        }
+    }
+
+    void test_round_trip(bool half)
+    {
+        printf("Testing encode/decode round trip half=%s\n", (half) ? "true" : "false");
+
+        core::DeltaEncoder enc;
+        core::DeltaDecoder dec;
+        mesh_t src, dst;
+        src.init();
+        dst.init();
+        UTEST_ASSERT(enc.init(BUFFERS, ITEMS, half) == STATUS_OK);
+
+        // The first packet is the key packet
+        randomize(&src, BUFFERS, ITEMS);
+        const size_t key_size = enc.encode(src.ptr, BUFFERS, ITEMS);
+        UTEST_ASSERT(key_size > 0);
+        UTEST_ASSERT(is_key(enc.data()));
+        UTEST_ASSERT(decode(&dec, &dst, enc.data(), key_size));
+        check_mesh(&dst, &src, half);
+
+        // Unchanged data produces empty delta packet
+        size_t size = enc.encode(src.ptr, BUFFERS, ITEMS);
+        UTEST_ASSERT(size == HEADER_SIZE + BUFFERS * sizeof(uint32_t));
+        UTEST_ASSERT(!is_key(enc.data()));
+        UTEST_ASSERT(decode(&dec, &dst, enc.data(), size));
+        check_mesh(&dst, &src, half);
+
+        // Sparse changes produce delta packets
+        for (size_t frame=0; frame<32; ++frame)
+        {
+            const size_t changes = 1 + frame % 7;
+            for (size_t k=0; k<changes; ++k)
+            {
+                const size_t i  = size_t(next_random() * BUFFERS);
+                const size_t j  = size_t(next_random() * ITEMS);
+                src.v[i][j]     = next_random() * 10.0f - 5.0f;
+            }
+
+            size = enc.encode(src.ptr, BUFFERS, ITEMS);
+            UTEST_ASSERT(size > 0);
+            UTEST_ASSERT(size < key_size);
+            UTEST_ASSERT(!is_key(enc.data()));
+            UTEST_ASSERT(decode(&dec, &dst, enc.data(), size));
+            check_mesh(&dst, &src, half);
+        }
+
+        // Change of the mesh size forces key packet
+        randomize(&src, BUFFERS - 1, ITEMS / 2);
+        size = enc.encode(src.ptr, BUFFERS - 1, ITEMS / 2);
+        UTEST_ASSERT(size > 0);
+        UTEST_ASSERT(is_key(enc.data()));
+        UTEST_ASSERT(decode(&dec, &dst, enc.data(), size));
+        check_mesh(&dst, &src, half);
+
+        // Mesh larger than the encoder limits is rejected
+        UTEST_ASSERT(enc.encode(src.ptr, BUFFERS + 1, ITEMS) == 0);
+        UTEST_ASSERT(enc.encode(src.ptr, BUFFERS, ITEMS + 1) == 0);
+    }
+
+    void test_key_interval()
+    {
+        printf("Testing periodic key packets\n");
+
+        core::DeltaEncoder enc;
+        mesh_t src;
+        src.init();
+        randomize(&src, BUFFERS, ITEMS);
+        UTEST_ASSERT(enc.init(BUFFERS, ITEMS, false) == STATUS_OK);
+
+        const size_t period = core::DeltaEncoder::KEY_INTERVAL + 1;
+        for (size_t i=0; i<=period * 3; ++i)
+        {
+            UTEST_ASSERT(enc.encode(src.ptr, BUFFERS, ITEMS) > 0);
+            UTEST_ASSERT_MSG(is_key(enc.data()) == ((i % period) == 0), "packet=%d", int(i));
+        }
+
+        // Reset forces key packet
+        UTEST_ASSERT(enc.encode(src.ptr, BUFFERS, ITEMS) > 0);
+        UTEST_ASSERT(!is_key(enc.data()));
+        enc.reset();
+        UTEST_ASSERT(enc.encode(src.ptr, BUFFERS, ITEMS) > 0);
+        UTEST_ASSERT(is_key(enc.data()));
+        UTEST_ASSERT(enc.encode(src.ptr, BUFFERS, ITEMS) > 0);
+        UTEST_ASSERT(!is_key(enc.data()));
+    }
+
+    void test_resync()
+    {
+        printf("Testing resynchronization after lost packets\n");
+
+        core::DeltaEncoder enc;
+        core::DeltaDecoder dec;
+        mesh_t src, dst;
+        src.init();
+        dst.init();
+        UTEST_ASSERT(enc.init(BUFFERS, ITEMS, false) == STATUS_OK);
+
+        // Encode the sequence of packets: key and four delta packets
+        uint8_t packets[5][4096];
+        size_t sizes[5];
+        randomize(&src, BUFFERS, ITEMS);
+        for (size_t i=0; i<5; ++i)
+        {
+            src.v[i % BUFFERS][i * 7]  += 1.0f;
+            sizes[i]    = enc.encode(src.ptr, BUFFERS, ITEMS);
+            UTEST_ASSERT((sizes[i] > 0) && (sizes[i] <= sizeof(packets[i])));
+            UTEST_ASSERT(is_key(enc.data()) == (i == 0));
+            memcpy(packets[i], enc.data(), sizes[i]);
+        }
+
+        // Delta packet without key packet is ignored
+        UTEST_ASSERT(!decode(&dec, &dst, packets[1], sizes[1]));
+
+        // Dropped packet invalidates the state until the next key packet
+        UTEST_ASSERT(decode(&dec, &dst, packets[0], sizes[0]));
+        UTEST_ASSERT(decode(&dec, &dst, packets[1], sizes[1]));
+        UTEST_ASSERT(!decode(&dec, &dst, packets[3], sizes[3]));
+        UTEST_ASSERT(!decode(&dec, &dst, packets[4], sizes[4]));
+        UTEST_ASSERT(!decode(&dec, &dst, packets[2], sizes[2]));
+
+        // Out-of-order and duplicate packets invalidate the state too
+        UTEST_ASSERT(decode(&dec, &dst, packets[0], sizes[0]));
+        UTEST_ASSERT(!decode(&dec, &dst, packets[2], sizes[2]));
+        UTEST_ASSERT(!decode(&dec, &dst, packets[1], sizes[1]));
+        UTEST_ASSERT(decode(&dec, &dst, packets[0], sizes[0]));
+        UTEST_ASSERT(decode(&dec, &dst, packets[1], sizes[1]));
+        UTEST_ASSERT(!decode(&dec, &dst, packets[1], sizes[1]));
+
+        // Explicit reset of the decoder
+        UTEST_ASSERT(decode(&dec, &dst, packets[0], sizes[0]));
+        dec.reset();
+        UTEST_ASSERT(!decode(&dec, &dst, packets[1], sizes[1]));
+
+        // The key packet requested from the encoder recovers the state
+        enc.reset();
+        src.v[0][0]    += 1.0f;
+        const size_t size = enc.encode(src.ptr, BUFFERS, ITEMS);
+        UTEST_ASSERT(is_key(enc.data()));
+        UTEST_ASSERT(decode(&dec, &dst, enc.data(), size));
+        check_mesh(&dst, &src, false);
+
+        src.v[1][1]    += 1.0f;
+        const size_t delta = enc.encode(src.ptr, BUFFERS, ITEMS);
+        UTEST_ASSERT(!is_key(enc.data()));
+        UTEST_ASSERT(decode(&dec, &dst, enc.data(), delta));
+        check_mesh(&dst, &src, false);
+    }
+
+    void test_fallback(bool half)
+    {
+        printf("Testing fallback to key packet half=%s\n", (half) ? "true" : "false");
+
+        core::DeltaEncoder enc;
+        core::DeltaDecoder dec;
+        mesh_t src, dst;
+        src.init();
+        dst.init();
+        UTEST_ASSERT(enc.init(BUFFERS, ITEMS, half) == STATUS_OK);
+
+        randomize(&src, BUFFERS, ITEMS);
+        const size_t key_size = enc.encode(src.ptr, BUFFERS, ITEMS);
+        UTEST_ASSERT(is_key(enc.data()));
+        UTEST_ASSERT(decode(&dec, &dst, enc.data(), key_size));
+
+        // Change of one buffer is still transmitted as delta
+        for (size_t j=0; j<ITEMS; ++j)
+            src.v[1][j]    += 1.0f;
+        size_t size = enc.encode(src.ptr, BUFFERS, ITEMS);
+        UTEST_ASSERT(!is_key(enc.data()));
+        UTEST_ASSERT(size < key_size);
+        UTEST_ASSERT(decode(&dec, &dst, enc.data(), size));
+        check_mesh(&dst, &src, half);
+
+        // Delta of all items would not be smaller than the key packet
+        for (size_t i=0; i<BUFFERS; ++i)
+            for (size_t j=0; j<ITEMS; ++j)
+                src.v[i][j]    += 1.0f;
+        size = enc.encode(src.ptr, BUFFERS, ITEMS);
+        UTEST_ASSERT(is_key(enc.data()));
+        UTEST_ASSERT(size == key_size);
+        UTEST_ASSERT(decode(&dec, &dst, enc.data(), size));
+        check_mesh(&dst, &src, half);
+
+        // Interleaved changes would not be smaller than the key packet
+        for (size_t i=0; i<BUFFERS; ++i)
+            for (size_t j=0; j<ITEMS; j += 2)
+                src.v[i][j]    += 1.0f;
+        size = enc.encode(src.ptr, BUFFERS, ITEMS);
+        UTEST_ASSERT(size <= key_size);
+        UTEST_ASSERT(decode(&dec, &dst, enc.data(), size));
+        check_mesh(&dst, &src, half);
+
+        // Packet after the fallback is delta again
+        src.v[0][0]    += 1.0f;
+        size = enc.encode(src.ptr, BUFFERS, ITEMS);
+        UTEST_ASSERT(!is_key(enc.data()));
+        UTEST_ASSERT(decode(&dec, &dst, enc.data(), size));
+        check_mesh(&dst, &src, half);
+    }
+
+    void test_saturation()
+    {
+        printf("Testing replacement of non-finite values\n");
+
+        core::DeltaEncoder enc;
+        core::DeltaDecoder dec;
+        mesh_t src, dst;
+        src.init();
+        dst.init();
+
+        for (size_t k=0; k<2; ++k)
+        {
+            const bool half = k > 0;
+            UTEST_ASSERT(enc.init(BUFFERS, ITEMS, half) == STATUS_OK);
+            randomize(&src, BUFFERS, ITEMS);
+            src.v[0][0]     = NAN;
+            src.v[1][1]     = INFINITY;
+            src.v[2][2]     = -INFINITY;
+            src.v[0][3]     = 1e+10f;
+
+            const size_t size = enc.encode(src.ptr, BUFFERS, ITEMS);
+            UTEST_ASSERT(decode(&dec, &dst, enc.data(), size));
+            for (size_t i=0; i<BUFFERS; ++i)
+                for (size_t j=0; j<ITEMS; ++j)
+                    UTEST_ASSERT_MSG(isfinite(dst.v[i][j]), "buffer=%d, item=%d, half=%d", int(i), int(j), int(half));
+        }
+    }
+
+    void test_corrupted()
+    {
+        printf("Testing rejection of corrupted packets\n");
+
+        core::DeltaEncoder enc;
+        core::DeltaDecoder dec;
+        mesh_t src, dst;
+        src.init();
+        dst.init();
+        UTEST_ASSERT(enc.init(BUFFERS, ITEMS, true) == STATUS_OK);
+
+        randomize(&src, BUFFERS, ITEMS);
+        uint8_t key[4096], delta[4096], buf[4096];
+        const size_t key_size = enc.encode(src.ptr, BUFFERS, ITEMS);
+        UTEST_ASSERT((key_size > 0) && (key_size <= sizeof(key)));
+        memcpy(key, enc.data(), key_size);
+
+        src.v[2][ITEMS - 1]    += 1.0f;
+        const size_t delta_size = enc.encode(src.ptr, BUFFERS, ITEMS);
+        UTEST_ASSERT((delta_size > 0) && (delta_size <= sizeof(delta)));
+        UTEST_ASSERT(!is_key(enc.data()));
+        memcpy(delta, enc.data(), delta_size);
+
+        // Truncated packets
+        for (size_t i=0; i<key_size; ++i)
+        {
+            UTEST_ASSERT_MSG(!decode(&dec, &dst, key, i), "size=%d", int(i));
+            UTEST_ASSERT(decode(&dec, &dst, key, key_size));
+        }
+        for (size_t i=0; i<delta_size; ++i)
+        {
+            UTEST_ASSERT(decode(&dec, &dst, key, key_size));
+            UTEST_ASSERT_MSG(!decode(&dec, &dst, delta, i), "size=%d", int(i));
+        }
+
+        // The decoder stays invalid after the corrupted packet
+        UTEST_ASSERT(!decode(&dec, &dst, delta, delta_size));
+        UTEST_ASSERT(decode(&dec, &dst, key, key_size));
+        UTEST_ASSERT(decode(&dec, &dst, delta, delta_size));
+        check_mesh(&dst, &src, true);
+
+        // Mesh size exceeds the destination
+        memcpy(buf, key, key_size);
+        set_field(buf, 2, BUFFERS + 1);
+        UTEST_ASSERT(!decode(&dec, &dst, buf, key_size));
+        memcpy(buf, key, key_size);
+        set_field(buf, 3, ITEMS + 1);
+        UTEST_ASSERT(!decode(&dec, &dst, buf, key_size));
+
+        // Corrupted ranges of the first buffer: number of ranges, offset and number of items
+        const uint32_t corrupted[][3] =
+        {
+            { 0xffffffff,   0,              ITEMS           },
+            { 2,            0,              ITEMS           },
+            { 1,            ITEMS + 1,      0               },
+            { 1,            1,              ITEMS           },
+            { 1,            0,              ITEMS + 1       },
+            { 1,            ITEMS,          0xffffffff      },
+            { 1,            0xffffffff,     2               },
+        };
+        for (size_t i=0; i<sizeof(corrupted)/sizeof(corrupted[0]); ++i)
+        {
+            memcpy(buf, key, key_size);
+            set_field(buf, 4, corrupted[i][0]);
+            set_field(buf, 5, corrupted[i][1]);
+            set_field(buf, 6, corrupted[i][2]);
+            UTEST_ASSERT_MSG(!decode(&dec, &dst, buf, key_size), "case=%d", int(i));
+        }
+
+        // Delta packet with different mesh size
+        UTEST_ASSERT(decode(&dec, &dst, key, key_size));
+        memcpy(buf, delta, delta_size);
+        set_field(buf, 3, ITEMS - 1);
+        UTEST_ASSERT(!decode(&dec, &dst, buf, delta_size));
+
+        // Delta packet with range out of the mesh
+        UTEST_ASSERT(decode(&dec, &dst, key, key_size));
+        memcpy(buf, delta, delta_size);
+        UTEST_ASSERT(get_field(buf, 4) == 0);
+        UTEST_ASSERT(get_field(buf, 5) == 0);
+        UTEST_ASSERT(get_field(buf, 6) == 1);
+        set_field(buf, 8, ITEMS);
+        UTEST_ASSERT(!decode(&dec, &dst, buf, delta_size));
+    }
+
+    UTEST_MAIN
+    {
+        nSeed       = 0x12345678;
+
+        test_half_conversion();
+        test_round_trip(false);
+        test_round_trip(true);
+        test_key_interval();
+        test_resync();
+        test_fallback(false);
+        test_fallback(true);
+        test_saturation();
+        test_corrupted();
+    }
+
+UTEST_END
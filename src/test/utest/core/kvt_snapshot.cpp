@@ -0,0 +1,347 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/finally.h>
+#include <lsp-plug.in/plug-fw/core/KVTSnapshot.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+namespace
+{
+    using namespace lsp;
+
+    static const uint8_t blob_data[] = { 0x00, 0x01, 0x02, 0xff, 0xfe, 0x80, 0x7f, 0x10, 0x20, 0x30, 0x40 };
+
+    // Offsets of fields in the snapshot
+    static constexpr size_t HDR_VERSION     = 4;
+    static constexpr size_t HDR_SIZE        = 12;
+    static constexpr size_t HEADER_SIZE     = 16;
+    static constexpr size_t REC_SIZE        = 0;
+    static constexpr size_t REC_NAME_LEN    = 8;
+    static constexpr size_t REC_TEXT_LEN    = 12;
+    static constexpr size_t REC_VALUE       = 16;
+
+    static void put_u32(uint8_t *dst, uint32_t value)
+    {
+        for (size_t i=0; i<sizeof(value); ++i, value >>= 8)
+            dst[i]      = uint8_t(value);
+    }
+
+    static uint32_t get_u32(const uint8_t *src)
+    {
+        return uint32_t(src[0]) | (uint32_t(src[1]) << 8) | (uint32_t(src[2]) << 16) | (uint32_t(src[3]) << 24);
+    }
+}
+
+UTEST_BEGIN("core", kvt_snapshot)
+
+    uint32_t    nSeed;
+
+    uint32_t next_random(uint32_t range)
+    {
+        nSeed       = nSeed * 1103515245 + 12345;
+        return ((nSeed >> 8) & 0xffffff) % range;
+    }
+
+    void fill_storage(core::KVTStorage *kvt)
+    {
+        float fnan      = NAN;
+        core::kvt_blob_t blob;
+
+        UTEST_ASSERT(kvt->put("/int32/min", int32_t(-0x7fffffff - 1)) == STATUS_OK);
+        UTEST_ASSERT(kvt->put("/int32/max", int32_t(0x7fffffff)) == STATUS_OK);
+        UTEST_ASSERT(kvt->put("/uint32", uint32_t(0xdeadbeef)) == STATUS_OK);
+        UTEST_ASSERT(kvt->put("/int64", int64_t(-0x123456789abcdefll)) == STATUS_OK);
+        UTEST_ASSERT(kvt->put("/uint64", uint64_t(0xfedcba9876543210ull)) == STATUS_OK);
+        UTEST_ASSERT(kvt->put("/float32/value", 3.14159f) == STATUS_OK);
+        UTEST_ASSERT(kvt->put("/float32/nan", fnan) == STATUS_OK);
+        UTEST_ASSERT(kvt->put("/float32/neg_zero", -0.0f) == STATUS_OK);
+        UTEST_ASSERT(kvt->put("/float64/value", -2.718281828459045) == STATUS_OK);
+        UTEST_ASSERT(kvt->put("/float64/inf", double(INFINITY)) == STATUS_OK);
+        UTEST_ASSERT(kvt->put("/string/value", "some string value") == STATUS_OK);
+        UTEST_ASSERT(kvt->put("/string/empty", "") == STATUS_OK);
+        UTEST_ASSERT(kvt->put("/string/utf8", "\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82") == STATUS_OK);
+        UTEST_ASSERT(kvt->put("/blob/value", sizeof(blob_data), "application/octet-stream", blob_data) == STATUS_OK);
+        UTEST_ASSERT(kvt->put("/blob/empty", size_t(0), "text/plain", NULL) == STATUS_OK);
+
+        blob.ctype      = NULL;
+        blob.data       = blob_data;
+        blob.size       = 7;
+        UTEST_ASSERT(kvt->put("/blob/no_ctype", &blob) == STATUS_OK);
+
+        UTEST_ASSERT(kvt->put("/private/value", int32_t(42), core::KVT_PRIVATE) == STATUS_OK);
+        UTEST_ASSERT(kvt->put("/transient/value", int32_t(43), core::KVT_TRANSIENT) == STATUS_OK);
+        UTEST_ASSERT(kvt->put("/deep/path/to/the/parameter", uint32_t(1)) == STATUS_OK);
+    }
+
+    void check_storage(core::KVTStorage *kvt, bool with_private)
+    {
+        const core::kvt_param_t *p;
+        int32_t i32;
+        uint32_t u32;
+        int64_t i64;
+        uint64_t u64;
+        float f32;
+        double f64;
+        const char *str;
+        const core::kvt_blob_t *blob;
+
+        UTEST_ASSERT((kvt->get("/int32/min", &i32) == STATUS_OK) && (i32 == -0x7fffffff - 1));
+        UTEST_ASSERT((kvt->get("/int32/max", &i32) == STATUS_OK) && (i32 == 0x7fffffff));
+        UTEST_ASSERT((kvt->get("/uint32", &u32) == STATUS_OK) && (u32 == 0xdeadbeef));
+        UTEST_ASSERT((kvt->get("/int64", &i64) == STATUS_OK) && (i64 == -0x123456789abcdefll));
+        UTEST_ASSERT((kvt->get("/uint64", &u64) == STATUS_OK) && (u64 == 0xfedcba9876543210ull));
+        UTEST_ASSERT((kvt->get("/float32/value", &f32) == STATUS_OK) && (f32 == 3.14159f));
+        UTEST_ASSERT((kvt->get("/float32/nan", &f32) == STATUS_OK) && (isnan(f32)));
+        UTEST_ASSERT((kvt->get("/float32/neg_zero", &f32) == STATUS_OK) && (f32 == 0.0f) && (signbit(f32)));
+        UTEST_ASSERT((kvt->get("/float64/value", &f64) == STATUS_OK) && (f64 == -2.718281828459045));
+        UTEST_ASSERT((kvt->get("/float64/inf", &f64) == STATUS_OK) && (isinf(f64)) && (f64 > 0.0));
+        UTEST_ASSERT((kvt->get("/string/value", &str) == STATUS_OK) && (strcmp(str, "some string value") == 0));
+        UTEST_ASSERT((kvt->get("/string/empty", &str) == STATUS_OK) && (str != NULL) && (str[0] == '\0'));
+        UTEST_ASSERT((kvt->get("/string/utf8", &str) == STATUS_OK) &&
+            (strcmp(str, "\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82") == 0));
+
+        UTEST_ASSERT(kvt->get("/blob/value", &blob) == STATUS_OK);
+        UTEST_ASSERT(blob->size == sizeof(blob_data));
+        UTEST_ASSERT(memcmp(blob->data, blob_data, sizeof(blob_data)) == 0);
+        UTEST_ASSERT((blob->ctype != NULL) && (strcmp(blob->ctype, "application/octet-stream") == 0));
+
+        UTEST_ASSERT(kvt->get("/blob/empty", &blob) == STATUS_OK);
+        UTEST_ASSERT((blob->size == 0) && (blob->data == NULL));
+        UTEST_ASSERT((blob->ctype != NULL) && (strcmp(blob->ctype, "text/plain") == 0));
+
+        // Missing content type is restored as empty string
+        UTEST_ASSERT(kvt->get("/blob/no_ctype", &blob) == STATUS_OK);
+        UTEST_ASSERT((blob->size == 7) && (memcmp(blob->data, blob_data, 7) == 0));
+        UTEST_ASSERT((blob->ctype == NULL) || (blob->ctype[0] == '\0'));
+
+        UTEST_ASSERT((kvt->get("/deep/path/to/the/parameter", &u32) == STATUS_OK) && (u32 == 1));
+
+        // Transient parameters are not stored, private parameters keep the flag
+        UTEST_ASSERT(!kvt->exists("/transient/value"));
+        if (with_private)
+        {
+            UTEST_ASSERT((kvt->get("/private/value", &i32) == STATUS_OK) && (i32 == 42));
+
+            core::KVTIterator *it = kvt->enum_branch("/private");
+            UTEST_ASSERT(it != NULL);
+            UTEST_ASSERT(it->next() == STATUS_OK);
+            UTEST_ASSERT(strcmp(it->name(), "/private/value") == 0);
+            UTEST_ASSERT(it->is_private());
+        }
+        else
+            UTEST_ASSERT(kvt->get("/private/value", &p) == STATUS_NOT_FOUND);
+
+        UTEST_ASSERT(kvt->values() == ((with_private) ? 18 : 17));
+    }
+
+    void test_round_trip()
+    {
+        printf("Testing round trip of all parameter types\n");
+
+        core::KVTStorage src, dst, dst2, dst3;
+        core::KVTSnapshot s1, s2;
+
+        fill_storage(&src);
+        UTEST_ASSERT(s1.save(&src) == STATUS_OK);
+        UTEST_ASSERT(core::KVTSnapshot::probe(s1.data(), s1.size()));
+        UTEST_ASSERT((s1.size() % sizeof(uint64_t)) == 0);
+
+        // Restore and save again: snapshots contain the same records, the order of records may differ
+        UTEST_ASSERT(core::KVTSnapshot::restore(&dst, s1.data(), s1.size(), 0) == STATUS_OK);
+        check_storage(&dst, true);
+        UTEST_ASSERT(s2.save(&dst) == STATUS_OK);
+        UTEST_ASSERT(s1.size() == s2.size());
+        {
+            core::KVTStorage tmp;
+            UTEST_ASSERT(core::KVTSnapshot::restore(&tmp, s2.data(), s2.size(), 0) == STATUS_OK);
+            check_storage(&tmp, true);
+        }
+
+        // Restore from the unaligned buffer with extra data after the snapshot
+        uint8_t *buf        = static_cast<uint8_t *>(malloc(s1.size() + 0x10));
+        UTEST_ASSERT(buf != NULL);
+        lsp_finally { free(buf); };
+        memcpy(&buf[1], s1.data(), s1.size());
+        memset(&buf[s1.size() + 1], 0x55, 0x0f);
+        UTEST_ASSERT(core::KVTSnapshot::restore(&dst2, &buf[1], s1.size() + 0x0f, 0) == STATUS_OK);
+        check_storage(&dst2, true);
+
+        // Skip private parameters and mark restored parameters
+        UTEST_ASSERT(core::KVTSnapshot::restore(&dst3, s1.data(), s1.size(), core::KVT_RX, core::KVT_PRIVATE) == STATUS_OK);
+        check_storage(&dst3, false);
+        UTEST_ASSERT(dst3.rx_pending() == dst3.values());
+
+        // Empty storage
+        core::KVTStorage empty;
+        UTEST_ASSERT(s2.save(&empty) == STATUS_OK);
+        UTEST_ASSERT(s2.size() == HEADER_SIZE);
+        UTEST_ASSERT(core::KVTSnapshot::restore(&dst, s2.data(), s2.size(), 0) == STATUS_OK);
+        check_storage(&dst, true);
+    }
+
+    // Restore of the snapshot should fail and should not modify the storage
+    void check_rejected(const uint8_t *data, size_t size, const char *what)
+    {
+        core::KVTStorage kvt;
+        core::KVTSnapshot before, after;
+
+        UTEST_ASSERT(kvt.put("/existing/value", int32_t(1)) == STATUS_OK);
+        UTEST_ASSERT(kvt.put("/int32/min", "not overwritten") == STATUS_OK);
+        UTEST_ASSERT(kvt.commit_all(core::KVT_TX | core::KVT_RX) == STATUS_OK);
+        UTEST_ASSERT(before.save(&kvt) == STATUS_OK);
+
+        const status_t res = core::KVTSnapshot::restore(&kvt, data, size, core::KVT_RX);
+        UTEST_ASSERT_MSG(res != STATUS_OK, "%s: restore succeeded", what);
+
+        UTEST_ASSERT_MSG(kvt.values() == 2, "%s: values=%d", what, int(kvt.values()));
+        UTEST_ASSERT_MSG(kvt.rx_pending() == 0, "%s: storage has been modified", what);
+        UTEST_ASSERT(after.save(&kvt) == STATUS_OK);
+        UTEST_ASSERT_MSG((before.size() == after.size()) && (memcmp(before.data(), after.data(), before.size()) == 0),
+            "%s: storage has been modified", what);
+    }
+
+    void test_corrupted()
+    {
+        printf("Testing restore of corrupted snapshots\n");
+
+        core::KVTStorage src;
+        core::KVTSnapshot snap;
+        char what[64];
+
+        fill_storage(&src);
+        UTEST_ASSERT(snap.save(&src) == STATUS_OK);
+
+        const size_t size   = snap.size();
+        uint8_t *buf        = static_cast<uint8_t *>(malloc(size));
+        UTEST_ASSERT(buf != NULL);
+        lsp_finally { free(buf); };
+
+        // Invalid arguments
+        UTEST_ASSERT(core::KVTSnapshot::restore(&src, NULL, size, 0) == STATUS_BAD_FORMAT);
+        check_rejected(static_cast<const uint8_t *>(snap.data()), 0, "empty data");
+        check_rejected(static_cast<const uint8_t *>(snap.data()), HEADER_SIZE - 1, "short header");
+
+        // Wrong signature and version
+        memcpy(buf, snap.data(), size);
+        buf[0]             ^= 0x20;
+        UTEST_ASSERT(!core::KVTSnapshot::probe(buf, size));
+        check_rejected(buf, size, "wrong signature");
+
+        static const uint16_t versions[] = { 0, 2, 0x100, 0xffff };
+        for (size_t i=0; i<sizeof(versions)/sizeof(versions[0]); ++i)
+        {
+            memcpy(buf, snap.data(), size);
+            buf[HDR_VERSION]        = uint8_t(versions[i]);
+            buf[HDR_VERSION + 1]    = uint8_t(versions[i] >> 8);
+            UTEST_ASSERT(!core::KVTSnapshot::probe(buf, size));
+            snprintf(what, sizeof(what), "version %d", int(versions[i]));
+            check_rejected(buf, size, what);
+        }
+
+        // Truncated data, the header may keep the original size or may be updated to match truncation
+        for (size_t len=HEADER_SIZE; len < size; ++len)
+        {
+            memcpy(buf, snap.data(), size);
+            snprintf(what, sizeof(what), "truncated to %d bytes", int(len));
+            check_rejected(buf, len, what);
+
+            put_u32(&buf[HDR_SIZE], uint32_t(len));
+            snprintf(what, sizeof(what), "truncated to %d bytes with header", int(len));
+            check_rejected(buf, len, what);
+        }
+
+        // Oversized snapshot length
+        memcpy(buf, snap.data(), size);
+        put_u32(&buf[HDR_SIZE], uint32_t(size + 8));
+        check_rejected(buf, size, "oversized snapshot");
+        put_u32(&buf[HDR_SIZE], 0xffffffff);
+        check_rejected(buf, size, "oversized snapshot");
+        put_u32(&buf[HDR_SIZE], HEADER_SIZE - 8);
+        check_rejected(buf, size, "undersized snapshot");
+
+        // Oversized lengths in each record, every record is checked to ensure that none of
+        // the previous records is committed to the storage
+        const uint32_t lengths[] = { uint32_t(size), 0x80000000, 0xffffffff };
+        static const size_t fields[] = { REC_SIZE, REC_NAME_LEN, REC_TEXT_LEN, REC_VALUE };
+        for (size_t off = HEADER_SIZE; off < size; )
+        {
+            memcpy(buf, snap.data(), size);
+            const uint32_t rec_size = get_u32(&buf[off + REC_SIZE]);
+            const uint32_t name_len = get_u32(&buf[off + REC_NAME_LEN]);
+            const uint8_t type      = buf[off + 4];
+
+            for (size_t i=0; i<sizeof(fields)/sizeof(fields[0]); ++i)
+            {
+                // Text length is used only by strings and blobs, the value is the size of blob data
+                if ((fields[i] == REC_TEXT_LEN) && (type != 's') && (type != 'B'))
+                    continue;
+                if ((fields[i] == REC_VALUE) && (type != 'B'))
+                    continue;
+
+                for (size_t j=0; j<sizeof(lengths)/sizeof(lengths[0]); ++j)
+                {
+                    memcpy(buf, snap.data(), size);
+                    put_u32(&buf[off + fields[i]], lengths[j]);
+                    snprintf(what, sizeof(what), "record at %d, field %d = 0x%x", int(off), int(fields[i]), int(lengths[j]));
+                    check_rejected(buf, size, what);
+                }
+            }
+
+            // Name without terminating zero
+            memcpy(buf, snap.data(), size);
+            buf[off + REC_VALUE + sizeof(uint64_t) + name_len] = 'x';
+            snprintf(what, sizeof(what), "record at %d, unterminated name", int(off));
+            check_rejected(buf, size, what);
+
+            // Misaligned size of the record
+            memcpy(buf, snap.data(), size);
+            put_u32(&buf[off + REC_SIZE], rec_size + 4);
+            snprintf(what, sizeof(what), "record at %d, misaligned size", int(off));
+            check_rejected(buf, size, what);
+
+            off        += rec_size;
+        }
+
+        // Random corruption never leaves the storage partially restored
+        for (size_t iter=0; iter<2000; ++iter)
+        {
+            memcpy(buf, snap.data(), size);
+            for (size_t i=0, n=next_random(4) + 1; i<n; ++i)
+                buf[HEADER_SIZE + next_random(size - HEADER_SIZE)] = uint8_t(next_random(0x100));
+
+            core::KVTStorage kvt;
+            if (core::KVTSnapshot::restore(&kvt, buf, size, 0) != STATUS_OK)
+                UTEST_ASSERT_MSG(kvt.values() == 0, "iteration %d: storage has been partially restored", int(iter));
+        }
+    }
+
+    UTEST_MAIN
+    {
+        nSeed       = 0x13572468;
+
+        test_round_trip();
+        test_corrupted();
+    }
+
+UTEST_END
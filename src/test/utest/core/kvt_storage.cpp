@@ -0,0 +1,486 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/finally.h>
+#include <lsp-plug.in/plug-fw/core/KVTStorage.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+namespace
+{
+    using namespace lsp;
+
+    static constexpr size_t POOL_MIN        = 0x40;     // Minimum number of parameters kept in the pool
+    static constexpr size_t PATH_COUNT      = 400;
+    static constexpr size_t PATH_LEN        = 128;
+    static constexpr size_t VALUE_LEN       = 64;
+
+    // Storage with access to the internal state
+    class TestStorage: public core::KVTStorage
+    {
+        public:
+            inline size_t hash_capacity() const { return nHashCap;      }
+            inline size_t hash_size() const     { return nHashSize;     }
+            inline size_t pool_size() const     { return nPoolSize;     }
+
+            const void *node(const char *name)
+            {
+                kvt_node_t *node = NULL;
+                return (lookup_node(&node, name) == STATUS_OK) ? node : NULL;
+            }
+
+            uint32_t node_hash(const char *name)
+            {
+                kvt_node_t *node = NULL;
+                return ((lookup_node(&node, name) == STATUS_OK) && (node != NULL)) ? node->hash : 0;
+            }
+    };
+
+    typedef struct reference_t
+    {
+        char                    sPath[PATH_LEN];
+        bool                    bPresent;
+        core::kvt_param_type_t  enType;
+        int32_t                 nValue;
+        double                  fValue;
+        char                    sValue[VALUE_LEN];
+    } reference_t;
+
+    // Pairs of different paths with the same 32-bit FNV-1a hash
+    static const char * const hash_collisions[][2] =
+    {
+        { "/hash/k0029599",         "/hash/k0632382"        },
+        { "/hash/k0029598",         "/hash/k0632383"        },
+        { "/hash/d10/e61/k23290",   "/hash/k0061505"        },
+        { "/hash/d92/e88/k56158",   "/hash/d25/e40/k70350"  },
+        { "/hash/d43/e53/k32538",   "/hash/k0076855"        },
+        { "/hash/d50/e43/k119748",  "/hash/d7/e40/k120190"  },
+    };
+}
+
+UTEST_BEGIN("core", kvt_storage)
+
+    uint32_t    nSeed;
+
+    uint32_t next_random(uint32_t range)
+    {
+        nSeed       = nSeed * 1103515245 + 12345;
+        return ((nSeed >> 8) & 0xffffff) % range;
+    }
+
+    void make_path(char *dst, size_t depth)
+    {
+        static const char * const items[] = { "a", "b", "c", "node", "x1", "long_component_name" };
+        dst[0]      = '\0';
+        for (size_t i=0; i<depth; ++i)
+        {
+            strcat(dst, "/");
+            strcat(dst, items[next_random(sizeof(items)/sizeof(items[0]))]);
+        }
+    }
+
+    void check_reference(TestStorage *s, const reference_t *ref)
+    {
+        const core::kvt_param_t *p = NULL;
+        const status_t res = s->get(ref->sPath, &p);
+
+        if (!ref->bPresent)
+        {
+            UTEST_ASSERT_MSG(res == STATUS_NOT_FOUND, "path=%s, res=%d", ref->sPath, int(res));
+            UTEST_ASSERT(!s->exists(ref->sPath));
+            return;
+        }
+
+        UTEST_ASSERT_MSG(res == STATUS_OK, "path=%s, res=%d", ref->sPath, int(res));
+        UTEST_ASSERT_MSG(p->type == ref->enType, "path=%s, type=%d, expected=%d", ref->sPath, int(p->type), int(ref->enType));
+        UTEST_ASSERT(s->exists(ref->sPath, ref->enType));
+
+        switch (ref->enType)
+        {
+            case core::KVT_INT32:
+                UTEST_ASSERT_MSG(p->i32 == ref->nValue, "path=%s", ref->sPath);
+                break;
+            case core::KVT_FLOAT64:
+                UTEST_ASSERT_MSG(p->f64 == ref->fValue, "path=%s", ref->sPath);
+                break;
+            case core::KVT_STRING:
+                UTEST_ASSERT_MSG(strcmp(p->str, ref->sValue) == 0, "path=%s: value='%s', expected='%s'",
+                    ref->sPath, p->str, ref->sValue);
+                break;
+            case core::KVT_BLOB:
+                UTEST_ASSERT_MSG(p->blob.size == strlen(ref->sValue), "path=%s", ref->sPath);
+                UTEST_ASSERT_MSG(memcmp(p->blob.data, ref->sValue, p->blob.size) == 0, "path=%s", ref->sPath);
+                UTEST_ASSERT_MSG((p->blob.ctype != NULL) && (strcmp(p->blob.ctype, "text/plain") == 0), "path=%s", ref->sPath);
+                break;
+            default:
+                UTEST_FAIL_MSG("path=%s: unexpected type %d", ref->sPath, int(ref->enType));
+                break;
+        }
+    }
+
+    void put_reference(TestStorage *s, reference_t *ref)
+    {
+        static const core::kvt_param_type_t types[] = { core::KVT_INT32, core::KVT_FLOAT64, core::KVT_STRING, core::KVT_BLOB };
+        status_t res;
+
+        ref->enType     = types[next_random(sizeof(types)/sizeof(types[0]))];
+        switch (ref->enType)
+        {
+            case core::KVT_INT32:
+                ref->nValue     = int32_t(next_random(0x1000000)) - 0x800000;
+                res             = s->put(ref->sPath, ref->nValue, core::KVT_TX);
+                break;
+            case core::KVT_FLOAT64:
+                ref->fValue     = next_random(0x100000) * 0.125;
+                res             = s->put(ref->sPath, ref->fValue, core::KVT_RX);
+                break;
+            case core::KVT_STRING:
+            case core::KVT_BLOB:
+            {
+                const size_t len = next_random(VALUE_LEN - 1);
+                for (size_t i=0; i<len; ++i)
+                    ref->sValue[i]  = 'a' + next_random(26);
+                ref->sValue[len]    = '\0';
+                res             = (ref->enType == core::KVT_STRING) ?
+                    s->put(ref->sPath, ref->sValue, core::KVT_TX) :
+                    s->put(ref->sPath, len, "text/plain", ref->sValue, core::KVT_RX);
+                break;
+            }
+            default:
+                res             = STATUS_BAD_TYPE;
+                break;
+        }
+
+        UTEST_ASSERT_MSG(res == STATUS_OK, "path=%s, res=%d", ref->sPath, int(res));
+        ref->bPresent   = true;
+    }
+
+    void test_deep_paths()
+    {
+        printf("Testing put/get/remove/gc on deep paths\n");
+
+        reference_t *refs   = static_cast<reference_t *>(malloc(sizeof(reference_t) * PATH_COUNT));
+        UTEST_ASSERT(refs != NULL);
+        lsp_finally { free(refs); };
+
+        // Generate unique paths, some of them are branches of other paths
+        size_t count = 0;
+        while (count < PATH_COUNT)
+        {
+            reference_t *ref = &refs[count];
+            make_path(ref->sPath, next_random(6) + 1);
+
+            bool unique = true;
+            for (size_t i=0; (unique) && (i<count); ++i)
+                unique      = strcmp(refs[i].sPath, ref->sPath) != 0;
+            if (!unique)
+                continue;
+
+            ref->bPresent   = false;
+            ++count;
+        }
+
+        TestStorage s;
+
+        // Invalid paths
+        UTEST_ASSERT(s.put("a/b", int32_t(1)) == STATUS_INVALID_VALUE);
+        UTEST_ASSERT(s.put("/a//b", int32_t(1)) == STATUS_INVALID_VALUE);
+        UTEST_ASSERT(s.put("/a/b/", int32_t(1)) == STATUS_INVALID_VALUE);
+        UTEST_ASSERT(s.put("/", int32_t(1)) == STATUS_INVALID_VALUE);
+        UTEST_ASSERT(s.get("/a//b", static_cast<const core::kvt_param_t **>(NULL)) == STATUS_INVALID_VALUE);
+        UTEST_ASSERT(s.values() == 0);
+
+        // Perform random operations and validate the state of the storage
+        for (size_t iter=0; iter<50000; ++iter)
+        {
+            reference_t *ref    = &refs[next_random(PATH_COUNT)];
+            const uint32_t op   = next_random(100);
+
+            if (op < 45)
+                put_reference(&s, ref);
+            else if (op < 80)
+                check_reference(&s, ref);
+            else if (op < 95)
+            {
+                const status_t res  = s.remove(ref->sPath);
+                UTEST_ASSERT_MSG(res == ((ref->bPresent) ? STATUS_OK : STATUS_NOT_FOUND),
+                    "path=%s, res=%d", ref->sPath, int(res));
+                ref->bPresent       = false;
+            }
+            else
+                UTEST_ASSERT(s.gc() == STATUS_OK);
+
+            // Validate the whole storage from time to time
+            if ((iter % 5000) == 0)
+            {
+                size_t values = 0;
+                for (size_t i=0; i<PATH_COUNT; ++i)
+                {
+                    check_reference(&s, &refs[i]);
+                    if (refs[i].bPresent)
+                        ++values;
+                }
+                UTEST_ASSERT(s.values() == values);
+            }
+        }
+
+        // Remove all values, garbage collection should drop all nodes
+        for (size_t i=0; i<PATH_COUNT; ++i)
+        {
+            reference_t *ref    = &refs[i];
+            UTEST_ASSERT(s.remove(ref->sPath) == ((ref->bPresent) ? STATUS_OK : STATUS_NOT_FOUND));
+            ref->bPresent       = false;
+        }
+        UTEST_ASSERT(s.values() == 0);
+        UTEST_ASSERT(s.gc() == STATUS_OK);
+        UTEST_ASSERT(s.hash_size() == 0);
+        for (size_t i=0; i<PATH_COUNT; ++i)
+        {
+            check_reference(&s, &refs[i]);
+            UTEST_ASSERT(s.node(refs[i].sPath) == NULL);
+        }
+    }
+
+    void test_hash_collisions()
+    {
+        printf("Testing hash collisions\n");
+
+        TestStorage s;
+        const size_t n = sizeof(hash_collisions)/sizeof(hash_collisions[0]);
+
+        for (size_t i=0; i<n; ++i)
+        {
+            const char *a = hash_collisions[i][0];
+            const char *b = hash_collisions[i][1];
+
+            // Only one path of the pair exists
+            UTEST_ASSERT(s.put(a, int32_t(i * 2)) == STATUS_OK);
+            UTEST_ASSERT(!s.exists(b));
+            UTEST_ASSERT(s.node(b) == NULL);
+
+            // Both paths exist and have the same hash
+            UTEST_ASSERT(s.put(b, int32_t(i * 2 + 1)) == STATUS_OK);
+            UTEST_ASSERT(s.node(a) != NULL);
+            UTEST_ASSERT(s.node(b) != NULL);
+            UTEST_ASSERT(s.node(a) != s.node(b));
+            UTEST_ASSERT_MSG(s.node_hash(a) == s.node_hash(b), "paths '%s' and '%s' have different hashes", a, b);
+        }
+
+        for (size_t i=0; i<n; ++i)
+        {
+            int32_t v1 = -1, v2 = -1;
+            UTEST_ASSERT(s.get(hash_collisions[i][0], &v1) == STATUS_OK);
+            UTEST_ASSERT(s.get(hash_collisions[i][1], &v2) == STATUS_OK);
+            UTEST_ASSERT(v1 == int32_t(i * 2));
+            UTEST_ASSERT(v2 == int32_t(i * 2 + 1));
+        }
+
+        // Update and remove one path of the pair, the other one should remain untouched
+        for (size_t i=0; i<n; ++i)
+        {
+            const char *a = hash_collisions[i][(i & 1)];
+            const char *b = hash_collisions[i][(i & 1) ^ 1];
+            int32_t v = -1;
+
+            UTEST_ASSERT(s.put(a, int32_t(100 + i)) == STATUS_OK);
+            UTEST_ASSERT(s.get(a, &v) == STATUS_OK);
+            UTEST_ASSERT(v == int32_t(100 + i));
+            UTEST_ASSERT(s.remove(a) == STATUS_OK);
+            UTEST_ASSERT(s.gc() == STATUS_OK);
+
+            UTEST_ASSERT(!s.exists(a));
+            UTEST_ASSERT(s.node(a) == NULL);
+            UTEST_ASSERT(s.get(b, &v) == STATUS_OK);
+            UTEST_ASSERT(v == int32_t(i * 2 + (((i & 1) ^ 1))));
+        }
+    }
+
+    void test_index_growth()
+    {
+        printf("Testing growth of the hash index\n");
+
+        TestStorage s;
+        char path[PATH_LEN];
+
+        UTEST_ASSERT(s.hash_capacity() == 0);
+
+        size_t caps = 0, prev = 0;
+        for (size_t i=0; i<10000; ++i)
+        {
+            snprintf(path, sizeof(path), "/g%d/k%d", int(i % 10), int(i));
+            UTEST_ASSERT(s.put(path, int32_t(i)) == STATUS_OK);
+
+            // Capacity is a power of two, index is never overloaded
+            const size_t cap = s.hash_capacity();
+            UTEST_ASSERT((cap & (cap - 1)) == 0);
+            UTEST_ASSERT(s.hash_size() <= cap);
+            UTEST_ASSERT(s.hash_size() == i + 1 + lsp_min(i + 1, size_t(10)));
+            if (cap != prev)
+            {
+                UTEST_ASSERT(cap > prev);
+                prev        = cap;
+                ++caps;
+            }
+        }
+        UTEST_ASSERT(caps > 5);
+
+        // All values are still reachable after re-distribution of nodes
+        for (size_t i=0; i<10000; ++i)
+        {
+            int32_t v = -1;
+            snprintf(path, sizeof(path), "/g%d/k%d", int(i % 10), int(i));
+            UTEST_ASSERT(s.get(path, &v) == STATUS_OK);
+            UTEST_ASSERT(v == int32_t(i));
+        }
+
+        // Removal of the whole branch removes nodes from the index
+        UTEST_ASSERT(s.remove_branch("/g3") == STATUS_OK);
+        UTEST_ASSERT(s.gc() == STATUS_OK);
+        UTEST_ASSERT(s.hash_size() == 9000 + 9);
+        UTEST_ASSERT(s.node("/g3") == NULL);
+        UTEST_ASSERT(s.node("/g3/k3") == NULL);
+        UTEST_ASSERT(s.exists("/g4/k4"));
+    }
+
+    void test_parameter_pool()
+    {
+        printf("Testing reuse of parameters\n");
+
+        TestStorage s;
+        const core::kvt_param_t *p1 = NULL, *p2 = NULL, *p = NULL;
+        char path[PATH_LEN];
+
+        // The replaced parameter and it's data buffer are reused after garbage collection
+        UTEST_ASSERT(s.put("/pool/a", "the first value of the parameter") == STATUS_OK);
+        UTEST_ASSERT(s.get("/pool/a", &p1) == STATUS_OK);
+        const char *data = p1->str;
+        UTEST_ASSERT(s.put("/pool/a", "the second value") == STATUS_OK);
+        UTEST_ASSERT(s.get("/pool/a", &p2) == STATUS_OK);
+        UTEST_ASSERT(p1 != p2);
+        UTEST_ASSERT(s.pool_size() == 0);
+        UTEST_ASSERT(s.gc() == STATUS_OK);
+        UTEST_ASSERT(s.pool_size() == 1);
+
+        UTEST_ASSERT(s.put("/pool/b", "a short value") == STATUS_OK);
+        UTEST_ASSERT(s.pool_size() == 0);
+        UTEST_ASSERT(s.get("/pool/b", &p) == STATUS_OK);
+        UTEST_ASSERT(p == p1);
+        UTEST_ASSERT(p->str == data);
+        UTEST_ASSERT(strcmp(p->str, "a short value") == 0);
+
+        // Reused parameter may change the type
+        UTEST_ASSERT(s.remove("/pool/b") == STATUS_OK);
+        UTEST_ASSERT(s.gc() == STATUS_OK);
+        UTEST_ASSERT(s.put("/pool/c", 1.5) == STATUS_OK);
+        UTEST_ASSERT(s.get("/pool/c", &p) == STATUS_OK);
+        UTEST_ASSERT(p == p1);
+        UTEST_ASSERT((p->type == core::KVT_FLOAT64) && (p->f64 == 1.5));
+        UTEST_ASSERT(s.remove("/pool/c") == STATUS_OK);
+        UTEST_ASSERT(s.gc() == STATUS_OK);
+
+        // Delegated contents are released when the parameter is recycled
+        char *str = strdup("delegated string");
+        UTEST_ASSERT(str != NULL);
+        UTEST_ASSERT(s.put("/pool/d", str, core::KVT_DELEGATE) == STATUS_OK);
+        UTEST_ASSERT(s.get("/pool/d", &p) == STATUS_OK);
+        UTEST_ASSERT(p->str == str);
+        UTEST_ASSERT(s.put("/pool/d", "plain string") == STATUS_OK);
+        UTEST_ASSERT(s.gc() == STATUS_OK);
+        UTEST_ASSERT(s.get("/pool/d", &p) == STATUS_OK);
+        UTEST_ASSERT(strcmp(p->str, "plain string") == 0);
+
+        // Steady-state updates of the same keys do not allocate new parameters
+        UTEST_ASSERT(s.clear() == STATUS_OK);
+        UTEST_ASSERT(s.gc() == STATUS_OK);
+
+        const core::kvt_param_t *seen[40];
+        size_t nseen = 0;
+        for (size_t iter=0; iter<100; ++iter)
+        {
+            for (size_t i=0; i<20; ++i)
+            {
+                snprintf(path, sizeof(path), "/steady/k%d", int(i));
+                UTEST_ASSERT(s.put(path, (iter & 1) ? "odd value" : "even value") == STATUS_OK);
+                UTEST_ASSERT(s.get(path, &p) == STATUS_OK);
+
+                bool found = false;
+                for (size_t j=0; (!found) && (j<nseen); ++j)
+                    found       = seen[j] == p;
+                if (!found)
+                {
+                    UTEST_ASSERT_MSG(iter < 2, "iteration %d allocated new parameter", int(iter));
+                    UTEST_ASSERT(nseen < sizeof(seen)/sizeof(seen[0]));
+                    seen[nseen++]   = p;
+                }
+            }
+            UTEST_ASSERT(s.gc() == STATUS_OK);
+            UTEST_ASSERT(s.pool_size() <= lsp_max(s.values(), POOL_MIN));
+        }
+
+        // The pool is bounded by the number of stored values
+        UTEST_ASSERT(s.clear() == STATUS_OK);
+        UTEST_ASSERT(s.gc() == STATUS_OK);
+        for (size_t i=0; i<1000; ++i)
+        {
+            snprintf(path, sizeof(path), "/bound/k%d", int(i));
+            UTEST_ASSERT(s.put(path, "value") == STATUS_OK);
+        }
+        UTEST_ASSERT(s.pool_size() == 0);
+
+        for (size_t i=0; i<200; ++i)
+        {
+            snprintf(path, sizeof(path), "/bound/k%d", int(i));
+            UTEST_ASSERT(s.put(path, "new value") == STATUS_OK);
+        }
+        UTEST_ASSERT(s.gc() == STATUS_OK);
+        UTEST_ASSERT(s.pool_size() == 200);
+
+        for (size_t i=0; i<1000; ++i)
+        {
+            snprintf(path, sizeof(path), "/bound/k%d", int(i));
+            UTEST_ASSERT(s.remove(path) == STATUS_OK);
+        }
+        UTEST_ASSERT(s.values() == 0);
+        UTEST_ASSERT(s.gc() == STATUS_OK);
+        UTEST_ASSERT(s.pool_size() == 200);     // The pool has already exceeded POOL_MIN, nothing is added
+
+        // New values are taken from the pool
+        for (size_t i=0; i<100; ++i)
+        {
+            snprintf(path, sizeof(path), "/bound/k%d", int(i));
+            UTEST_ASSERT(s.put(path, int32_t(i)) == STATUS_OK);
+        }
+        UTEST_ASSERT(s.pool_size() == 100);
+    }
+
+    UTEST_MAIN
+    {
+        nSeed       = 0x5eed1234;
+
+        test_deep_paths();
+        test_hash_collisions();
+        test_index_growth();
+        test_parameter_pool();
+    }
+
+UTEST_END
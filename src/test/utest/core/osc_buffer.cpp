@@ -0,0 +1,351 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/finally.h>
+#include <lsp-plug.in/plug-fw/core/osc_buffer.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+namespace
+{
+    using namespace lsp;
+
+    static constexpr size_t BUFFER_CAPACITY     = 0x400;
+    static constexpr size_t PACKET_MAX          = 0x100;
+
+    typedef struct state_t
+    {
+        size_t      nSize;
+        size_t      nHead;
+        size_t      nTail;
+        size_t      nReserved;
+        size_t      nPadding;
+        uint8_t     vData[BUFFER_CAPACITY];
+    } state_t;
+}
+
+UTEST_BEGIN("core", osc_buffer)
+
+    // Fill the packet with the data pattern which depends on the sequence number of the packet
+    static void make_packet(uint8_t *dst, size_t size, size_t seq)
+    {
+        for (size_t i=0; i<size; ++i)
+            dst[i]      = uint8_t(seq * 31 + i * 7 + (i >> 8));
+    }
+
+    void check_packet(const void *data, size_t size, size_t expected_size, size_t seq)
+    {
+        uint8_t buf[PACKET_MAX];
+        UTEST_ASSERT_MSG(size == expected_size, "seq=%d: size=%d, expected=%d", int(seq), int(size), int(expected_size));
+        make_packet(buf, size, seq);
+        UTEST_ASSERT_MSG(::memcmp(data, buf, size) == 0, "seq=%d: packet data mismatch", int(seq));
+    }
+
+    static void save_state(state_t *st, const core::osc_buffer_t *buf)
+    {
+        st->nSize       = buf->size();
+        st->nHead       = buf->nHead;
+        st->nTail       = buf->nTail;
+        st->nReserved   = buf->nReserved;
+        st->nPadding    = buf->nPadding;
+        ::memcpy(st->vData, buf->pBuffer, BUFFER_CAPACITY);
+    }
+
+    static bool same_state(const state_t *st, const core::osc_buffer_t *buf)
+    {
+        return (st->nSize == buf->size()) &&
+            (st->nHead == buf->nHead) &&
+            (st->nTail == buf->nTail) &&
+            (st->nReserved == buf->nReserved) &&
+            (st->nPadding == buf->nPadding) &&
+            (::memcmp(st->vData, buf->pBuffer, BUFFER_CAPACITY) == 0);
+    }
+
+    void test_wrap()
+    {
+        printf("Testing packets wrapping around the end of the buffer\n");
+
+        core::osc_buffer_t *buf = core::osc_buffer_t::create(BUFFER_CAPACITY);
+        UTEST_ASSERT(buf != NULL);
+        lsp_finally { core::osc_buffer_t::destroy(buf); };
+
+        uint8_t packet[PACKET_MAX];
+        size_t length;
+
+        // Fill the buffer up to the wrap point: 7 records of 0x90 bytes leave 0x10 bytes at the end
+        for (size_t i=0; i<7; ++i)
+        {
+            make_packet(packet, 0x8c, i);
+            UTEST_ASSERT(buf->submit(packet, 0x8c) == STATUS_OK);
+        }
+        UTEST_ASSERT(buf->nTail == 0x3f0);
+        UTEST_ASSERT(buf->size() == 0x3f0);
+
+        // The packet that does not fit into the end of the buffer can not be stored until the head moves
+        make_packet(packet, 0x20, 7);
+        UTEST_ASSERT(buf->submit(packet, 0x20) == STATUS_OVERFLOW);
+        UTEST_ASSERT(buf->nTail == 0x3f0);
+
+        // Release two records, the packet is stored at the beginning of the buffer after the padding
+        for (size_t i=0; i<2; ++i)
+        {
+            UTEST_ASSERT(buf->fetch(packet, &length, sizeof(packet)) == STATUS_OK);
+            check_packet(packet, length, 0x8c, i);
+        }
+        make_packet(packet, 0x20, 7);
+        UTEST_ASSERT(buf->submit(packet, 0x20) == STATUS_OK);
+        UTEST_ASSERT(*reinterpret_cast<uint32_t *>(&buf->pBuffer[0x3f0]) == 0xffffffff);
+        UTEST_ASSERT(buf->nTail == 0x24);
+        UTEST_ASSERT(buf->size() == 0x2d0 + 0x10 + 0x24);
+
+        // The record that exactly fits the end of the buffer moves the tail to the beginning
+        // without any padding
+        buf->clear();
+        for (size_t i=0; i<8; ++i)
+        {
+            make_packet(packet, 0x7c, i);
+            UTEST_ASSERT(buf->submit(packet, 0x7c) == STATUS_OK);
+        }
+        UTEST_ASSERT(buf->nTail == 0);
+        UTEST_ASSERT(buf->size() == BUFFER_CAPACITY);
+        make_packet(packet, 0x4, 8);
+        UTEST_ASSERT(buf->submit(packet, 0x4) == STATUS_OVERFLOW);
+        for (size_t i=0; i<8; ++i)
+        {
+            UTEST_ASSERT(buf->fetch(packet, &length, sizeof(packet)) == STATUS_OK);
+            check_packet(packet, length, 0x7c, i);
+        }
+        UTEST_ASSERT(buf->size() == 0);
+        UTEST_ASSERT(buf->fetch(packet, &length, sizeof(packet)) == STATUS_NO_DATA);
+
+        // Stream packets of different sizes through the buffer, the padding records are skipped on read
+        static const size_t sizes[] = { 4, 12, 0x28, 0x64, 0xfc, 0x8, 0x3c, 0x100, 0x10 };
+        static constexpr size_t n_sizes = sizeof(sizes) / sizeof(sizes[0]);
+
+        buf->clear();
+        size_t written = 0, read = 0, paddings = 0;
+        for (size_t iter=0; iter<2000; ++iter)
+        {
+            // Write packets until the buffer overflows
+            while (true)
+            {
+                const size_t size   = sizes[written % n_sizes];
+                const size_t tail   = buf->nTail;
+                make_packet(packet, size, written);
+                const status_t res  = buf->submit(packet, size);
+                if (res == STATUS_OVERFLOW)
+                    break;
+                UTEST_ASSERT(res == STATUS_OK);
+                if (buf->nTail == size + sizeof(uint32_t))
+                {
+                    if (tail > 0)
+                    {
+                        UTEST_ASSERT(*reinterpret_cast<uint32_t *>(&buf->pBuffer[tail]) == 0xffffffff);
+                        ++paddings;
+                    }
+                }
+                ++written;
+            }
+
+            // Read some packets
+            for (size_t i=0, n=(iter % 5) + 1; (i<n) && (read < written); ++i, ++read)
+            {
+                UTEST_ASSERT(buf->fetch(packet, &length, sizeof(packet)) == STATUS_OK);
+                check_packet(packet, length, sizes[read % n_sizes], read);
+            }
+        }
+
+        // Read the rest of packets
+        for ( ; read < written; ++read)
+        {
+            UTEST_ASSERT(buf->fetch(packet, &length, sizeof(packet)) == STATUS_OK);
+            check_packet(packet, length, sizes[read % n_sizes], read);
+        }
+        UTEST_ASSERT(buf->size() == 0);
+        UTEST_ASSERT(buf->fetch(packet, &length, sizeof(packet)) == STATUS_NO_DATA);
+        UTEST_ASSERT(paddings > 0);
+    }
+
+    void test_failed_reserve()
+    {
+        printf("Testing failed reservation\n");
+
+        core::osc_buffer_t *buf = core::osc_buffer_t::create(BUFFER_CAPACITY);
+        UTEST_ASSERT(buf != NULL);
+        lsp_finally { core::osc_buffer_t::destroy(buf); };
+
+        uint8_t packet[PACKET_MAX];
+        size_t length;
+        state_t st;
+
+        // Move the tail close to the end of the buffer and release the beginning of the buffer
+        for (size_t i=0; i<6; ++i)
+        {
+            make_packet(packet, 0x9c, i);
+            UTEST_ASSERT(buf->submit(packet, 0x9c) == STATUS_OK);
+        }
+        UTEST_ASSERT(buf->fetch(packet, &length, sizeof(packet)) == STATUS_OK);
+        check_packet(packet, length, 0x9c, 0);
+
+        save_state(&st, buf);
+        UTEST_ASSERT(buf->nTail == 0x3c0);
+
+        // Invalid sizes
+        UTEST_ASSERT(buf->reserve_packet(0) == NULL);
+        UTEST_ASSERT(buf->reserve_packet(6) == NULL);
+        UTEST_ASSERT(buf->submit(packet, 0) == STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(buf->submit(packet, 6) == STATUS_BAD_ARGUMENTS);
+        UTEST_ASSERT(buf->submit(packet, BUFFER_CAPACITY) == STATUS_TOO_BIG);
+        UTEST_ASSERT(same_state(&st, buf));
+
+        // Not enough space: the packet requires padding and does not fit at the beginning of the buffer
+        UTEST_ASSERT(buf->reserve_packet(0xa0) == NULL);
+        make_packet(packet, 0xa0, 6);
+        UTEST_ASSERT(buf->submit(packet, 0xa0) == STATUS_OVERFLOW);
+        UTEST_ASSERT(same_state(&st, buf));
+        UTEST_ASSERT(buf->commit_packet(0xa0) == STATUS_OVERFLOW);
+        UTEST_ASSERT(same_state(&st, buf));
+
+        // Reservation that has not been committed does not modify the buffer
+        uint8_t *dst = static_cast<uint8_t *>(buf->reserve_packet(0x38));
+        UTEST_ASSERT(dst == &buf->pBuffer[0x3c4]);
+        UTEST_ASSERT(buf->nTail == st.nTail);
+        UTEST_ASSERT(buf->size() == st.nSize);
+
+        // Reservation of more space than actually committed
+        dst = static_cast<uint8_t *>(buf->reserve_packet(0x60));
+        UTEST_ASSERT(dst == &buf->pBuffer[sizeof(uint32_t)]);
+        UTEST_ASSERT(buf->nTail == st.nTail);
+        UTEST_ASSERT(buf->size() == st.nSize);
+        make_packet(dst, 0x20, 6);
+        UTEST_ASSERT(buf->commit_packet(0x64) == STATUS_OVERFLOW);
+        UTEST_ASSERT(buf->nTail == st.nTail);
+        UTEST_ASSERT(buf->size() == st.nSize);
+        UTEST_ASSERT(buf->commit_packet(0x20) == STATUS_OK);
+        UTEST_ASSERT(buf->nTail == 0x24);
+        UTEST_ASSERT(buf->size() == st.nSize + 0x40 + 0x24);
+
+        // All packets are read in order
+        for (size_t i=1; i<6; ++i)
+        {
+            UTEST_ASSERT(buf->fetch(packet, &length, sizeof(packet)) == STATUS_OK);
+            check_packet(packet, length, 0x9c, i);
+        }
+        UTEST_ASSERT(buf->fetch(packet, &length, sizeof(packet)) == STATUS_OK);
+        check_packet(packet, length, 0x20, 6);
+        UTEST_ASSERT(buf->size() == 0);
+
+        // Fetch into the small buffer fails and keeps the packet
+        make_packet(packet, 0x40, 7);
+        UTEST_ASSERT(buf->submit(packet, 0x40) == STATUS_OK);
+        save_state(&st, buf);
+        UTEST_ASSERT(buf->fetch(packet, &length, 0x3c) == STATUS_OVERFLOW);
+        UTEST_ASSERT(same_state(&st, buf));
+        UTEST_ASSERT(buf->fetch(packet, &length, 0x40) == STATUS_OK);
+        check_packet(packet, length, 0x40, 7);
+    }
+
+    void test_peek_skip()
+    {
+        printf("Testing peek and skip of packets\n");
+
+        core::osc_buffer_t *b1  = core::osc_buffer_t::create(BUFFER_CAPACITY);
+        core::osc_buffer_t *b2  = core::osc_buffer_t::create(BUFFER_CAPACITY);
+        UTEST_ASSERT((b1 != NULL) && (b2 != NULL));
+        lsp_finally {
+            core::osc_buffer_t::destroy(b1);
+            core::osc_buffer_t::destroy(b2);
+        };
+
+        uint8_t packet[PACKET_MAX];
+        size_t length;
+        osc::packet_t pk;
+
+        UTEST_ASSERT(b1->peek(&pk) == STATUS_NO_DATA);
+        UTEST_ASSERT(b1->skip() == 0);
+
+        size_t written = 0;
+        for (size_t iter=0; iter<1000; ++iter)
+        {
+            // Submit the same packets to both buffers
+            for (size_t i=0, n=(iter % 7) + 1; i<n; ++i)
+            {
+                const size_t size   = ((written * 13) % (PACKET_MAX / sizeof(uint32_t)) + 1) * sizeof(uint32_t);
+                make_packet(packet, size, written);
+                const status_t r1   = b1->submit(packet, size);
+                const status_t r2   = b2->submit(packet, size);
+                UTEST_ASSERT(r1 == r2);
+                if (r1 != STATUS_OK)
+                    break;
+                ++written;
+            }
+
+            // Read packets by different methods and compare results
+            for (size_t i=0, n=(iter % 5) + 1; i<n; ++i)
+            {
+                const status_t r1   = b1->peek(&pk);
+                const status_t r2   = b2->fetch(packet, &length, sizeof(packet));
+                UTEST_ASSERT(r1 == r2);
+                if (r1 != STATUS_OK)
+                    break;
+
+                // Peek does not modify the buffer
+                osc::packet_t pk2;
+                UTEST_ASSERT(b1->peek(&pk2) == STATUS_OK);
+                UTEST_ASSERT((pk2.data == pk.data) && (pk2.size == pk.size));
+
+                UTEST_ASSERT(pk.size == length);
+                UTEST_ASSERT(::memcmp(pk.data, packet, length) == 0);
+                UTEST_ASSERT(b1->skip() == length);
+
+                UTEST_ASSERT(b1->size() == b2->size());
+                UTEST_ASSERT(b1->nHead == b2->nHead);
+            }
+        }
+
+        // Both buffers are drained in the same way
+        while (true)
+        {
+            const status_t r1   = b1->peek(&pk);
+            const status_t r2   = b2->fetch(packet, &length, sizeof(packet));
+            UTEST_ASSERT(r1 == r2);
+            if (r1 != STATUS_OK)
+            {
+                UTEST_ASSERT(r1 == STATUS_NO_DATA);
+                break;
+            }
+            UTEST_ASSERT(pk.size == length);
+            UTEST_ASSERT(::memcmp(pk.data, packet, length) == 0);
+            b1->release();
+        }
+        UTEST_ASSERT(b1->size() == 0);
+        UTEST_ASSERT(b2->size() == 0);
+    }
+
+    UTEST_MAIN
+    {
+        test_wrap();
+        test_failed_reserve();
+        test_peek_skip();
+    }
+
+UTEST_END
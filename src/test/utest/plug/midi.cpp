@@ -0,0 +1,351 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/finally.h>
+#include <lsp-plug.in/plug-fw/plug/data.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <lsp-plug.in/test-fw/utest.h>
+
+UTEST_BEGIN("plug", midi)
+
+    uint32_t    nSeed;
+
+    uint32_t next_random(uint32_t range)
+    {
+        nSeed       = nSeed * 1103515245 + 12345;
+        return ((nSeed >> 8) & 0xffffff) % range;
+    }
+
+    // Events are tagged by unique identifier stored in the note fields
+    static midi::event_t make_event(uint32_t timestamp, size_t id)
+    {
+        midi::event_t ev;
+        ::bzero(&ev, sizeof(ev));
+        ev.timestamp        = timestamp;
+        ev.type             = midi::MIDI_MSG_NOTE_ON;
+        ev.channel          = 0;
+        ev.note.pitch       = id & 0x7f;
+        ev.note.velocity    = (id >> 7) & 0x7f;
+        return ev;
+    }
+
+    static size_t event_id(const midi::event_t *ev)
+    {
+        return ev->note.pitch | (size_t(ev->note.velocity) << 7);
+    }
+
+    static plug::midi_t *alloc_queue()
+    {
+        plug::midi_t *q     = static_cast<plug::midi_t *>(malloc(sizeof(plug::midi_t)));
+        if (q != NULL)
+            q->clear();
+        return q;
+    }
+
+    // Fill queue with count events in chronological order, timestamps may repeat
+    void fill_sorted(plug::midi_t *q, size_t count, uint32_t first, uint32_t step, size_t id)
+    {
+        uint32_t ts     = first;
+        for (size_t i=0; i<count; ++i)
+        {
+            ts         += next_random(step + 1);
+            UTEST_ASSERT(q->push(make_event(ts, id + i)));
+        }
+    }
+
+    // Reference implementation of the merge: destination events go first on equal timestamps
+    static size_t reference_merge(midi::event_t *dst, const plug::midi_t *a, const plug::midi_t *b, uint32_t offset)
+    {
+        size_t i = 0, j = 0, n = 0;
+        while ((i < a->nEvents) || (j < b->nEvents))
+        {
+            if ((j >= b->nEvents) || ((i < a->nEvents) && (a->vEvents[i].timestamp <= b->vEvents[j].timestamp + offset)))
+                dst[n++]        = a->vEvents[i++];
+            else
+            {
+                dst[n]          = b->vEvents[j++];
+                dst[n++].timestamp += offset;
+            }
+        }
+
+        return n;
+    }
+
+    void check_queue(const plug::midi_t *q, const midi::event_t *expected, size_t count)
+    {
+        UTEST_ASSERT_MSG(q->nEvents == count, "got %d events, expected %d", int(q->nEvents), int(count));
+        for (size_t i=0; i<count; ++i)
+        {
+            const midi::event_t *ev = &q->vEvents[i];
+            UTEST_ASSERT_MSG(ev->timestamp == expected[i].timestamp,
+                "index=%d: timestamp=%d, expected=%d", int(i), int(ev->timestamp), int(expected[i].timestamp));
+            UTEST_ASSERT_MSG(event_id(ev) == event_id(&expected[i]),
+                "index=%d: id=%d, expected=%d", int(i), int(event_id(ev)), int(event_id(&expected[i])));
+        }
+    }
+
+    void test_insert()
+    {
+        printf("Testing ordered insertion\n");
+
+        plug::midi_t *q     = alloc_queue();
+        UTEST_ASSERT(q != NULL);
+        lsp_finally { free(q); };
+
+        // Events with the same timestamp keep the order of insertion
+        static const uint32_t timestamps[] = { 10, 5, 10, 0, 5, 20, 10, 0, 15, 5 };
+        static const size_t order[] = { 3, 7, 1, 4, 9, 0, 2, 6, 8, 5 };
+        for (size_t i=0; i<sizeof(timestamps)/sizeof(timestamps[0]); ++i)
+            UTEST_ASSERT(q->insert(make_event(timestamps[i], i)));
+
+        UTEST_ASSERT(q->nEvents == sizeof(order)/sizeof(order[0]));
+        UTEST_ASSERT(q->is_sorted());
+        for (size_t i=0; i<q->nEvents; ++i)
+        {
+            UTEST_ASSERT_MSG(event_id(&q->vEvents[i]) == order[i], "index=%d", int(i));
+            UTEST_ASSERT(q->vEvents[i].timestamp == timestamps[order[i]]);
+        }
+
+        // Lower bound points to the first event with the same timestamp
+        UTEST_ASSERT(q->lower_bound(0) == 0);
+        UTEST_ASSERT(q->lower_bound(5) == 2);
+        UTEST_ASSERT(q->lower_bound(6) == 5);
+        UTEST_ASSERT(q->lower_bound(10) == 5);
+        UTEST_ASSERT(q->lower_bound(20) == 9);
+        UTEST_ASSERT(q->lower_bound(21) == 10);
+
+        // Random insertion keeps the queue sorted and stable
+        q->clear();
+        for (size_t i=0; i<1000; ++i)
+            UTEST_ASSERT(q->insert(make_event(next_random(64), i)));
+        UTEST_ASSERT(q->nEvents == 1000);
+        for (size_t i=1; i<q->nEvents; ++i)
+        {
+            const midi::event_t *prev = &q->vEvents[i-1];
+            const midi::event_t *curr = &q->vEvents[i];
+            UTEST_ASSERT(prev->timestamp <= curr->timestamp);
+            if (prev->timestamp == curr->timestamp)
+                UTEST_ASSERT(event_id(prev) < event_id(curr));
+        }
+    }
+
+    void test_overflow()
+    {
+        printf("Testing queue overflow\n");
+
+        plug::midi_t *q     = alloc_queue();
+        plug::midi_t *src   = alloc_queue();
+        midi::event_t *ref  = static_cast<midi::event_t *>(malloc(sizeof(midi::event_t) * MIDI_EVENTS_MAX * 2));
+        UTEST_ASSERT((q != NULL) && (src != NULL) && (ref != NULL));
+        lsp_finally {
+            free(q);
+            free(src);
+            free(ref);
+        };
+
+        // Insertion and push into the full queue fail without modification of the queue
+        for (size_t i=0; i<MIDI_EVENTS_MAX; ++i)
+            UTEST_ASSERT(q->insert(make_event(MIDI_EVENTS_MAX - i, i)));
+        UTEST_ASSERT(q->nEvents == MIDI_EVENTS_MAX);
+        UTEST_ASSERT(q->is_sorted());
+        ::memcpy(ref, q->vEvents, sizeof(midi::event_t) * MIDI_EVENTS_MAX);
+
+        UTEST_ASSERT(!q->insert(make_event(0, MIDI_EVENTS_MAX)));
+        UTEST_ASSERT(!q->insert(make_event(MIDI_EVENTS_MAX * 2, MIDI_EVENTS_MAX)));
+        UTEST_ASSERT(!q->push(make_event(MIDI_EVENTS_MAX * 2, MIDI_EVENTS_MAX)));
+        check_queue(q, ref, MIDI_EVENTS_MAX);
+
+        // Merge with overflow drops the latest events, interleaved and appended queues
+        for (size_t k=0; k<2; ++k)
+        {
+            const uint32_t offset = (k > 0) ? MIDI_EVENTS_MAX * 4 : 0;
+
+            q->clear();
+            src->clear();
+            fill_sorted(q, MIDI_EVENTS_MAX - 100, 0, 4, 0);
+            fill_sorted(src, 300, 0, 16, MIDI_EVENTS_MAX);
+
+            const size_t total = reference_merge(ref, q, src, offset);
+            UTEST_ASSERT(total == MIDI_EVENTS_MAX + 200);
+            UTEST_ASSERT(!q->merge_shifted(src, offset));
+            check_queue(q, ref, MIDI_EVENTS_MAX);
+            UTEST_ASSERT(q->is_sorted());
+        }
+
+        // Split into the full queue drops events but advances the cursor
+        q->clear();
+        src->clear();
+        fill_sorted(q, MIDI_EVENTS_MAX - 2, 0, 2, 0);
+        for (size_t i=0; i<5; ++i)
+            UTEST_ASSERT(src->push(make_event(100 + i, MIDI_EVENTS_MAX + i)));
+        UTEST_ASSERT(src->push(make_event(200, MIDI_EVENTS_MAX + 5)));
+        UTEST_ASSERT(q->push_split(src, 0, 100, 200) == 5);
+        UTEST_ASSERT(q->nEvents == MIDI_EVENTS_MAX);
+        UTEST_ASSERT(event_id(&q->vEvents[MIDI_EVENTS_MAX - 2]) == MIDI_EVENTS_MAX);
+        UTEST_ASSERT(event_id(&q->vEvents[MIDI_EVENTS_MAX - 1]) == MIDI_EVENTS_MAX + 1);
+    }
+
+    void test_merge()
+    {
+        printf("Testing merge of sorted queues\n");
+
+        plug::midi_t *q     = alloc_queue();
+        plug::midi_t *src   = alloc_queue();
+        midi::event_t *ref  = static_cast<midi::event_t *>(malloc(sizeof(midi::event_t) * MIDI_EVENTS_MAX * 2));
+        UTEST_ASSERT((q != NULL) && (src != NULL) && (ref != NULL));
+        lsp_finally {
+            free(q);
+            free(src);
+            free(ref);
+        };
+
+        static const uint32_t offsets[] = { 0, 1, 7, 100, 1000, 100000 };
+        for (size_t k=0; k<sizeof(offsets)/sizeof(offsets[0]); ++k)
+        {
+            for (size_t iter=0; iter<20; ++iter)
+            {
+                q->clear();
+                src->clear();
+                fill_sorted(q, next_random(200), next_random(100), 8, 0);
+                fill_sorted(src, next_random(200), next_random(100), 8, 1000);
+
+                const size_t total = reference_merge(ref, q, src, offsets[k]);
+                UTEST_ASSERT(q->merge_shifted(src, offsets[k]));
+                check_queue(q, ref, total);
+                UTEST_ASSERT(q->is_sorted());
+            }
+        }
+
+        // Source events go after the events of the queue with the same timestamp
+        q->clear();
+        src->clear();
+        UTEST_ASSERT(q->push(make_event(10, 0)));
+        UTEST_ASSERT(q->push(make_event(20, 1)));
+        UTEST_ASSERT(q->push(make_event(30, 2)));
+        UTEST_ASSERT(src->push(make_event(0, 3)));
+        UTEST_ASSERT(src->push(make_event(10, 4)));
+        UTEST_ASSERT(src->push(make_event(20, 5)));
+        UTEST_ASSERT(q->merge_shifted(src, 10));
+        {
+            static const size_t ids[] = { 0, 3, 1, 4, 2, 5 };
+            static const uint32_t ts[] = { 10, 10, 20, 20, 30, 30 };
+            UTEST_ASSERT(q->nEvents == 6);
+            for (size_t i=0; i<6; ++i)
+            {
+                UTEST_ASSERT_MSG(event_id(&q->vEvents[i]) == ids[i], "index=%d", int(i));
+                UTEST_ASSERT_MSG(q->vEvents[i].timestamp == ts[i], "index=%d", int(i));
+            }
+        }
+
+        // Merge with empty queues
+        q->clear();
+        src->clear();
+        UTEST_ASSERT(q->merge(src));
+        UTEST_ASSERT(q->nEvents == 0);
+        fill_sorted(src, 10, 0, 4, 0);
+        UTEST_ASSERT(q->merge(src));
+        check_queue(q, src->vEvents, 10);
+        src->clear();
+        UTEST_ASSERT(q->merge(src));
+        UTEST_ASSERT(q->nEvents == 10);
+    }
+
+    void test_push_split()
+    {
+        printf("Testing split of the queue into blocks\n");
+
+        plug::midi_t *src   = alloc_queue();
+        plug::midi_t *dst   = alloc_queue();
+        UTEST_ASSERT((src != NULL) && (dst != NULL));
+        lsp_finally {
+            free(src);
+            free(dst);
+        };
+
+        static const uint32_t blocks[] = { 1, 7, 16, 64, 1000 };
+        for (size_t k=0; k<sizeof(blocks)/sizeof(blocks[0]); ++k)
+        {
+            const uint32_t block = blocks[k];
+
+            // Events share timestamps, some of them lie exactly at the block boundaries
+            src->clear();
+            fill_sorted(src, 500, 0, 3, 0);
+            UTEST_ASSERT(src->push(make_event(src->vEvents[src->nEvents - 1].timestamp, 500)));
+            const uint32_t length   = src->vEvents[src->nEvents - 1].timestamp + 1;
+
+            size_t cursor = 0, count = 0;
+            for (uint32_t start = 0; start < length; start += block)
+            {
+                const uint32_t end  = start + block;
+
+                dst->clear();
+                cursor              = dst->push_split(src, cursor, start, end);
+                UTEST_ASSERT_MSG(cursor == src->lower_bound(end), "block=%d, start=%d", int(block), int(start));
+
+                // Block contains all events from the range with timestamps relative to the block
+                const size_t first  = src->lower_bound(start);
+                UTEST_ASSERT(dst->nEvents == cursor - first);
+                for (size_t i=0; i<dst->nEvents; ++i)
+                {
+                    const midi::event_t *se = &src->vEvents[first + i];
+                    const midi::event_t *de = &dst->vEvents[i];
+                    UTEST_ASSERT(de->timestamp == se->timestamp - start);
+                    UTEST_ASSERT(de->timestamp < block);
+                    UTEST_ASSERT(event_id(de) == event_id(se));
+                }
+                count              += dst->nEvents;
+            }
+
+            UTEST_ASSERT(cursor == src->nEvents);
+            UTEST_ASSERT(count == src->nEvents);
+
+            // Nothing is added after the end of the queue
+            dst->clear();
+            UTEST_ASSERT(dst->push_split(src, cursor, length, length + block) == cursor);
+            UTEST_ASSERT(dst->nEvents == 0);
+        }
+
+        // Events before the start of the block are placed at the beginning of the block
+        src->clear();
+        UTEST_ASSERT(src->push(make_event(5, 0)));
+        UTEST_ASSERT(src->push(make_event(12, 1)));
+        UTEST_ASSERT(src->push(make_event(20, 2)));
+        dst->clear();
+        UTEST_ASSERT(dst->push_split(src, 0, 10, 20) == 2);
+        UTEST_ASSERT(dst->nEvents == 2);
+        UTEST_ASSERT(dst->vEvents[0].timestamp == 0);
+        UTEST_ASSERT(dst->vEvents[1].timestamp == 2);
+        UTEST_ASSERT(dst->push_split(src, 2, 20, 20) == 2);
+        UTEST_ASSERT(dst->nEvents == 2);
+    }
+
+    UTEST_MAIN
+    {
+        nSeed       = 0x12345678;
+
+        test_insert();
+        test_overflow();
+        test_merge();
+        test_push_split();
+    }
+
+UTEST_END
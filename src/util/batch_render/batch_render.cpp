@@ -0,0 +1,443 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/dsp-units/units.h>
+#include <lsp-plug.in/io/Path.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/lltl/parray.h>
+#include <lsp-plug.in/mm/InAudioFileStream.h>
+#include <lsp-plug.in/mm/OutAudioFileStream.h>
+#include <lsp-plug.in/plug-fw/core/Resources.h>
+#include <lsp-plug.in/plug-fw/meta/manifest.h>
+#include <lsp-plug.in/plug-fw/plug.h>
+#include <lsp-plug.in/plug-fw/util/batch_render/batch_render.h>
+#include <lsp-plug.in/plug-fw/util/offline/offline.h>
+#include <lsp-plug.in/runtime/system.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <errno.h>
+#include <stdlib.h>
+
+namespace lsp
+{
+    namespace batch_render
+    {
+        static constexpr size_t BLOCK_SIZE_DFL      = 8192;     // Default processing block size
+        static constexpr size_t BLOCK_SIZE_MAX      = 0x100000; // Maximum processing block size
+
+        typedef struct cmdline_t
+        {
+            const char                 *plugin_id;  // Plugin identifier
+            const char                 *config;     // Configuration file to import
+            const char                 *out_dir;    // Output directory
+            size_t                      block_size; // Processing block size
+            size_t                      jobs;       // Number of parallel jobs
+            size_t                      rate;       // Required sample rate of input files, 0 for any
+            float                       tail;       // Tail length in seconds, negative for plugin's tail
+            bool                        list;       // List available plugins
+            lltl::parray<char>          files;      // List of input files
+        } cmdline_t;
+
+        typedef struct context_t
+        {
+            const cmdline_t            *cmd;        // Command line
+            const meta::package_t      *package;    // Package manifest
+            plug::Factory              *factory;    // Plugin factory
+            const meta::plugin_t       *meta;       // Plugin metadata
+            uatomic_t                   next;       // Next file to process
+            uatomic_t                   errors;     // Number of errors
+        } context_t;
+
+        static status_t parse_cmdline(cmdline_t *cfg, int argc, const char **argv)
+        {
+            cfg->plugin_id      = NULL;
+            cfg->config         = NULL;
+            cfg->out_dir        = NULL;
+            cfg->block_size     = BLOCK_SIZE_DFL;
+            cfg->jobs           = ipc::Thread::system_cores();
+            cfg->rate           = 0;
+            cfg->tail           = -1.0f;
+            cfg->list           = false;
+
+            // Parse arguments
+            int i = 1;
+
+            while (i < argc)
+            {
+                const char *arg = argv[i++];
+                if ((!::strcmp(arg, "--help")) || (!::strcmp(arg, "-h")))
+                {
+                    printf("Usage: %s [parameters] [input-files]\n\n", argv[0]);
+                    printf("Available parameters:\n");
+                    printf("  -b, --block <samples>         Size of processing block in samples (default %d)\n", int(BLOCK_SIZE_DFL));
+                    printf("  -c, --config <file>           Configuration file to import into the plugin\n");
+                    printf("  -h, --help                    Show help\n");
+                    printf("  -j, --jobs <count>            Number of files processed in parallel (default: number of cores)\n");
+                    printf("  -l, --list                    List available plugins\n");
+                    printf("  -o, --output <dir>            Directory to store processed files\n");
+                    printf("  -p, --plugin <id>             Identifier of the plugin\n");
+                    printf("  -r, --rate <hz>               Reject input files with sample rate other than specified\n");
+                    printf("  -t, --tail <seconds>          Length of tail rendered after the end of input (default: plugin's tail)\n");
+                    printf("\n");
+
+                    return STATUS_CANCELLED;
+                }
+                else if ((!::strcmp(arg, "--list")) || (!::strcmp(arg, "-l")))
+                    cfg->list       = true;
+                else if ((!::strcmp(arg, "--plugin")) || (!::strcmp(arg, "-p")) ||
+                         (!::strcmp(arg, "--config")) || (!::strcmp(arg, "-c")) ||
+                         (!::strcmp(arg, "--output")) || (!::strcmp(arg, "-o")))
+                {
+                    if (i >= argc)
+                    {
+                        fprintf(stderr, "Not specified value for '%s' parameter\n", arg);
+                        return STATUS_BAD_ARGUMENTS;
+                    }
+
+                    const char **dst    =
+                        ((!::strcmp(arg, "--plugin")) || (!::strcmp(arg, "-p"))) ? &cfg->plugin_id :
+                        ((!::strcmp(arg, "--config")) || (!::strcmp(arg, "-c"))) ? &cfg->config :
+                        &cfg->out_dir;
+                    if (*dst != NULL)
+                    {
+                        fprintf(stderr, "Duplicate parameter '%s'\n", arg);
+                        return STATUS_BAD_ARGUMENTS;
+                    }
+                    *dst            = argv[i++];
+                }
+                else if ((!::strcmp(arg, "--block")) || (!::strcmp(arg, "-b")) ||
+                         (!::strcmp(arg, "--jobs")) || (!::strcmp(arg, "-j")) ||
+                         (!::strcmp(arg, "--rate")) || (!::strcmp(arg, "-r")))
+                {
+                    if (i >= argc)
+                    {
+                        fprintf(stderr, "Not specified value for '%s' parameter\n", arg);
+                        return STATUS_BAD_ARGUMENTS;
+                    }
+
+                    char *end           = NULL;
+                    errno               = 0;
+                    const long value    = ::strtol(argv[i], &end, 10);
+                    if ((errno != 0) || (*end != '\0') || (value <= 0))
+                    {
+                        fprintf(stderr, "Invalid value '%s' for '%s' parameter\n", argv[i], arg);
+                        return STATUS_BAD_ARGUMENTS;
+                    }
+                    ++i;
+
+                    if ((!::strcmp(arg, "--block")) || (!::strcmp(arg, "-b")))
+                        cfg->block_size     = lsp_min(size_t(value), BLOCK_SIZE_MAX);
+                    else if ((!::strcmp(arg, "--jobs")) || (!::strcmp(arg, "-j")))
+                        cfg->jobs           = value;
+                    else
+                        cfg->rate           = value;
+                }
+                else if ((!::strcmp(arg, "--tail")) || (!::strcmp(arg, "-t")))
+                {
+                    if (i >= argc)
+                    {
+                        fprintf(stderr, "Not specified value for '%s' parameter\n", arg);
+                        return STATUS_BAD_ARGUMENTS;
+                    }
+
+                    char *end           = NULL;
+                    errno               = 0;
+                    const float value   = ::strtof(argv[i], &end);
+                    if ((errno != 0) || (*end != '\0') || (value < 0.0f))
+                    {
+                        fprintf(stderr, "Invalid value '%s' for '%s' parameter\n", argv[i], arg);
+                        return STATUS_BAD_ARGUMENTS;
+                    }
+                    ++i;
+                    cfg->tail           = value;
+                }
+                else if (arg[0] == '-')
+                {
+                    fprintf(stderr, "Unknown argument '%s'\n", arg);
+                    return STATUS_BAD_ARGUMENTS;
+                }
+                else if (!cfg->files.add(const_cast<char *>(arg)))
+                    return STATUS_NO_MEM;
+            }
+
+            if (cfg->list)
+                return STATUS_OK;
+
+            // Validate arguments
+            if (cfg->plugin_id == NULL)
+            {
+                fprintf(stderr, "Plugin identifier is not specified\n");
+                return STATUS_BAD_ARGUMENTS;
+            }
+            if (cfg->out_dir == NULL)
+            {
+                fprintf(stderr, "Output directory is not specified\n");
+                return STATUS_BAD_ARGUMENTS;
+            }
+
+            return STATUS_OK;
+        }
+
+        static void list_plugins()
+        {
+            for (plug::Factory *f = plug::Factory::root(); f != NULL; f = f->next())
+            {
+                for (size_t i=0; ; ++i)
+                {
+                    const meta::plugin_t *meta = f->enumerate(i);
+                    if (meta == NULL)
+                        break;
+                    printf("%-32s %s\n", meta->uid, meta->description);
+                }
+            }
+        }
+
+        static const meta::plugin_t *find_plugin(plug::Factory **factory, const char *id)
+        {
+            for (plug::Factory *f = plug::Factory::root(); f != NULL; f = f->next())
+            {
+                for (size_t i=0; ; ++i)
+                {
+                    const meta::plugin_t *meta = f->enumerate(i);
+                    if (meta == NULL)
+                        break;
+                    if (!::strcmp(meta->uid, id))
+                    {
+                        *factory    = f;
+                        return meta;
+                    }
+                }
+            }
+
+            return NULL;
+        }
+
+        static status_t render_file(context_t *ctx, const char *file)
+        {
+            const cmdline_t *cmd = ctx->cmd;
+            status_t res;
+
+            // Compute the name of the output file
+            io::Path path;
+            LSPString name;
+            if ((res = path.set(file)) != STATUS_OK)
+                return res;
+            if ((res = path.get_last_noext(&name)) != STATUS_OK)
+                return res;
+            if (!name.append_ascii(".wav"))
+                return STATUS_NO_MEM;
+            if ((res = path.set(cmd->out_dir)) != STATUS_OK)
+                return res;
+            if ((res = path.append_child(&name)) != STATUS_OK)
+                return res;
+
+            // Open the input file
+            mm::InAudioFileStream is;
+            mm::audio_stream_t in_fmt;
+            if ((res = is.open(file)) != STATUS_OK)
+                return res;
+            lsp_finally {
+                is.close();
+            };
+            if ((res = is.info(&in_fmt)) != STATUS_OK)
+                return res;
+            if ((cmd->rate > 0) && (in_fmt.srate != cmd->rate))
+            {
+                fprintf(stderr, "Sample rate of file '%s' is %d Hz, expected %d Hz\n",
+                    file, int(in_fmt.srate), int(cmd->rate));
+                return STATUS_BAD_FORMAT;
+            }
+
+            // Create plugin and it's host
+            resource::ILoader *loader   = core::create_resource_loader();
+            if (loader == NULL)
+                return STATUS_BAD_STATE;
+            lsp_finally {
+                delete loader;
+            };
+
+            plug::Module *plugin        = ctx->factory->create(ctx->meta);
+            if (plugin == NULL)
+                return STATUS_NO_MEM;
+            offline::Wrapper wrapper(plugin, loader, ctx->package);
+
+            if ((res = wrapper.init(in_fmt.srate, cmd->block_size)) != STATUS_OK)
+                return res;
+            if (cmd->config != NULL)
+            {
+                if ((res = wrapper.import_settings(cmd->config)) != STATUS_OK)
+                    return res;
+            }
+            wrapper.warm_up();
+
+            // Render the output directly into the file
+            size_t tail = 0;
+            if (cmd->tail >= 0.0f)
+                tail    = dspu::seconds_to_samples(in_fmt.srate, cmd->tail);
+            else if (plugin->tail_size() > 0)
+                tail    = plugin->tail_size();
+
+            mm::OutAudioFileStream os;
+            mm::audio_stream_t out_fmt;
+            out_fmt.srate       = in_fmt.srate;
+            out_fmt.channels    = wrapper.audio_outputs();
+            out_fmt.frames      = (in_fmt.frames >= 0) ? in_fmt.frames + tail : -1;
+            out_fmt.format      = mm::SFMT_F32;
+
+            if ((res = os.open(&path, &out_fmt, mm::AFMT_WAV | mm::CFMT_PCM)) != STATUS_OK)
+                return res;
+            res                 = wrapper.render(&os, &is, tail);
+            const status_t res2 = os.close();
+            if (res == STATUS_OK)
+                res                 = res2;
+            wrapper.destroy();
+            if (res != STATUS_OK)
+            {
+                path.remove();
+                return res;
+            }
+
+            printf("  %s -> %s\n", file, path.as_native());
+            return STATUS_OK;
+        }
+
+        static status_t render_thread(void *arg)
+        {
+            context_t *ctx = static_cast<context_t *>(arg);
+            const cmdline_t *cmd = ctx->cmd;
+
+            dsp::context_t dctx;
+            dsp::start(&dctx);
+            lsp_finally { dsp::finish(&dctx); };
+
+            while (true)
+            {
+                const size_t index  = atomic_add(&ctx->next, 1);
+                if (index >= cmd->files.size())
+                    break;
+
+                const char *file    = cmd->files.uget(index);
+                const status_t res  = render_file(ctx, file);
+                if (res != STATUS_OK)
+                {
+                    fprintf(stderr, "Error processing file '%s': %s\n", file, get_status(res));
+                    atomic_add(&ctx->errors, 1);
+                }
+            }
+
+            return STATUS_OK;
+        }
+
+        int main(int argc, const char **argv)
+        {
+            // Parse command line options
+            cmdline_t cmd;
+            status_t res = parse_cmdline(&cmd, argc, argv);
+            if (res != STATUS_OK)
+                return res;
+
+            dsp::init();
+
+            if (cmd.list)
+            {
+                list_plugins();
+                return STATUS_OK;
+            }
+
+            // Find the plugin
+            context_t ctx;
+            ctx.cmd         = &cmd;
+            ctx.package     = NULL;
+            ctx.factory     = NULL;
+            ctx.meta        = find_plugin(&ctx.factory, cmd.plugin_id);
+            atomic_store(&ctx.next, 0);
+            atomic_store(&ctx.errors, 0);
+            if (ctx.meta == NULL)
+            {
+                fprintf(stderr, "Plugin '%s' not found\n", cmd.plugin_id);
+                return STATUS_NOT_FOUND;
+            }
+            if (!offline::supported(ctx.meta))
+            {
+                fprintf(stderr, "Plugin '%s' has port types not supported by the offline host\n", cmd.plugin_id);
+                return STATUS_NOT_SUPPORTED;
+            }
+
+            // Load package manifest
+            meta::package_t *manifest = NULL;
+            if ((res = offline::load_package(&manifest)) != STATUS_OK)
+            {
+                fprintf(stderr, "Error loading manifest file, error=%d\n", int(res));
+                return res;
+            }
+            lsp_finally {
+                meta::free_manifest(manifest);
+            };
+            ctx.package     = manifest;
+
+            // Launch processing threads
+            const size_t jobs   = lsp_max(lsp_min(cmd.jobs, cmd.files.size()), size_t(1));
+            lltl::parray<ipc::Thread> threads;
+            lsp_finally {
+                for (size_t i=0, n=threads.size(); i<n; ++i)
+                {
+                    ipc::Thread *t = threads.uget(i);
+                    t->join();
+                    delete t;
+                }
+                threads.flush();
+            };
+
+            printf("Rendering %d files using %d jobs...\n", int(cmd.files.size()), int(jobs));
+            const system::time_millis_t start = system::get_time_millis();
+
+            for (size_t i=0; i<jobs; ++i)
+            {
+                ipc::Thread *t = new ipc::Thread(render_thread, &ctx);
+                if (t == NULL)
+                    return STATUS_NO_MEM;
+                if (!threads.add(t))
+                {
+                    delete t;
+                    return STATUS_NO_MEM;
+                }
+                if ((res = t->start()) != STATUS_OK)
+                    return res;
+            }
+
+            // Wait for threads
+            for (size_t i=0, n=threads.size(); i<n; ++i)
+                threads.uget(i)->join();
+
+            const size_t errors = atomic_load(&ctx.errors);
+            printf("Rendered %d files in %d ms, %d errors\n",
+                int(cmd.files.size() - errors), int(system::get_time_millis() - start), int(errors));
+
+            return (errors > 0) ? STATUS_FAILED : STATUS_OK;
+        }
+
+    } /* namespace batch_render */
+} /* namespace lsp */
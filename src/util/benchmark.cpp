@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <lsp-plug.in/plug-fw/util/benchmark/benchmark.h>
+
+#ifndef LSP_IDE_DEBUG
+
+#include <stdlib.h>
+
+// The __GLIBC__ macro is defined by <stdlib.h>. Other C libraries, including uClibc which
+// pretends to be GNU libc, do not export the __libc_* entry points, so allocations are not tracked
+#if defined(__GLIBC__) && !defined(__UCLIBC__)
+// Count allocations by interposing the allocation functions of the C library
+extern "C"
+{
+    extern void *__libc_malloc(size_t size);
+    extern void *__libc_calloc(size_t nmemb, size_t size);
+    extern void *__libc_realloc(void *ptr, size_t size);
+
+    void *malloc(size_t size)
+    {
+        lsp::benchmark::on_allocate();
+        return __libc_malloc(size);
+    }
+
+    void *calloc(size_t nmemb, size_t size)
+    {
+        lsp::benchmark::on_allocate();
+        return __libc_calloc(nmemb, size);
+    }
+
+    void *realloc(void *ptr, size_t size)
+    {
+        lsp::benchmark::on_allocate();
+        return __libc_realloc(ptr, size);
+    }
+}
+#endif /* __GLIBC__, __UCLIBC__ */
+
+int main(int argc, const char **argv)
+{
+    return lsp::benchmark::main(argc, argv);
+}
+#endif /* LSP_IDE_DEBUG */
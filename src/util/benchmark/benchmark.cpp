@@ -0,0 +1,564 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/dsp-units/units.h>
+#include <lsp-plug.in/fmt/json/Serializer.h>
+#include <lsp-plug.in/lltl/darray.h>
+#include <lsp-plug.in/lltl/parray.h>
+#include <lsp-plug.in/plug-fw/const.h>
+#include <lsp-plug.in/plug-fw/core/DspProfiler.h>
+#include <lsp-plug.in/plug-fw/core/Resources.h>
+#include <lsp-plug.in/plug-fw/meta/func.h>
+#include <lsp-plug.in/plug-fw/util/benchmark/benchmark.h>
+#include <lsp-plug.in/plug-fw/util/offline/offline.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <errno.h>
+#include <stdlib.h>
+
+namespace lsp
+{
+    namespace benchmark
+    {
+        static constexpr size_t BLOCK_SIZE_MAX      = 0x100000; // Maximum processing block size
+        static constexpr float  DURATION_DFL        = 2.0f;     // Default duration of processed audio per measurement, seconds
+        static constexpr size_t SEED_DFL            = 0x1234abcd; // Default seed of the random generator
+
+        static const size_t sample_rates_dfl[]      = { 44100, 48000, 96000, 0 };
+        static const size_t block_sizes_dfl[]       = { 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192, 0 };
+
+        static uatomic_t alloc_count                = 0;
+        static uatomic_t alloc_hooks                = 0;
+
+        typedef struct cmdline_t
+        {
+            const char                 *out_file;   // Output file
+            float                       duration;   // Duration of processed audio, seconds
+            uint32_t                    seed;       // Seed of the random generator
+            bool                        list;       // List available plugins
+            lltl::parray<char>          plugins;    // List of plugin identifiers
+            lltl::darray<size_t>        rates;      // List of sample rates
+            lltl::darray<size_t>        blocks;     // List of block sizes
+        } cmdline_t;
+
+        typedef struct result_t
+        {
+            const meta::plugin_t       *meta;       // Plugin metadata
+            size_t                      rate;       // Sample rate
+            size_t                      block;      // Block size
+            wsize_t                     samples;    // Number of processed samples
+            uint64_t                    time;       // Processing time, nanoseconds
+            ssize_t                     allocs;     // Number of allocations while processing, negative if not tracked
+        } result_t;
+
+        typedef struct random_t
+        {
+            uint32_t                    state;      // State of the xorshift generator
+        } random_t;
+
+        void on_allocate()
+        {
+            atomic_store(&alloc_hooks, 1);
+            atomic_add(&alloc_count, 1);
+        }
+
+        // Own generator keeps the sequence independent of library versions,
+        // so results of different versions can be compared
+        static float next_random(random_t *rnd)
+        {
+            uint32_t x      = rnd->state;
+            x              ^= x << 13;
+            x              ^= x >> 17;
+            x              ^= x << 5;
+            rnd->state      = x;
+
+            return float(x >> 8) / float(1 << 24);
+        }
+
+        static status_t parse_list(lltl::darray<size_t> *dst, const char *arg, const char *value, size_t max)
+        {
+            for (const char *s = value; ; )
+            {
+                char *end           = NULL;
+                errno               = 0;
+                const long item     = ::strtol(s, &end, 10);
+                if ((errno != 0) || (end == s) || (item <= 0) || (size_t(item) > max) ||
+                    ((*end != ',') && (*end != '\0')))
+                {
+                    fprintf(stderr, "Invalid value '%s' for '%s' parameter\n", value, arg);
+                    return STATUS_BAD_ARGUMENTS;
+                }
+
+                const size_t v      = item;
+                if (!dst->add(&v))
+                    return STATUS_NO_MEM;
+                if (*end == '\0')
+                    break;
+                s                   = end + 1;
+            }
+
+            return STATUS_OK;
+        }
+
+        static status_t parse_cmdline(cmdline_t *cfg, int argc, const char **argv)
+        {
+            status_t res;
+
+            cfg->out_file       = NULL;
+            cfg->duration       = DURATION_DFL;
+            cfg->seed           = SEED_DFL;
+            cfg->list           = false;
+
+            // Parse arguments
+            int i = 1;
+
+            while (i < argc)
+            {
+                const char *arg = argv[i++];
+                if ((!::strcmp(arg, "--help")) || (!::strcmp(arg, "-h")))
+                {
+                    printf("Usage: %s [parameters] [plugin-ids]\n\n", argv[0]);
+                    printf("Measures processing throughput of all plugins in the package or plugins\n");
+                    printf("with specified identifiers.\n\n");
+                    printf("Available parameters:\n");
+                    printf("  -b, --blocks <list>           Comma-separated list of block sizes (default 32,64,...,8192)\n");
+                    printf("  -d, --duration <seconds>      Duration of audio processed per measurement (default %.1f)\n", DURATION_DFL);
+                    printf("  -h, --help                    Show help\n");
+                    printf("  -l, --list                    List available plugins\n");
+                    printf("  -o, --output <file>           Output file, JSON if the extension is .json, CSV otherwise\n");
+                    printf("  -r, --rates <list>            Comma-separated list of sample rates (default 44100,48000,96000)\n");
+                    printf("  -s, --seed <value>            Seed for randomization of input data and parameters\n");
+                    printf("\n");
+
+                    return STATUS_CANCELLED;
+                }
+                else if ((!::strcmp(arg, "--list")) || (!::strcmp(arg, "-l")))
+                    cfg->list       = true;
+                else if ((!::strcmp(arg, "--output")) || (!::strcmp(arg, "-o")))
+                {
+                    if (i >= argc)
+                    {
+                        fprintf(stderr, "Not specified value for '%s' parameter\n", arg);
+                        return STATUS_BAD_ARGUMENTS;
+                    }
+                    if (cfg->out_file != NULL)
+                    {
+                        fprintf(stderr, "Duplicate parameter '%s'\n", arg);
+                        return STATUS_BAD_ARGUMENTS;
+                    }
+                    cfg->out_file   = argv[i++];
+                }
+                else if ((!::strcmp(arg, "--blocks")) || (!::strcmp(arg, "-b")) ||
+                         (!::strcmp(arg, "--rates")) || (!::strcmp(arg, "-r")))
+                {
+                    if (i >= argc)
+                    {
+                        fprintf(stderr, "Not specified value for '%s' parameter\n", arg);
+                        return STATUS_BAD_ARGUMENTS;
+                    }
+
+                    res = ((!::strcmp(arg, "--blocks")) || (!::strcmp(arg, "-b"))) ?
+                        parse_list(&cfg->blocks, arg, argv[i++], BLOCK_SIZE_MAX) :
+                        parse_list(&cfg->rates, arg, argv[i++], MAX_SAMPLE_RATE);
+                    if (res != STATUS_OK)
+                        return res;
+                }
+                else if ((!::strcmp(arg, "--duration")) || (!::strcmp(arg, "-d")))
+                {
+                    if (i >= argc)
+                    {
+                        fprintf(stderr, "Not specified value for '%s' parameter\n", arg);
+                        return STATUS_BAD_ARGUMENTS;
+                    }
+
+                    char *end           = NULL;
+                    errno               = 0;
+                    const float value   = ::strtof(argv[i], &end);
+                    if ((errno != 0) || (*end != '\0') || (value <= 0.0f))
+                    {
+                        fprintf(stderr, "Invalid value '%s' for '%s' parameter\n", argv[i], arg);
+                        return STATUS_BAD_ARGUMENTS;
+                    }
+                    ++i;
+                    cfg->duration       = value;
+                }
+                else if ((!::strcmp(arg, "--seed")) || (!::strcmp(arg, "-s")))
+                {
+                    if (i >= argc)
+                    {
+                        fprintf(stderr, "Not specified value for '%s' parameter\n", arg);
+                        return STATUS_BAD_ARGUMENTS;
+                    }
+
+                    char *end           = NULL;
+                    errno               = 0;
+                    const unsigned long value = ::strtoul(argv[i], &end, 0);
+                    if ((errno != 0) || (*end != '\0'))
+                    {
+                        fprintf(stderr, "Invalid value '%s' for '%s' parameter\n", argv[i], arg);
+                        return STATUS_BAD_ARGUMENTS;
+                    }
+                    ++i;
+                    cfg->seed           = (value != 0) ? uint32_t(value) : SEED_DFL; // Zero state is not allowed
+                }
+                else if (arg[0] == '-')
+                {
+                    fprintf(stderr, "Unknown argument '%s'\n", arg);
+                    return STATUS_BAD_ARGUMENTS;
+                }
+                else if (!cfg->plugins.add(const_cast<char *>(arg)))
+                    return STATUS_NO_MEM;
+            }
+
+            // Apply defaults
+            if (cfg->rates.is_empty())
+            {
+                for (const size_t *v = sample_rates_dfl; *v > 0; ++v)
+                    if (!cfg->rates.add(v))
+                        return STATUS_NO_MEM;
+            }
+            if (cfg->blocks.is_empty())
+            {
+                for (const size_t *v = block_sizes_dfl; *v > 0; ++v)
+                    if (!cfg->blocks.add(v))
+                        return STATUS_NO_MEM;
+            }
+
+            return STATUS_OK;
+        }
+
+        static void list_plugins()
+        {
+            for (plug::Factory *f = plug::Factory::root(); f != NULL; f = f->next())
+            {
+                for (size_t i=0; ; ++i)
+                {
+                    const meta::plugin_t *meta = f->enumerate(i);
+                    if (meta == NULL)
+                        break;
+                    printf("%-32s %s\n", meta->uid, meta->description);
+                }
+            }
+        }
+
+        static bool plugin_selected(const cmdline_t *cmd, const meta::plugin_t *meta)
+        {
+            if (cmd->plugins.is_empty())
+                return true;
+
+            for (size_t i=0, n=cmd->plugins.size(); i<n; ++i)
+            {
+                if (!::strcmp(cmd->plugins.uget(i), meta->uid))
+                    return true;
+            }
+
+            return false;
+        }
+
+        static void randomize_parameters(offline::Wrapper *wrapper, random_t *rnd)
+        {
+            float min, max, step;
+
+            for (size_t i=0, n=wrapper->ports(); i<n; ++i)
+            {
+                offline::Port *p            = wrapper->port(i);
+                const meta::port_t *meta    = p->metadata();
+
+                // Bypass is kept at the default value to measure the actual processing
+                if ((!meta::is_in_port(meta)) || (!meta::is_control_port(meta)))
+                    continue;
+
+                meta::get_port_parameters(meta, &min, &max, &step);
+                float value     = min + (max - min) * next_random(rnd);
+                if ((meta->unit == meta::U_BOOL) || (meta->unit == meta::U_ENUM) ||
+                    (meta->unit == meta::U_SAMPLES) || (meta->flags & meta::F_INT))
+                    value           = min + roundf((value - min) / step) * step;
+
+                p->set_value(value);
+            }
+        }
+
+        static status_t run_benchmark(result_t *result, plug::Factory *factory, const meta::package_t *package, const cmdline_t *cmd)
+        {
+            status_t res;
+            random_t rnd;
+            rnd.state       = cmd->seed;
+
+            // Create plugin and it's host
+            resource::ILoader *loader   = core::create_resource_loader();
+            if (loader == NULL)
+                return STATUS_BAD_STATE;
+            lsp_finally {
+                delete loader;
+            };
+
+            plug::Module *plugin        = factory->create(result->meta);
+            if (plugin == NULL)
+                return STATUS_NO_MEM;
+            offline::Wrapper wrapper(plugin, loader, package);
+
+            if ((res = wrapper.init(result->rate, result->block)) != STATUS_OK)
+                return res;
+            randomize_parameters(&wrapper, &rnd);
+            wrapper.warm_up();
+
+            // Fill inputs with white noise
+            for (size_t i=0, n=wrapper.audio_inputs(); i<n; ++i)
+            {
+                float *buf      = static_cast<float *>(wrapper.audio_input(i)->buffer());
+                for (size_t j=0; j<result->block; ++j)
+                    buf[j]          = next_random(&rnd) * 2.0f - 1.0f;
+            }
+
+            // Measure the processing
+            const size_t samples    = dspu::seconds_to_samples(result->rate, cmd->duration);
+            const size_t blocks     = lsp_max(samples / result->block, size_t(1));
+            const uatomic_t allocs  = atomic_load(&alloc_count);
+
+            const uint64_t ts       = core::DspProfiler::timestamp();
+            for (size_t i=0; i<blocks; ++i)
+                wrapper.process_block(result->block);
+            const uint64_t te       = core::DspProfiler::timestamp();
+
+            result->samples         = wsize_t(blocks) * result->block;
+            result->time            = te - ts;
+            result->allocs          = (atomic_load(&alloc_hooks)) ? ssize_t(atomic_load(&alloc_count) - allocs) : -1;
+
+            wrapper.destroy();
+
+            return STATUS_OK;
+        }
+
+        static inline double samples_per_second(const result_t *r)
+        {
+            return (r->time > 0) ? double(r->samples) * 1e+9 / double(r->time) : 0.0;
+        }
+
+        static inline double ns_per_sample(const result_t *r)
+        {
+            return (r->samples > 0) ? double(r->time) / double(r->samples) : 0.0;
+        }
+
+        static inline double realtime_factor(const result_t *r)
+        {
+            return samples_per_second(r) / double(r->rate);
+        }
+
+        static status_t save_csv(const char *path, const lltl::darray<result_t> *results)
+        {
+            FILE *fd = fopen(path, "w");
+            if (fd == NULL)
+                return STATUS_IO_ERROR;
+
+            fprintf(fd, "plugin,version,sample_rate,block_size,samples,time_ns,samples_per_sec,ns_per_sample,realtime_factor,allocations\n");
+            for (size_t i=0, n=results->size(); i<n; ++i)
+            {
+                const result_t *r           = results->uget(i);
+                const meta::module_version_t *v = &r->meta->version;
+
+                fprintf(fd, "%s,%d.%d.%d,%d,%d,%llu,%llu,%.1f,%.3f,%.3f,%ld\n",
+                    r->meta->uid, int(v->major), int(v->minor), int(v->micro),
+                    int(r->rate), int(r->block),
+                    (unsigned long long)(r->samples), (unsigned long long)(r->time),
+                    samples_per_second(r), ns_per_sample(r), realtime_factor(r),
+                    long(r->allocs));
+            }
+
+            return (fclose(fd) == 0) ? STATUS_OK : STATUS_IO_ERROR;
+        }
+
+        static status_t save_json(const char *path, const meta::package_t *package, const lltl::darray<result_t> *results)
+        {
+            status_t res;
+            json::Serializer s;
+            json::serial_flags_t flags;
+
+            flags.version       = json::JSON_LEGACY;
+            flags.identifiers   = false;
+            flags.ident         = ' ';
+            flags.padding       = 4;
+            flags.separator     = true;
+            flags.multiline     = true;
+
+            if ((res = s.open(path, &flags)) != STATUS_OK)
+                return res;
+
+            char buf[32];
+            s.start_object();
+            {
+                snprintf(buf, sizeof(buf), "%d.%d.%d",
+                    int(package->version.major), int(package->version.minor), int(package->version.micro));
+                s.write_property("package");
+                s.write_string(package->artifact);
+                s.write_property("version");
+                s.write_string(buf);
+
+                s.write_property("results");
+                s.start_array();
+                for (size_t i=0, n=results->size(); i<n; ++i)
+                {
+                    const result_t *r           = results->uget(i);
+                    const meta::module_version_t *v = &r->meta->version;
+                    snprintf(buf, sizeof(buf), "%d.%d.%d", int(v->major), int(v->minor), int(v->micro));
+
+                    s.start_object();
+                    {
+                        s.write_property("plugin");
+                        s.write_string(r->meta->uid);
+                        s.write_property("version");
+                        s.write_string(buf);
+                        s.write_property("sample_rate");
+                        s.write_int(r->rate);
+                        s.write_property("block_size");
+                        s.write_int(r->block);
+                        s.write_property("samples");
+                        s.write_int(r->samples);
+                        s.write_property("time_ns");
+                        s.write_int(r->time);
+                        s.write_property("samples_per_sec");
+                        s.write_double(samples_per_second(r), "%.1f");
+                        s.write_property("ns_per_sample");
+                        s.write_double(ns_per_sample(r), "%.3f");
+                        s.write_property("realtime_factor");
+                        s.write_double(realtime_factor(r), "%.3f");
+                        s.write_property("allocations");
+                        s.write_int(r->allocs);
+                    }
+                    s.end_object();
+                }
+                s.end_array();
+            }
+            s.end_object();
+
+            return s.close();
+        }
+
+        int main(int argc, const char **argv)
+        {
+            // Parse command line options
+            cmdline_t cmd;
+            status_t res = parse_cmdline(&cmd, argc, argv);
+            if (res != STATUS_OK)
+                return res;
+
+            dsp::init();
+
+            if (cmd.list)
+            {
+                list_plugins();
+                return STATUS_OK;
+            }
+
+            // Load package manifest
+            meta::package_t *manifest = NULL;
+            if ((res = offline::load_package(&manifest)) != STATUS_OK)
+            {
+                fprintf(stderr, "Error loading manifest file, error=%d\n", int(res));
+                return res;
+            }
+            lsp_finally {
+                meta::free_manifest(manifest);
+            };
+
+            dsp::context_t dctx;
+            dsp::start(&dctx);
+            lsp_finally { dsp::finish(&dctx); };
+
+            // Run benchmarks
+            lltl::darray<result_t> results;
+            size_t errors = 0;
+
+            printf("%-32s %8s %6s %14s %12s %10s %8s\n",
+                "Plugin", "Rate", "Block", "Samples/s", "ns/sample", "RT factor", "Allocs");
+
+            for (plug::Factory *f = plug::Factory::root(); f != NULL; f = f->next())
+            {
+                for (size_t i=0; ; ++i)
+                {
+                    const meta::plugin_t *meta = f->enumerate(i);
+                    if (meta == NULL)
+                        break;
+                    if (!plugin_selected(&cmd, meta))
+                        continue;
+                    if (!offline::supported(meta))
+                    {
+                        fprintf(stderr, "Skipping plugin '%s': some port types are not supported by the offline host\n", meta->uid);
+                        continue;
+                    }
+
+                    for (size_t j=0, nj=cmd.rates.size(); j<nj; ++j)
+                        for (size_t k=0, nk=cmd.blocks.size(); k<nk; ++k)
+                        {
+                            result_t r;
+                            r.meta          = meta;
+                            r.rate          = *cmd.rates.uget(j);
+                            r.block         = *cmd.blocks.uget(k);
+                            r.samples       = 0;
+                            r.time          = 0;
+                            r.allocs        = -1;
+
+                            if ((res = run_benchmark(&r, f, manifest, &cmd)) != STATUS_OK)
+                            {
+                                fprintf(stderr, "Error benchmarking plugin '%s': %s\n", meta->uid, get_status(res));
+                                ++errors;
+                                continue;
+                            }
+
+                            printf("%-32s %8d %6d %14.1f %12.3f %10.3f %8ld\n",
+                                meta->uid, int(r.rate), int(r.block),
+                                samples_per_second(&r), ns_per_sample(&r), realtime_factor(&r), long(r.allocs));
+                            if (!results.add(&r))
+                                return STATUS_NO_MEM;
+                        }
+                }
+            }
+
+            // Store results
+            if (cmd.out_file != NULL)
+            {
+                io::Path path;
+                LSPString ext;
+                if ((res = path.set(cmd.out_file)) != STATUS_OK)
+                    return res;
+                if ((res = path.get_ext(&ext)) != STATUS_OK)
+                    return res;
+
+                res = (ext.equals_ascii_nocase("json")) ?
+                    save_json(cmd.out_file, manifest, &results) :
+                    save_csv(cmd.out_file, &results);
+                if (res != STATUS_OK)
+                {
+                    fprintf(stderr, "Error saving results to file '%s': %s\n", cmd.out_file, get_status(res));
+                    return res;
+                }
+                printf("Results have been saved to file: %s\n", cmd.out_file);
+            }
+
+            return (errors > 0) ? STATUS_FAILED : STATUS_OK;
+        }
+
+    } /* namespace benchmark */
+} /* namespace lsp */
@@ -0,0 +1,639 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugin-fw
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugin-fw is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugin-fw is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugin-fw. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/debug.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/ipc/Thread.h>
+#include <lsp-plug.in/plug-fw/core/config.h>
+#include <lsp-plug.in/plug-fw/core/Resources.h>
+#include <lsp-plug.in/plug-fw/meta/func.h>
+#include <lsp-plug.in/plug-fw/util/offline/offline.h>
+#include <lsp-plug.in/runtime/system.h>
+
+namespace lsp
+{
+    namespace offline
+    {
+        static constexpr size_t WARMUP_TIMEOUT      = 30000;    // Maximum time to wait for plugin to load it's data, ms
+        static constexpr size_t WARMUP_DELAY        = 5;        // Delay between warm-up cycles, ms
+
+        MeshPort::MeshPort(const meta::port_t *meta) : Port(meta)
+        {
+            const size_t buffers    = meta->step;
+            const size_t buf_size   = align_size(meta->start * sizeof(float), 0x40);
+            const size_t mesh_size  = align_size(sizeof(plug::mesh_t) + sizeof(float *) * buffers, 0x40);
+
+            // Allocate pointer
+            uint8_t *ptr            = static_cast<uint8_t *>(malloc(mesh_size + buf_size * buffers));
+            if (ptr == NULL)
+                return;
+
+            // Initialize mesh
+            plug::mesh_t *mesh      = advance_ptr_bytes<plug::mesh_t>(ptr, mesh_size);
+            mesh->init(reinterpret_cast<float *>(ptr), buffers, buf_size / sizeof(float));
+            pBuffer                 = mesh;
+        }
+
+        MeshPort::~MeshPort()
+        {
+            if (pBuffer != NULL)
+            {
+                free(pBuffer);
+                pBuffer                 = NULL;
+            }
+        }
+
+        Wrapper::Wrapper(plug::Module *plugin, resource::ILoader *loader, const meta::package_t *package):
+            IWrapper(plugin, loader)
+        {
+            pPackage        = package;
+            pExecutor       = NULL;
+            vBuffers        = NULL;
+            nBlockSize      = 0;
+            bUpdateSettings = true;
+        }
+
+        Wrapper::~Wrapper()
+        {
+            destroy();
+        }
+
+        status_t Wrapper::init(size_t sample_rate, size_t block_size)
+        {
+            // Create ports
+            lltl::parray<plug::IPort> plugin_ports;
+            const meta::plugin_t *m = pPlugin->metadata();
+            if (!supported(m))
+                return STATUS_NOT_SUPPORTED;
+            for (const meta::port_t *port = m->ports; port->id != NULL; ++port)
+            {
+                if (create_port(&plugin_ports, port) == NULL)
+                    return STATUS_NO_MEM;
+            }
+
+            // Allocate audio buffers
+            const size_t buffers    = vAudioIn.size() + vAudioOut.size();
+            if (buffers > 0)
+            {
+                vBuffers                = static_cast<float *>(malloc(sizeof(float) * buffers * block_size));
+                if (vBuffers == NULL)
+                    return STATUS_NO_MEM;
+                dsp::fill_zero(vBuffers, buffers * block_size);
+
+                float *ptr              = vBuffers;
+                for (size_t i=0, n=vAudioIn.size(); i<n; ++i, ptr += block_size)
+                    vAudioIn.uget(i)->bind(ptr);
+                for (size_t i=0, n=vAudioOut.size(); i<n; ++i, ptr += block_size)
+                    vAudioOut.uget(i)->bind(ptr);
+            }
+            for (size_t i=0, n=vAudioBuffers.size(); i<n; ++i)
+                vAudioBuffers.uget(i)->set_buffer_size(block_size);
+            nBlockSize              = block_size;
+
+            // Initialize plugin
+            sPosition.sampleRate    = sample_rate;
+            pPlugin->init(this, plugin_ports.array());
+            pPlugin->set_sample_rate(sample_rate);
+            bUpdateSettings         = true;
+
+            return STATUS_OK;
+        }
+
+        void Wrapper::destroy()
+        {
+            // Delete plugin
+            if (pPlugin != NULL)
+            {
+                pPlugin->deactivate();
+                pPlugin->destroy();
+                delete pPlugin;
+                pPlugin     = NULL;
+            }
+
+            // Destroy executor
+            if (pExecutor != NULL)
+            {
+                pExecutor->shutdown();
+                delete pExecutor;
+                pExecutor   = NULL;
+            }
+
+            // Destroy ports
+            for (size_t i=0, n=vAllPorts.size(); i<n; ++i)
+                delete vAllPorts.uget(i);
+            vAllPorts.flush();
+            vAudioIn.flush();
+            vAudioOut.flush();
+            vPaths.flush();
+            vStrings.flush();
+            vMidi.flush();
+            vOsc.flush();
+            vAudioBuffers.flush();
+
+            // Free buffers
+            if (vBuffers != NULL)
+            {
+                free(vBuffers);
+                vBuffers    = NULL;
+            }
+
+            sKVT.clear();
+        }
+
+        Port *Wrapper::create_port(lltl::parray<plug::IPort> *plugin_ports, const meta::port_t *port)
+        {
+            Port *result = NULL;
+
+            // Control ports just hold the value, data ports get the storage which is not
+            // transferred anywhere because there is no UI in the offline host
+            switch (port->role)
+            {
+                case meta::R_PATH:
+                    result  = new PathPort(port);
+                    break;
+                case meta::R_STRING:
+                case meta::R_SEND_NAME:
+                case meta::R_RETURN_NAME:
+                    result  = new StringPort(port);
+                    break;
+                case meta::R_MIDI_IN:
+                case meta::R_MIDI_OUT:
+                    result  = new MidiPort(port);
+                    break;
+                case meta::R_MESH:
+                    result  = new MeshPort(port);
+                    break;
+                case meta::R_STREAM:
+                    result  = new StreamPort(port);
+                    break;
+                case meta::R_FBUFFER:
+                    result  = new FrameBufferPort(port);
+                    break;
+                case meta::R_OSC_IN:
+                case meta::R_OSC_OUT:
+                    result  = new OscPort(port);
+                    break;
+                case meta::R_AUDIO_SEND:
+                case meta::R_AUDIO_RETURN:
+                    result  = new AudioBufferPort(port);
+                    break;
+                default:
+                    result  = new Port(port);
+                    break;
+            }
+
+            if (result == NULL)
+                return NULL;
+            if (!vAllPorts.add(result))
+            {
+                delete result;
+                return NULL;
+            }
+
+            // The port is owned by the list of all ports since this moment
+            bool added = true;
+            switch (port->role)
+            {
+                case meta::R_MIDI_IN:
+                case meta::R_MIDI_OUT:
+                    added   = vMidi.add(static_cast<MidiPort *>(result));
+                    break;
+                case meta::R_MESH:
+                case meta::R_STREAM:
+                case meta::R_FBUFFER:
+                    added   = result->buffer() != NULL;
+                    break;
+                case meta::R_OSC_IN:
+                case meta::R_OSC_OUT:
+                    added   = (result->buffer() != NULL) && (vOsc.add(static_cast<OscPort *>(result)));
+                    break;
+                case meta::R_AUDIO_SEND:
+                case meta::R_AUDIO_RETURN:
+                    added   = vAudioBuffers.add(static_cast<AudioBufferPort *>(result));
+                    break;
+                case meta::R_AUDIO_IN:
+                    added   = vAudioIn.add(result);
+                    break;
+                case meta::R_AUDIO_OUT:
+                    added   = vAudioOut.add(result);
+                    break;
+                case meta::R_PATH:
+                    added   = vPaths.add(static_cast<PathPort *>(result));
+                    break;
+                case meta::R_STRING:
+                case meta::R_SEND_NAME:
+                case meta::R_RETURN_NAME:
+                    added   = (result->buffer() != NULL) && (vStrings.add(static_cast<StringPort *>(result)));
+                    break;
+                default:
+                    break;
+            }
+
+            return ((added) && (plugin_ports->add(result))) ? result : NULL;
+        }
+
+        ipc::IExecutor *Wrapper::executor()
+        {
+            if (pExecutor != NULL)
+                return pExecutor;
+
+            core::SharedExecutor *exec = new core::SharedExecutor();
+            if (exec == NULL)
+                return NULL;
+            if (exec->init() != STATUS_OK)
+            {
+                delete exec;
+                return NULL;
+            }
+            return pExecutor = exec;
+        }
+
+        core::KVTStorage *Wrapper::kvt_lock()
+        {
+            return (sKVTMutex.lock()) ? &sKVT : NULL;
+        }
+
+        core::KVTStorage *Wrapper::kvt_trylock()
+        {
+            return (sKVTMutex.try_lock()) ? &sKVT : NULL;
+        }
+
+        bool Wrapper::kvt_release()
+        {
+            return sKVTMutex.unlock();
+        }
+
+        void Wrapper::request_settings_update()
+        {
+            bUpdateSettings     = true;
+        }
+
+        const meta::package_t *Wrapper::package() const
+        {
+            return pPackage;
+        }
+
+        status_t Wrapper::import_settings(const char *file)
+        {
+            io::Path base;
+            status_t res = base.set(file);
+            if (res == STATUS_OK)
+                res = base.remove_last();
+            if (res != STATUS_OK)
+                return res;
+
+            config::PullParser parser;
+            if ((res = parser.open(file)) == STATUS_OK)
+            {
+                pPlugin->before_state_load();
+                res = import_settings_work(&parser, &base);
+                if (res == STATUS_OK)
+                    pPlugin->state_loaded();
+            }
+            status_t res2 = parser.close();
+            bUpdateSettings     = true;
+
+            return (res == STATUS_OK) ? res2 : res;
+        }
+
+        status_t Wrapper::import_settings_work(config::PullParser *parser, const io::Path *base)
+        {
+            status_t res;
+            config::param_t param;
+
+            // Lock KVT
+            core::KVTStorage *kvt = kvt_lock();
+            lsp_finally {
+                if (kvt != NULL)
+                {
+                    kvt->gc();
+                    kvt_release();
+                }
+            };
+
+            // Reset all ports to default values
+            for (size_t i=0, n=vAllPorts.size(); i<n; ++i)
+            {
+                Port *p = vAllPorts.uget(i);
+                if (meta::is_in_port(p->metadata()))
+                    p->set_default();
+            }
+
+            // Process the configuration file
+            while ((res = parser->next(&param)) == STATUS_OK)
+            {
+                if (param.name.starts_with('/')) // KVT
+                {
+                    if (kvt == NULL)
+                        continue;
+
+                    core::deserialize_kvt_param(kvt, &param, core::KVT_RX);
+                }
+                else
+                {
+                    for (size_t i=0, n=vAllPorts.size(); i<n; ++i)
+                    {
+                        Port *p = vAllPorts.uget(i);
+                        const meta::port_t *meta = p->metadata();
+                        if ((meta != NULL) && (param.name.equals_ascii(meta->id)))
+                        {
+                            set_port_value(p, &param, base);
+                            break;
+                        }
+                    }
+                }
+            }
+
+            return (res == STATUS_EOF) ? STATUS_OK : res;
+        }
+
+        bool Wrapper::set_port_value(Port *port, const config::param_t *param, const io::Path *base)
+        {
+            const meta::port_t *p = port->metadata();
+            if ((p == NULL) || (!meta::is_in_port(p)))
+                return false;
+
+            switch (p->role)
+            {
+                case meta::R_PORT_SET:
+                case meta::R_CONTROL:
+                case meta::R_BYPASS:
+                {
+                    port->set_value(core::deserialize_control_value(p, param));
+                    break;
+                }
+                case meta::R_PATH:
+                {
+                    if (!param->is_string())
+                        return false;
+
+                    const char *value = param->v.str;
+                    io::Path path;
+                    if (core::parse_relative_path(&path, base, value, ::strlen(value)))
+                        value   = path.as_utf8();
+
+                    static_cast<PathPort *>(port)->data()->submit(value, plug::PF_STATE_IMPORT);
+                    break;
+                }
+                case meta::R_STRING:
+                case meta::R_SEND_NAME:
+                case meta::R_RETURN_NAME:
+                {
+                    if (!param->is_string())
+                        return false;
+
+                    plug::string_t *str = static_cast<StringPort *>(port)->data();
+                    if (str != NULL)
+                        str->submit(param->v.str, false);
+                    break;
+                }
+                default:
+                    return false;
+            }
+
+            return true;
+        }
+
+        void Wrapper::process_block(size_t samples)
+        {
+            // Commit pending string changes
+            for (size_t i=0, n=vStrings.size(); i<n; ++i)
+            {
+                if (vStrings.uget(i)->sync())
+                    bUpdateSettings     = true;
+            }
+
+            // Apply settings
+            if (bUpdateSettings)
+            {
+                bUpdateSettings     = false;
+                pPlugin->update_settings();
+            }
+
+            // There are no MIDI and OSC sources, and nobody consumes the output
+            for (size_t i=0, n=vMidi.size(); i<n; ++i)
+                vMidi.uget(i)->clear();
+            for (size_t i=0, n=vOsc.size(); i<n; ++i)
+                vOsc.uget(i)->clear();
+
+            // Process the data
+            pPlugin->process(samples);
+            sPosition.frame    += samples;
+        }
+
+        bool Wrapper::loading()
+        {
+            for (size_t i=0, n=vPaths.size(); i<n; ++i)
+            {
+                if (!vPaths.uget(i)->data()->idle())
+                    return true;
+            }
+
+            return (pExecutor != NULL) && (pExecutor->active_tasks() > 0);
+        }
+
+        void Wrapper::warm_up()
+        {
+            pPlugin->activate();
+
+            // Feed the plugin with silence until it loads all files and finishes all background tasks
+            for (size_t i=0, n=vAudioIn.size(); i<n; ++i)
+                dsp::fill_zero(static_cast<float *>(vAudioIn.uget(i)->buffer()), nBlockSize);
+
+            const system::time_millis_t deadline = system::get_time_millis() + WARMUP_TIMEOUT;
+            for (size_t idle = 0; idle < 2; )
+            {
+                process_block(nBlockSize);
+                if (!loading())
+                {
+                    ++idle;
+                    continue;
+                }
+
+                idle    = 0;
+                if (system::get_time_millis() >= deadline)
+                {
+                    lsp_warn("Plugin did not finish loading of data in %d ms", int(WARMUP_TIMEOUT));
+                    break;
+                }
+                ipc::Thread::sleep(WARMUP_DELAY);
+            }
+
+            sPosition.frame     = 0;
+        }
+
+        static ssize_t read_frames(mm::IInAudioStream *is, float *dst, size_t channels, size_t frames)
+        {
+            // The stream may return less frames than requested, read until the block is full
+            size_t count = 0;
+            while (count < frames)
+            {
+                const ssize_t n = is->read(&dst[count * channels], frames - count);
+                if (n < 0)
+                {
+                    if (n == -STATUS_EOF)
+                        break;
+                    return n;
+                }
+                else if (n == 0)
+                    break;
+                count          += n;
+            }
+
+            return count;
+        }
+
+        static status_t write_frames(mm::IOutAudioStream *os, const float *src, size_t channels, size_t frames)
+        {
+            for (size_t count = 0; count < frames; )
+            {
+                const ssize_t n = os->write(&src[count * channels], frames - count);
+                if (n < 0)
+                    return status_t(-n);
+                else if (n == 0)
+                    return STATUS_IO_ERROR;
+                count          += n;
+            }
+
+            return STATUS_OK;
+        }
+
+        status_t Wrapper::render(mm::IOutAudioStream *os, mm::IInAudioStream *is, size_t tail)
+        {
+            const size_t in_channels    = is->channels();
+            const size_t out_channels   = vAudioOut.size();
+            const size_t latency        = pPlugin->latency();
+
+            if (out_channels <= 0)
+                return STATUS_NO_DATA;
+            if (os->channels() != out_channels)
+                return STATUS_BAD_ARGUMENTS;
+
+            // Interleaved data is exchanged with streams by blocks of the same size as the plugin's block
+            const size_t channels       = lsp_max(in_channels, out_channels);
+            float *buf                  = static_cast<float *>(malloc(sizeof(float) * channels * nBlockSize));
+            if (buf == NULL)
+                return STATUS_NO_MEM;
+            lsp_finally {
+                free(buf);
+            };
+
+            bool eof                    = false;
+            size_t flush                = tail + latency;   // Number of samples to process after the end of input
+            size_t drop                 = latency;          // Number of output samples to drop for latency compensation
+
+            while (true)
+            {
+                // Read the input data
+                size_t in_count             = 0;
+                if ((!eof) && (in_channels > 0))
+                {
+                    const ssize_t n             = read_frames(is, buf, in_channels, nBlockSize);
+                    if (n < 0)
+                        return status_t(-n);
+                    in_count                    = n;
+                    eof                         = in_count < nBlockSize;
+                }
+                else
+                    eof                         = true;
+
+                // Compute the size of the block
+                size_t to_do                = nBlockSize;
+                if (eof)
+                {
+                    to_do                       = lsp_min(nBlockSize, in_count + flush);
+                    flush                      -= to_do - in_count;
+                }
+                if (to_do <= 0)
+                    break;
+
+                // Prepare input data
+                for (size_t i=0, n=vAudioIn.size(); i<n; ++i)
+                {
+                    float *dst                  = static_cast<float *>(vAudioIn.uget(i)->buffer());
+                    if (in_channels > 0)
+                    {
+                        const float *src            = &buf[i % in_channels];
+                        for (size_t j=0; j<in_count; ++j, src += in_channels)
+                            dst[j]                      = *src;
+                    }
+                    dsp::fill_zero(&dst[in_count], to_do - in_count);
+                }
+
+                process_block(to_do);
+
+                // Store output data, latency is compensated by dropping first samples of the plugin's output
+                const size_t skip           = lsp_min(drop, to_do);
+                drop                       -= skip;
+                if (skip >= to_do)
+                    continue;
+
+                for (size_t i=0; i<out_channels; ++i)
+                {
+                    const float *src            = static_cast<float *>(vAudioOut.uget(i)->buffer());
+                    float *dst                  = &buf[i];
+                    for (size_t j=skip; j<to_do; ++j, dst += out_channels)
+                        *dst                        = src[j];
+                }
+
+                status_t res                = write_frames(os, buf, out_channels, to_do - skip);
+                if (res != STATUS_OK)
+                    return res;
+            }
+
+            return STATUS_OK;
+        }
+
+        bool supported(const meta::plugin_t *meta)
+        {
+            // Port sets require expansion of the member ports which is not implemented
+            for (const meta::port_t *port = meta->ports; port->id != NULL; ++port)
+            {
+                if (port->role == meta::R_PORT_SET)
+                    return false;
+            }
+
+            return true;
+        }
+
+        status_t load_package(meta::package_t **package)
+        {
+            resource::ILoader *loader   = core::create_resource_loader();
+            if (loader == NULL)
+                return STATUS_BAD_STATE;
+            lsp_finally {
+                delete loader;
+            };
+
+            io::IInStream *is = loader->read_stream(LSP_BUILTIN_PREFIX "manifest.json");
+            if (is == NULL)
+                return STATUS_NOT_FOUND;
+            lsp_finally {
+                is->close();
+                delete is;
+            };
+
+            return meta::load_manifest(package, is);
+        }
+
+    } /* namespace offline */
+} /* namespace lsp */
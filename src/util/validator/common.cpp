@@ -42,7 +42,8 @@ namespace lsp
             meta::E_KVT_SYNC |
             meta::E_DUMP_STATE |
             meta::E_FILE_PREVIEW |
-            meta::E_SHM_TRACKING;
+            meta::E_SHM_TRACKING |
+            meta::E_SILENCE_SUSPEND;
 
         static const char *decode_plugin_class(int type)
         {